@@ -42,7 +42,8 @@ struct nnp_profile benchmark_fully_connected_output(
 			if (!read_timer(&start_time))
 				continue;
 
-			nnp_fully_connected_inference(
+			nnp_fully_connected_inference_batch(
+				batch_size,
 				input_channels,
 				output_channels,
 				input,
@@ -30,6 +30,9 @@ class Configuration:
             cflags.append("-pthread")
             cxxflags.append("-pthread")
             ldflags.append("-pthread")
+        if options.use_work_stealing_pool:
+            # Leave pages of temporary buffers to be first touched by the (pinned) threads of the pool
+            cflags.append("-DNNP_FIRST_TOUCH_ALLOCATION=1")
 
         if self.host == "x86_64-linux-gnu":
             self.writer.variable("imageformat", "elf")
@@ -241,6 +244,7 @@ parser.add_argument("--host", dest="host", choices=("x86_64-linux-gnu", "x86_64-
 parser.add_argument("--enable-mkl", dest="use_mkl", action="store_true")
 parser.add_argument("--enable-openblas", dest="use_openblas", action="store_true")
 parser.add_argument("--enable-blis", dest="use_blis", action="store_true")
+parser.add_argument("--enable-work-stealing-pool", dest="use_work_stealing_pool", action="store_true")
 
 
 def main():
@@ -260,11 +264,19 @@ def main():
 
     # Build pthreadpool
     pthreadpool_dir = os.path.join(root_dir, "third-party", "pthreadpool")
-    config.source_dir = os.path.join(pthreadpool_dir, "src")
-    config.build_dir = os.path.join(pthreadpool_dir, "lib")
-    config.include_dirs = [os.path.join(pthreadpool_dir, "include")]
+    if options.use_work_stealing_pool:
+        # Work-stealing, NUMA-aware implementation of the pthreadpool interface
+        config.source_dir = os.path.join(root_dir, "src")
+        config.build_dir = os.path.join(root_dir, "build")
+        config.include_dirs = [os.path.join(root_dir, "include"), os.path.join(pthreadpool_dir, "include")]
+
+        pthreadpool_objects = [config.cc("work-stealing-pool.c")]
+    else:
+        config.source_dir = os.path.join(pthreadpool_dir, "src")
+        config.build_dir = os.path.join(pthreadpool_dir, "lib")
+        config.include_dirs = [os.path.join(pthreadpool_dir, "include")]
 
-    pthreadpool_objects = [config.cc("pthreadpool.c")]
+        pthreadpool_objects = [config.cc("pthreadpool.c")]
 
     # Build the library
     config.source_dir = os.path.join(root_dir, "src")
@@ -277,9 +289,17 @@ def main():
         config.cc("convolution-input-gradient.c"),
         config.cc("convolution-kernel.c"),
         config.cc("convolution-inference.c"),
+        config.cc("convolution-kernel-transform.c"),
+        config.cc("convolution-implicit-gemm.c"),
+        config.cc("convolution-depthwise.c"),
+        config.cc("convolution-autotune.c"),
         config.cc("fully-connected-output.c"),
         config.cc("fully-connected-inference.c"),
         config.cc("pooling-output.c"),
+        config.cc("pooling-input-gradient.c"),
+        config.cc("softmax-output.c"),
+        config.cc("relu-output.c"),
+        config.cc("relu-input-gradient.c"),
     ]
 
     x86_64_nnpack_objects = [
@@ -289,6 +309,14 @@ def main():
         config.peachpy("x86_64-fma/2d-wt-8x8-3x3.py"),
         # Pooling
         config.peachpy("x86_64-fma/max-pooling.py"),
+        config.cc("x86_64-fma/max-pooling.c", extra_cflags=["-mavx2"]),
+        config.cc("x86_64-fma/average-pooling.c", extra_cflags=["-mavx2"]),
+        # Softmax
+        config.cc("x86_64-fma/softmax.c", extra_cflags=["-mavx2", "-mfma"]),
+        # ReLU
+        config.peachpy("x86_64-fma/relu.py"),
+        # Depthwise convolution
+        config.cc("x86_64-fma/depthwise.c", extra_cflags=["-mavx2", "-mfma"]),
         # FFT block accumulation
         config.peachpy("x86_64-fma/fft-block-mac.py"),
         # Tuple GEMM
@@ -297,6 +325,26 @@ def main():
         # BLAS microkernels
         config.peachpy("x86_64-fma/sgemm.py"),
         config.peachpy("x86_64-fma/sdotxf.py"),
+        # AVX-512 microkernels, selected at runtime
+        config.cc("x86_64-avx512/sgemm.c", extra_cflags=["-mavx512f"]),
+        config.cc("x86_64-avx512/sdotxf.c", extra_cflags=["-mavx512f"]),
+        config.cc("x86_64-avx512/relu.c", extra_cflags=["-mavx512f"]),
+        config.cc("x86_64-avx512/2d-fft.c", extra_cflags=["-mavx512f"]),
+        config.cc("x86_64-avx512/2d-winograd-8x8-3x3.c", extra_cflags=["-mavx512f"]),
+        config.cc("x86_64-avx512/c16gemm.c", extra_cflags=["-mavx512f"]),
+        config.cc("x86_64-avx512/s16gemm.c", extra_cflags=["-mavx512f"]),
+        # SSE2 kernels, selected at runtime on processors without AVX2 and FMA3
+        config.cc("x86_64-sse2/2d-fft.c"),
+        config.cc("x86_64-sse2/2d-winograd-8x8-3x3.c"),
+        config.cc("x86_64-sse2/max-pooling.c"),
+        config.cc("x86_64-sse2/average-pooling.c"),
+        config.cc("x86_64-sse2/softmax.c"),
+        config.cc("x86_64-sse2/relu.c"),
+        config.cc("x86_64-sse2/depthwise.c"),
+        config.cc("x86_64-sse2/c8gemm.c"),
+        config.cc("x86_64-sse2/s8gemm.c"),
+        config.cc("x86_64-sse2/sgemm.c"),
+        config.cc("x86_64-sse2/sdotxf.c"),
     ]
 
     reference_layer_objects = [
@@ -304,8 +352,13 @@ def main():
         config.cc("ref/convolution-input-gradient.c"),
         config.cc("ref/convolution-kernel.c"),
         config.cc("ref/fully-connected-output.c"),
+        config.cc("ref/fully-connected-input-gradient.c"),
+        config.cc("ref/fully-connected-kernel-gradient.c"),
         config.cc("ref/pooling-output.c"),
+        config.cc("ref/pooling-input-gradient.c"),
         config.cc("ref/softmax-output.c"),
+        config.cc("ref/relu-output.c"),
+        config.cc("ref/relu-input-gradient.c"),
     ]
 
     reference_fft_objects = [
@@ -463,29 +516,73 @@ def main():
         config.phony("fully-connected-output-test",
             ["fully-connected-output-smoketest", "fully-connected-output-alexnet-test", "fully-connected-output-vgg-a-test", "fully-connected-output-overfeat-fast-test"])
 
+        fully_connected_inference_smoke_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("fully-connected-inference/smoke.cc")] + gtest_objects,
+                "fully-connected-inference-smoketest", libs=unittest_libs)
         fully_connected_inference_alexnet_test_binary = \
             config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("fully-connected-inference/alexnet.cc")] + gtest_objects, "fully-connected-inference-alexnet-test", libs=unittest_libs)
         fully_connected_inference_vgg_a_test_binary = \
             config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("fully-connected-inference/vgg-a.cc")] + gtest_objects, "fully-connected-inference-vgg-a-test", libs=unittest_libs)
         fully_connected_inference_overfeat_fast_test_binary = \
             config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("fully-connected-inference/overfeat-fast.cc")] + gtest_objects, "fully-connected-inference-overfeat-fast-test", libs=unittest_libs)
+        config.run(fully_connected_inference_smoke_test_binary, "fully-connected-inference-smoketest")
         config.run(fully_connected_inference_alexnet_test_binary, "fully-connected-inference-alexnet-test")
         config.run(fully_connected_inference_vgg_a_test_binary, "fully-connected-inference-vgg-a-test")
         config.run(fully_connected_inference_overfeat_fast_test_binary, "fully-connected-inference-overfeat-fast-test")
         config.phony("fully-connected-inference-test",
-            ["fully-connected-inference-alexnet-test", "fully-connected-inference-vgg-a-test", "fully-connected-inference-overfeat-fast-test"])
+            ["fully-connected-inference-smoketest", "fully-connected-inference-alexnet-test", "fully-connected-inference-vgg-a-test", "fully-connected-inference-overfeat-fast-test"])
+
+        fully_connected_input_gradient_smoke_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("fully-connected-input-gradient/smoke.cc")] + gtest_objects,
+                "fully-connected-input-gradient-smoketest", libs=unittest_libs)
+        fully_connected_input_gradient_alexnet_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("fully-connected-input-gradient/alexnet.cc")] + gtest_objects,
+                "fully-connected-input-gradient-alexnet-test", libs=unittest_libs)
+        config.run(fully_connected_input_gradient_smoke_test_binary, "fully-connected-input-gradient-smoketest")
+        config.run(fully_connected_input_gradient_alexnet_test_binary, "fully-connected-input-gradient-alexnet-test")
+        config.phony("fully-connected-input-gradient-test",
+            ["fully-connected-input-gradient-smoketest", "fully-connected-input-gradient-alexnet-test"])
+
+        fully_connected_kernel_gradient_smoke_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("fully-connected-kernel-gradient/smoke.cc")] + gtest_objects,
+                "fully-connected-kernel-gradient-smoketest", libs=unittest_libs)
+        fully_connected_kernel_gradient_alexnet_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("fully-connected-kernel-gradient/alexnet.cc")] + gtest_objects,
+                "fully-connected-kernel-gradient-alexnet-test", libs=unittest_libs)
+        config.run(fully_connected_kernel_gradient_smoke_test_binary, "fully-connected-kernel-gradient-smoketest")
+        config.run(fully_connected_kernel_gradient_alexnet_test_binary, "fully-connected-kernel-gradient-alexnet-test")
+        config.phony("fully-connected-kernel-gradient-test",
+            ["fully-connected-kernel-gradient-smoketest", "fully-connected-kernel-gradient-alexnet-test"])
 
         pooling_output_smoke_test_binary = \
             config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("pooling-output/smoke.cc")] + gtest_objects, "pooling-output-smoketest", libs=unittest_libs)
+        pooling_output_alexnet_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("pooling-output/alexnet.cc")] + gtest_objects, "pooling-output-alexnet-test", libs=unittest_libs)
         pooling_output_vgg_a_test_binary = \
             config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("pooling-output/vgg-a.cc")] + gtest_objects, "pooling-output-vgg-a-test", libs=unittest_libs)
         pooling_output_overfeat_fast_test_binary = \
             config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("pooling-output/overfeat-fast.cc")] + gtest_objects, "pooling-output-overfeat-fast", libs=unittest_libs)
         config.run(pooling_output_smoke_test_binary, "pooling-output-smoketest")
+        config.run(pooling_output_alexnet_test_binary, "pooling-output-alexnet-test")
         config.run(pooling_output_vgg_a_test_binary, "pooling-output-vgg-a-test")
         config.run(pooling_output_overfeat_fast_test_binary, "pooling-output-overfeat-fast")
         config.phony("pooling-output-test",
-            ["pooling-output-smoketest", "pooling-output-vgg-a-test", "pooling-output-overfeat-fast"])
+            ["pooling-output-smoketest", "pooling-output-alexnet-test", "pooling-output-vgg-a-test", "pooling-output-overfeat-fast"])
+
+        softmax_output_smoke_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("softmax-output/smoke.cc")] + gtest_objects, "softmax-output-smoketest", libs=unittest_libs)
+        config.run(softmax_output_smoke_test_binary, "softmax-output-smoketest")
+        config.phony("softmax-output-test", ["softmax-output-smoketest"])
+
+        relu_output_smoke_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("relu-output/smoke.cc")] + gtest_objects, "relu-output-smoketest", libs=unittest_libs)
+        config.run(relu_output_smoke_test_binary, "relu-output-smoketest")
+        config.phony("relu-output-test", ["relu-output-smoketest"])
+
+        relu_input_gradient_smoke_test_binary = \
+            config.cxxld(nnpack_objects + reference_layer_objects + [config.cxx("relu-input-gradient/smoke.cc")] + gtest_objects, "relu-input-gradient-smoketest", libs=unittest_libs)
+        config.run(relu_input_gradient_smoke_test_binary, "relu-input-gradient-smoketest")
+        config.phony("relu-input-gradient-test", ["relu-input-gradient-smoketest"])
 
         config.writer.default([
             fourier_reference_test_binary, fourier_x86_64_avx2_test_binary,
@@ -495,12 +592,16 @@ def main():
             convolution_inference_smoke_test_binary, convolution_inference_alexnet_test_binary, convolution_inference_vgg_a_test_binary, convolution_inference_overfeat_fast_test_binary,
             fully_connected_output_smoke_test_binary, fully_connected_output_alexnet_test_binary, fully_connected_output_vgg_a_test_binary, fully_connected_output_overfeat_fast_test_binary,
             fully_connected_inference_alexnet_test_binary, fully_connected_inference_vgg_a_test_binary, fully_connected_inference_overfeat_fast_test_binary,
-            pooling_output_smoke_test_binary, pooling_output_vgg_a_test_binary, pooling_output_overfeat_fast_test_binary])
+            fully_connected_input_gradient_smoke_test_binary, fully_connected_input_gradient_alexnet_test_binary,
+            fully_connected_kernel_gradient_smoke_test_binary, fully_connected_kernel_gradient_alexnet_test_binary,
+            pooling_output_smoke_test_binary, pooling_output_alexnet_test_binary, pooling_output_vgg_a_test_binary, pooling_output_overfeat_fast_test_binary,
+            softmax_output_smoke_test_binary,
+            relu_output_smoke_test_binary, relu_input_gradient_smoke_test_binary])
 
         config.phony("test",
-            ["convolution-output-test", "convolution-inference-test", "fully-connected-output-test", "pooling-output-test"])
+            ["convolution-output-test", "convolution-inference-test", "fully-connected-output-test", "fully-connected-input-gradient-test", "fully-connected-kernel-gradient-test", "pooling-output-test", "softmax-output-test", "relu-output-test", "relu-input-gradient-test"])
         config.phony("smoketest",
-            ["convolution-output-smoketest", "convolution-inference-smoketest", "fully-connected-output-smoketest", "pooling-output-smoketest"])
+            ["convolution-output-smoketest", "convolution-inference-smoketest", "fully-connected-output-smoketest", "fully-connected-input-gradient-smoketest", "fully-connected-kernel-gradient-smoketest", "pooling-output-smoketest", "softmax-output-smoketest", "relu-output-smoketest", "relu-input-gradient-smoketest"])
 
     # Build benchmarks
     config.source_dir = os.path.join(root_dir, "bench")
@@ -24,7 +24,13 @@ enum nnp_status {
 	nnp_status_invalid_input_channels = 4,
 	/** NNPACK function was called with output_channels == 0. */
 	nnp_status_invalid_output_channels = 5,
-	/** NNPACK function was called with input_size.height == 0 or input_size.width == 0 */
+	/** NNPACK function was called with groups == 0, or with input_channels or output_channels not divisible by groups */
+	nnp_status_invalid_groups = 6,
+	/** NNPACK function was called with kernel_dilation.height == 0 or kernel_dilation.width == 0 */
+	nnp_status_invalid_kernel_dilation = 7,
+	/** NNPACK function was called with activation parameters which are invalid for the activation function */
+	nnp_status_invalid_activation_parameters = 8,
+	/** NNPACK function was called with input_size.height == 0 or input_size.width == 0, or the padded input is smaller than the (dilated) kernel or the pooling window */
 	nnp_status_invalid_input_size = 10,
 	/** NNPACK function was called with input_stride.height == 0 or input_stride.width == 0 */
 	nnp_status_invalid_input_stride = 11,
@@ -34,6 +40,8 @@ enum nnp_status {
 	 *  - input_padding.right  >= kernel_size.width  (>= pooling_size.width)
 	 *  - input_padding.top    >= kernel_size.height (>= pooling_size.height)
 	 *  - input_padding.bottom >= kernel_size.height (>= pooling_size.height)
+	 *
+	 *  For dilated convolutions, the padding is compared with the size of the dilated kernel.
 	 */
 	nnp_status_invalid_input_padding = 12,
 	/** NNPACK function was called with kernel_size.height == 0 or kernel_size.width == 0 */
@@ -44,6 +52,16 @@ enum nnp_status {
 	nnp_status_invalid_pooling_stride = 15,
 	/** NNPACK function was called with convolution algorithm not in nnp_convolution_algorithm enumeration */
 	nnp_status_invalid_algorithm = 15,
+	/** NNPACK function was called with a transformed kernel which was not produced by nnp_convolution_kernel_transform
+	 *  for the same convolution algorithm, kernel transform layout, number of channels, and kernel size, or with a
+	 *  packed kernel which was not produced by nnp_fully_connected_pack_kernel for the same number of channels */
+	nnp_status_invalid_transformed_kernel = 16,
+	/** NNPACK function was called with kernel transform layout not in nnp_convolution_kernel_transform_layout enumeration */
+	nnp_status_invalid_kernel_transform_layout = 17,
+	/** NNPACK function was called with output_subsampling.height == 0 or output_subsampling.width == 0 */
+	nnp_status_invalid_output_subsampling = 18,
+	/** NNPACK function was called with activation not in nnp_activation enumeration */
+	nnp_status_invalid_activation = 19,
 
 	/** NNPACK does not support the particular input size for the function */
 	nnp_status_unsupported_input_size = 20,
@@ -65,7 +83,11 @@ enum nnp_status {
 	/** NNPACK does not implement this function for the host CPU */
 	nnp_status_unsupported_hardware = 51,
 	/** NNPACK failed to allocate memory for temporary buffers */
-	nnp_status_out_of_memory = 52
+	nnp_status_out_of_memory = 52,
+	/** NNPACK function was called with a caller-provided buffer which is too small for the computation */
+	nnp_status_insufficient_buffer = 53,
+	/** NNPACK function was called with a caller-provided buffer which is not aligned on a 64-byte boundary */
+	nnp_status_misaligned_buffer = 54
 };
 
 /**
@@ -79,15 +101,65 @@ enum nnp_convolution_algorithm {
 	/** Tiled convolution based on 2D Fourier transform with 16x16 blocks. Supports kernels up to 16x16. */
 	nnp_convolution_algorithm_ft16x16 = 2,
 	/** Tiled convolution based on 2D Winograd transform F(3x3, 6x6) with 8x8 blocks. Supports only 3x3 kernels. */
-	nnp_convolution_algorithm_wt8x8 = 3
+	nnp_convolution_algorithm_wt8x8 = 3,
+	/** Matrix multiplication of the kernel and implicitly formed input patches. Supports kernels of any size. */
+	nnp_convolution_algorithm_implicit_gemm = 4
 };
 
+/**
+ * @brief Strategy for computing kernel transform coefficients in convolutional layers.
+ */
 enum nnp_convolution_kernel_transform_strategy {
+	/** Recompute transformation of kernel every time it is needed, and never store it to memory */
 	nnp_convolution_kernel_transform_strategy_recompute = 1,
+	/** Compute transformation of kernel once per call, store it in memory, and reuse it for every input tile */
 	nnp_convolution_kernel_transform_strategy_reuse = 2,
+	/** Use kernel transform precomputed with nnp_convolution_kernel_transform */
 	nnp_convolution_kernel_transform_strategy_precomputed = 3
 };
 
+/**
+ * @brief Memory layout of precomputed kernel transform. The layout depends on the function which consumes it.
+ */
+enum nnp_convolution_kernel_transform_layout {
+	/** Kernel transform for nnp_convolution_output_precomputed */
+	nnp_convolution_kernel_transform_layout_output = 1,
+	/** Kernel transform for nnp_convolution_inference with nnp_convolution_kernel_transform_strategy_precomputed */
+	nnp_convolution_kernel_transform_layout_inference = 2
+};
+
+/**
+ * @brief Activation applied to the output of a layer.
+ */
+enum nnp_activation {
+	/** Identity activation f(x) := x, i.e. no transformation of the output */
+	nnp_activation_identity = 0,
+	/** Rectified linear unit f(x) := max(0, x) */
+	nnp_activation_relu = 1,
+	/** Leaky rectified linear unit f(x) := x < 0 ? negative_slope * x : x, with parameters in nnp_leaky_relu_parameters */
+	nnp_activation_leaky_relu = 2,
+	/** Clamp f(x) := min(max(x, min), max), with parameters in nnp_clamp_parameters */
+	nnp_activation_clamp = 3
+};
+
+/**
+ * @brief Parameters of nnp_activation_leaky_relu.
+ */
+struct nnp_leaky_relu_parameters {
+	/** Slope of the activation function for negative inputs. Must be finite. */
+	float negative_slope;
+};
+
+/**
+ * @brief Parameters of nnp_activation_clamp.
+ */
+struct nnp_clamp_parameters {
+	/** Lower bound of the output. May be -INFINITY. */
+	float min;
+	/** Upper bound of the output. Must not be less than min. May be INFINITY. */
+	float max;
+};
+
 /**
  * @brief Size of images, kernels, and pooling filters in NNPACK.
  */
@@ -128,10 +200,48 @@ struct nnp_profile {
 	double block_multiplication;
 };
 
+/**
+ * @brief Cache blocking of tiled convolution algorithms (ft8x8, ft16x16, wt8x8) in nnp_convolution_output.
+ * @details Transformed tuples of a block of input channels are multiplied while they stay in L1 cache. Each thread
+ *          keeps transformed kernel tuples of its block of output channels in L2 cache, and transformed input tuples
+ *          of a block of images are shared by all threads in L3 cache.
+ */
+struct nnp_convolution_blocking {
+	/** The number of input channels in a block. */
+	size_t input_channels_block;
+	/**
+	 * The number of transformed images in a block. If the batch is smaller than the block, the block holds images
+	 * of several output tiles.
+	 */
+	size_t batch_block;
+	/** The number of output channels in a block. */
+	size_t output_channels_block;
+};
+
 enum nnp_status nnp_initialize(void);
 
 enum nnp_status nnp_deinitialize(void);
 
+/**
+ * @brief Enables measured selection of convolution algorithms.
+ * @details With auto-tuning enabled, nnp_convolution_output and nnp_convolution_inference (including their workspace
+ *          and strided variants) resolve nnp_convolution_algorithm_auto by timing every algorithm which supports the
+ *          layer on the first call with a new layer shape. The fastest algorithm is remembered for the layer shape,
+ *          number of threads, and instruction set of the micro-kernels, and later calls use it without measurements.
+ *          Workspace size queries for nnp_convolution_algorithm_auto report a size sufficient for any algorithm
+ *          until the layer is measured.
+ * @param cache_path An optional path to a text file which persists measurements across processes. Measurements from
+ *                   the file are loaded by this call, and new measurements are appended to the file. If cache_path is
+ *                   NULL, measurements are kept only in memory.
+ */
+enum nnp_status nnp_autotune_enable(const char* cache_path);
+
+/**
+ * @brief Disables measured selection of convolution algorithms and releases the in-memory measurements.
+ * @details nnp_convolution_algorithm_auto falls back to selection by estimated cost.
+ */
+enum nnp_status nnp_autotune_disable(void);
+
 /**
  * @brief Computes output of a 2D convolutional layer from input and kernel tensors.
  * @details This function targets training of convolutional neural networks and performs forward propagation.
@@ -146,6 +256,9 @@ enum nnp_status nnp_deinitialize(void);
  *                                           Supports kernels up to 16x16.
  *    - nnp_convolution_algorithm_wt8x8   -- tiled convolution based on 2D Winograd transform F(3x3, 6x6).
  *                                           Supports only 3x3 kernels.
+ *    - nnp_convolution_algorithm_implicit_gemm -- matrix multiplication of the kernel and implicitly formed input
+ *                                                 patches. Supports kernels of any size. Chosen automatically
+ *                                                 for 1x1 kernels and for layers with few input channels.
  *
  * @param batch_size The number of images on the input and output of the convolutional layer.
  * @param input_channels The number of channels (AKA features, dimensions) in the input images.
@@ -181,6 +294,320 @@ enum nnp_status nnp_convolution_output(
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile);
 
+/**
+ * @brief Computes output of a 2D convolutional layer with a fused activation function.
+ * @details This function is similar to nnp_convolution_output, but applies an activation function to the output.
+ *          See nnp_convolution_output for description of the other parameters.
+ * @param activation Activation function applied to the output. The activation is fused into the output transform and
+ *                   does not need an extra pass over the output tensor. Possible values are:
+ *
+ *    - nnp_activation_identity   -- no activation, output is the sum of convolution and bias.
+ *    - nnp_activation_relu       -- rectified linear unit, output is max(0, convolution + bias).
+ *    - nnp_activation_leaky_relu -- leaky rectified linear unit, output is convolution + bias scaled by
+ *                                   negative_slope where it is negative.
+ *    - nnp_activation_clamp      -- output is convolution + bias clamped to [min, max].
+ *
+ * @param activation_parameters Parameters of the activation function: a pointer to nnp_leaky_relu_parameters for
+ *                              nnp_activation_leaky_relu, a pointer to nnp_clamp_parameters for nnp_activation_clamp,
+ *                              and NULL for other activation functions.
+ */
+enum nnp_status nnp_convolution_output_with_activation(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer using a caller-provided workspace for temporary buffers.
+ * @details This function is similar to nnp_convolution_output_with_activation, but avoids allocation of temporary memory
+ *          on every call. The same workspace can be reused across calls and layers, but not across concurrent calls.
+ *          See nnp_convolution_output_with_activation for description of the other parameters.
+ * @param[in,out] workspace_buffer A buffer for temporary data, aligned on a 64-byte boundary. If workspace_buffer is
+ *                                 NULL and workspace_size is not NULL, the function stores the required buffer size
+ *                                 to workspace_size and returns without doing the computation; input and output
+ *                                 pointers are not accessed in this case. If both workspace_buffer and
+ *                                 workspace_size are NULL, the function allocates temporary buffers internally.
+ * @param[in,out] workspace_size   The size of workspace_buffer, in bytes. Receives the required size of the workspace
+ *                                 buffer in a workspace size query.
+ */
+enum nnp_status nnp_convolution_output_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer with subsampling of the output (strided convolution).
+ * @details This function is similar to nnp_convolution_output_with_workspace, but computes only every
+ *          output_subsampling.height-th row and every output_subsampling.width-th column of the output.
+ *          With nnp_convolution_algorithm_auto, the function chooses the algorithm with the lowest estimated cost,
+ *          which is nnp_convolution_algorithm_implicit_gemm when subsampling would discard most of the outputs
+ *          computed by transform-based algorithms.
+ *          See nnp_convolution_output_with_workspace for description of the other parameters.
+ * @param output_subsampling Subsampling factors (strides) of the output in vertical and horizontal direction.
+ * @param[out] output A 4D tensor output[batch_size][output_channels][output_size.height][output_size.width] where
+ *                        output_size.height = (input_padding.top + input_size.height + input_padding.bottom -
+ *                                              kernel_size.height) / output_subsampling.height + 1
+ *                        output_size.width  = (input_padding.left + input_size.width + input_padding.right -
+ *                                              kernel_size.width) / output_subsampling.width + 1
+ */
+enum nnp_status nnp_convolution_output_strided(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer with grouped channels (grouped or depthwise convolution).
+ * @details This function is similar to nnp_convolution_output_strided, but input and output channels are split into
+ *          groups, and every output channel is a convolution of only the input channels in its group. All groups are
+ *          computed in one call with one workspace, which fits a single group. Depthwise convolutions (one input
+ *          channel per group) with nnp_convolution_algorithm_auto use direct convolution of every channel, with a
+ *          vectorized micro-kernel for 3x3 kernels. Direct depthwise convolution needs no workspace: the workspace size
+ *          query reports 0 bytes, and the computation is then called with NULL workspace_buffer and workspace_size.
+ *          Other grouped convolutions choose the algorithm for the channels of one group. Auto-tuning does not
+ *          measure grouped layers.
+ *          See nnp_convolution_output_strided for description of the other parameters.
+ * @param groups The number of groups. Must divide both input_channels and output_channels.
+ *               With groups == 1 the function computes a regular convolution.
+ * @param input_channels The total number of channels in the input images.
+ * @param output_channels The total number of channels in the output images. Output channels
+ *                        [g * output_channels / groups, (g + 1) * output_channels / groups) are computed from input
+ *                        channels [g * input_channels / groups, (g + 1) * input_channels / groups).
+ * @param[in]  kernel A 4D tensor kernel[output_channels][input_channels / groups][kernel_size.height][kernel_size.width].
+ */
+enum nnp_status nnp_convolution_output_grouped(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t groups,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer with a dilated kernel (dilated or atrous convolution).
+ * @details This function is similar to nnp_convolution_output_strided, but kernel elements are applied to input pixels
+ *          kernel_dilation apart, i.e. kernel element (i, j) multiplies the input pixel
+ *          (y * output_subsampling.height + i * kernel_dilation.height, x * output_subsampling.width + j * kernel_dilation.width)
+ *          of the padded input for output pixel (y, x). The dilated kernel covers
+ *
+ *              dilated_kernel_size.height = (kernel_size.height - 1) * kernel_dilation.height + 1
+ *              dilated_kernel_size.width  = (kernel_size.width - 1) * kernel_dilation.width + 1
+ *
+ *          input pixels. Fourier transform-based algorithms compute the convolution with a sparse kernel of the dilated
+ *          size, which must fit into the transform tile. nnp_convolution_algorithm_implicit_gemm reads only the input
+ *          pixels under the kernel elements and supports any dilation. nnp_convolution_algorithm_wt8x8 does not
+ *          support dilation other than 1x1. With nnp_convolution_algorithm_auto, the function chooses the algorithm
+ *          with the lowest estimated cost, which is nnp_convolution_algorithm_implicit_gemm when the dilated kernel is
+ *          too large for the transforms. Auto-tuning does not measure dilated layers.
+ *          See nnp_convolution_output_strided for description of the other parameters.
+ * @param kernel_dilation Dilation of the kernel in vertical and horizontal direction. A 1x1 dilation computes a regular
+ *                        convolution.
+ * @param input_padding Implicit zero-padding of input images. Must be less than the dilated kernel size, and the padded
+ *                      input must be at least as large as the dilated kernel.
+ * @param[out] output A 4D tensor output[batch_size][output_channels][output_size.height][output_size.width] where
+ *                        output_size.height = (input_padding.top + input_size.height + input_padding.bottom -
+ *                                              dilated_kernel_size.height) / output_subsampling.height + 1
+ *                        output_size.width  = (input_padding.left + input_size.width + input_padding.right -
+ *                                              dilated_kernel_size.width) / output_subsampling.width + 1
+ */
+enum nnp_status nnp_convolution_output_dilated(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer from input tensor and precomputed kernel transform.
+ * @details This function is similar to nnp_convolution_output, but skips transformation of the kernel tensor.
+ *          It targets forward propagation with fixed kernel coefficients, e.g. prediction on minibatches.
+ * @param algorithm The type of algorithm to use for convolution. Must match the algorithm used to compute the
+ *                  kernel transform, or be nnp_convolution_algorithm_auto to use the algorithm of the kernel transform.
+ * @param batch_size The number of images on the input and output of the convolutional layer.
+ * @param input_channels The number of channels (AKA features, dimensions) in the input images.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output images.
+ * @param input_size Size of input images, excluding implicit zero-padding.
+ * @param input_padding Implicit zero-padding of input images.
+ * @param kernel_size Kernel size.
+ * @param[in]  input  A 4D tensor input[batch_size][input_channels][input_size.height][input_size.width].
+ * @param[in]  transformed_kernel A kernel transform computed by nnp_convolution_kernel_transform with
+ *                                nnp_convolution_kernel_transform_layout_output layout.
+ * @param[in]  bias   A 1D array bias[output_channels].
+ * @param[out] output A 4D tensor output[batch_size][output_channels][output_size.height][output_size.width].
+ * @param activation Activation function applied to the output. The activation is fused into the output transform and
+ *                   does not need an extra pass over the output tensor. Possible values are:
+ *
+ *    - nnp_activation_identity   -- no activation, output is the sum of convolution and bias.
+ *    - nnp_activation_relu       -- rectified linear unit, output is max(0, convolution + bias).
+ *    - nnp_activation_leaky_relu -- leaky rectified linear unit, output is convolution + bias scaled by
+ *                                   negative_slope where it is negative.
+ *    - nnp_activation_clamp      -- output is convolution + bias clamped to [min, max].
+ *
+ * @param activation_parameters Parameters of the activation function: a pointer to nnp_leaky_relu_parameters for
+ *                              nnp_activation_leaky_relu, a pointer to nnp_clamp_parameters for nnp_activation_clamp,
+ *                              and NULL for other activation functions.
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ * @param[out] profile An optional pointer to profiling structure.
+ *                     If provided, the structure would record time spent in different phases of the computation.
+ */
+enum nnp_status nnp_convolution_output_precomputed(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const void* transformed_kernel,
+	const float bias[],
+	float output[],
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer from precomputed kernel transform using a caller-provided workspace.
+ * @details This function is similar to nnp_convolution_output_precomputed, but avoids allocation of temporary memory on
+ *          every call. The same workspace can be reused across calls and layers, but not across concurrent calls.
+ *          See nnp_convolution_output_precomputed for description of the other parameters.
+ * @param[in,out] workspace_buffer A buffer for temporary data, aligned on a 64-byte boundary. If workspace_buffer is
+ *                                 NULL and workspace_size is not NULL, the function stores the required buffer size
+ *                                 to workspace_size and returns without doing the computation; input and output
+ *                                 pointers are not accessed in this case. If both workspace_buffer and
+ *                                 workspace_size are NULL, the function allocates temporary buffers internally.
+ * @param[in,out] workspace_size   The size of workspace_buffer, in bytes. Receives the required size of the workspace
+ *                                 buffer in a workspace size query.
+ */
+enum nnp_status nnp_convolution_output_precomputed_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const void* transformed_kernel,
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Reports cache blocking which nnp_convolution_output_strided would use for a layer.
+ * @details Block sizes are derived from capacity of the caches available to the threads of threadpool, unless they are
+ *          overridden for the layer with nnp_convolution_output_set_blocking. The function does not run auto-tuning
+ *          measurements: for nnp_convolution_algorithm_auto it reports blocking of the algorithm which a call would
+ *          use without measurements. If the algorithm is not a tiled convolution algorithm, the function returns
+ *          nnp_status_unsupported_algorithm.
+ *          See nnp_convolution_output_strided for description of the other parameters.
+ * @param[out] blocking Receives the block sizes.
+ */
+enum nnp_status nnp_convolution_output_blocking(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	pthreadpool_t threadpool,
+	struct nnp_convolution_blocking* blocking);
+
+/**
+ * @brief Overrides cache blocking of tiled convolution algorithms in nnp_convolution_output for a layer.
+ * @details The override applies to all variants of nnp_convolution_output with the same layer parameters, for any
+ *          number of threads. Block sizes are rounded down to multiples of the register blocking of the algorithm.
+ *          Kernels transformed by nnp_convolution_kernel_transform fix the block of input channels, and its
+ *          override is ignored for them. Block sizes can be tuned by timing the layer with different overrides.
+ *          See nnp_convolution_output_strided for description of the other parameters.
+ * @param[in] blocking Block sizes for the layer. Zero fields keep the default block size. If blocking is NULL, the
+ *                     override is removed.
+ */
+enum nnp_status nnp_convolution_output_set_blocking(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const struct nnp_convolution_blocking* blocking);
+
 /**
  * @brief Computes gradient of input of a 2D convolutional layer from gradient of output and kernel tensors.
  * @details This function targets training of convolutional neural networks and performs backward propagation.
@@ -228,6 +655,35 @@ enum nnp_status nnp_convolution_input_gradient(
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile);
 
+/**
+ * @brief Computes gradient of input of a 2D convolutional layer using a caller-provided workspace for temporary buffers.
+ * @details This function is similar to nnp_convolution_input_gradient, but avoids allocation of temporary memory on every
+ *          call. The same workspace can be reused across calls and layers, but not across concurrent calls.
+ *          See nnp_convolution_input_gradient for description of the other parameters.
+ * @param[in,out] workspace_buffer A buffer for temporary data, aligned on a 64-byte boundary. If workspace_buffer is
+ *                                 NULL and workspace_size is not NULL, the function stores the required buffer size
+ *                                 to workspace_size and returns without doing the computation; input and output
+ *                                 pointers are not accessed in this case. If both workspace_buffer and
+ *                                 workspace_size are NULL, the function allocates temporary buffers internally.
+ * @param[in,out] workspace_size   The size of workspace_buffer, in bytes. Receives the required size of the workspace
+ *                                 buffer in a workspace size query.
+ */
+enum nnp_status nnp_convolution_input_gradient_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float grad_output[],
+	const float kernel[],
+	float grad_input[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
 /**
  * @brief Computes gradient of kernel of a 2D convolutional layer from gradient of output and input tensors.
  * @details This function targets training of convolutional neural networks and performs backward propagation.
@@ -274,6 +730,44 @@ enum nnp_status nnp_convolution_kernel_gradient(
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile);
 
+/**
+ * @brief Computes gradient of kernel of a 2D convolutional layer using a caller-provided workspace for temporary buffers.
+ * @details This function is similar to nnp_convolution_kernel_gradient, but avoids allocation of temporary memory on every
+ *          call. The same workspace can be reused across calls and layers, but not across concurrent calls.
+ *          See nnp_convolution_kernel_gradient for description of the other parameters.
+ * @param[in,out] workspace_buffer A buffer for temporary data, aligned on a 64-byte boundary. If workspace_buffer is
+ *                                 NULL and workspace_size is not NULL, the function stores the required buffer size
+ *                                 to workspace_size and returns without doing the computation; input and output
+ *                                 pointers are not accessed in this case. If both workspace_buffer and
+ *                                 workspace_size are NULL, the function allocates temporary buffers internally.
+ * @param[in,out] workspace_size   The size of workspace_buffer, in bytes. Receives the required size of the workspace
+ *                                 buffer in a workspace size query.
+ */
+enum nnp_status nnp_convolution_kernel_gradient_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float grad_output[],
+	float grad_kernel[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Updates kernel of a 2D convolutional layer with its scaled gradient: kernel += scale * grad_kernel.
+ * @details This function targets training of convolutional neural networks and fuses the computation of kernel
+ *          gradient (as in nnp_convolution_kernel_gradient) with an SGD step. The gradient is accumulated into the
+ *          kernel as soon as it is reconstructed from the transform domain, and is never stored to memory.
+ *          See nnp_convolution_kernel_gradient for description of algorithms and the other parameters.
+ * @param[in,out] kernel A 4D tensor kernel[output_channels][input_channels][kernel_size.height][kernel_size.width].
+ * @param scale The multiplier for the kernel gradient, e.g. the negated learning rate.
+ */
 enum nnp_status nnp_convolution_kernel_update(
 	enum nnp_convolution_algorithm algorithm,
 	size_t batch_size,
@@ -301,6 +795,9 @@ enum nnp_status nnp_convolution_kernel_update(
  *                                           Supports kernels up to 16x16.
  *    - nnp_convolution_algorithm_wt8x8   -- tiled convolution based on 2D Winograd transform F(3x3, 6x6).
  *                                           Supports only 3x3 kernels.
+ *    - nnp_convolution_algorithm_implicit_gemm -- matrix multiplication of the kernel and implicitly formed input
+ *                                                 patches. Supports kernels of any size. Chosen automatically
+ *                                                 for 1x1 kernels and for layers with few input channels.
  *
  * @param kernel_transform_strategy A strategy that guides computation of kernel transforms coefficients.
  *                                  Possible values are:
@@ -309,6 +806,10 @@ enum nnp_status nnp_convolution_kernel_update(
  *                                                             and never store it to memory.
  *    - nnp_convolution_kernel_transform_strategy_reuse     -- compute transformation of kernel tensor once, store in
  *                                                             memory, and reuse the coefficients for every input tile.
+ *    - nnp_convolution_kernel_transform_strategy_precomputed -- use kernel transform previously computed by
+ *                                                             nnp_convolution_kernel_transform with
+ *                                                             nnp_convolution_kernel_transform_layout_inference layout.
+ *                                                             The kernel argument must point to the kernel transform.
  *
  * @param input_channels The number of channels (AKA features, dimensions) in the input image.
  * @param output_channels The number of channels (AKA features, dimensions) in the output image.
@@ -316,7 +817,9 @@ enum nnp_status nnp_convolution_kernel_update(
  * @param input_padding Implicit zero-padding of input image.
  * @param kernel_size Kernel size.
  * @param[in]  input  A 3D tensor input[input_channels][input_size.height][input_size.width].
- * @param[in]  kernel A 4D tensor kernel[output_channels][input_channels][kernel_size.height][kernel_size.width].
+ * @param[in]  kernel A 4D tensor kernel[output_channels][input_channels][kernel_size.height][kernel_size.width],
+ *                    or a kernel transform if kernel_transform_strategy is
+ *                    nnp_convolution_kernel_transform_strategy_precomputed.
  * @param[in]  bias   A 1D array bias[output_channels].
  * @param[out] output A 3D tensor output[output_channels][output_size.height][output_size.width] where
  *                        output_size.height = (input_padding.top + input_size.height + input_padding.bottom) -
@@ -343,11 +846,255 @@ enum nnp_status nnp_convolution_inference(
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile);
 
+/**
+ * @brief Computes output of a 2D convolutional layer for a single input image with a fused activation function.
+ * @details This function is similar to nnp_convolution_inference, but applies an activation function to the output.
+ *          See nnp_convolution_inference for description of the other parameters.
+ * @param activation Activation function applied to the output. The activation is fused into the output transform and
+ *                   does not need an extra pass over the output tensor. Possible values are:
+ *
+ *    - nnp_activation_identity   -- no activation, output is the sum of convolution and bias.
+ *    - nnp_activation_relu       -- rectified linear unit, output is max(0, convolution + bias).
+ *    - nnp_activation_leaky_relu -- leaky rectified linear unit, output is convolution + bias scaled by
+ *                                   negative_slope where it is negative.
+ *    - nnp_activation_clamp      -- output is convolution + bias clamped to [min, max].
+ *
+ * @param activation_parameters Parameters of the activation function: a pointer to nnp_leaky_relu_parameters for
+ *                              nnp_activation_leaky_relu, a pointer to nnp_clamp_parameters for nnp_activation_clamp,
+ *                              and NULL for other activation functions.
+ */
+enum nnp_status nnp_convolution_inference_with_activation(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer for a single input image using a caller-provided workspace.
+ * @details This function is similar to nnp_convolution_inference_with_activation, but avoids allocation of temporary
+ *          memory on every call. The same workspace can be reused across calls and layers, but not across concurrent
+ *          calls. With nnp_convolution_kernel_transform_strategy_precomputed the kernel transform must be provided to
+ *          the workspace size query, too. Tiles of the image are processed in blocks, so the workspace for large images
+ *          is bounded by the cache size rather than proportional to the image size.
+ *          See nnp_convolution_inference_with_activation for description of the other parameters.
+ * @param[in,out] workspace_buffer A buffer for temporary data, aligned on a 64-byte boundary. If workspace_buffer is
+ *                                 NULL and workspace_size is not NULL, the function stores the required buffer size
+ *                                 to workspace_size and returns without doing the computation; input and output
+ *                                 pointers are not accessed in this case. If both workspace_buffer and
+ *                                 workspace_size are NULL, the function allocates temporary buffers internally.
+ * @param[in,out] workspace_size   The size of workspace_buffer, in bytes. Receives the required size of the workspace
+ *                                 buffer in a workspace size query.
+ */
+enum nnp_status nnp_convolution_inference_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer for a single input image with subsampling of the output.
+ * @details This function is similar to nnp_convolution_inference_with_workspace, but computes only every
+ *          output_subsampling.height-th row and every output_subsampling.width-th column of the output.
+ *          With nnp_convolution_algorithm_auto, the function chooses the algorithm with the lowest estimated cost,
+ *          which is nnp_convolution_algorithm_implicit_gemm when subsampling would discard most of the outputs
+ *          computed by transform-based algorithms.
+ *          nnp_convolution_algorithm_implicit_gemm does not support precomputed kernel transforms.
+ *          See nnp_convolution_inference_with_workspace for description of the other parameters.
+ * @param output_subsampling Subsampling factors (strides) of the output in vertical and horizontal direction.
+ * @param[out] output A 3D tensor output[output_channels][output_size.height][output_size.width] where
+ *                        output_size.height = (input_padding.top + input_size.height + input_padding.bottom -
+ *                                              kernel_size.height) / output_subsampling.height + 1
+ *                        output_size.width  = (input_padding.left + input_size.width + input_padding.right -
+ *                                              kernel_size.width) / output_subsampling.width + 1
+ */
+enum nnp_status nnp_convolution_inference_strided(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer with grouped channels for a single input image.
+ * @details This function is similar to nnp_convolution_inference_strided, but input and output channels are split
+ *          into groups, and every output channel is a convolution of only the input channels in its group. All groups
+ *          are computed in one call with one workspace, which fits a single group. Depthwise convolutions (one input
+ *          channel per group) with nnp_convolution_algorithm_auto use direct convolution of every channel, with a
+ *          vectorized micro-kernel for 3x3 kernels. Direct depthwise convolution needs no workspace: the workspace size
+ *          query reports 0 bytes, and the computation is then called with NULL workspace_buffer and workspace_size.
+ *          Other grouped convolutions choose the algorithm for the channels of one group. Auto-tuning does not
+ *          measure grouped layers, and with groups > 1 the function does not support
+ *          nnp_convolution_kernel_transform_strategy_precomputed.
+ *          See nnp_convolution_inference_strided for description of the other parameters.
+ * @param groups The number of groups. Must divide both input_channels and output_channels.
+ *               With groups == 1 the function computes a regular convolution.
+ * @param input_channels The total number of channels in the input image.
+ * @param output_channels The total number of channels in the output image. Output channels
+ *                        [g * output_channels / groups, (g + 1) * output_channels / groups) are computed from input
+ *                        channels [g * input_channels / groups, (g + 1) * input_channels / groups).
+ * @param[in]  kernel A 4D tensor kernel[output_channels][input_channels / groups][kernel_size.height][kernel_size.width].
+ */
+enum nnp_status nnp_convolution_inference_grouped(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t groups,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes output of a 2D convolutional layer with a dilated kernel for a single input image.
+ * @details This function is similar to nnp_convolution_inference_strided, but kernel elements are applied to input
+ *          pixels kernel_dilation apart. See nnp_convolution_output_dilated for the definition of dilation and the
+ *          supported algorithms. With dilation other than 1x1 the function does not support
+ *          nnp_convolution_kernel_transform_strategy_precomputed, and with
+ *          nnp_convolution_kernel_transform_strategy_recompute the sparse kernel of the dilated size is formed on the
+ *          worker's stack every time it is transformed. Auto-tuning does not measure dilated layers.
+ *          See nnp_convolution_inference_strided for description of the other parameters.
+ * @param kernel_dilation Dilation of the kernel in vertical and horizontal direction. A 1x1 dilation computes a regular
+ *                        convolution.
+ * @param input_padding Implicit zero-padding of input image. Must be less than the dilated kernel size.
+ * @param[out] output A 3D tensor output[output_channels][output_size.height][output_size.width] where
+ *                        output_size.height = (input_padding.top + input_size.height + input_padding.bottom -
+ *                                              dilated_kernel_size.height) / output_subsampling.height + 1
+ *                        output_size.width  = (input_padding.left + input_size.width + input_padding.right -
+ *                                              dilated_kernel_size.width) / output_subsampling.width + 1
+ */
+enum nnp_status nnp_convolution_inference_dilated(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes the size of the buffer for kernel transform of a 2D convolutional layer.
+ * @param algorithm The type of algorithm to compute kernel transform for. Possible values are:
+ *
+ *    - nnp_convolution_algorithm_ft8x8   -- tiled convolution based on 2D Fourier transform with 8x8 blocks.
+ *                                           Supports kernels up to 8x8.
+ *    - nnp_convolution_algorithm_ft16x16 -- tiled convolution based on 2D Fourier transform with 16x16 blocks.
+ *                                           Supports kernels up to 16x16.
+ *    - nnp_convolution_algorithm_wt8x8   -- tiled convolution based on 2D Winograd transform F(3x3, 6x6).
+ *                                           Supports only 3x3 kernels.
+ *
+ * @param layout Layout of the kernel transform. Possible values are:
+ *
+ *    - nnp_convolution_kernel_transform_layout_output    -- kernel transform for nnp_convolution_output_precomputed.
+ *    - nnp_convolution_kernel_transform_layout_inference -- kernel transform for nnp_convolution_inference with
+ *                                                           nnp_convolution_kernel_transform_strategy_precomputed.
+ *
+ * @param input_channels The number of channels (AKA features, dimensions) in the input images.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output images.
+ * @param kernel_size Kernel size.
+ * @param[out] transformed_kernel_size The size of the kernel transform buffer, in bytes.
+ */
+enum nnp_status nnp_convolution_kernel_transform_size(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_layout layout,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size kernel_size,
+	size_t* transformed_kernel_size);
+
+/**
+ * @brief Computes kernel transform of a 2D convolutional layer for repeated use in forward propagation.
+ * @details The kernel transform is an opaque buffer which records the algorithm, layout, and layer parameters it was
+ *          computed for. It is specific to the version of NNPACK and the host CPU, and should not be serialized.
+ * @param algorithm The type of algorithm to compute kernel transform for.
+ *                  See nnp_convolution_kernel_transform_size for possible values.
+ * @param layout Layout of the kernel transform. See nnp_convolution_kernel_transform_size for possible values.
+ * @param input_channels The number of channels (AKA features, dimensions) in the input images.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output images.
+ * @param kernel_size Kernel size.
+ * @param[in]  kernel A 4D tensor kernel[output_channels][input_channels][kernel_size.height][kernel_size.width].
+ * @param[out] transformed_kernel A buffer for the kernel transform. The buffer must be aligned on a 64-byte boundary.
+ * @param transformed_kernel_size The size of the transformed_kernel buffer, in bytes. Must be at least the size
+ *                                returned by nnp_convolution_kernel_transform_size.
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_convolution_kernel_transform(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_layout layout,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size kernel_size,
+	const float kernel[],
+	void* transformed_kernel,
+	size_t transformed_kernel_size,
+	pthreadpool_t threadpool);
+
 /**
  * @brief Computes output of a fully connected layer from input and kernel matrices.
  * @details This function targets training of convolutional neural networks and performs forward propagation.
  *          It is optimized for moderate minibatch sizes (64-128) and can be inefficient on a small minibatch.
- *          For minibatch size 1, use nnp_fully_connected_inference for optimal performance.
+ *          For minibatch size 1, use nnp_fully_connected_inference for optimal performance, and for small minibatches
+ *          in prediction use nnp_fully_connected_inference_batch.
  * @param input_channels The number of channels (AKA features, dimensions) in the input vector.
  * @param output_channels The number of channels (AKA features, dimensions) in the output vector.
  * @param[in]  input  A 1D array input[input_channels].
@@ -366,6 +1113,109 @@ enum nnp_status nnp_fully_connected_output(
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile);
 
+/**
+ * @brief Computes the size of the buffer for a packed kernel matrix of a fully connected layer.
+ * @param input_channels The number of channels (AKA features, dimensions) in the input vector.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output vector.
+ * @param[out] packed_kernel_size The size of the packed kernel buffer, in bytes.
+ */
+enum nnp_status nnp_fully_connected_packed_kernel_size(
+	size_t input_channels,
+	size_t output_channels,
+	size_t* packed_kernel_size);
+
+/**
+ * @brief Packs kernel matrix of a fully connected layer for repeated use in nnp_fully_connected_output_packed.
+ * @details The packed kernel is an opaque buffer which records the layer parameters and blocking it was packed with.
+ *          It is specific to the version of NNPACK and the host CPU, and should not be serialized.
+ * @param input_channels The number of channels (AKA features, dimensions) in the input vector.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output vector.
+ * @param[in]  kernel A 2D matrix kernel[output_channels][input_channels].
+ * @param[out] packed_kernel A buffer for the packed kernel. The buffer must be aligned on a 64-byte boundary.
+ * @param packed_kernel_size The size of the packed_kernel buffer, in bytes. Must be at least the size
+ *                           returned by nnp_fully_connected_packed_kernel_size.
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_fully_connected_pack_kernel(
+	size_t input_channels,
+	size_t output_channels,
+	const float kernel[],
+	void* packed_kernel,
+	size_t packed_kernel_size,
+	pthreadpool_t threadpool);
+
+/**
+ * @brief Computes output of a fully connected layer from input matrix and packed kernel matrix.
+ * @details This function is similar to nnp_fully_connected_output, but skips packing of the kernel matrix.
+ *          It targets forward propagation with fixed kernel coefficients.
+ * @param batch_size The number of vectors in the minibatch.
+ * @param input_channels The number of channels (AKA features, dimensions) in the input vector.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output vector.
+ * @param[in]  input  A 2D matrix input[batch_size][input_channels].
+ * @param[in]  packed_kernel A kernel matrix packed by nnp_fully_connected_pack_kernel.
+ * @param[out] output A 2D matrix output[batch_size][output_channels].
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ * @param[out] profile An optional pointer to profiling structure.
+ *                     If provided, the structure would record time spent in different phases of the computation.
+ */
+enum nnp_status nnp_fully_connected_output_packed(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input[],
+	const void* packed_kernel,
+	float output[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes gradient of input of a fully connected layer from gradient of output and kernel matrix.
+ * @details This function targets training of convolutional neural networks and performs backward propagation.
+ *          It is optimized for moderate minibatch sizes (64-128) and can be inefficient on a small minibatch.
+ * @param batch_size The number of vectors in the minibatch.
+ * @param input_channels The number of channels (AKA features, dimensions) in the input vector.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output vector.
+ * @param[in]  grad_output A 2D matrix grad_output[batch_size][output_channels].
+ * @param[in]  kernel      A 2D matrix kernel[output_channels][input_channels].
+ * @param[out] grad_input  A 2D matrix grad_input[batch_size][input_channels].
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_fully_connected_input_gradient(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float grad_output[],
+	const float kernel[],
+	float grad_input[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/**
+ * @brief Computes gradient of kernel of a fully connected layer from gradient of output and input matrix.
+ * @details This function targets training of convolutional neural networks and performs backward propagation.
+ *          The gradient is summed over the minibatch.
+ * @param batch_size The number of vectors in the minibatch.
+ * @param input_channels The number of channels (AKA features, dimensions) in the input vector.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output vector.
+ * @param[in]  input       A 2D matrix input[batch_size][input_channels].
+ * @param[in]  grad_output A 2D matrix grad_output[batch_size][output_channels].
+ * @param[out] grad_kernel A 2D matrix grad_kernel[output_channels][input_channels].
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_fully_connected_kernel_gradient(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input[],
+	const float grad_output[],
+	float grad_kernel[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
 /**
  * @brief Computes output of a fully connected layer for a single input vector and a kernel matrix.
  * @details This function targets prediction with convolutional neural networks and performs forward propagation.
@@ -385,6 +1235,29 @@ enum nnp_status nnp_fully_connected_inference(
 	float output[],
 	pthreadpool_t threadpool);
 
+/**
+ * @brief Computes output of a fully connected layer for a small minibatch of input vectors and a kernel matrix.
+ * @details This function targets prediction with convolutional neural networks and performs forward propagation.
+ *          It is optimized for small minibatch sizes (2-16): the kernel matrix is read from memory once and multiplied
+ *          by all input vectors in the minibatch. For minibatch size 1 it is equivalent to nnp_fully_connected_inference.
+ * @param batch_size The number of vectors in the minibatch.
+ * @param input_channels The number of channels (AKA features, dimensions) in the input vector.
+ * @param output_channels The number of channels (AKA features, dimensions) in the output vector.
+ * @param[in]  input  A 2D matrix input[batch_size][input_channels].
+ * @param[in]  kernel A 2D matrix kernel[output_channels][input_channels].
+ * @param[out] output A 2D matrix output[batch_size][output_channels].
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_fully_connected_inference_batch(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input[],
+	const float kernel[],
+	float output[],
+	pthreadpool_t threadpool);
+
 /**
  * @brief Computes output of a max-pooling layer for an input tensor.
  * @details This function targets both prediction and training of convolutional neural networks and performs forward
@@ -393,16 +1266,20 @@ enum nnp_status nnp_fully_connected_inference(
  * @param input_size Size of input images, excluding implicit zero-padding.
  * @param input_padding Implicit padding of input images. The padding pixels are ignored by the pooling filter, but
  *                      affect the output size.
- * @param pooling_size   Size of the pooling filter. Only 2x2 filter are currently supported.
- * @param pooling_stride Stride of the pooling filter. Only 2x2 strides are currently supported.
+ * @param pooling_size   Size of the pooling filter. 2x2 and 3x3 filters use specialized kernels, other sizes use a
+ *                       generic implementation.
+ * @param pooling_stride Stride of the pooling filter. Must not exceed the pooling size. 2x2 stride (for 2x2 and 3x3
+ *                       filters) and 1x1 stride (for 3x3 filter) use specialized kernels.
  * @param[in]  input  A 4D tensors input[batch_size][channels][input_size.height][input_size.width].
  * @param[out] output A 4D tensor output[batch_size][channels][output_size.height][output_size.width] where
  *                    output_size.height = ceil(
  *                      (input_padding.top + input_size.height + input_padding.bottom - pooling_size.height) /
- *                        pooling_stride.height)
+ *                        pooling_stride.height) + 1
  *                    output_size.width = ceil(
  *                      (input_padding.left + input_size.width + input_padding.right - pooling_size.width) /
- *                        pooling_stride.width)
+ *                        pooling_stride.width) + 1
+ *                    minus one in each dimension where the last pooling window would start in the bottom or right
+ *                    padding.
  * @param threadpool A thread pool for parallelization of the computation.
  *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
  */
@@ -417,12 +1294,151 @@ enum nnp_status nnp_max_pooling_output(
 	float output[],
 	pthreadpool_t threadpool);
 
+/**
+ * @brief Computes output of a max-pooling layer for an input tensor, and the locations of the maxima.
+ * @details This function targets training of convolutional neural networks and performs forward propagation.
+ *          The indices enable nnp_max_pooling_input_gradient to propagate gradient without another pass over the
+ *          input. See nnp_max_pooling_output for description of the other parameters.
+ * @param[out] indices A 4D tensor indices[batch_size][channels][output_size.height][output_size.width].
+ *                     Each element is the index (y * input_size.width + x) of the maximum input pixel of the pooling
+ *                     window within its input image. If several pixels have the maximum value, one of them is
+ *                     selected. Windows which cover only implicit padding produce UINT32_MAX.
+ */
+enum nnp_status nnp_max_pooling_output_with_indices(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float input[],
+	float output[],
+	uint32_t indices[],
+	pthreadpool_t threadpool);
+
+/**
+ * @brief Computes gradient of input of a max-pooling layer from gradient of output and locations of the maxima.
+ * @details This function targets training of convolutional neural networks and performs backward propagation.
+ *          Gradient of every output pixel is added to the input pixel selected by indices; all other input pixels
+ *          receive zero gradient. Parameters describing the layer must match the call to
+ *          nnp_max_pooling_output_with_indices which produced the indices.
+ * @param[in]  grad_output A 4D tensor grad_output[batch_size][channels][output_size.height][output_size.width].
+ * @param[in]  indices     A 4D tensor indices[batch_size][channels][output_size.height][output_size.width] produced by
+ *                         nnp_max_pooling_output_with_indices.
+ * @param[out] grad_input  A 4D tensor grad_input[batch_size][channels][input_size.height][input_size.width].
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_max_pooling_input_gradient(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float grad_output[],
+	const uint32_t indices[],
+	float grad_input[],
+	pthreadpool_t threadpool);
+
+/**
+ * @brief Computes output of an average-pooling layer for an input tensor.
+ * @details This function targets both prediction and training of convolutional neural networks and performs forward
+ *          propagation. Each output pixel is the average of input pixels in the pooling window: padding pixels are
+ *          not included in the average, and windows which cover only padding produce zero.
+ *          See nnp_max_pooling_output for description of the other parameters and the output size.
+ * @param pooling_size   Size of the pooling filter.
+ * @param pooling_stride Stride of the pooling filter. Must not exceed the pooling size.
+ */
+enum nnp_status nnp_average_pooling_output(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float input[],
+	float output[],
+	pthreadpool_t threadpool);
+
+/**
+ * @brief Computes output of a global average-pooling layer for an input tensor.
+ * @details This function targets both prediction and training of convolutional neural networks and performs forward
+ *          propagation. Each channel of every input image is averaged into a single output element.
+ * @param channels   The number of channels (AKA features, dimensions) in both input and output.
+ * @param input_size Size of input images.
+ * @param[in]  input  A 4D tensor input[batch_size][channels][input_size.height][input_size.width].
+ * @param[out] output A 2D matrix output[batch_size][channels].
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_global_average_pooling_output(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	const float input[],
+	float output[],
+	pthreadpool_t threadpool);
+
+/**
+ * @brief Computes output of a softmax layer for an input matrix.
+ * @details This function targets both prediction and training of convolutional neural networks and performs forward
+ *          propagation. The maximum of each input vector is subtracted before exponentiation to avoid overflow.
+ * @param batch_size The number of vectors on the input and output of the softmax layer.
+ * @param channels   The number of channels (AKA features, dimensions) in both input and output vectors.
+ * @param[in]  input  A 2D matrix input[batch_size][channels].
+ * @param[out] output A 2D matrix output[batch_size][channels]. The output may alias the input.
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
 enum nnp_status nnp_softmax_output(
-    size_t batch_size,
-    size_t channels,
-    const float input[],
-    float output[],
-    pthreadpool_t threadpool);
+	size_t batch_size,
+	size_t channels,
+	const float input[],
+	float output[],
+	pthreadpool_t threadpool);
+
+/**
+ * @brief Computes output of a rectified linear unit (ReLU) layer for an input matrix.
+ * @details This function targets both prediction and training of convolutional neural networks and performs forward
+ *          propagation. Non-negative inputs are passed unchanged, and negative inputs are multiplied by negative_slope.
+ * @param batch_size The number of vectors on the input and output of the ReLU layer.
+ * @param channels   The number of channels (AKA features, dimensions) in both input and output vectors.
+ * @param[in]  input  A 2D matrix input[batch_size][channels].
+ * @param[out] output A 2D matrix output[batch_size][channels]. The output may alias the input.
+ * @param negative_slope The multiplier for negative inputs. Zero gives the standard ReLU, a small positive value gives leaky ReLU.
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_relu_output(
+	size_t batch_size,
+	size_t channels,
+	const float input[],
+	float output[],
+	float negative_slope,
+	pthreadpool_t threadpool);
+
+/**
+ * @brief Computes gradient of input of a rectified linear unit (ReLU) layer from gradient of output and input matrices.
+ * @details This function targets training of convolutional neural networks and performs backward propagation.
+ *          Gradients of non-negative inputs are passed unchanged, and gradients of negative inputs are multiplied by negative_slope.
+ * @param batch_size The number of vectors on the input and output of the ReLU layer.
+ * @param channels   The number of channels (AKA features, dimensions) in both input and output vectors.
+ * @param[in]  grad_output A 2D matrix grad_output[batch_size][channels] with gradient of the ReLU output.
+ * @param[in]  input       A 2D matrix input[batch_size][channels] with the input of the ReLU layer.
+ * @param[out] grad_input  A 2D matrix grad_input[batch_size][channels]. The gradient of input may alias the gradient of output.
+ * @param negative_slope The multiplier for negative inputs, the same as in the call to nnp_relu_output.
+ * @param threadpool A thread pool for parallelization of the computation.
+ *                   If threadpool is NULL, the computation would run on the caller thread without parallelization.
+ */
+enum nnp_status nnp_relu_input_gradient(
+	size_t batch_size,
+	size_t channels,
+	const float grad_output[],
+	const float input[],
+	float grad_input[],
+	float negative_slope,
+	pthreadpool_t threadpool);
 
 #ifdef __cplusplus
 } /* extern "C" */
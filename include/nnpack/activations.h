@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stddef.h>
+#include <math.h>
+
+#include <nnpack.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Activation fused into the output of a layer:
+ *   f(x) := min(max(x < 0 ? negative_slope * x : x, lower_bound), upper_bound)
+ * ReLU is negative_slope = lower_bound = 0, leaky ReLU has infinite bounds, and clamp has negative_slope = 1.
+ * Layers pass NULL instead of a fused activation for the identity function.
+ */
+struct nnp_fused_activation {
+	float negative_slope;
+	float lower_bound;
+	float upper_bound;
+};
+
+/* Converts a validated activation other than nnp_activation_identity */
+static inline struct nnp_fused_activation nnp_fused_activation_init(
+	enum nnp_activation activation, const void* activation_parameters)
+{
+	switch (activation) {
+		case nnp_activation_leaky_relu:
+		{
+			const struct nnp_leaky_relu_parameters* parameters = activation_parameters;
+			return (struct nnp_fused_activation) {
+				.negative_slope = parameters->negative_slope,
+				.lower_bound = -INFINITY,
+				.upper_bound = INFINITY,
+			};
+		}
+		case nnp_activation_clamp:
+		{
+			const struct nnp_clamp_parameters* parameters = activation_parameters;
+			return (struct nnp_fused_activation) {
+				.negative_slope = 1.0f,
+				.lower_bound = parameters->min,
+				.upper_bound = parameters->max,
+			};
+		}
+		default:
+			/* ReLU: the zero lower bound also maps 0 * -inf = NaN to 0 */
+			return (struct nnp_fused_activation) {
+				.negative_slope = 0.0f,
+				.lower_bound = 0.0f,
+				.upper_bound = INFINITY,
+			};
+	}
+}
+
+/* Scalar version of the fused activation, with the NaN semantics of MAXPS/MINPS */
+static inline float nnp_fused_activation_apply(const struct nnp_fused_activation* activation, float x) {
+	if (x < 0.0f) {
+		x *= activation->negative_slope;
+	}
+	x = x > activation->lower_bound ? x : activation->lower_bound;
+	return x < activation->upper_bound ? x : activation->upper_bound;
+}
+
+typedef void (*nnp_relu_function)(const float*, float*, size_t, float);
+typedef void (*nnp_grad_relu_function)(const float*, const float*, float*, size_t, float);
+
+void nnp_relu__avx2(const float* input, float* output, size_t length, float negative_slope);
+void nnp_grad_relu__avx2(const float* output_gradient, const float* input, float* input_gradient, size_t length, float negative_slope);
+
+void nnp_relu__avx512f(const float* input, float* output, size_t length, float negative_slope);
+void nnp_grad_relu__avx512f(const float* output_gradient, const float* input, float* input_gradient, size_t length, float negative_slope);
+
+void nnp_relu__sse2(const float* input, float* output, size_t length, float negative_slope);
+void nnp_grad_relu__sse2(const float* output_gradient, const float* input, float* input_gradient, size_t length, float negative_slope);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
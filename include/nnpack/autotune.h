@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <nnpack.h>
+
+enum nnp_autotune_operation {
+	nnp_autotune_operation_convolution_output = 1,
+	nnp_autotune_operation_convolution_inference = 2,
+};
+
+/*
+ * Layer shape which auto-tuning results are keyed by.
+ * Micro-kernel ISA is a part of the key too, but it is fixed for the process and only matters for the cache file.
+ */
+struct nnp_autotune_key {
+	enum nnp_autotune_operation operation;
+	/* Kernel transform strategy for inference, zero for other operations */
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy;
+	size_t threads;
+	size_t batch_size;
+	size_t input_channels;
+	size_t output_channels;
+	struct nnp_size input_size;
+	struct nnp_padding input_padding;
+	struct nnp_size kernel_size;
+	struct nnp_size output_subsampling;
+};
+
+/*
+ * Runs the layer with the specified algorithm. Workspace arguments have the semantics of *_with_workspace functions.
+ * Returns an error status if the algorithm does not support the layer.
+ */
+typedef enum nnp_status (*nnp_autotune_function)(void* context,
+	enum nnp_convolution_algorithm algorithm,
+	void* workspace_buffer, size_t* workspace_size);
+
+bool nnp_autotune_enabled(void);
+
+/* Returns the fastest algorithm measured for the layer, or nnp_convolution_algorithm_auto if it was not measured */
+enum nnp_convolution_algorithm nnp_autotune_lookup(const struct nnp_autotune_key* key);
+
+/*
+ * Times every candidate algorithm on the layer and records the fastest one.
+ * Returns nnp_convolution_algorithm_auto if no candidate supports the layer.
+ * Output of the layer is left in an unspecified state: the caller runs the layer again with the selected algorithm.
+ */
+enum nnp_convolution_algorithm nnp_autotune_measure(const struct nnp_autotune_key* key,
+	nnp_autotune_function function, void* context,
+	void* workspace_buffer, size_t* workspace_size);
+
+/* Computes the workspace size which is sufficient for every candidate algorithm */
+enum nnp_status nnp_autotune_workspace_size(nnp_autotune_function function, void* context, size_t* workspace_size);
+
+/*
+ * Per-layer overrides of cache blocking. The threads field of the key is ignored: overrides apply to any number
+ * of threads. Setting a NULL blocking removes the override.
+ */
+bool nnp_autotune_lookup_blocking(const struct nnp_autotune_key* key, struct nnp_convolution_blocking* blocking);
+enum nnp_status nnp_autotune_set_blocking(const struct nnp_autotune_key* key,
+	const struct nnp_convolution_blocking* blocking);
+
+/* Removes all blocking overrides */
+void nnp_autotune_release_blocking(void);
@@ -20,6 +20,30 @@ void nnp_sgemm_1x24__fma3(size_t k, size_t k_block_number, const float* a, const
 void nnp_sgemm_2x24__fma3(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
 void nnp_sgemm_3x24__fma3(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
 void nnp_sgemm_4x24__fma3(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_1x16__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_2x16__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_3x16__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_4x16__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_1x32__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_2x32__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_3x32__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_4x32__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_1x48__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_2x48__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_3x48__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_4x48__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_1x8__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_2x8__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_3x8__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_4x8__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_1x16__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_2x16__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_3x16__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_4x16__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_1x24__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_2x24__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_3x24__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
+void nnp_sgemm_4x24__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask);
 
 typedef void (*nnp_tuple_gemm_function)(size_t, size_t, const float*, const float*, float*, size_t, size_t);
 
@@ -27,31 +51,109 @@ void nnp_c8gemm1x1__fma3(size_t k, size_t k_tile, const float* a, const float* b
 void nnp_c8gemm1x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_c8gemm2x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_c8gemm2x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemm1x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemm1x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemm2x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemm2x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm1x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm1x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm1x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm2x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm2x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm2x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm3x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm3x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemm3x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 
 void nnp_s4c6gemm2x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemm1x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemm1x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemm2x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemm2x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemm1x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemm1x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemm2x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm1x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm1x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm1x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm2x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm2x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm2x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm3x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm3x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemm3x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 
 void nnp_c8gemmca1x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_c8gemmca1x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_c8gemmca2x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_c8gemmca2x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemmca1x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemmca1x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemmca2x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemmca2x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca1x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca1x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca1x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca2x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca2x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca2x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca3x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca3x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmca3x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 
 void nnp_s4c6gemmca1x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemmca1x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemmca2x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemmca2x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemmca1x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemmca1x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemmca2x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemmca2x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca1x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca1x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca1x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca2x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca2x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca2x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca3x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca3x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmca3x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 
 void nnp_c8gemmcb1x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_c8gemmcb1x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_c8gemmcb2x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_c8gemmcb2x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemmcb1x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemmcb1x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemmcb2x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c8gemmcb2x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb1x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb1x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb1x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb2x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb2x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb2x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb3x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb3x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_c16gemmcb3x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 
 void nnp_s4c6gemmcb1x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemmcb1x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemmcb2x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s4c6gemmcb2x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemmcb1x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemmcb1x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemmcb2x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c6gemmcb2x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb1x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb1x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb1x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb2x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb2x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb2x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb3x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb3x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s4c14gemmcb3x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 
 void nnp_s8gemm1x1__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s8gemm1x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
@@ -65,6 +167,42 @@ void nnp_s8gemm3x1__fma3(size_t k, size_t k_tile, const float* a, const float* b
 void nnp_s8gemm3x2__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s8gemm3x3__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 void nnp_s8gemm3x4__fma3(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm1x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm1x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm1x3__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm1x4__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm2x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm2x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm2x3__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm2x4__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm3x1__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm3x2__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm3x3__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s8gemm3x4__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm1x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm1x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm1x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm1x4__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm1x5__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm1x6__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm2x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm2x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm2x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm2x4__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm2x5__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm2x6__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm3x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm3x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm3x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm3x4__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm3x5__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm3x6__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm4x1__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm4x2__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm4x3__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm4x4__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm4x5__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
+void nnp_s16gemm4x6__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride, size_t column_stride);
 
 
 typedef void (*nnp_sdotxf_function)(const float*, const float*, size_t, float*, size_t);
@@ -76,6 +214,22 @@ void nnp_sdotxf5__avx2(const float* x, const float* y, size_t stride_y, float* s
 void nnp_sdotxf6__avx2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
 void nnp_sdotxf7__avx2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
 void nnp_sdotxf8__avx2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf1__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf2__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf3__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf4__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf5__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf6__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf7__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf8__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf1__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf2__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf3__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf4__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf5__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf6__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf7__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
+void nnp_sdotxf8__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n);
 
 #ifdef __cplusplus
 } /* extern "C" */
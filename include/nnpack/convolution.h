@@ -0,0 +1,221 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include <nnpack.h>
+#include <nnpack/utils.h>
+#include <nnpack/activations.h>
+
+static inline struct nnp_size nnp_convolution_output_size(
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size kernel_size, struct nnp_size output_subsampling)
+{
+	return (struct nnp_size) {
+		.width = (input_padding.left + input_size.width + input_padding.right - kernel_size.width) / output_subsampling.width + 1,
+		.height = (input_padding.top + input_size.height + input_padding.bottom - kernel_size.height) / output_subsampling.height + 1
+	};
+}
+
+/* Size of the input region which a kernel with kernel_dilation - 1 pixels between its elements covers */
+static inline struct nnp_size nnp_convolution_dilated_kernel_size(
+	struct nnp_size kernel_size, struct nnp_size kernel_dilation)
+{
+	return (struct nnp_size) {
+		.width = (kernel_size.width - 1) * kernel_dilation.width + 1,
+		.height = (kernel_size.height - 1) * kernel_dilation.height + 1
+	};
+}
+
+/*
+ * Scatters elements of a kernel into a zero-filled kernel of the dilated size. Transform-based algorithms convolve with
+ * the resulting sparse kernel as with a dense kernel of the dilated size.
+ */
+static inline void nnp_convolution_dilate_kernel(
+	const float* kernel, float* dilated_kernel,
+	struct nnp_size kernel_size, struct nnp_size kernel_dilation)
+{
+	const struct nnp_size dilated_kernel_size = nnp_convolution_dilated_kernel_size(kernel_size, kernel_dilation);
+	memset(dilated_kernel, 0, dilated_kernel_size.height * dilated_kernel_size.width * sizeof(float));
+	for (size_t row = 0; row < kernel_size.height; row++) {
+		for (size_t column = 0; column < kernel_size.width; column++) {
+			dilated_kernel[row * kernel_dilation.height * dilated_kernel_size.width + column * kernel_dilation.width] =
+				kernel[row * kernel_size.width + column];
+		}
+	}
+}
+
+/*
+ * Stores every output_subsampling-th element of a dense block of convolution outputs.
+ * row_count and column_count specify the number of stored (subsampled) elements.
+ */
+static inline void nnp_store_subsampled_tile(
+	const float* block, size_t block_stride,
+	float* output, size_t output_stride,
+	size_t row_count, size_t column_count,
+	struct nnp_size output_subsampling)
+{
+	for (size_t row = 0; row < row_count; row++) {
+		const float* block_row = block + row * output_subsampling.height * block_stride;
+		float* output_row = output + row * output_stride;
+		for (size_t column = 0; column < column_count; column++) {
+			output_row[column] = block_row[column * output_subsampling.width];
+		}
+	}
+}
+
+/*
+ * Estimated cost of a convolutional layer with an algorithm, in multiply-accumulate operations of the sgemm
+ * micro-kernels. Transform-based algorithms multiply transformed tiles with slightly lower efficiency, and their
+ * transforms are memory-bound: a transform costs about as much per tile as a thousand or more micro-kernel
+ * multiply-accumulates. Layers with few input channels, large kernels, or strides save too little arithmetic to pay
+ * for the transforms. Transforms compute all outputs, including the ones which subsampling discards, and convolve with
+ * dilated kernels as with dense kernels of the dilated size, while implicit GEMM multiplies only the kernel elements.
+ */
+static inline double nnp_convolution_cost(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size, size_t input_channels, size_t output_channels,
+	struct nnp_size kernel_size, struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling, struct nnp_size output_size)
+{
+	/* Relative efficiency of gathering input patches and of multiplication of transformed tiles */
+	const double implicit_gemm_efficiency = 0.9;
+	const double tuple_gemm_efficiency = 0.7;
+
+	const double channels_product = (double) input_channels * (double) output_channels;
+	if (algorithm == nnp_convolution_algorithm_implicit_gemm) {
+		const double output_pixels = (double) output_size.height * (double) output_size.width;
+		return (double) batch_size * channels_product * (double) (kernel_size.height * kernel_size.width) *
+			output_pixels / implicit_gemm_efficiency;
+	}
+
+	size_t tile_dimension;
+	double tile_mac_cost, transform_cost;
+	switch (algorithm) {
+		case nnp_convolution_algorithm_ft8x8:
+			/* Products of complex coefficients of the real-to-complex transform */
+			tile_dimension = 8;
+			tile_mac_cost = 2.0 * 8 * 8;
+			transform_cost = 1350.0;
+			break;
+		case nnp_convolution_algorithm_ft16x16:
+			tile_dimension = 16;
+			tile_mac_cost = 2.0 * 16 * 16;
+			transform_cost = 7200.0;
+			break;
+		case nnp_convolution_algorithm_wt8x8:
+			tile_dimension = 8;
+			tile_mac_cost = 8 * 8;
+			transform_cost = 800.0;
+			break;
+		default:
+			return HUGE_VAL;
+	}
+	const struct nnp_size dilated_kernel_size = nnp_convolution_dilated_kernel_size(kernel_size, kernel_dilation);
+	if (max(dilated_kernel_size.height, dilated_kernel_size.width) > tile_dimension) {
+		return HUGE_VAL;
+	}
+
+	/* Outputs which the transforms compute before subsampling */
+	const size_t dense_height = (output_size.height - 1) * output_subsampling.height + 1;
+	const size_t dense_width = (output_size.width - 1) * output_subsampling.width + 1;
+	const double tiles = (double) batch_size *
+		(double) divide_round_up(dense_height, tile_dimension - dilated_kernel_size.height + 1) *
+		(double) divide_round_up(dense_width, tile_dimension - dilated_kernel_size.width + 1);
+	return tiles * channels_product * tile_mac_cost / tuple_gemm_efficiency +
+		tiles * (double) (input_channels + output_channels) * transform_cost +
+		channels_product * transform_cost;
+}
+
+/*
+ * Chooses the algorithm with the lowest estimated cost for nnp_convolution_algorithm_auto. The Winograd transform is a
+ * candidate only for undilated 3x3 kernels, and only if the caller accepts its lower accuracy.
+ */
+static inline enum nnp_convolution_algorithm nnp_convolution_select_algorithm(
+	size_t batch_size, size_t input_channels, size_t output_channels,
+	struct nnp_size kernel_size, struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling, struct nnp_size output_size,
+	bool winograd)
+{
+	static const enum nnp_convolution_algorithm candidates[] = {
+		nnp_convolution_algorithm_implicit_gemm,
+		nnp_convolution_algorithm_wt8x8,
+		nnp_convolution_algorithm_ft8x8,
+		nnp_convolution_algorithm_ft16x16,
+	};
+
+	enum nnp_convolution_algorithm best_algorithm = nnp_convolution_algorithm_implicit_gemm;
+	double best_cost = HUGE_VAL;
+	for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+		if ((candidates[i] == nnp_convolution_algorithm_wt8x8) &&
+			!(winograd && (kernel_size.height == 3) && (kernel_size.width == 3) &&
+				((kernel_dilation.height | kernel_dilation.width) == 1)))
+		{
+			continue;
+		}
+
+		const double cost = nnp_convolution_cost(candidates[i],
+			batch_size, input_channels, output_channels,
+			kernel_size, kernel_dilation, output_subsampling, output_size);
+		if (cost < best_cost) {
+			best_algorithm = candidates[i];
+			best_cost = cost;
+		}
+	}
+	return best_algorithm;
+}
+
+/*
+ * Computes convolution as a product of the kernel matrix and a matrix of input patches (im2col).
+ * Patches are packed into cache-sized panels on the fly and never materialized for the whole image,
+ * thus the only temporary buffer is the packed kernel matrix.
+ * Bias and activation are applied to each block of outputs right after it is computed.
+ * Groups are multiplied one after another, and reuse the buffer for the packed kernel matrix of a group.
+ * With kernel dilation, patches gather input pixels kernel_dilation apart, so the reduction has only the kernel elements.
+ * Arguments must be validated by the caller. Workspace semantics match nnp_convolution_output_with_workspace.
+ */
+enum nnp_status nnp_convolution_implicit_gemm(
+	size_t batch_size,
+	size_t groups,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	const struct nnp_fused_activation* activation,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
+
+/*
+ * Computes depthwise convolution: every output channel is a convolution of the input channel
+ * output_channel / (output_channels / input_channels) with its own kernel. Channel images are convolved independently
+ * and directly, with a vectorized micro-kernel for 3x3 kernels, and the workspace is empty.
+ * Arguments must be validated by the caller. Workspace semantics match nnp_convolution_output_with_workspace.
+ */
+enum nnp_status nnp_convolution_depthwise(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	const struct nnp_fused_activation* activation,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <nnpack.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct nnp_fused_activation;
+
+/*
+ * Convolves one channel image with one kernel, adds the bias, and applies the activation unless it is NULL:
+ * a plane of a depthwise convolution.
+ * Arguments are (input, kernel, bias, output, input_size, input_padding, output_subsampling, output_size, activation).
+ */
+typedef void (*nnp_depthwise_conv_function)(const float*, const float*, float, float*,
+	struct nnp_size, struct nnp_padding, struct nnp_size, struct nnp_size, const struct nnp_fused_activation*);
+
+void nnp_dwconv3x3__avx2(const float* input, const float* kernel, float bias, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size output_subsampling, struct nnp_size output_size,
+	const struct nnp_fused_activation* activation);
+
+void nnp_dwconv3x3__sse2(const float* input, const float* kernel, float bias, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size output_subsampling, struct nnp_size output_size,
+	const struct nnp_fused_activation* activation);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
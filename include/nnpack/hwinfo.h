@@ -6,6 +6,10 @@
 #include <nnpack/macros.h>
 #include <nnpack/transform.h>
 #include <nnpack/blas.h>
+#include <nnpack/pooling.h>
+#include <nnpack/softmax.h>
+#include <nnpack/activations.h>
+#include <nnpack/depthwise.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,6 +19,9 @@ struct isa_info {
 	bool has_avx;
 	bool has_fma3;
 	bool has_avx2;
+	bool has_avx512f;
+	/* ISA targeted by the micro-kernels selected for the processor */
+	const char* name;
 };
 
 struct cache_info {
@@ -38,47 +45,120 @@ struct cache_blocking_info {
 	size_t l4;
 };
 
+/*
+ * Tables of micro-kernels for the detected ISA. They are filled by nnp_initialize, and the layers call kernels only
+ * through these tables. Shapes of the kernel tables are fixed by the packed data layouts.
+ */
+
 struct transforms {
-	nnp_transform_2d fft8x8;
+	nnp_transform_2d fft8x8_and_store;
+	nnp_transform_2d fft8x8_and_stream;
+	nnp_transform_2d_and_macc fft8x8_and_macc;
 	nnp_transform_2d ifft8x8;
 	nnp_transform_2d_with_bias ifft8x8_with_bias;
-	nnp_transform_2d fft16x16;
+	nnp_transform_2d_with_bias_and_activation ifft8x8_with_bias_activation;
+	nnp_transform_2d fft16x16_and_store;
+	nnp_transform_2d fft16x16_and_stream;
+	nnp_transform_2d_and_macc fft16x16_and_macc;
 	nnp_transform_2d ifft16x16;
 	nnp_transform_2d_with_bias ifft16x16_with_bias;
-	nnp_transform_2d iwt_f6x6_3x3;
-	nnp_transform_2d kwt_f6x6_3x3;
-	nnp_transform_2d kwt_f6x6_3Rx3R;
+	nnp_transform_2d_with_bias_and_activation ifft16x16_with_bias_activation;
+	nnp_transform_2d iwt_f6x6_3x3_and_store;
+	nnp_transform_2d iwt_f6x6_3x3_and_stream;
+	nnp_transform_2d kwt_f6x6_3x3_and_stream;
+	nnp_kernel_transform_and_mac kwt_f6x6_3x3_and_mac;
+	nnp_transform_2d kwt_f6x6_3Rx3R_and_stream;
 	nnp_transform_2d owt_f6x6_3x3;
 	nnp_transform_2d_with_bias owt_f6x6_3x3_with_bias;
+	nnp_transform_2d_with_bias_and_activation owt_f6x6_3x3_with_bias_activation;
 };
 
+/* functions[m - 1][n / simd_width - 1] multiplies packed panels into an m x n block of C */
 struct sgemm {
 	uint32_t mr;
 	uint32_t nr;
-	nnp_sgemm_function functions;
+	nnp_sgemm_function functions[4][3];
+};
+
+/*
+ * Formats of tuples of transformed coefficients. Tuples hold simd_width real or complex coefficients, and every set of
+ * micro-kernels packs transformed tiles into tuples in its own way, so only kernels of the same format can consume them.
+ */
+enum tuple_format {
+	tuple_format_sse2 = 1,
+	tuple_format_avx2 = 2,
+	tuple_format_avx512f = 3,
 };
 
+/* Products of real tuples: functions[m - 1][n - 1] computes an m x n block of tuples, m <= mr and n <= nr */
 struct sxgemm {
 	uint32_t mr;
 	uint32_t nr;
-	nnp_tuple_gemm_function* functions;
+	nnp_tuple_gemm_function functions[4][6];
+	/* Product of whole 8x8 tiles for inference */
+	nnp_tile_gemm_function tile8x8;
 };
 
+/*
+ * Products of complex tuples: functions[m - 1][n - 1] computes an m x n block of tuples, m <= mr and n <= nr.
+ * The first tuple of a real Fourier transform holds four real DC and Nyquist coefficients and uses the s4cX kernels
+ * (s4c6 for 8-element tuples), the other tuples use the cX kernels (c8 for 8-element tuples).
+ * conja and conjb variants multiply by complex conjugates of A and B.
+ */
 struct cxgemm {
 	uint32_t mr;
 	uint32_t nr;
-	nnp_tuple_gemm_function* functions;
+	nnp_tuple_gemm_function s4cX_functions[3][3];
+	nnp_tuple_gemm_function cX_functions[3][3];
+	nnp_tuple_gemm_function s4cX_conja_functions[3][3];
+	nnp_tuple_gemm_function cX_conja_functions[3][3];
+	nnp_tuple_gemm_function s4cX_conjb_functions[3][3];
+	nnp_tuple_gemm_function cX_conjb_functions[3][3];
+	/* Products of whole 8x8 and 16x16 Fourier tiles for inference */
+	nnp_tile_gemm_function tile8x8;
+	nnp_tile_gemm_function tile16x16;
 };
 
+/* functions[f - 1] computes f dot products with a shared vector */
 struct sdotxf {
 	uint32_t fusion;
-	nnp_sdotxf_function* functions;
+	nnp_sdotxf_function functions[8];
+};
+
+struct pooling {
+	nnp_pooling_function max_2x2_2x2;
+	nnp_pooling_function max_3x3_2x2;
+	nnp_pooling_function max_3x3_1x1;
+	nnp_image_pooling_function max_generic;
+	nnp_image_argmax_pooling_function max_argmax_generic;
+	nnp_image_pooling_function average_generic;
+	nnp_global_pooling_function global_average;
+};
+
+struct softmax {
+	nnp_vector_max_function vector_max;
+	nnp_vector_exp_minus_c_and_sum_function vector_exp_minus_c_and_sum;
+	nnp_vector_scale_function vector_scale;
+};
+
+struct activations {
+	nnp_relu_function relu;
+	nnp_grad_relu_function grad_relu;
+};
+
+/* Planes of depthwise convolution with 3x3 kernels, with optional fused activation */
+struct depthwise {
+	nnp_depthwise_conv_function conv3x3;
 };
 
 struct hardware_info {
 	bool initialized;
 	bool supported;
+	/* Number of elements in a tuple of transformed coefficients (real or complex) */
 	uint32_t simd_width;
+	enum tuple_format tuple_format;
+	/* Number of online logical processors */
+	uint32_t processors;
 
 	struct cache_hierarchy_info cache;
 	struct cache_blocking_info blocking;
@@ -88,12 +168,25 @@ struct hardware_info {
 	struct sxgemm sxgemm;
 	struct cxgemm cxgemm;
 	struct sdotxf sdotxf;
+	struct pooling pooling;
+	struct softmax softmax;
+	struct activations activations;
+	struct depthwise depthwise;
 
 	struct isa_info isa;
 };
 
 extern struct hardware_info nnp_hwinfo;
 
+/*
+ * Cache capacity in bytes which a computation with the specified number of threads can block for:
+ * - l1 and l2 are the parts of private caches available to a thread. Threads which run on logical processors sharing a
+ *   cache split it between themselves.
+ * - l3 is the capacity of the cache shared by all threads, less the copies of L2 content if the cache is inclusive.
+ * nnp_hwinfo.blocking holds the parameters for as many threads as there are logical processors.
+ */
+struct cache_blocking_info nnp_cache_blocking(size_t threads);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+
+/* "NNPK" in little-endian byte order */
+#define NNP_PACKED_KERNEL_MAGIC UINT32_C(0x4B504E4E)
+#define NNP_PACKED_KERNEL_VERSION UINT32_C(1)
+
+/*
+ * Header of the opaque buffer produced by nnp_fully_connected_pack_kernel.
+ * Packed kernel elements immediately follow the header. The header occupies a whole cache line,
+ * thus the elements inherit alignment of the buffer.
+ */
+struct NNP_CACHE_ALIGN nnp_packed_kernel {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t input_channels;
+	uint64_t output_channels;
+	/* Blocking of input channels and register blocking of output channels the elements were laid out with */
+	uint64_t input_channels_block_max;
+	uint64_t output_channels_subblock_max;
+};
+
+static inline const float* nnp_packed_kernel_data(const struct nnp_packed_kernel* packed_kernel) {
+	return (const float*) (packed_kernel + 1);
+}
+
+static inline enum nnp_status validate_packed_kernel(
+	const struct nnp_packed_kernel* packed_kernel,
+	size_t input_channels, size_t output_channels,
+	size_t output_channels_subblock_max)
+{
+	if (packed_kernel == NULL) {
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	if (((uintptr_t) packed_kernel) % sizeof(struct nnp_packed_kernel) != 0) {
+		return nnp_status_misaligned_buffer;
+	}
+
+	if ((packed_kernel->magic != NNP_PACKED_KERNEL_MAGIC) ||
+		(packed_kernel->version != NNP_PACKED_KERNEL_VERSION))
+	{
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	if ((packed_kernel->input_channels != input_channels) ||
+		(packed_kernel->output_channels != output_channels) ||
+		(packed_kernel->output_channels_subblock_max != output_channels_subblock_max) ||
+		(packed_kernel->input_channels_block_max == 0))
+	{
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	return nnp_status_success;
+}
@@ -2,14 +2,68 @@
 
 #include <stddef.h>
 
+#include <nnpack.h>
 #include <pthreadpool.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef void (*nnp_pooling_function)(const float*, float*, size_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+typedef void (*nnp_image_pooling_function)(const float*, float*,
+	struct nnp_size, struct nnp_padding, struct nnp_size, struct nnp_size, struct nnp_size);
+typedef void (*nnp_image_argmax_pooling_function)(const float*, float*, uint32_t*,
+	struct nnp_size, struct nnp_padding, struct nnp_size, struct nnp_size, struct nnp_size);
+typedef void (*nnp_global_pooling_function)(const float*, float*, size_t, size_t);
+
 void nnp_maxpool_2x2_2x2__avx2(const float* src_pointer, float* dst_pointer, size_t src_stride,
 	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count);
+void nnp_maxpool_3x3_2x2__avx2(const float* src_pointer, float* dst_pointer, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count);
+void nnp_maxpool_3x3_1x1__avx2(const float* src_pointer, float* dst_pointer, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count);
+void nnp_maxpool_2x2_2x2__sse2(const float* src_pointer, float* dst_pointer, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count);
+void nnp_maxpool_3x3_2x2__sse2(const float* src_pointer, float* dst_pointer, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count);
+void nnp_maxpool_3x3_1x1__sse2(const float* src_pointer, float* dst_pointer, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count);
+
+/* Max pooling of a whole image with arbitrary pooling size, stride, and padding */
+void nnp_maxpool_generic__avx2(const float* input, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size);
+
+/* Same as nnp_maxpool_generic__avx2, but also stores the index of the maximum within the input image */
+void nnp_maxpool_argmax_generic__avx2(const float* input, float* output, uint32_t* indices,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size);
+
+/* Average pooling of a whole image with arbitrary pooling size, stride, and padding. Padding pixels are not averaged. */
+void nnp_avgpool_generic__avx2(const float* input, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size);
+
+/* Averages each of the channels images of image_elements pixels into a single output element */
+void nnp_global_avgpool__avx2(const float* input, float* output, size_t channels, size_t image_elements);
+
+/* SSE2 versions of the above for processors without AVX2 and FMA3 */
+void nnp_maxpool_generic__sse2(const float* input, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size);
+void nnp_maxpool_argmax_generic__sse2(const float* input, float* output, uint32_t* indices,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size);
+void nnp_avgpool_generic__sse2(const float* input, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size);
+void nnp_global_avgpool__sse2(const float* input, float* output, size_t channels, size_t image_elements);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -10,11 +10,14 @@ extern "C" {
 
 void nnp_convolution_output__reference(
 	size_t batch_size,
+	size_t groups,
 	size_t input_channels,
 	size_t output_channels,
 	struct nnp_size input_size,
 	struct nnp_padding input_padding,
 	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
 	const float input_pointer[],
 	const float kernel_pointer[],
 	const float bias[],
@@ -67,6 +70,24 @@ void nnp_fully_connected_output__reference(
 	float output[],
 	pthreadpool_t threadpool);
 
+void nnp_fully_connected_input_gradient__reference(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float grad_output[],
+	const float kernel[],
+	float grad_input[],
+	pthreadpool_t threadpool);
+
+void nnp_fully_connected_kernel_gradient__reference(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input[],
+	const float grad_output[],
+	float grad_kernel[],
+	pthreadpool_t threadpool);
+
 void nnp_max_pooling_output__reference(
 	size_t batch_size,
 	size_t channels,
@@ -78,6 +99,61 @@ void nnp_max_pooling_output__reference(
 	float* output_pointer,
 	pthreadpool_t threadpool);
 
+void nnp_max_pooling_input_gradient__reference(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size kernel_stride,
+	const float* input_pointer,
+	const float* grad_output_pointer,
+	float* grad_input_pointer,
+	pthreadpool_t threadpool);
+
+void nnp_average_pooling_output__reference(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size kernel_stride,
+	const float* input_pointer,
+	float* output_pointer,
+	pthreadpool_t threadpool);
+
+void nnp_global_average_pooling_output__reference(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	const float* input_pointer,
+	float* output_pointer,
+	pthreadpool_t threadpool);
+
+void nnp_softmax_output__reference(
+	size_t batch_size,
+	size_t channels,
+	const float* input_pointer,
+	float* output_pointer,
+	pthreadpool_t threadpool);
+
+void nnp_relu_output__reference(
+	size_t batch_size,
+	size_t channels,
+	const float* input,
+	float* output,
+	float negative_slope,
+	pthreadpool_t threadpool);
+
+void nnp_relu_input_gradient__reference(
+	size_t batch_size,
+	size_t channels,
+	const float* grad_output,
+	const float* input,
+	float* grad_input,
+	float negative_slope,
+	pthreadpool_t threadpool);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
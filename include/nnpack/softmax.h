@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef float (*nnp_vector_max_function)(size_t, const float*);
+typedef float (*nnp_vector_exp_minus_c_and_sum_function)(size_t, const float*, float*, float);
+typedef void (*nnp_vector_scale_function)(size_t, float*, float);
+
+float nnp_vector_max__avx2(size_t length, const float* input);
+float nnp_vector_exp_minus_c_and_sum__avx2(size_t length, const float* input, float* output, float c);
+void nnp_vector_scale__avx2(size_t length, float* data, float scale);
+
+float nnp_vector_max__sse2(size_t length, const float* input);
+float nnp_vector_exp_minus_c_and_sum__sse2(size_t length, const float* input, float* output, float c);
+void nnp_vector_scale__sse2(size_t length, float* data, float scale);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -95,13 +95,26 @@ inline static double read_timer() {
 		profile_ptr->block_multiplication += read_timer() - block_multiplication_start; \
 	}
 
+#if defined(__linux__)
+	/*
+	 * Pages are normally populated by the calling thread, and on a NUMA system they are allocated on its node.
+	 * With NNP_FIRST_TOUCH_ALLOCATION, pages are allocated when threads of the pool first write them in parallel
+	 * transforms, and are placed on the nodes of the threads which process them.
+	 */
+	#if defined(NNP_FIRST_TOUCH_ALLOCATION) && NNP_FIRST_TOUCH_ALLOCATION
+		#define NNP_MAP_POPULATE 0
+	#else
+		#define NNP_MAP_POPULATE MAP_POPULATE
+	#endif
+#endif
+
 inline static void* allocate_memory(size_t memory_size) {
 #if defined(__linux__)
 	/* Try to use large page TLB */
-	void* memory_block = mmap(NULL, memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | MAP_HUGETLB, -1, 0);
+	void* memory_block = mmap(NULL, memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | NNP_MAP_POPULATE | MAP_HUGETLB, -1, 0);
 	if (memory_block == MAP_FAILED) {
 		/* Fallback to standard pages */
-		memory_block = mmap(NULL, memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+		memory_block = mmap(NULL, memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | NNP_MAP_POPULATE, -1, 0);
 		if (memory_block == MAP_FAILED) {
 			return NULL;
 		}
@@ -7,20 +7,28 @@
 extern "C" {
 #endif
 
+struct nnp_fused_activation;
+
 typedef void (*nnp_transform_2d)(const float*, float*, size_t, size_t, uint32_t, uint32_t, uint32_t, uint32_t);
 typedef void (*nnp_transform_2d_with_bias)(const float*, float*, const float*, size_t, size_t, uint32_t, uint32_t);
+typedef void (*nnp_transform_2d_with_bias_and_activation)(const float*, float*, const float*, size_t, size_t, uint32_t, uint32_t, const struct nnp_fused_activation*);
+typedef void (*nnp_transform_2d_and_macc)(const float*, float*, const float*, size_t, uint32_t, uint32_t, uint32_t, uint32_t);
+typedef void (*nnp_kernel_transform_and_mac)(const float*, float*, const float*, size_t);
+typedef void (*nnp_tile_gemm_function)(float*, const float*, const float*);
 
 void nnp_fft8x8_and_store__avx2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_fft8x8_and_stream__avx2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_fft8x8_and_macc__avx2(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_ifft8x8__avx2(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_ifft8x8_with_bias__avx2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count);
+void nnp_ifft8x8_with_bias_activation__avx2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
 
 void nnp_fft16x16_and_store__avx2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_fft16x16_and_stream__avx2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_fft16x16_and_macc__avx2(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_ifft16x16__avx2(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_ifft16x16_with_bias__avx2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count);
+void nnp_ifft16x16_with_bias_activation__avx2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
 
 void nnp_iwt8x8_3x3_and_store__avx2(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
 void nnp_iwt8x8_3x3_and_stream__avx2(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
@@ -32,12 +40,69 @@ void nnp_kwt8x8_3Rx3R_and_stream__avx2(const float g[], float wg[], size_t strid
 void nnp_kwt8x8_3Rx3R_and_mac__avx2(const float g[], float wg[], const float x[], size_t stride_g);
 void nnp_owt8x8_3x3__avx2(const float m[], float s[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, uint32_t, uint32_t);
 void nnp_owt8x8_3x3_with_bias__avx2(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count);
+void nnp_owt8x8_3x3_with_bias_activation__avx2(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
+
+void nnp_fft8x8_and_store__sse2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_fft8x8_and_stream__sse2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_fft8x8_and_macc__sse2(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_ifft8x8__sse2(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_ifft8x8_with_bias__sse2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count);
+void nnp_ifft8x8_with_bias_activation__sse2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
+void nnp_fft16x16_and_store__sse2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_fft16x16_and_stream__sse2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_fft16x16_and_macc__sse2(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_ifft16x16__sse2(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_ifft16x16_with_bias__sse2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count);
+void nnp_ifft16x16_with_bias_activation__sse2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
+
+void nnp_iwt8x8_3x3_and_store__sse2(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_iwt8x8_3x3_and_stream__sse2(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_kwt8x8_3x3_and_store__sse2(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t, uint32_t, uint32_t, uint32_t);
+void nnp_kwt8x8_3x3_and_stream__sse2(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t, uint32_t, uint32_t, uint32_t);
+void nnp_kwt8x8_3x3_and_mac__sse2(const float g[], float wg[], const float x[], size_t stride_g);
+void nnp_kwt8x8_3Rx3R_and_store__sse2(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t, uint32_t, uint32_t, uint32_t);
+void nnp_kwt8x8_3Rx3R_and_stream__sse2(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t, uint32_t, uint32_t, uint32_t);
+void nnp_kwt8x8_3Rx3R_and_mac__sse2(const float g[], float wg[], const float x[], size_t stride_g);
+void nnp_owt8x8_3x3__sse2(const float m[], float s[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, uint32_t, uint32_t);
+void nnp_owt8x8_3x3_with_bias__sse2(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count);
+void nnp_owt8x8_3x3_with_bias_activation__sse2(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
+
+void nnp_fft8x8_and_store__avx512f(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_fft8x8_and_stream__avx512f(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_fft8x8_and_macc__avx512f(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_ifft8x8__avx512f(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_ifft8x8_with_bias__avx512f(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count);
+void nnp_ifft8x8_with_bias_activation__avx512f(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
+void nnp_fft16x16_and_store__avx512f(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_fft16x16_and_stream__avx512f(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_fft16x16_and_macc__avx512f(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_ifft16x16__avx512f(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_ifft16x16_with_bias__avx512f(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count);
+void nnp_ifft16x16_with_bias_activation__avx512f(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
+
+void nnp_iwt8x8_3x3_and_store__avx512f(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_iwt8x8_3x3_and_stream__avx512f(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset);
+void nnp_kwt8x8_3x3_and_store__avx512f(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t, uint32_t, uint32_t, uint32_t);
+void nnp_kwt8x8_3x3_and_stream__avx512f(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t, uint32_t, uint32_t, uint32_t);
+void nnp_kwt8x8_3x3_and_mac__avx512f(const float g[], float wg[], const float x[], size_t stride_g);
+void nnp_kwt8x8_3Rx3R_and_store__avx512f(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t, uint32_t, uint32_t, uint32_t);
+void nnp_kwt8x8_3Rx3R_and_stream__avx512f(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t, uint32_t, uint32_t, uint32_t);
+void nnp_kwt8x8_3Rx3R_and_mac__avx512f(const float g[], float wg[], const float x[], size_t stride_g);
+void nnp_owt8x8_3x3__avx512f(const float m[], float s[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, uint32_t, uint32_t);
+void nnp_owt8x8_3x3_with_bias__avx512f(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count);
+void nnp_owt8x8_3x3_with_bias_activation__avx512f(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation);
 
 /* Convolution */
 
 void nnp_ft8x8gemmc__fma3(float acc[], const float x[], const float y[]);
 void nnp_ft16x16gemmc__fma3(float acc[], const float x[], const float y[]);
 void nnp_s8x8gemm__fma3(float acc[], const float x[], const float y[]);
+void nnp_ft8x8gemmc__sse2(float acc[], const float x[], const float y[]);
+void nnp_ft16x16gemmc__sse2(float acc[], const float x[], const float y[]);
+void nnp_s8x8gemm__sse2(float acc[], const float x[], const float y[]);
+void nnp_ft8x8gemmc__avx512f(float acc[], const float x[], const float y[]);
+void nnp_ft16x16gemmc__avx512f(float acc[], const float x[], const float y[]);
+void nnp_s8x8gemm__avx512f(float acc[], const float x[], const float y[]);
 
 #ifdef __cplusplus
 } /* extern "C" */
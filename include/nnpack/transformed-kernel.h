@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+#include <nnpack/hwinfo.h>
+
+/* "NNTK" in little-endian byte order */
+#define NNP_TRANSFORMED_KERNEL_MAGIC UINT32_C(0x4B544E4E)
+#define NNP_TRANSFORMED_KERNEL_VERSION UINT32_C(2)
+
+/*
+ * Header of the opaque buffer produced by nnp_convolution_kernel_transform.
+ * Transformed kernel coefficients immediately follow the header. The header occupies a whole cache line,
+ * thus the coefficients inherit alignment of the buffer.
+ */
+struct NNP_CACHE_ALIGN nnp_transformed_kernel {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t algorithm;
+	uint32_t layout;
+	uint64_t input_channels;
+	uint64_t output_channels;
+	uint32_t kernel_height;
+	uint32_t kernel_width;
+	/* Blocking of input channels the coefficients were laid out with */
+	uint64_t input_channels_block_max;
+	/* Format of tuples, which is specific to the micro-kernels that computed the transform (enum tuple_format) */
+	uint32_t tuple_format;
+};
+
+static inline const float* nnp_transformed_kernel_data(const struct nnp_transformed_kernel* transformed_kernel) {
+	return (const float*) (transformed_kernel + 1);
+}
+
+static inline enum nnp_status validate_transformed_kernel(
+	const struct nnp_transformed_kernel* transformed_kernel,
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_layout layout,
+	size_t input_channels, size_t output_channels,
+	struct nnp_size kernel_size)
+{
+	if (transformed_kernel == NULL) {
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	if (((uintptr_t) transformed_kernel) % sizeof(struct nnp_transformed_kernel) != 0) {
+		return nnp_status_misaligned_buffer;
+	}
+
+	if ((transformed_kernel->magic != NNP_TRANSFORMED_KERNEL_MAGIC) ||
+		(transformed_kernel->version != NNP_TRANSFORMED_KERNEL_VERSION))
+	{
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	if (transformed_kernel->tuple_format != (uint32_t) nnp_hwinfo.tuple_format) {
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	if ((algorithm != nnp_convolution_algorithm_auto) && (transformed_kernel->algorithm != (uint32_t) algorithm)) {
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	if (transformed_kernel->layout != (uint32_t) layout) {
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	if ((transformed_kernel->input_channels != input_channels) ||
+		(transformed_kernel->output_channels != output_channels) ||
+		(transformed_kernel->kernel_height != kernel_size.height) ||
+		(transformed_kernel->kernel_width != kernel_size.width) ||
+		(transformed_kernel->input_channels_block_max == 0))
+	{
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	return nnp_status_success;
+}
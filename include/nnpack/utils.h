@@ -37,3 +37,18 @@ static inline size_t divide_round_up(size_t dividend, size_t divisor) {
 		return dividend / divisor + 1;
 	}
 }
+
+/*
+ * Number of pooling windows along one dimension: the padded input is covered with ceiling rounding, but,
+ * as in Caffe, the last window is dropped if it would start in the trailing padding.
+ * The padded input must be at least as large as the pooling window (see validate_pooling_arguments).
+ */
+static inline size_t pooling_output_dimension(size_t input_size, size_t padding_before, size_t padding_after,
+	size_t pooling_size, size_t pooling_stride)
+{
+	const size_t output_size = divide_round_up(padding_before + input_size + padding_after - pooling_size, pooling_stride) + 1;
+	if ((output_size > 1) && ((output_size - 1) * pooling_stride >= padding_before + input_size)) {
+		return output_size - 1;
+	}
+	return output_size;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <math.h>
+
 #include <nnpack.h>
 #include <nnpack/utils.h>
 #include <nnpack/hwinfo.h>
@@ -7,7 +9,7 @@
 static inline enum nnp_status validate_convolution_arguments(
 	size_t batch_size, size_t input_channels, size_t output_channels,
 	struct nnp_size input_size, struct nnp_padding input_padding,
-	struct nnp_size kernel_size)
+	struct nnp_size kernel_size, struct nnp_size kernel_dilation, struct nnp_size output_subsampling)
 {
 	if (!nnp_hwinfo.initialized) {
 		return nnp_status_uninitialized;
@@ -33,16 +35,48 @@ static inline enum nnp_status validate_convolution_arguments(
 		return nnp_status_invalid_input_size;
 	}
 
-	if (max(input_padding.top, input_padding.bottom) >= kernel_size.height) {
+	if (min(kernel_size.height, kernel_size.width) == 0) {
+		return nnp_status_invalid_kernel_size;
+	}
+
+	if (min(kernel_dilation.height, kernel_dilation.width) == 0) {
+		return nnp_status_invalid_kernel_dilation;
+	}
+
+	/* Padding is limited by the extent of the kernel in the input, which dilation enlarges */
+	if (max(input_padding.top, input_padding.bottom) >= (kernel_size.height - 1) * kernel_dilation.height + 1) {
 		return nnp_status_invalid_input_padding;
 	}
 
-	if (max(input_padding.left, input_padding.right) >= kernel_size.width) {
+	if (max(input_padding.left, input_padding.right) >= (kernel_size.width - 1) * kernel_dilation.width + 1) {
 		return nnp_status_invalid_input_padding;
 	}
 
-	if (min(kernel_size.height, kernel_size.width) == 0) {
-		return nnp_status_invalid_kernel_size;
+	/* The padded input must contain at least one position of the dilated kernel */
+	if (input_padding.top + input_size.height + input_padding.bottom < (kernel_size.height - 1) * kernel_dilation.height + 1) {
+		return nnp_status_invalid_input_size;
+	}
+
+	if (input_padding.left + input_size.width + input_padding.right < (kernel_size.width - 1) * kernel_dilation.width + 1) {
+		return nnp_status_invalid_input_size;
+	}
+
+	if (min(output_subsampling.height, output_subsampling.width) == 0) {
+		return nnp_status_invalid_output_subsampling;
+	}
+
+	return nnp_status_success;
+}
+
+static inline enum nnp_status validate_convolution_groups(
+	size_t groups, size_t input_channels, size_t output_channels)
+{
+	if (groups == 0) {
+		return nnp_status_invalid_groups;
+	}
+
+	if ((input_channels % groups != 0) || (output_channels % groups != 0)) {
+		return nnp_status_invalid_groups;
 	}
 
 	return nnp_status_success;
@@ -99,7 +133,7 @@ static inline enum nnp_status validate_pooling_arguments(
 		return nnp_status_invalid_pooling_stride;
 	}
 
-	if ((pooling_size.height < pooling_stride.height) || (pooling_size.width < pooling_size.width)) {
+	if ((pooling_size.height < pooling_stride.height) || (pooling_size.width < pooling_stride.width)) {
 		return nnp_status_invalid_pooling_stride;
 	}
 
@@ -111,5 +145,78 @@ static inline enum nnp_status validate_pooling_arguments(
 		return nnp_status_invalid_input_padding;
 	}
 
+	/* The padded input must contain at least one pooling window */
+	if (input_padding.top + input_size.height + input_padding.bottom < pooling_size.height) {
+		return nnp_status_invalid_input_size;
+	}
+
+	if (input_padding.left + input_size.width + input_padding.right < pooling_size.width) {
+		return nnp_status_invalid_input_size;
+	}
+
+	return nnp_status_success;
+}
+
+static inline enum nnp_status validate_global_pooling_arguments(
+	size_t batch_size, size_t channels,
+	struct nnp_size input_size)
+{
+	if (!nnp_hwinfo.initialized) {
+		return nnp_status_uninitialized;
+	}
+
+	if (!nnp_hwinfo.supported) {
+		return nnp_status_unsupported_hardware;
+	}
+
+	if (batch_size == 0) {
+		return nnp_status_invalid_batch_size;
+	}
+
+	if (channels == 0) {
+		return nnp_status_invalid_channels;
+	}
+
+	if (min(input_size.height, input_size.width) == 0) {
+		return nnp_status_invalid_input_size;
+	}
+
 	return nnp_status_success;
 }
+
+static inline enum nnp_status validate_activation(enum nnp_activation activation, const void* activation_parameters)
+{
+	switch (activation) {
+		case nnp_activation_identity:
+		case nnp_activation_relu:
+			if (activation_parameters != NULL) {
+				return nnp_status_invalid_activation_parameters;
+			}
+			return nnp_status_success;
+		case nnp_activation_leaky_relu:
+		{
+			if (activation_parameters == NULL) {
+				return nnp_status_invalid_activation_parameters;
+			}
+			const struct nnp_leaky_relu_parameters* parameters = activation_parameters;
+			if (!isfinite(parameters->negative_slope)) {
+				return nnp_status_invalid_activation_parameters;
+			}
+			return nnp_status_success;
+		}
+		case nnp_activation_clamp:
+		{
+			if (activation_parameters == NULL) {
+				return nnp_status_invalid_activation_parameters;
+			}
+			/* Also rejects NaN bounds */
+			const struct nnp_clamp_parameters* parameters = activation_parameters;
+			if (!(parameters->min <= parameters->max)) {
+				return nnp_status_invalid_activation_parameters;
+			}
+			return nnp_status_success;
+		}
+		default:
+			return nnp_status_invalid_activation;
+	}
+}
@@ -0,0 +1,398 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <float.h>
+
+#include <pthread.h>
+
+#include <nnpack.h>
+#include <nnpack/utils.h>
+#include <nnpack/system.h>
+#include <nnpack/hwinfo.h>
+#include <nnpack/autotune.h>
+
+
+struct autotune_entry {
+	struct nnp_autotune_key key;
+	enum nnp_convolution_algorithm algorithm;
+};
+
+static pthread_mutex_t autotune_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool autotune_enabled = false;
+static char* autotune_cache_path = NULL;
+static struct autotune_entry* autotune_entries = NULL;
+static size_t autotune_entries_count = 0;
+static size_t autotune_entries_capacity = 0;
+
+struct blocking_override {
+	struct nnp_autotune_key key;
+	struct nnp_convolution_blocking blocking;
+};
+
+/* Blocking overrides are set explicitly by the user, and stay in effect when auto-tuning is disabled */
+static struct blocking_override* blocking_overrides = NULL;
+static size_t blocking_overrides_count = 0;
+static size_t blocking_overrides_capacity = 0;
+
+/* Candidates are tried in this order, and the first one wins a tie */
+static const enum nnp_convolution_algorithm candidate_algorithms[] = {
+	nnp_convolution_algorithm_ft8x8,
+	nnp_convolution_algorithm_ft16x16,
+	nnp_convolution_algorithm_wt8x8,
+	nnp_convolution_algorithm_implicit_gemm,
+};
+static const size_t candidate_count = sizeof(candidate_algorithms) / sizeof(candidate_algorithms[0]);
+
+/* Number of timed runs per candidate, after an untimed warm-up run */
+static const size_t autotune_repetitions = 2;
+
+static const char* algorithm_name(enum nnp_convolution_algorithm algorithm) {
+	switch (algorithm) {
+		case nnp_convolution_algorithm_ft8x8:
+			return "ft8x8";
+		case nnp_convolution_algorithm_ft16x16:
+			return "ft16x16";
+		case nnp_convolution_algorithm_wt8x8:
+			return "wt8x8";
+		case nnp_convolution_algorithm_implicit_gemm:
+			return "implicit-gemm";
+		default:
+			return NULL;
+	}
+}
+
+static const char* operation_name(enum nnp_autotune_operation operation) {
+	switch (operation) {
+		case nnp_autotune_operation_convolution_output:
+			return "output";
+		case nnp_autotune_operation_convolution_inference:
+			return "inference";
+		default:
+			return NULL;
+	}
+}
+
+static bool equal_keys(const struct nnp_autotune_key* a, const struct nnp_autotune_key* b) {
+	return (a->operation == b->operation) &&
+		(a->kernel_transform_strategy == b->kernel_transform_strategy) &&
+		(a->threads == b->threads) &&
+		(a->batch_size == b->batch_size) &&
+		(a->input_channels == b->input_channels) &&
+		(a->output_channels == b->output_channels) &&
+		(a->input_size.height == b->input_size.height) && (a->input_size.width == b->input_size.width) &&
+		(a->input_padding.top == b->input_padding.top) && (a->input_padding.right == b->input_padding.right) &&
+		(a->input_padding.bottom == b->input_padding.bottom) && (a->input_padding.left == b->input_padding.left) &&
+		(a->kernel_size.height == b->kernel_size.height) && (a->kernel_size.width == b->kernel_size.width) &&
+		(a->output_subsampling.height == b->output_subsampling.height) &&
+		(a->output_subsampling.width == b->output_subsampling.width);
+}
+
+/* Must be called with autotune_mutex locked */
+static struct autotune_entry* find_entry(const struct nnp_autotune_key* key) {
+	for (size_t i = 0; i < autotune_entries_count; i++) {
+		if (equal_keys(&autotune_entries[i].key, key)) {
+			return &autotune_entries[i];
+		}
+	}
+	return NULL;
+}
+
+/* Must be called with autotune_mutex locked */
+static bool insert_entry(const struct nnp_autotune_key* key, enum nnp_convolution_algorithm algorithm) {
+	struct autotune_entry* entry = find_entry(key);
+	if (entry == NULL) {
+		if (autotune_entries_count == autotune_entries_capacity) {
+			const size_t capacity = max(autotune_entries_capacity * 2, 16);
+			struct autotune_entry* entries = realloc(autotune_entries, capacity * sizeof(struct autotune_entry));
+			if (entries == NULL) {
+				return false;
+			}
+			autotune_entries = entries;
+			autotune_entries_capacity = capacity;
+		}
+		entry = &autotune_entries[autotune_entries_count++];
+		entry->key = *key;
+	}
+	entry->algorithm = algorithm;
+	return true;
+}
+
+/*
+ * Cache file has one measurement per line:
+ *   operation isa threads strategy batch input-channels output-channels input-height input-width
+ *   padding-top padding-right padding-bottom padding-left kernel-height kernel-width
+ *   subsampling-height subsampling-width algorithm
+ * Empty lines, lines starting with '#', and lines which fail to parse are ignored.
+ */
+static bool parse_entry(const char* line, char isa[static 16], struct autotune_entry* entry) {
+	char operation[16], algorithm[16];
+	unsigned int strategy;
+	struct nnp_autotune_key key;
+	const int fields = sscanf(line,
+		"%15s %15s %zu %u %zu %zu %zu %zu %zu %zu %zu %zu %zu %zu %zu %zu %zu %15s",
+		operation, isa, &key.threads, &strategy,
+		&key.batch_size, &key.input_channels, &key.output_channels,
+		&key.input_size.height, &key.input_size.width,
+		&key.input_padding.top, &key.input_padding.right, &key.input_padding.bottom, &key.input_padding.left,
+		&key.kernel_size.height, &key.kernel_size.width,
+		&key.output_subsampling.height, &key.output_subsampling.width,
+		algorithm);
+	if (fields != 18) {
+		return false;
+	}
+	key.kernel_transform_strategy = (enum nnp_convolution_kernel_transform_strategy) strategy;
+
+	if (strcmp(operation, operation_name(nnp_autotune_operation_convolution_output)) == 0) {
+		key.operation = nnp_autotune_operation_convolution_output;
+	} else if (strcmp(operation, operation_name(nnp_autotune_operation_convolution_inference)) == 0) {
+		key.operation = nnp_autotune_operation_convolution_inference;
+	} else {
+		return false;
+	}
+
+	for (size_t i = 0; i < candidate_count; i++) {
+		if (strcmp(algorithm, algorithm_name(candidate_algorithms[i])) == 0) {
+			*entry = (struct autotune_entry) {
+				.key = key,
+				.algorithm = candidate_algorithms[i],
+			};
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Must be called with autotune_mutex locked */
+static void load_cache(const char* path) {
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		/* The file is created when the first measurement is appended */
+		return;
+	}
+
+	char line[256];
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (line[0] == '#') {
+			continue;
+		}
+
+		char isa[16];
+		struct autotune_entry entry;
+		if (parse_entry(line, isa, &entry) && (strcmp(isa, nnp_hwinfo.isa.name) == 0)) {
+			if (!insert_entry(&entry.key, entry.algorithm)) {
+				break;
+			}
+		}
+	}
+	fclose(file);
+}
+
+/* Must be called with autotune_mutex locked. Persisting is best-effort: I/O errors only lose the measurement. */
+static void append_cache(const char* path, const struct nnp_autotune_key* key, enum nnp_convolution_algorithm algorithm) {
+	FILE* file = fopen(path, "a");
+	if (file == NULL) {
+		return;
+	}
+
+	fprintf(file, "%s %s %zu %u %zu %zu %zu %zu %zu %zu %zu %zu %zu %zu %zu %zu %zu %s\n",
+		operation_name(key->operation), nnp_hwinfo.isa.name, key->threads, (unsigned int) key->kernel_transform_strategy,
+		key->batch_size, key->input_channels, key->output_channels,
+		key->input_size.height, key->input_size.width,
+		key->input_padding.top, key->input_padding.right, key->input_padding.bottom, key->input_padding.left,
+		key->kernel_size.height, key->kernel_size.width,
+		key->output_subsampling.height, key->output_subsampling.width,
+		algorithm_name(algorithm));
+	fclose(file);
+}
+
+/* Must be called with autotune_mutex locked */
+static void release_state(void) {
+	free(autotune_cache_path);
+	autotune_cache_path = NULL;
+	free(autotune_entries);
+	autotune_entries = NULL;
+	autotune_entries_count = 0;
+	autotune_entries_capacity = 0;
+}
+
+bool nnp_autotune_enabled(void) {
+	pthread_mutex_lock(&autotune_mutex);
+	const bool enabled = autotune_enabled;
+	pthread_mutex_unlock(&autotune_mutex);
+	return enabled;
+}
+
+enum nnp_convolution_algorithm nnp_autotune_lookup(const struct nnp_autotune_key* key) {
+	enum nnp_convolution_algorithm algorithm = nnp_convolution_algorithm_auto;
+	pthread_mutex_lock(&autotune_mutex);
+	if (autotune_enabled) {
+		const struct autotune_entry* entry = find_entry(key);
+		if (entry != NULL) {
+			algorithm = entry->algorithm;
+		}
+	}
+	pthread_mutex_unlock(&autotune_mutex);
+	return algorithm;
+}
+
+enum nnp_convolution_algorithm nnp_autotune_measure(const struct nnp_autotune_key* key,
+	nnp_autotune_function function, void* context,
+	void* workspace_buffer, size_t* workspace_size)
+{
+	enum nnp_convolution_algorithm best_algorithm = nnp_convolution_algorithm_auto;
+	double best_time = DBL_MAX;
+	for (size_t i = 0; i < candidate_count; i++) {
+		const enum nnp_convolution_algorithm algorithm = candidate_algorithms[i];
+
+		/* Warm-up run also detects algorithms which do not support the layer */
+		if (function(context, algorithm, workspace_buffer, workspace_size) != nnp_status_success) {
+			continue;
+		}
+
+		for (size_t repetition = 0; repetition < autotune_repetitions; repetition++) {
+			const double start_time = read_timer();
+			function(context, algorithm, workspace_buffer, workspace_size);
+			const double time = read_timer() - start_time;
+			if (time < best_time) {
+				best_time = time;
+				best_algorithm = algorithm;
+			}
+		}
+	}
+
+	if (best_algorithm != nnp_convolution_algorithm_auto) {
+		pthread_mutex_lock(&autotune_mutex);
+		/* Auto-tuning could be disabled while the layer was measured */
+		if (autotune_enabled && insert_entry(key, best_algorithm) && (autotune_cache_path != NULL)) {
+			append_cache(autotune_cache_path, key, best_algorithm);
+		}
+		pthread_mutex_unlock(&autotune_mutex);
+	}
+	return best_algorithm;
+}
+
+enum nnp_status nnp_autotune_workspace_size(nnp_autotune_function function, void* context, size_t* workspace_size) {
+	enum nnp_status status = nnp_status_unsupported_algorithm;
+	size_t max_workspace_size = 0;
+	for (size_t i = 0; i < candidate_count; i++) {
+		size_t candidate_workspace_size = 0;
+		const enum nnp_status candidate_status =
+			function(context, candidate_algorithms[i], NULL, &candidate_workspace_size);
+		if (candidate_status == nnp_status_success) {
+			max_workspace_size = max(max_workspace_size, candidate_workspace_size);
+			status = nnp_status_success;
+		} else if (i == 0) {
+			/* Report invalid arguments, if any, rather than an unsupported algorithm */
+			status = candidate_status;
+		}
+	}
+
+	if (status == nnp_status_success) {
+		*workspace_size = max_workspace_size;
+	}
+	return status;
+}
+
+/* Overrides apply to any number of threads */
+static struct nnp_autotune_key blocking_override_key(const struct nnp_autotune_key* key) {
+	struct nnp_autotune_key override_key = *key;
+	override_key.threads = 0;
+	return override_key;
+}
+
+bool nnp_autotune_lookup_blocking(const struct nnp_autotune_key* key, struct nnp_convolution_blocking* blocking) {
+	const struct nnp_autotune_key override_key = blocking_override_key(key);
+	bool found = false;
+	pthread_mutex_lock(&autotune_mutex);
+	for (size_t i = 0; i < blocking_overrides_count; i++) {
+		if (equal_keys(&blocking_overrides[i].key, &override_key)) {
+			*blocking = blocking_overrides[i].blocking;
+			found = true;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&autotune_mutex);
+	return found;
+}
+
+enum nnp_status nnp_autotune_set_blocking(const struct nnp_autotune_key* key,
+	const struct nnp_convolution_blocking* blocking)
+{
+	const struct nnp_autotune_key override_key = blocking_override_key(key);
+	enum nnp_status status = nnp_status_success;
+	pthread_mutex_lock(&autotune_mutex);
+
+	size_t index = 0;
+	while ((index < blocking_overrides_count) && !equal_keys(&blocking_overrides[index].key, &override_key)) {
+		index++;
+	}
+
+	if (blocking == NULL) {
+		if (index < blocking_overrides_count) {
+			/* Order of overrides does not matter: move the last one into the gap */
+			blocking_overrides[index] = blocking_overrides[--blocking_overrides_count];
+		}
+		goto cleanup;
+	}
+
+	if (index == blocking_overrides_count) {
+		if (blocking_overrides_count == blocking_overrides_capacity) {
+			const size_t capacity = max(blocking_overrides_capacity * 2, 16);
+			struct blocking_override* overrides =
+				realloc(blocking_overrides, capacity * sizeof(struct blocking_override));
+			if (overrides == NULL) {
+				status = nnp_status_out_of_memory;
+				goto cleanup;
+			}
+			blocking_overrides = overrides;
+			blocking_overrides_capacity = capacity;
+		}
+		blocking_overrides[blocking_overrides_count++].key = override_key;
+	}
+	blocking_overrides[index].blocking = *blocking;
+
+cleanup:
+	pthread_mutex_unlock(&autotune_mutex);
+	return status;
+}
+
+void nnp_autotune_release_blocking(void) {
+	pthread_mutex_lock(&autotune_mutex);
+	free(blocking_overrides);
+	blocking_overrides = NULL;
+	blocking_overrides_count = 0;
+	blocking_overrides_capacity = 0;
+	pthread_mutex_unlock(&autotune_mutex);
+}
+
+enum nnp_status nnp_autotune_enable(const char* cache_path) {
+	if (!nnp_hwinfo.initialized) {
+		return nnp_status_uninitialized;
+	}
+
+	enum nnp_status status = nnp_status_success;
+	pthread_mutex_lock(&autotune_mutex);
+	release_state();
+	if (cache_path != NULL) {
+		autotune_cache_path = strdup(cache_path);
+		if (autotune_cache_path == NULL) {
+			status = nnp_status_out_of_memory;
+			goto cleanup;
+		}
+		load_cache(autotune_cache_path);
+	}
+	autotune_enabled = true;
+
+cleanup:
+	pthread_mutex_unlock(&autotune_mutex);
+	return status;
+}
+
+enum nnp_status nnp_autotune_disable(void) {
+	pthread_mutex_lock(&autotune_mutex);
+	autotune_enabled = false;
+	release_state();
+	pthread_mutex_unlock(&autotune_mutex);
+	return nnp_status_success;
+}
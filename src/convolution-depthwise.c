@@ -0,0 +1,152 @@
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/system.h>
+#include <nnpack/hwinfo.h>
+
+#include <nnpack/convolution.h>
+
+
+struct NNP_CACHE_ALIGN depthwise_convolution_context {
+	nnp_depthwise_conv_function convolution_function;
+	const float* input;
+	const float* kernel;
+	const float* bias;
+	float* output;
+
+	const struct nnp_fused_activation* activation;
+	size_t input_channels;
+	size_t output_channels;
+	struct nnp_size input_size;
+	struct nnp_padding input_padding;
+	struct nnp_size kernel_size;
+	struct nnp_size output_subsampling;
+	struct nnp_size output_size;
+};
+
+/*
+ * Convolves a channel image with a kernel of any size. For every kernel element the range of output columns which
+ * read input (not padding) pixels is computed upfront, so the inner loop has no bounds checks.
+ */
+static void convolve_plane(const float* input, const float* kernel, float bias, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding, struct nnp_size kernel_size,
+	struct nnp_size output_subsampling, struct nnp_size output_size, const struct nnp_fused_activation* activation)
+{
+	for (size_t y = 0; y < output_size.height; y++) {
+		float* output_row = output + y * output_size.width;
+		for (size_t x = 0; x < output_size.width; x++) {
+			output_row[x] = bias;
+		}
+
+		for (size_t i = 0; i < kernel_size.height; i++) {
+			/* Rows in the top padding wrap around to out-of-range unsigned values */
+			const size_t input_y = y * output_subsampling.height + i - input_padding.top;
+			if (input_y >= input_size.height) {
+				continue;
+			}
+
+			const float* input_row = input + input_y * input_size.width;
+			for (size_t j = 0; j < kernel_size.width; j++) {
+				const float weight = kernel[i * kernel_size.width + j];
+				const size_t x_start = divide_round_up(doz(input_padding.left, j), output_subsampling.width);
+				const size_t x_end = min(output_size.width,
+					divide_round_up(doz(input_size.width + input_padding.left, j), output_subsampling.width));
+				for (size_t x = x_start; x < x_end; x++) {
+					output_row[x] += weight * input_row[x * output_subsampling.width + j - input_padding.left];
+				}
+			}
+		}
+
+		if (activation != NULL) {
+			for (size_t x = 0; x < output_size.width; x++) {
+				output_row[x] = nnp_fused_activation_apply(activation, output_row[x]);
+			}
+		}
+	}
+}
+
+static void compute_depthwise_convolution(
+	const struct depthwise_convolution_context context[restrict static 1],
+	size_t sample, size_t output_channel)
+{
+	const size_t input_channels              = context->input_channels;
+	const size_t output_channels             = context->output_channels;
+	const struct nnp_size input_size         = context->input_size;
+	const struct nnp_padding input_padding   = context->input_padding;
+	const struct nnp_size kernel_size        = context->kernel_size;
+	const struct nnp_size output_subsampling = context->output_subsampling;
+	const struct nnp_size output_size        = context->output_size;
+
+	/* With a channel multiplier, consecutive output channels convolve the same input channel */
+	const size_t input_channel = output_channel / (output_channels / input_channels);
+	const float* input = context->input + (sample * input_channels + input_channel) * (input_size.height * input_size.width);
+	const float* kernel = context->kernel + output_channel * (kernel_size.height * kernel_size.width);
+	float* output = context->output + (sample * output_channels + output_channel) * (output_size.height * output_size.width);
+	const float bias = context->bias[output_channel];
+
+	if (context->convolution_function != NULL) {
+		context->convolution_function(input, kernel, bias, output,
+			input_size, input_padding, output_subsampling, output_size, context->activation);
+	} else {
+		convolve_plane(input, kernel, bias, output,
+			input_size, input_padding, kernel_size, output_subsampling, output_size,
+			context->activation);
+	}
+}
+
+enum nnp_status nnp_convolution_depthwise(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	const struct nnp_fused_activation* activation,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	/* Channel images are convolved in place, so the workspace is empty */
+	if ((workspace_buffer == NULL) && (workspace_size != NULL)) {
+		*workspace_size = 0;
+		return nnp_status_success;
+	}
+
+	nnp_depthwise_conv_function convolution_function = NULL;
+	if ((kernel_size.height == 3) && (kernel_size.width == 3)) {
+		convolution_function = nnp_hwinfo.depthwise.conv3x3;
+	}
+
+	NNP_BLOCK_MULTIPLICATION_START(profile)
+	struct depthwise_convolution_context depthwise_convolution_context = {
+		.convolution_function = convolution_function,
+		.input = input,
+		.kernel = kernel,
+		.bias = bias,
+		.output = output,
+		.activation = activation,
+		.input_channels = input_channels,
+		.output_channels = output_channels,
+		.input_size = input_size,
+		.input_padding = input_padding,
+		.kernel_size = kernel_size,
+		.output_subsampling = output_subsampling,
+		.output_size = nnp_convolution_output_size(input_size, input_padding, kernel_size, output_subsampling),
+	};
+	pthreadpool_compute_2d(threadpool,
+		(pthreadpool_function_2d_t) compute_depthwise_convolution,
+		&depthwise_convolution_context,
+		batch_size, output_channels);
+	NNP_BLOCK_MULTIPLICATION_END(profile)
+
+	return nnp_status_success;
+}
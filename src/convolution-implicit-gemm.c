@@ -0,0 +1,347 @@
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/system.h>
+#include <nnpack/hwinfo.h>
+#include <nnpack/simd.h>
+
+#include <nnpack/convolution.h>
+#include <nnpack/blas.h>
+
+
+struct NNP_CACHE_ALIGN kernel_packing_context {
+	const float* kernel;
+	float* packed_kernel;
+
+	size_t reduction_size;
+	size_t reduction_block_max;
+	size_t output_channels;
+	size_t output_channels_subblock_max;
+};
+
+/*
+ * Kernel matrix kernel[output_channels][input_channels * kernel_size.height * kernel_size.width] is packed into
+ * panels of output_channels_subblock_max rows for every block of the reduction dimension.
+ */
+static void pack_kernel_matrix(
+	const struct kernel_packing_context context[restrict static 1],
+	size_t output_channels_subblock_start, size_t reduction_block_start,
+	size_t output_channels_subblock_size,  size_t reduction_block_size)
+{
+	const size_t reduction_size               = context->reduction_size;
+	const size_t output_channels              = context->output_channels;
+	const size_t output_channels_subblock_max = context->output_channels_subblock_max;
+
+	const float (*kernel)[reduction_size] = (const float(*)[reduction_size]) context->kernel;
+	float* packed_kernel = context->packed_kernel +
+		reduction_block_start * round_up(output_channels, output_channels_subblock_max) +
+		output_channels_subblock_start * reduction_block_size;
+
+	for (size_t reduction_block_offset = 0; reduction_block_offset < reduction_block_size; reduction_block_offset += 1) {
+		const size_t reduction_index = reduction_block_start + reduction_block_offset;
+		for (size_t output_channels_subblock_offset = 0; output_channels_subblock_offset < output_channels_subblock_size; output_channels_subblock_offset += 1) {
+			const size_t output_channel = output_channels_subblock_start + output_channels_subblock_offset;
+			packed_kernel[reduction_block_offset * output_channels_subblock_max + output_channels_subblock_offset] =
+				kernel[output_channel][reduction_index];
+		}
+	}
+}
+
+struct NNP_CACHE_ALIGN matrix_multiplication_context {
+	const float* input;
+	const float* packed_kernel;
+	const float* bias;
+	float* output;
+
+	const struct nnp_fused_activation* activation;
+	size_t input_image_stride;
+	size_t output_image_stride;
+	size_t output_channels;
+	size_t reduction_size;
+	size_t reduction_block_max;
+	size_t output_channels_subblock_max;
+	size_t pixels_subblock_max;
+	struct nnp_size input_size;
+	struct nnp_padding input_padding;
+	struct nnp_size kernel_size;
+	struct nnp_size kernel_dilation;
+	struct nnp_size output_size;
+	struct nnp_size output_subsampling;
+	const uint32_t* column_mask;
+	nnp_sgemm_function (*sgemm_functions)[3];
+};
+
+/*
+ * Computes a block of output channels for pixels_subblock_max consecutive output pixels of the minibatch.
+ * Output pixels of all images form one dimension, so a panel may continue from one image into the next one, and
+ * small images (e.g. 7x7 outputs of 1x1 convolutions in late layers) do not leave partially filled panels.
+ * The matching rows of the im2col matrix are packed into a panel on the worker's stack, and the block of outputs is
+ * accumulated on the stack too, then stored with bias and activation.
+ */
+static void compute_matrix_multiplication(
+	const struct matrix_multiplication_context context[restrict static 1],
+	size_t pixels_subblock_start,       size_t output_channels_block_start,
+	size_t pixels_subblock_size,        size_t output_channels_block_size)
+{
+	const size_t input_image_stride           = context->input_image_stride;
+	const size_t output_image_stride          = context->output_image_stride;
+	const size_t output_channels              = context->output_channels;
+	const size_t reduction_size               = context->reduction_size;
+	const size_t reduction_block_max          = context->reduction_block_max;
+	const size_t output_channels_subblock_max = context->output_channels_subblock_max;
+	const size_t pixels_subblock_max          = context->pixels_subblock_max;
+	const struct nnp_size input_size          = context->input_size;
+	const struct nnp_padding input_padding    = context->input_padding;
+	const struct nnp_size kernel_size         = context->kernel_size;
+	const struct nnp_size kernel_dilation     = context->kernel_dilation;
+	const struct nnp_size output_size         = context->output_size;
+	const struct nnp_size output_subsampling  = context->output_subsampling;
+
+	const size_t input_pixels = input_size.height * input_size.width;
+	const size_t output_pixels = output_size.height * output_size.width;
+	const float* input         = context->input;
+	float* output              = context->output;
+	const float* packed_kernel = context->packed_kernel;
+	const float* bias          = context->bias;
+
+	/*
+	 * Every column of the panel is described by offsets of its image in the input and output tensors, and coordinates
+	 * of its top-left kernel element in the input image. Coordinates in the top and left padding wrap around to
+	 * out-of-range unsigned values.
+	 */
+	size_t input_offset[pixels_subblock_max];
+	size_t output_offset[pixels_subblock_max];
+	size_t column_y[pixels_subblock_max];
+	size_t column_x[pixels_subblock_max];
+	for (size_t pixels_subblock_offset = 0; pixels_subblock_offset < pixels_subblock_size; pixels_subblock_offset += 1) {
+		const size_t sample = (pixels_subblock_start + pixels_subblock_offset) / output_pixels;
+		const size_t pixel  = (pixels_subblock_start + pixels_subblock_offset) % output_pixels;
+		column_y[pixels_subblock_offset] = (pixel / output_size.width) * output_subsampling.height - input_padding.top;
+		column_x[pixels_subblock_offset] = (pixel % output_size.width) * output_subsampling.width - input_padding.left;
+		input_offset[pixels_subblock_offset] = sample * input_image_stride +
+			column_y[pixels_subblock_offset] * input_size.width + column_x[pixels_subblock_offset];
+		output_offset[pixels_subblock_offset] = sample * output_image_stride + pixel;
+	}
+
+	/*
+	 * For 1x1 kernels without padding the panel reads input channels at the positions of output pixels. Without
+	 * subsampling, and within one image, these positions are contiguous, and the rows of the panel are plain copies.
+	 */
+	const bool pointwise = (kernel_size.height == 1) && (kernel_size.width == 1) &&
+		((input_padding.top | input_padding.left | input_padding.bottom | input_padding.right) == 0);
+	const bool contiguous = pointwise &&
+		(input_offset[pixels_subblock_size - 1] - input_offset[0] == pixels_subblock_size - 1);
+
+	const size_t kernel_elements = kernel_size.height * kernel_size.width;
+	const size_t output_channels_stride = round_up(output_channels, output_channels_subblock_max);
+
+	NNP_SIMD_ALIGN float packed_input[reduction_block_max * pixels_subblock_max];
+	NNP_SIMD_ALIGN float output_block[output_channels_block_size * pixels_subblock_max];
+	for (size_t reduction_block_start = 0; reduction_block_start < reduction_size; reduction_block_start += reduction_block_max) {
+		const size_t reduction_block_size = min(reduction_size - reduction_block_start, reduction_block_max);
+
+		/* Gather input pixels for the panel. Pixels outside of the image are implicit padding and read as zeroes. */
+		for (size_t reduction_block_offset = 0; reduction_block_offset < reduction_block_size; reduction_block_offset += 1) {
+			const size_t reduction_index = reduction_block_start + reduction_block_offset;
+			const size_t input_channel = reduction_index / kernel_elements;
+			const size_t kernel_y = (reduction_index % kernel_elements) / kernel_size.width * kernel_dilation.height;
+			const size_t kernel_x = reduction_index % kernel_size.width * kernel_dilation.width;
+			const size_t row_offset = input_channel * input_pixels + kernel_y * input_size.width + kernel_x;
+
+			float* packed_row = &packed_input[reduction_block_offset * pixels_subblock_max];
+			if (contiguous) {
+				memcpy(packed_row, &input[input_offset[0] + row_offset], pixels_subblock_size * sizeof(float));
+			} else if (pointwise) {
+				for (size_t pixels_subblock_offset = 0; pixels_subblock_offset < pixels_subblock_size; pixels_subblock_offset += 1) {
+					packed_row[pixels_subblock_offset] = input[input_offset[pixels_subblock_offset] + row_offset];
+				}
+			} else {
+				for (size_t pixels_subblock_offset = 0; pixels_subblock_offset < pixels_subblock_size; pixels_subblock_offset += 1) {
+					const size_t input_y = column_y[pixels_subblock_offset] + kernel_y;
+					const size_t input_x = column_x[pixels_subblock_offset] + kernel_x;
+					if ((input_y < input_size.height) && (input_x < input_size.width)) {
+						packed_row[pixels_subblock_offset] = input[input_offset[pixels_subblock_offset] + row_offset];
+					} else {
+						packed_row[pixels_subblock_offset] = 0.0f;
+					}
+				}
+			}
+			for (size_t pixels_subblock_offset = pixels_subblock_size; pixels_subblock_offset < pixels_subblock_max; pixels_subblock_offset += 1) {
+				packed_row[pixels_subblock_offset] = 0.0f;
+			}
+		}
+
+		/* Columns past the end of the minibatch are zero-padded, thus all columns of the block are computed */
+		const float* packed_kernel_block = packed_kernel +
+			reduction_block_start * output_channels_stride +
+			output_channels_block_start * reduction_block_size;
+		for (size_t output_channels_subblock_start = 0; output_channels_subblock_start < output_channels_block_size; output_channels_subblock_start += output_channels_subblock_max) {
+			const size_t output_channels_subblock_size = min(output_channels_block_size - output_channels_subblock_start, output_channels_subblock_max);
+			context->sgemm_functions[output_channels_subblock_size - 1][2](
+				reduction_block_size, reduction_block_start,
+				packed_kernel_block + output_channels_subblock_start * reduction_block_size,
+				packed_input,
+				&output_block[output_channels_subblock_start * pixels_subblock_max],
+				pixels_subblock_max,
+				context->column_mask);
+		}
+	}
+
+	for (size_t output_channels_block_offset = 0; output_channels_block_offset < output_channels_block_size; output_channels_block_offset += 1) {
+		const size_t output_channel = output_channels_block_start + output_channels_block_offset;
+		const float bias_value = bias[output_channel];
+		const float* output_row = &output_block[output_channels_block_offset * pixels_subblock_max];
+		float* output_channel_data = &output[output_channel * output_pixels];
+		if (context->activation != NULL) {
+			for (size_t pixels_subblock_offset = 0; pixels_subblock_offset < pixels_subblock_size; pixels_subblock_offset += 1) {
+				const float value = output_row[pixels_subblock_offset] + bias_value;
+				output_channel_data[output_offset[pixels_subblock_offset]] = nnp_fused_activation_apply(context->activation, value);
+			}
+		} else {
+			for (size_t pixels_subblock_offset = 0; pixels_subblock_offset < pixels_subblock_size; pixels_subblock_offset += 1) {
+				output_channel_data[output_offset[pixels_subblock_offset]] = output_row[pixels_subblock_offset] + bias_value;
+			}
+		}
+	}
+}
+
+enum nnp_status nnp_convolution_implicit_gemm(
+	size_t batch_size,
+	size_t groups,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	const struct nnp_fused_activation* activation,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	void* memory_block = NULL;
+	enum nnp_status status = nnp_status_success;
+
+	const struct nnp_size output_size = nnp_convolution_output_size(input_size, input_padding,
+		nnp_convolution_dilated_kernel_size(kernel_size, kernel_dilation), output_subsampling);
+	const size_t input_pixels = input_size.height * input_size.width;
+	const size_t output_pixels = output_size.height * output_size.width;
+	const size_t group_input_channels = input_channels / groups;
+	const size_t group_output_channels = output_channels / groups;
+	const size_t reduction_size = group_input_channels * kernel_size.height * kernel_size.width;
+
+	/* Calculate cache blocking parameters */
+	const size_t cache_elements_l1 = nnp_hwinfo.blocking.l1 / sizeof(float);
+	const size_t cache_elements_l2 = nnp_hwinfo.blocking.l2 / sizeof(float);
+
+	const size_t output_channels_subblock_max = nnp_hwinfo.sgemm.mr;
+	const size_t pixels_subblock_max = nnp_hwinfo.sgemm.nr;
+	/* Bounds the block of outputs which is accumulated on the worker's stack */
+	const size_t output_channels_block_limit = 256;
+
+	const size_t reduction_block_max = cache_elements_l1 / (output_channels_subblock_max + pixels_subblock_max);
+	const size_t output_channels_block_max =
+		max(round_down(min(cache_elements_l2 / reduction_block_max, output_channels_block_limit), output_channels_subblock_max), output_channels_subblock_max);
+
+	/* Calculate memory footprint and allocate memory */
+	const size_t memory_size = round_up(group_output_channels, output_channels_subblock_max) * reduction_size * sizeof(float);
+
+	if (workspace_buffer == NULL) {
+		if (workspace_size != NULL) {
+			/* Workspace size query: report the required size and skip the computation */
+			*workspace_size = memory_size;
+			goto cleanup;
+		}
+
+		memory_block = allocate_memory(memory_size);
+		if (memory_block == NULL) {
+			status = nnp_status_out_of_memory;
+			goto cleanup;
+		}
+	} else {
+		if ((workspace_size == NULL) || (*workspace_size < memory_size)) {
+			status = nnp_status_insufficient_buffer;
+			goto cleanup;
+		}
+
+		if (((uintptr_t) workspace_buffer) % 64 != 0) {
+			status = nnp_status_misaligned_buffer;
+			goto cleanup;
+		}
+
+		memory_block = workspace_buffer;
+	}
+
+	float* packed_kernel = memory_block;
+
+	/* Micro-kernels always compute all columns of the panel */
+	NNP_SIMD_ALIGN const uint32_t column_mask[16] = {
+		UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+		UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+	};
+	const size_t pixels_count = batch_size * output_pixels;
+	for (size_t group = 0; group < groups; group++) {
+		NNP_KERNEL_TRANSFORM_START(profile)
+		struct kernel_packing_context kernel_packing_context = {
+			.kernel = kernel + group * group_output_channels * reduction_size,
+			.packed_kernel = packed_kernel,
+			.reduction_size = reduction_size,
+			.reduction_block_max = reduction_block_max,
+			.output_channels = group_output_channels,
+			.output_channels_subblock_max = output_channels_subblock_max,
+		};
+		pthreadpool_compute_2d_tiled(threadpool,
+			(pthreadpool_function_2d_tiled_t) pack_kernel_matrix,
+			&kernel_packing_context,
+			group_output_channels,        reduction_size,
+			output_channels_subblock_max, reduction_block_max);
+		NNP_KERNEL_TRANSFORM_END(profile)
+
+		NNP_BLOCK_MULTIPLICATION_START(profile)
+		struct matrix_multiplication_context matrix_multiplication_context = {
+			.input = input + group * group_input_channels * input_pixels,
+			.packed_kernel = packed_kernel,
+			.bias = bias + group * group_output_channels,
+			.output = output + group * group_output_channels * output_pixels,
+			.activation = activation,
+			.input_image_stride = input_channels * input_pixels,
+			.output_image_stride = output_channels * output_pixels,
+			.output_channels = group_output_channels,
+			.reduction_size = reduction_size,
+			.reduction_block_max = reduction_block_max,
+			.output_channels_subblock_max = output_channels_subblock_max,
+			.pixels_subblock_max = pixels_subblock_max,
+			.input_size = input_size,
+			.input_padding = input_padding,
+			.kernel_size = kernel_size,
+			.kernel_dilation = kernel_dilation,
+			.output_size = output_size,
+			.output_subsampling = output_subsampling,
+			.column_mask = column_mask,
+			.sgemm_functions = nnp_hwinfo.sgemm.functions,
+		};
+		pthreadpool_compute_2d_tiled(threadpool,
+			(pthreadpool_function_2d_tiled_t) compute_matrix_multiplication,
+			&matrix_multiplication_context,
+			pixels_count,        group_output_channels,
+			pixels_subblock_max, output_channels_block_max);
+		NNP_BLOCK_MULTIPLICATION_END(profile)
+	}
+
+cleanup:
+	if (workspace_buffer == NULL) {
+		release_memory(memory_block, memory_size);
+	}
+	return status;
+}
@@ -13,20 +13,375 @@
 #include <nnpack/simd.h>
 
 #include <nnpack/validation.h>
+#include <nnpack/convolution.h>
 #include <nnpack/transform.h>
+#include <nnpack/transformed-kernel.h>
+#include <nnpack/autotune.h>
 
-enum nnp_status nnp_convolution_inference(
+
+struct NNP_CACHE_ALIGN input_transform_context {
+	nnp_transform_2d transform_function;
+	const float* input;
+	float* input_transform;
+
+	size_t tuple_size;
+	size_t tile_elements;
+	size_t input_channels;
+	size_t tiles_x;
+	size_t tiles_block_start;
+	struct nnp_size input_size;
+	struct nnp_padding input_padding;
+	struct nnp_size input_tile;
+	struct nnp_size output_tile;
+	struct nnp_size output_subsampling;
+};
+
+/* Tiles are numbered within the block of tiles, which starts from tile tiles_block_start in row-major order */
+static void compute_input_transform(
+	const struct input_transform_context context[restrict static 1],
+	size_t tile,       size_t input_channels_subblock_start,
+	size_t tile_range, size_t input_channels_subblock_size)
+{
+	const size_t tuple_size                = context->tuple_size;
+	const size_t tile_elements             = context->tile_elements;
+	const size_t input_channels            = context->input_channels;
+	const size_t tiles_x                   = context->tiles_x;
+	const size_t tiles_block_start         = context->tiles_block_start;
+	const struct nnp_size input_size       = context->input_size;
+	const struct nnp_padding input_padding = context->input_padding;
+	const struct nnp_size input_tile       = context->input_tile;
+	const struct nnp_size output_tile      = context->output_tile;
+	const struct nnp_size output_subsampling = context->output_subsampling;
+
+	const float (*input)[input_size.width * input_size.height] =
+		(const float(*)[input_size.width * input_size.height]) context->input;
+	float* input_transform              = context->input_transform;
+	nnp_transform_2d transform_function = context->transform_function;
+
+	/* Tiles are positioned in the space of non-subsampled outputs */
+	const size_t y = ((tiles_block_start + tile) / tiles_x) * output_tile.height * output_subsampling.height;
+	const size_t x = ((tiles_block_start + tile) % tiles_x) * output_tile.width * output_subsampling.width;
+	const size_t input_y = min(doz(y, input_padding.top), input_size.height);
+	const size_t input_x = min(doz(x, input_padding.left), input_size.width);
+
+	for (size_t input_channels_subblock_offset = 0; input_channels_subblock_offset < input_channels_subblock_size; input_channels_subblock_offset += 1) {
+		const size_t input_channel = input_channels_subblock_start + input_channels_subblock_offset;
+		transform_function(
+			&input[input_channel][input_y * input_size.width + input_x],
+			input_transform + (tile * input_channels + input_channel) * tile_elements,
+			input_size.width,
+			tuple_size,
+			min(input_tile.height, doz(input_size.height, input_y)),
+			min(input_tile.width, doz(input_size.width, input_x)),
+			doz(input_padding.top, y),
+			doz(input_padding.left, x));
+	}
+}
+
+struct NNP_CACHE_ALIGN kernel_transform_context {
+	nnp_transform_2d transform_function;
+	const float* kernel;
+	float* kernel_transform;
+
+	size_t tuple_size;
+	size_t tile_elements;
+	size_t input_channels;
+	size_t input_channels_block_max;
+	size_t output_channels;
+	struct nnp_size kernel_size;
+	struct nnp_size kernel_dilation;
+};
+
+/* Dilated kernels are scattered into a sparse kernel of the dilated size on the stack, and transformed as dense kernels */
+static void compute_kernel_transform(
+	const struct kernel_transform_context context[restrict static 1],
+	size_t output_channel,       size_t input_channels_subblock_start,
+	size_t output_channel_range, size_t input_channels_subblock_size)
+{
+	const size_t tuple_size               = context->tuple_size;
+	const size_t tile_elements            = context->tile_elements;
+	const size_t input_channels           = context->input_channels;
+	const size_t input_channels_block_max = context->input_channels_block_max;
+	const size_t output_channels          = context->output_channels;
+	const struct nnp_size kernel_size     = context->kernel_size;
+	const struct nnp_size kernel_dilation = context->kernel_dilation;
+
+	const float (*kernel)[input_channels][kernel_size.width * kernel_size.height] =
+		(const float(*)[input_channels][kernel_size.width * kernel_size.height]) context->kernel;
+	float* kernel_transform             = context->kernel_transform;
+	nnp_transform_2d transform_function = context->transform_function;
+
+	const bool dilated = (kernel_dilation.height | kernel_dilation.width) != 1;
+	const struct nnp_size dilated_kernel_size = nnp_convolution_dilated_kernel_size(kernel_size, kernel_dilation);
+	NNP_SIMD_ALIGN float dilated_kernel[dilated_kernel_size.height * dilated_kernel_size.width];
+	for (size_t input_channels_subblock_offset = 0; input_channels_subblock_offset < input_channels_subblock_size; input_channels_subblock_offset += 1) {
+		const size_t input_channel = input_channels_subblock_start + input_channels_subblock_offset;
+		const size_t input_channels_block_start  = round_down(input_channel, input_channels_block_max);
+		const size_t input_channels_block_size   = min(input_channels - input_channels_block_start, input_channels_block_max);
+		const size_t input_channels_block_offset = input_channel - input_channels_block_start;
+		const float* kernel_data = kernel[output_channel][input_channel];
+		if (dilated) {
+			nnp_convolution_dilate_kernel(kernel_data, dilated_kernel, kernel_size, kernel_dilation);
+			kernel_data = dilated_kernel;
+		}
+		transform_function(
+			kernel_data,
+			kernel_transform +
+				(input_channels_block_start * output_channels + output_channel * input_channels_block_size + input_channels_block_offset) * tile_elements,
+			dilated_kernel_size.width,
+			tuple_size,
+			dilated_kernel_size.height, dilated_kernel_size.width, 0, 0);
+	}
+}
+
+struct NNP_CACHE_ALIGN tile_convolution_context {
+	nnp_transform_2d_and_macc kernel_fourier_transform_and_macc_function;
+	nnp_kernel_transform_and_mac kernel_winograd_transform_and_mac_function;
+	nnp_tile_gemm_function macc_function;
+	nnp_transform_2d_with_bias output_transform_function;
+	/* Replaces output_transform_function if activation is not NULL */
+	nnp_transform_2d_with_bias_and_activation output_activation_transform_function;
+	const struct nnp_fused_activation* activation;
+	const float* kernel;
+	const float* bias;
+	float* output;
+	const float* input_transform;
+	const float* kernel_transform;
+
+	bool fourier_transform;
+	size_t tuple_size;
+	size_t tile_elements;
+	size_t input_channels;
+	size_t input_channels_block_max;
+	size_t output_channels;
+	size_t tiles_x;
+	size_t tiles_block_start;
+	struct nnp_size kernel_size;
+	struct nnp_size kernel_dilation;
+	struct nnp_size output_size;
+	struct nnp_size output_tile;
+	struct nnp_size output_subsampling;
+	struct nnp_size input_tile;
+};
+
+static inline void output_transform_tile(
+	const struct tile_convolution_context context[restrict static 1],
+	const float output_transform[],
+	float output[],
+	const float bias[],
+	size_t output_stride, size_t row_count, size_t column_count)
+{
+	if (context->activation != NULL) {
+		context->output_activation_transform_function(
+			output_transform, output, bias,
+			context->tuple_size, output_stride,
+			row_count, column_count,
+			context->activation);
+	} else {
+		context->output_transform_function(
+			output_transform, output, bias,
+			context->tuple_size, output_stride,
+			row_count, column_count);
+	}
+}
+
+/* Applies output transform to accumulated coefficients and stores (subsampled) outputs of the tile */
+static inline void store_output_tile(
+	const struct tile_convolution_context context[restrict static 1],
+	const float output_transform[],
+	float output[],
+	const float bias[],
+	size_t row_count, size_t column_count)
+{
+	const struct nnp_size output_size        = context->output_size;
+	const struct nnp_size output_subsampling = context->output_subsampling;
+	const struct nnp_size input_tile         = context->input_tile;
+
+	if ((output_subsampling.height | output_subsampling.width) == 1) {
+		output_transform_tile(context,
+			output_transform, output, bias,
+			output_size.width, row_count, column_count);
+	} else {
+		NNP_SIMD_ALIGN float block[input_tile.height * input_tile.width];
+		output_transform_tile(context,
+			output_transform, block, bias,
+			input_tile.width,
+			(row_count - 1) * output_subsampling.height + 1,
+			(column_count - 1) * output_subsampling.width + 1);
+		nnp_store_subsampled_tile(
+			block, input_tile.width,
+			output, output_size.width,
+			row_count, column_count,
+			output_subsampling);
+	}
+}
+
+/*
+ * Computes one output tile of the block of tiles for a block of output channels.
+ * The output transform is fused: accumulators live on the worker's stack and never touch shared memory.
+ * Dilated kernels are scattered into a sparse kernel of the dilated size before every transform.
+ */
+static void compute_tile_convolution_recompute(
+	const struct tile_convolution_context context[restrict static 1],
+	size_t tile,       size_t output_channels_block_start,
+	size_t tile_range, size_t output_channels_block_size)
+{
+	const bool fourier_transform          = context->fourier_transform;
+	const size_t tile_elements            = context->tile_elements;
+	const size_t input_channels           = context->input_channels;
+	const size_t tiles_x                  = context->tiles_x;
+	const size_t tiles_block_start        = context->tiles_block_start;
+	const struct nnp_size kernel_size     = context->kernel_size;
+	const struct nnp_size kernel_dilation = context->kernel_dilation;
+	const struct nnp_size output_size     = context->output_size;
+	const struct nnp_size output_tile     = context->output_tile;
+
+	const float (*kernel)[input_channels][kernel_size.width * kernel_size.height] =
+		(const float(*)[input_channels][kernel_size.width * kernel_size.height]) context->kernel;
+	float (*output)[output_size.width * output_size.height] =
+		(float(*)[output_size.width * output_size.height]) context->output;
+	const float* bias            = context->bias;
+	const float* input_transform = context->input_transform + tile * input_channels * tile_elements;
+
+	const size_t y = ((tiles_block_start + tile) / tiles_x) * output_tile.height;
+	const size_t x = ((tiles_block_start + tile) % tiles_x) * output_tile.width;
+
+	const bool dilated = (kernel_dilation.height | kernel_dilation.width) != 1;
+	const struct nnp_size dilated_kernel_size = nnp_convolution_dilated_kernel_size(kernel_size, kernel_dilation);
+	NNP_SIMD_ALIGN float dilated_kernel[dilated_kernel_size.height * dilated_kernel_size.width];
+
+	NNP_SIMD_ALIGN float output_transform[tile_elements];
+	for (size_t output_channels_block_offset = 0; output_channels_block_offset < output_channels_block_size; output_channels_block_offset += 1) {
+		const size_t output_channel = output_channels_block_start + output_channels_block_offset;
+
+		memset(output_transform, 0, tile_elements * sizeof(float));
+		for (size_t input_channel = 0; input_channel < input_channels; input_channel++) {
+			if (fourier_transform) {
+				const float* kernel_data = kernel[output_channel][input_channel];
+				if (dilated) {
+					nnp_convolution_dilate_kernel(kernel_data, dilated_kernel, kernel_size, kernel_dilation);
+					kernel_data = dilated_kernel;
+				}
+				context->kernel_fourier_transform_and_macc_function(
+					kernel_data,
+					output_transform,
+					input_transform + input_channel * tile_elements,
+					dilated_kernel_size.width,
+					dilated_kernel_size.height, dilated_kernel_size.width, 0, 0);
+			} else {
+				context->kernel_winograd_transform_and_mac_function(
+					kernel[output_channel][input_channel],
+					output_transform,
+					input_transform + input_channel * tile_elements,
+					kernel_size.width);
+			}
+		}
+
+		store_output_tile(context,
+			output_transform,
+			&output[output_channel][y * output_size.width + x],
+			&bias[output_channel],
+			min(output_tile.height, output_size.height - y),
+			min(output_tile.width, output_size.width - x));
+	}
+}
+
+static void compute_tile_convolution_reuse(
+	const struct tile_convolution_context context[restrict static 1],
+	size_t tile,       size_t output_channels_block_start,
+	size_t tile_range, size_t output_channels_block_size)
+{
+	const size_t tile_elements            = context->tile_elements;
+	const size_t input_channels           = context->input_channels;
+	const size_t input_channels_block_max = context->input_channels_block_max;
+	const size_t output_channels          = context->output_channels;
+	const size_t tiles_x                  = context->tiles_x;
+	const size_t tiles_block_start        = context->tiles_block_start;
+	const struct nnp_size output_size     = context->output_size;
+	const struct nnp_size output_tile     = context->output_tile;
+
+	float (*output)[output_size.width * output_size.height] =
+		(float(*)[output_size.width * output_size.height]) context->output;
+	const float* bias             = context->bias;
+	const float* input_transform  = context->input_transform + tile * input_channels * tile_elements;
+	const float* kernel_transform = context->kernel_transform;
+
+	const size_t y = ((tiles_block_start + tile) / tiles_x) * output_tile.height;
+	const size_t x = ((tiles_block_start + tile) % tiles_x) * output_tile.width;
+
+	NNP_SIMD_ALIGN float output_transform[output_channels_block_size * tile_elements];
+	memset(output_transform, 0, output_channels_block_size * tile_elements * sizeof(float));
+
+	for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
+		const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
+		for (size_t output_channels_block_offset = 0; output_channels_block_offset < output_channels_block_size; output_channels_block_offset += 1) {
+			const size_t output_channel = output_channels_block_start + output_channels_block_offset;
+			for (size_t input_channels_block_offset = 0; input_channels_block_offset < input_channels_block_size; input_channels_block_offset++) {
+				context->macc_function(
+					output_transform + output_channels_block_offset * tile_elements,
+					input_transform + (input_channels_block_start + input_channels_block_offset) * tile_elements,
+					kernel_transform + (input_channels_block_start * output_channels + output_channel * input_channels_block_size + input_channels_block_offset) * tile_elements);
+			}
+		}
+	}
+
+	for (size_t output_channels_block_offset = 0; output_channels_block_offset < output_channels_block_size; output_channels_block_offset += 1) {
+		const size_t output_channel = output_channels_block_start + output_channels_block_offset;
+		store_output_tile(context,
+			output_transform + output_channels_block_offset * tile_elements,
+			&output[output_channel][y * output_size.width + x],
+			&bias[output_channel],
+			min(output_tile.height, output_size.height - y),
+			min(output_tile.width, output_size.width - x));
+	}
+}
+
+/* Arguments of convolution_inference which stay the same while auto-tuning measures the algorithms */
+struct convolution_inference_autotune_context {
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy;
+	size_t input_channels;
+	size_t output_channels;
+	struct nnp_size input_size;
+	struct nnp_padding input_padding;
+	struct nnp_size kernel_size;
+	struct nnp_size output_subsampling;
+	const float* input;
+	const float* kernel;
+	const float* bias;
+	float* output;
+	enum nnp_activation activation;
+	const void* activation_parameters;
+	pthreadpool_t threadpool;
+};
+
+static enum nnp_status autotune_convolution_inference(
+	const struct convolution_inference_autotune_context* context,
+	enum nnp_convolution_algorithm algorithm,
+	void* workspace_buffer, size_t* workspace_size);
+
+/*
+ * Kernel dilation other than 1x1 implies groups == 1.
+ * If workspace_buffer is NULL, temporary buffers are allocated for the duration of the call.
+ */
+static enum nnp_status convolution_inference(
 	enum nnp_convolution_algorithm algorithm,
 	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t groups,
 	size_t input_channels,
 	size_t output_channels,
 	struct nnp_size input_size,
 	struct nnp_padding input_padding,
 	struct nnp_size kernel_size,
-	const float input_pointer[],
-	const float kernel_pointer[],
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
 	const float bias[],
-	float output_pointer[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile)
 {
@@ -36,74 +391,181 @@ enum nnp_status nnp_convolution_inference(
 	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
 	enum nnp_status status = validate_convolution_arguments(
 		1, input_channels, output_channels,
-		input_size, input_padding, kernel_size);
+		input_size, input_padding, kernel_size, kernel_dilation, output_subsampling);
 	if (status != nnp_status_success) {
 		goto cleanup;
 	}
 
-	const struct nnp_size output_size = {
-		.width = input_padding.left + input_size.width + input_padding.right - kernel_size.width + 1,
-		.height = input_padding.top + input_size.height + input_padding.bottom - kernel_size.height + 1
-	};
+	status = validate_convolution_groups(groups, input_channels, output_channels);
+	if (status != nnp_status_success) {
+		goto cleanup;
+	}
 
-	if (algorithm == nnp_convolution_algorithm_auto) {
-		if (max(kernel_size.width, kernel_size.height) > 8) {
-			algorithm = nnp_convolution_algorithm_ft16x16;
-		} else {
-			const size_t tile_count_8x8 =
-				divide_round_up(output_size.height, 8 - kernel_size.height + 1) *
-				divide_round_up(output_size.width, 8 - kernel_size.width + 1);
-			const size_t tile_count_16x16 =
-				divide_round_up(output_size.height, 16 - kernel_size.height + 1) *
-				divide_round_up(output_size.width, 16 - kernel_size.width + 1);
-			if (tile_count_8x8 <= 4 * tile_count_16x16) {
-				/* 8x8 tiles are more efficient */
-				if ((kernel_size.height == 3) && (kernel_size.width == 3)) {
-					algorithm = nnp_convolution_algorithm_wt8x8;
-				} else {
-					algorithm = nnp_convolution_algorithm_ft8x8;
-				}
-			} else {
-				algorithm = nnp_convolution_algorithm_ft16x16;
+	status = validate_activation(activation, activation_parameters);
+	if (status != nnp_status_success) {
+		goto cleanup;
+	}
+	struct nnp_fused_activation fused_activation;
+	if (activation != nnp_activation_identity) {
+		fused_activation = nnp_fused_activation_init(activation, activation_parameters);
+	}
+	const struct nnp_fused_activation* output_activation =
+		(activation != nnp_activation_identity ? &fused_activation : NULL);
+
+	const bool dilated = (kernel_dilation.height | kernel_dilation.width) != 1;
+	const struct nnp_size dilated_kernel_size = nnp_convolution_dilated_kernel_size(kernel_size, kernel_dilation);
+	const struct nnp_size output_size =
+		nnp_convolution_output_size(input_size, input_padding, dilated_kernel_size, output_subsampling);
+	const size_t group_input_channels = input_channels / groups;
+	const size_t group_output_channels = output_channels / groups;
+
+	/* Precomputed kernel transform determines the algorithm */
+	const struct nnp_transformed_kernel* transformed_kernel = NULL;
+	if (kernel_transform_strategy == nnp_convolution_kernel_transform_strategy_precomputed) {
+		/* Kernel transforms describe a single group of channels of a dense kernel */
+		if ((groups != 1) || dilated) {
+			status = nnp_status_unsupported_algorithm;
+			goto cleanup;
+		}
+
+		transformed_kernel = (const struct nnp_transformed_kernel*) kernel;
+		status = validate_transformed_kernel(transformed_kernel,
+			algorithm, nnp_convolution_kernel_transform_layout_inference,
+			input_channels, output_channels, kernel_size);
+		if (status != nnp_status_success) {
+			goto cleanup;
+		}
+		algorithm = (enum nnp_convolution_algorithm) transformed_kernel->algorithm;
+	}
+
+	/* If auto-tuning is enabled, choose the algorithm which was measured to be the fastest for this layer */
+	if ((algorithm == nnp_convolution_algorithm_auto) && (groups == 1) && !dilated && nnp_autotune_enabled()) {
+		const struct nnp_autotune_key autotune_key = {
+			.operation = nnp_autotune_operation_convolution_inference,
+			.kernel_transform_strategy = kernel_transform_strategy,
+			.threads = (threadpool != NULL ? pthreadpool_get_threads_count(threadpool) : 1),
+			.batch_size = 1,
+			.input_channels = input_channels,
+			.output_channels = output_channels,
+			.input_size = input_size,
+			.input_padding = input_padding,
+			.kernel_size = kernel_size,
+			.output_subsampling = output_subsampling,
+		};
+		algorithm = nnp_autotune_lookup(&autotune_key);
+		if (algorithm == nnp_convolution_algorithm_auto) {
+			struct convolution_inference_autotune_context autotune_context = {
+				.kernel_transform_strategy = kernel_transform_strategy,
+				.input_channels = input_channels,
+				.output_channels = output_channels,
+				.input_size = input_size,
+				.input_padding = input_padding,
+				.kernel_size = kernel_size,
+				.output_subsampling = output_subsampling,
+				.input = input,
+				.kernel = kernel,
+				.bias = bias,
+				.output = output,
+				.activation = activation,
+				.activation_parameters = activation_parameters,
+				.threadpool = threadpool,
+			};
+			if ((workspace_buffer == NULL) && (workspace_size != NULL)) {
+				/* Workspace size query: until the layer is measured, the workspace must fit any algorithm */
+				status = nnp_autotune_workspace_size(
+					(nnp_autotune_function) autotune_convolution_inference, &autotune_context,
+					workspace_size);
+				goto cleanup;
 			}
+			/* Measurements overwrite the output, and the layer is then computed again with the fastest algorithm */
+			algorithm = nnp_autotune_measure(&autotune_key,
+				(nnp_autotune_function) autotune_convolution_inference, &autotune_context,
+				workspace_buffer, workspace_size);
 		}
 	}
 
-	const size_t simd_width = 8;
+	/* Depthwise convolution has no reduction over channels to amortize transforms, and is computed directly */
+	if ((algorithm == nnp_convolution_algorithm_auto) && (groups > 1) && (group_input_channels == 1)) {
+		status = nnp_convolution_depthwise(
+			1, input_channels, output_channels,
+			input_size, input_padding, kernel_size, output_subsampling,
+			input, kernel, bias, output,
+			workspace_buffer, workspace_size,
+			output_activation,
+			threadpool, profile);
+		goto cleanup;
+	}
+
+	if (algorithm == nnp_convolution_algorithm_auto) {
+		algorithm = nnp_convolution_select_algorithm(1, group_input_channels, group_output_channels,
+			kernel_size, kernel_dilation, output_subsampling, output_size, true);
+	}
+
+	if (algorithm == nnp_convolution_algorithm_implicit_gemm) {
+		/* Kernel matrix is packed on every call, so only recompute and reuse strategies apply */
+		switch (kernel_transform_strategy) {
+			case nnp_convolution_kernel_transform_strategy_recompute:
+			case nnp_convolution_kernel_transform_strategy_reuse:
+				break;
+			default:
+				status = nnp_status_unsupported_algorithm;
+				goto cleanup;
+		}
+
+		status = nnp_convolution_implicit_gemm(
+			1, groups, input_channels, output_channels,
+			input_size, input_padding, kernel_size, kernel_dilation, output_subsampling,
+			input, kernel, bias, output,
+			workspace_buffer, workspace_size,
+			output_activation,
+			threadpool, profile);
+		goto cleanup;
+	}
+
+	const size_t simd_width = nnp_hwinfo.simd_width;
 	struct nnp_size tile_size;
 	bool fourier_transform;
-	void (*input_transform_function)(const float[], float[], size_t, size_t, uint32_t, uint32_t, uint32_t, uint32_t) = NULL;
-	void (*kernel_transform_function)(const float[], float[], size_t, size_t, uint32_t, uint32_t, uint32_t, uint32_t) = NULL;
-	void (*kernel_fourier_transform_and_macc_function)(const float[], float[], const float[], size_t, uint32_t, uint32_t, uint32_t, uint32_t) = NULL;
-	void (*kernel_winograd_transform_and_mac_function)(const float[], float[], const float[], size_t) = NULL;
-	void (*macc_function)(float[], const float[], const float[]) = NULL;
-	void (*output_transform_function)(const float[], float[], const float[], size_t, size_t, uint32_t, uint32_t) = NULL;
+	nnp_transform_2d input_transform_function = NULL;
+	nnp_transform_2d kernel_transform_function = NULL;
+	nnp_transform_2d_and_macc kernel_fourier_transform_and_macc_function = NULL;
+	nnp_kernel_transform_and_mac kernel_winograd_transform_and_mac_function = NULL;
+	nnp_tile_gemm_function macc_function = NULL;
+	nnp_transform_2d_with_bias output_transform_function = NULL;
+	nnp_transform_2d_with_bias_and_activation output_activation_transform_function = NULL;
 	switch (algorithm) {
 		case nnp_convolution_algorithm_wt8x8:
+			/* Winograd transform is specific to dense 3x3 kernels */
+			if (dilated) {
+				status = nnp_status_unsupported_algorithm;
+				goto cleanup;
+			}
 			tile_size = (struct nnp_size) { .height = 8, .width = 8 };
-			input_transform_function = nnp_iwt8x8_3x3_and_store__avx2;
-			kernel_transform_function = nnp_kwt8x8_3x3_and_stream__avx2;
-			kernel_winograd_transform_and_mac_function = nnp_kwt8x8_3x3_and_mac__avx2;
-			macc_function = nnp_s8x8gemm__fma3;
-			output_transform_function = nnp_owt8x8_3x3_with_bias__avx2;
+			input_transform_function = nnp_hwinfo.transforms.iwt_f6x6_3x3_and_store;
+			kernel_transform_function = nnp_hwinfo.transforms.kwt_f6x6_3x3_and_stream;
+			kernel_winograd_transform_and_mac_function = nnp_hwinfo.transforms.kwt_f6x6_3x3_and_mac;
+			macc_function = nnp_hwinfo.sxgemm.tile8x8;
+			output_transform_function = nnp_hwinfo.transforms.owt_f6x6_3x3_with_bias;
+			output_activation_transform_function = nnp_hwinfo.transforms.owt_f6x6_3x3_with_bias_activation;
 			fourier_transform = false;
 			break;
 		case nnp_convolution_algorithm_ft8x8:
 			tile_size = (struct nnp_size) { .height = 8, .width = 8 };
-			input_transform_function = nnp_fft8x8_and_store__avx2;
-			kernel_transform_function = nnp_fft8x8_and_stream__avx2;
-			kernel_fourier_transform_and_macc_function = nnp_fft8x8_and_macc__avx2;
-			macc_function = nnp_ft8x8gemmc__fma3;
-			output_transform_function = nnp_ifft8x8_with_bias__avx2;
+			input_transform_function = nnp_hwinfo.transforms.fft8x8_and_store;
+			kernel_transform_function = nnp_hwinfo.transforms.fft8x8_and_stream;
+			kernel_fourier_transform_and_macc_function = nnp_hwinfo.transforms.fft8x8_and_macc;
+			macc_function = nnp_hwinfo.cxgemm.tile8x8;
+			output_transform_function = nnp_hwinfo.transforms.ifft8x8_with_bias;
+			output_activation_transform_function = nnp_hwinfo.transforms.ifft8x8_with_bias_activation;
 			fourier_transform = true;
 			break;
 		case nnp_convolution_algorithm_ft16x16:
 			tile_size = (struct nnp_size) { .height = 16, .width = 16 };
-			input_transform_function = nnp_fft16x16_and_store__avx2;
-			kernel_transform_function = nnp_fft16x16_and_stream__avx2;
-			kernel_fourier_transform_and_macc_function = nnp_fft16x16_and_macc__avx2;
-			macc_function = nnp_ft16x16gemmc__fma3;
-			output_transform_function = nnp_ifft16x16_with_bias__avx2;
+			input_transform_function = nnp_hwinfo.transforms.fft16x16_and_store;
+			kernel_transform_function = nnp_hwinfo.transforms.fft16x16_and_stream;
+			kernel_fourier_transform_and_macc_function = nnp_hwinfo.transforms.fft16x16_and_macc;
+			macc_function = nnp_hwinfo.cxgemm.tile16x16;
+			output_transform_function = nnp_hwinfo.transforms.ifft16x16_with_bias;
+			output_activation_transform_function = nnp_hwinfo.transforms.ifft16x16_with_bias_activation;
 			fourier_transform = true;
 			break;
 		case nnp_convolution_algorithm_auto:
@@ -112,6 +574,22 @@ enum nnp_status nnp_convolution_inference(
 			goto cleanup;
 	}
 
+	/* Detect incompatibilities between kernel size and algorithm */
+	if ((dilated_kernel_size.height > tile_size.height) || (dilated_kernel_size.width > tile_size.width)) {
+		status = nnp_status_unsupported_kernel_size;
+		goto cleanup;
+	}
+
+	switch (kernel_transform_strategy) {
+		case nnp_convolution_kernel_transform_strategy_recompute:
+		case nnp_convolution_kernel_transform_strategy_reuse:
+		case nnp_convolution_kernel_transform_strategy_precomputed:
+			break;
+		default:
+			status = nnp_status_unsupported_algorithm;
+			goto cleanup;
+	}
+
 	const size_t tuple_elements = (fourier_transform ? simd_width * 2 : simd_width);
 	const size_t tuple_size = tuple_elements * sizeof(float);
 	const size_t tile_elements = tile_size.height * tile_size.width;
@@ -121,180 +599,366 @@ enum nnp_status nnp_convolution_inference(
 		.height = tile_size.height
 	};
 
+	/* With subsampling, a tile covers output_tile outputs spaced output_subsampling apart */
 	const struct nnp_size output_tile = {
-		.width = input_tile.width - kernel_size.width + 1,
-		.height = input_tile.height - kernel_size.height + 1
+		.width = divide_round_up(input_tile.width - dilated_kernel_size.width + 1, output_subsampling.width),
+		.height = divide_round_up(input_tile.height - dilated_kernel_size.height + 1, output_subsampling.height)
 	};
 
+	const size_t tiles_y = divide_round_up(output_size.height, output_tile.height);
+	const size_t tiles_x = divide_round_up(output_size.width, output_tile.width);
+	const size_t tiles_count = tiles_y * tiles_x;
+
+	/*
+	 * Tiles are processed in blocks: input transforms for a block of tiles are computed upfront, so that the output
+	 * tiles of the block can be processed in parallel. The block is sized for the input transforms to stay in the
+	 * shared cache, but has at least a tile per thread, so the workspace does not grow with the image.
+	 * Output transform accumulators are allocated on the stack of each worker thread.
+	 * Groups are computed one by one and reuse the buffers.
+	 */
+	const size_t threads = (threadpool != NULL ? pthreadpool_get_threads_count(threadpool) : 1);
 	const size_t transform_tile_size = tile_elements * sizeof(float);
-	const size_t input_transform_size = input_channels * transform_tile_size;
-	const size_t kernel_transform_size = output_channels * input_channels * transform_tile_size;
-	const size_t output_transform_size = output_channels * transform_tile_size;
-	size_t memory_size = input_transform_size + output_transform_size;
+	const size_t tiles_block_max = min(
+		max(nnp_cache_blocking(threads).l3 / (group_input_channels * transform_tile_size), threads),
+		tiles_count);
+	const size_t input_transform_size = tiles_block_max * group_input_channels * transform_tile_size;
+	const size_t kernel_transform_size = group_output_channels * group_input_channels * transform_tile_size;
+	size_t memory_size = input_transform_size;
 	if (kernel_transform_strategy == nnp_convolution_kernel_transform_strategy_reuse) {
 		memory_size += kernel_transform_size;
 	}
 
-	memory_block = allocate_memory(memory_size);
-	if (memory_block == NULL) {
-		status = nnp_status_out_of_memory;
-		goto cleanup;
+	if (workspace_buffer == NULL) {
+		if (workspace_size != NULL) {
+			/* Workspace size query: report the required size and skip the computation */
+			*workspace_size = memory_size;
+			goto cleanup;
+		}
+
+		memory_block = allocate_memory(memory_size);
+		if (memory_block == NULL) {
+			status = nnp_status_out_of_memory;
+			goto cleanup;
+		}
+	} else {
+		if ((workspace_size == NULL) || (*workspace_size < memory_size)) {
+			status = nnp_status_insufficient_buffer;
+			goto cleanup;
+		}
+
+		if (((uintptr_t) workspace_buffer) % 64 != 0) {
+			status = nnp_status_misaligned_buffer;
+			goto cleanup;
+		}
+
+		memory_block = workspace_buffer;
 	}
 
 	float* input_transform = memory_block;
-	float* output_transform = memory_block + input_transform_size;
 	float* kernel_transform = NULL;
 	if (kernel_transform_strategy == nnp_convolution_kernel_transform_strategy_reuse) {
-		kernel_transform = memory_block + input_transform_size + output_transform_size;
+		kernel_transform = memory_block + input_transform_size;
 	}
 
-	const size_t input_channels_block_max = 16 / (tile_elements / 64);
+	const size_t input_channels_subblock_max = 4;
+	size_t input_channels_block_max = 16 / (tile_elements / 64);
 	const size_t output_channels_block_max = 16 / (tile_elements / 64);
+	if (transformed_kernel != NULL) {
+		/* Coefficients are laid out with the blocking recorded in the kernel transform */
+		input_channels_block_max = transformed_kernel->input_channels_block_max;
+	}
 
-	{
-		const float (*input)[input_size.width * input_size.height] =
-			(const float(*)[input_size.width * input_size.height]) input_pointer;
-		const float (*kernel)[input_channels][kernel_size.width * kernel_size.height] =
-			(const float(*)[input_channels][kernel_size.width * kernel_size.height]) kernel_pointer;
-		float (*output)[output_size.width * output_size.height] =
-			(float(*)[output_size.width * output_size.height]) output_pointer;
+	const size_t kernel_elements = kernel_size.height * kernel_size.width;
+	for (size_t group = 0; group < groups; group++) {
+		const float* group_input = input + group * group_input_channels * input_size.height * input_size.width;
+		const float* group_kernel = kernel + group * group_output_channels * group_input_channels * kernel_elements;
+		const float* group_bias = bias + group * group_output_channels;
+		float* group_output = output + group * group_output_channels * output_size.height * output_size.width;
 
-		switch (kernel_transform_strategy) {
-			case nnp_convolution_kernel_transform_strategy_recompute:
-				for (size_t y = 0; y < output_size.height; y += output_tile.height) {
-					const size_t input_y = min(doz(y, input_padding.top), input_size.height);
-					for (size_t x = 0; x < output_size.width; x += output_tile.width) {
-						const size_t input_x = min(doz(x, input_padding.left), input_size.width);
-
-						{
-							NNP_INPUT_TRANSFORM_START(profile)
-							for (size_t input_channel = 0; input_channel < input_channels; input_channel++) {
-								input_transform_function(
-									&input[input_channel][input_y * input_size.width + input_x],
-									input_transform + input_channel * tile_elements,
-									input_size.width,
-									tuple_size,
-									min(input_tile.height, doz(input_size.height, input_y)),
-									min(input_tile.width, doz(input_size.width, input_x)),
-									doz(input_padding.top, y),
-									doz(input_padding.left, x));
-							}
-							NNP_INPUT_TRANSFORM_END(profile)
-						}
-
-						for (size_t output_channel = 0; output_channel < output_channels; output_channel++) {
-							memset(output_transform + output_channel * tile_elements, 0, tile_elements * sizeof(float));
-
-							NNP_KERNEL_TRANSFORM_START(profile)
-							for (size_t input_channel = 0; input_channel < input_channels; input_channel++) {
-								if (fourier_transform) {
-									kernel_fourier_transform_and_macc_function(
-										kernel[output_channel][input_channel],
-										output_transform + output_channel * tile_elements,
-										input_transform + input_channel * tile_elements,
-										kernel_size.width,
-										kernel_size.height, kernel_size.width, 0, 0);
-								} else {
-									kernel_winograd_transform_and_mac_function(
-										kernel[output_channel][input_channel],
-										output_transform + output_channel * tile_elements,
-										input_transform + input_channel * tile_elements,
-										kernel_size.width);
-								}
-							}
-							NNP_KERNEL_TRANSFORM_END(profile)
-
-							NNP_OUTPUT_TRANSFORM_START(profile)
-							output_transform_function(
-								output_transform + output_channel * tile_elements,
-								&output[output_channel][y * output_size.width + x],
-								&bias[output_channel],
-								tuple_size,
-								output_size.width,
-								min(output_tile.height, output_size.height - y),
-								min(output_tile.width, output_size.width - x));
-							NNP_OUTPUT_TRANSFORM_END(profile)
-						}
-					}
-				}
-				break;
-			case nnp_convolution_kernel_transform_strategy_reuse:
-				{
-					for (size_t output_channel = 0; output_channel < output_channels; output_channel++) {
-						for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
-							const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
-							for (size_t input_channels_block_offset = 0; input_channels_block_offset < input_channels_block_size; input_channels_block_offset++) {
-								const size_t input_channel = input_channels_block_start + input_channels_block_offset;
-								kernel_transform_function(
-									kernel[output_channel][input_channel],
-									kernel_transform + (input_channels_block_start * output_channels + output_channel * input_channels_block_size + input_channels_block_offset) * tile_elements,
-									kernel_size.width,
-									tuple_size,
-									kernel_size.height, kernel_size.width, 0, 0);
-							}
-						}
-					}
-				}
-				for (size_t y = 0; y < output_size.height; y += output_tile.height) {
-					const size_t input_y = min(doz(y, input_padding.top), input_size.height);
-					for (size_t x = 0; x < output_size.width; x += output_tile.width) {
-						const size_t input_x = min(doz(x, input_padding.left), input_size.width);
-
-						for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
-							const size_t input_channels_block_end = min(input_channels_block_start + input_channels_block_max, input_channels);
-							for (size_t input_channel = input_channels_block_start; input_channel < input_channels_block_end; input_channel++) {
-								input_transform_function(
-									&input[input_channel][input_y * input_size.width + input_x],
-									input_transform + input_channel * tile_elements,
-									input_size.width,
-									tuple_size,
-									min(input_tile.height, doz(input_size.height, input_y)),
-									min(input_tile.width, doz(input_size.width, input_x)),
-									doz(input_padding.top, y),
-									doz(input_padding.left, x));
-							}
-						}
-
-						for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
-							const size_t input_channels_block_size = min(input_channels_block_max, input_channels - input_channels_block_start);
-							for (size_t output_channels_block_start = 0; output_channels_block_start < output_channels; output_channels_block_start += output_channels_block_max) {
-								const size_t output_channels_block_end = min(output_channels_block_start + output_channels_block_max, output_channels);
-								for (size_t output_channel = output_channels_block_start; output_channel < output_channels_block_end; output_channel++) {
-									if (input_channels_block_start == 0) {
-										memset(output_transform + output_channel * tile_elements, 0, tile_elements * sizeof(float));
-									}
-
-									for (size_t input_channels_block_offset = 0; input_channels_block_offset < input_channels_block_size; input_channels_block_offset++) {
-										macc_function(
-											output_transform + output_channel * tile_elements,
-											input_transform + (input_channels_block_start + input_channels_block_offset) * tile_elements,
-											kernel_transform + (input_channels_block_start * output_channels + output_channel * input_channels_block_size + input_channels_block_offset) * tile_elements);
-									}
-
-									if (input_channels_block_start + input_channels_block_size == input_channels) {
-										output_transform_function(
-											output_transform + output_channel * tile_elements,
-											&output[output_channel][y * output_size.width + x],
-											&bias[output_channel],
-											tuple_size,
-											output_size.width,
-											min(output_tile.height, output_size.height - y),
-											min(output_tile.width, output_size.width - x));
-									}
-								}
-							}
-						}
-					}
-				}
-				break;
-			case nnp_convolution_kernel_transform_strategy_precomputed:
-				NNP_UNREACHABLE;
-				break;
+		if (kernel_transform_strategy == nnp_convolution_kernel_transform_strategy_reuse) {
+			NNP_KERNEL_TRANSFORM_START(profile)
+			struct kernel_transform_context kernel_transform_context = {
+				.transform_function = kernel_transform_function,
+				.kernel = group_kernel,
+				.kernel_transform = kernel_transform,
+				.tuple_size = tuple_size,
+				.tile_elements = tile_elements,
+				.input_channels = group_input_channels,
+				.input_channels_block_max = input_channels_block_max,
+				.output_channels = group_output_channels,
+				.kernel_size = kernel_size,
+				.kernel_dilation = kernel_dilation,
+			};
+			pthreadpool_compute_2d_tiled(threadpool,
+				(pthreadpool_function_2d_tiled_t) compute_kernel_transform,
+				&kernel_transform_context,
+				group_output_channels, group_input_channels,
+				1,                     input_channels_subblock_max);
+			NNP_KERNEL_TRANSFORM_END(profile)
+		}
+
+		for (size_t tiles_block_start = 0; tiles_block_start < tiles_count; tiles_block_start += tiles_block_max) {
+			const size_t tiles_block_size = min(tiles_count - tiles_block_start, tiles_block_max);
+
+			NNP_INPUT_TRANSFORM_START(profile)
+			struct input_transform_context input_transform_context = {
+				.transform_function = input_transform_function,
+				.input = group_input,
+				.input_transform = input_transform,
+				.tuple_size = tuple_size,
+				.tile_elements = tile_elements,
+				.input_channels = group_input_channels,
+				.tiles_x = tiles_x,
+				.tiles_block_start = tiles_block_start,
+				.input_size = input_size,
+				.input_padding = input_padding,
+				.input_tile = input_tile,
+				.output_tile = output_tile,
+				.output_subsampling = output_subsampling,
+			};
+			pthreadpool_compute_2d_tiled(threadpool,
+				(pthreadpool_function_2d_tiled_t) compute_input_transform,
+				&input_transform_context,
+				tiles_block_size, group_input_channels,
+				1,                input_channels_subblock_max);
+			NNP_INPUT_TRANSFORM_END(profile)
+
+			NNP_BLOCK_MULTIPLICATION_START(profile)
+			struct tile_convolution_context tile_convolution_context = {
+				.kernel_fourier_transform_and_macc_function = kernel_fourier_transform_and_macc_function,
+				.kernel_winograd_transform_and_mac_function = kernel_winograd_transform_and_mac_function,
+				.macc_function = macc_function,
+				.output_transform_function = output_transform_function,
+				.output_activation_transform_function = output_activation_transform_function,
+				.activation = output_activation,
+				.kernel = group_kernel,
+				.bias = group_bias,
+				.output = group_output,
+				.input_transform = input_transform,
+				.kernel_transform = (transformed_kernel != NULL ?
+					nnp_transformed_kernel_data(transformed_kernel) : kernel_transform),
+				.fourier_transform = fourier_transform,
+				.tuple_size = tuple_size,
+				.tile_elements = tile_elements,
+				.input_channels = group_input_channels,
+				.input_channels_block_max = input_channels_block_max,
+				.output_channels = group_output_channels,
+				.tiles_x = tiles_x,
+				.tiles_block_start = tiles_block_start,
+				.kernel_size = kernel_size,
+				.kernel_dilation = kernel_dilation,
+				.output_size = output_size,
+				.output_tile = output_tile,
+				.output_subsampling = output_subsampling,
+				.input_tile = input_tile,
+			};
+			pthreadpool_compute_2d_tiled(threadpool,
+				(pthreadpool_function_2d_tiled_t)
+					(kernel_transform_strategy == nnp_convolution_kernel_transform_strategy_recompute ?
+						compute_tile_convolution_recompute : compute_tile_convolution_reuse),
+				&tile_convolution_context,
+				tiles_block_size, group_output_channels,
+				1,                output_channels_block_max);
+			NNP_BLOCK_MULTIPLICATION_END(profile)
 		}
 	}
 
 cleanup:
-	release_memory(memory_block, memory_size);
+	if (workspace_buffer == NULL) {
+		release_memory(memory_block, memory_size);
+	}
 	NNP_TOTAL_END(profile)
 	return status;
 }
+
+static enum nnp_status autotune_convolution_inference(
+	const struct convolution_inference_autotune_context* context,
+	enum nnp_convolution_algorithm algorithm,
+	void* workspace_buffer, size_t* workspace_size)
+{
+	return convolution_inference(
+		algorithm, context->kernel_transform_strategy, 1,
+		context->input_channels, context->output_channels,
+		context->input_size, context->input_padding,
+		context->kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, context->output_subsampling,
+		context->input, context->kernel, context->bias, context->output,
+		workspace_buffer, workspace_size,
+		context->activation, context->activation_parameters,
+		context->threadpool, NULL);
+}
+
+enum nnp_status nnp_convolution_inference(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_inference(
+		algorithm, kernel_transform_strategy, 1,
+		input_channels, output_channels,
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 },
+		input, kernel, bias, output,
+		NULL, NULL,
+		nnp_activation_identity, NULL,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_inference_with_activation(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_inference(
+		algorithm, kernel_transform_strategy, 1,
+		input_channels, output_channels,
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 },
+		input, kernel, bias, output,
+		NULL, NULL,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_inference_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_inference(
+		algorithm, kernel_transform_strategy, 1,
+		input_channels, output_channels,
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 },
+		input, kernel, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_inference_strided(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_inference(
+		algorithm, kernel_transform_strategy, 1,
+		input_channels, output_channels,
+		input_size, input_padding, kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, output_subsampling,
+		input, kernel, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_inference_grouped(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t groups,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_inference(
+		algorithm, kernel_transform_strategy, groups,
+		input_channels, output_channels,
+		input_size, input_padding, kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, output_subsampling,
+		input, kernel, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_inference_dilated(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_inference(
+		algorithm, kernel_transform_strategy, 1,
+		input_channels, output_channels,
+		input_size, input_padding, kernel_size, kernel_dilation, output_subsampling,
+		input, kernel, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
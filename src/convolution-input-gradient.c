@@ -179,8 +179,8 @@ struct NNP_CACHE_ALIGN matrix_multiplication_context {
 	float* grad_input_transform;
 
 	union {
-		nnp_tuple_gemm_function cgemm[2][2];
-		nnp_tuple_gemm_function sgemm[3][4];
+		nnp_tuple_gemm_function (*cgemm)[3];
+		nnp_tuple_gemm_function (*sgemm)[6];
 	};
 };
 
@@ -352,30 +352,10 @@ static void compute_convolution_input_gradient(
 							.grad_input_transform = grad_input_transform + tuple_index * tuple_elements * batch_size * input_channels,
 						};
 						if (fourier_transform) {
-							if (tuple_index == 0) {
-								matrix_multiplication_context.cgemm[0][0] = nnp_s4c6gemm1x1__fma3;
-								matrix_multiplication_context.cgemm[0][1] = nnp_s4c6gemm1x2__fma3;
-								matrix_multiplication_context.cgemm[1][0] = nnp_s4c6gemm2x1__fma3;
-								matrix_multiplication_context.cgemm[1][1] = nnp_s4c6gemm2x2__fma3;
-							} else {
-								matrix_multiplication_context.cgemm[0][0] = nnp_c8gemm1x1__fma3;
-								matrix_multiplication_context.cgemm[0][1] = nnp_c8gemm1x2__fma3;
-								matrix_multiplication_context.cgemm[1][0] = nnp_c8gemm2x1__fma3;
-								matrix_multiplication_context.cgemm[1][1] = nnp_c8gemm2x2__fma3;
-							}
+							matrix_multiplication_context.cgemm = (tuple_index == 0 ?
+								nnp_hwinfo.cxgemm.s4cX_functions : nnp_hwinfo.cxgemm.cX_functions);
 						} else {
-							matrix_multiplication_context.sgemm[0][0] = nnp_s8gemm1x1__fma3;
-							matrix_multiplication_context.sgemm[0][1] = nnp_s8gemm1x2__fma3;
-							matrix_multiplication_context.sgemm[0][2] = nnp_s8gemm1x3__fma3;
-							matrix_multiplication_context.sgemm[0][3] = nnp_s8gemm1x4__fma3;
-							matrix_multiplication_context.sgemm[1][0] = nnp_s8gemm2x1__fma3;
-							matrix_multiplication_context.sgemm[1][1] = nnp_s8gemm2x2__fma3;
-							matrix_multiplication_context.sgemm[1][2] = nnp_s8gemm2x3__fma3;
-							matrix_multiplication_context.sgemm[1][3] = nnp_s8gemm2x4__fma3;
-							matrix_multiplication_context.sgemm[2][0] = nnp_s8gemm3x1__fma3;
-							matrix_multiplication_context.sgemm[2][1] = nnp_s8gemm3x2__fma3;
-							matrix_multiplication_context.sgemm[2][2] = nnp_s8gemm3x3__fma3;
-							matrix_multiplication_context.sgemm[2][3] = nnp_s8gemm3x4__fma3;
+							matrix_multiplication_context.sgemm = nnp_hwinfo.sxgemm.functions;
 						}
 						pthreadpool_compute_2d_tiled(threadpool,
 							(pthreadpool_function_2d_tiled_t) (fourier_transform ?
@@ -414,7 +394,8 @@ static void compute_convolution_input_gradient(
 	}
 }
 
-enum nnp_status nnp_convolution_input_gradient(
+/* If workspace_buffer is NULL, temporary buffers are allocated for the duration of the call */
+static enum nnp_status convolution_input_gradient(
 	enum nnp_convolution_algorithm algorithm,
 	size_t batch_size,
 	size_t input_channels,
@@ -425,6 +406,8 @@ enum nnp_status nnp_convolution_input_gradient(
 	const float grad_output[],
 	const float kernel[],
 	float grad_input[],
+	void* workspace_buffer,
+	size_t* workspace_size,
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile)
 {
@@ -434,7 +417,8 @@ enum nnp_status nnp_convolution_input_gradient(
 	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
 	enum nnp_status status = validate_convolution_arguments(
 		batch_size, input_channels, output_channels,
-		input_size, input_padding, kernel_size);
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 });
 	if (status != nnp_status_success) {
 		goto cleanup;
 	}
@@ -467,23 +451,23 @@ enum nnp_status nnp_convolution_input_gradient(
 	nnp_transform_2d grad_input_transform_function;
 	switch (algorithm) {
 		case nnp_convolution_algorithm_ft8x8:
-			grad_output_transform_function = nnp_fft8x8_and_stream__avx2;
-			kernel_transform_function = nnp_fft8x8_and_stream__avx2;
-			grad_input_transform_function = nnp_ifft8x8__avx2;
+			grad_output_transform_function = nnp_hwinfo.transforms.fft8x8_and_stream;
+			kernel_transform_function = nnp_hwinfo.transforms.fft8x8_and_stream;
+			grad_input_transform_function = nnp_hwinfo.transforms.ifft8x8;
 			transform_tile = (struct nnp_size) { .height = 8, .width = 8 };
 			fourier_transform = true;
 			break;
 		case nnp_convolution_algorithm_ft16x16:
-			grad_output_transform_function = nnp_fft16x16_and_stream__avx2;
-			kernel_transform_function = nnp_fft16x16_and_stream__avx2;
-			grad_input_transform_function = nnp_ifft16x16__avx2;
+			grad_output_transform_function = nnp_hwinfo.transforms.fft16x16_and_stream;
+			kernel_transform_function = nnp_hwinfo.transforms.fft16x16_and_stream;
+			grad_input_transform_function = nnp_hwinfo.transforms.ifft16x16;
 			transform_tile = (struct nnp_size) { .height = 16, .width = 16 };
 			fourier_transform = true;
 			break;
 		case nnp_convolution_algorithm_wt8x8:
-			grad_output_transform_function = nnp_iwt8x8_3x3_and_stream__avx2;
-			kernel_transform_function = nnp_kwt8x8_3Rx3R_and_stream__avx2;
-			grad_input_transform_function = nnp_owt8x8_3x3__avx2;
+			grad_output_transform_function = nnp_hwinfo.transforms.iwt_f6x6_3x3_and_stream;
+			kernel_transform_function = nnp_hwinfo.transforms.kwt_f6x6_3Rx3R_and_stream;
+			grad_input_transform_function = nnp_hwinfo.transforms.owt_f6x6_3x3;
 			transform_tile = (struct nnp_size) { .height = 8, .width = 8 };
 			fourier_transform = false;
 			break;
@@ -500,7 +484,7 @@ enum nnp_status nnp_convolution_input_gradient(
 		goto cleanup;
 	}
 
-	const size_t simd_width = 8;
+	const size_t simd_width = nnp_hwinfo.simd_width;
 	const size_t tuple_elements = (fourier_transform ? simd_width * 2 : simd_width);
 	const size_t transform_tile_elements = transform_tile.height * transform_tile.width;
 
@@ -509,8 +493,8 @@ enum nnp_status nnp_convolution_input_gradient(
 	const size_t cache_elements_l2 = nnp_hwinfo.blocking.l2 / (tuple_elements * sizeof(float));
 	const size_t cache_elements_l3 = nnp_hwinfo.blocking.l3 / (tuple_elements * sizeof(float));
 
-	const size_t batch_subblock_max = (fourier_transform ? 2 : 3);
-	const size_t input_channels_subblock_max = (fourier_transform ? 2 : 4);
+	const size_t batch_subblock_max = (fourier_transform ? nnp_hwinfo.cxgemm.mr : nnp_hwinfo.sxgemm.mr);
+	const size_t input_channels_subblock_max = (fourier_transform ? nnp_hwinfo.cxgemm.nr : nnp_hwinfo.sxgemm.nr);
 
 	const size_t output_channels_block_max =
 		round_down(cache_elements_l1 / (batch_subblock_max + input_channels_subblock_max), 2);
@@ -525,10 +509,30 @@ enum nnp_status nnp_convolution_input_gradient(
 	const size_t grad_output_transform_size = batch_size * output_channels * transform_tile_elements * sizeof(float);
 	const size_t memory_size = kernel_transform_size + grad_input_transform_size + grad_output_transform_size;
 
-	memory_block = allocate_memory(memory_size);
-	if (memory_block == NULL) {
-		status = nnp_status_out_of_memory;
-		goto cleanup;
+	if (workspace_buffer == NULL) {
+		if (workspace_size != NULL) {
+			/* Workspace size query: report the required size and skip the computation */
+			*workspace_size = memory_size;
+			goto cleanup;
+		}
+
+		memory_block = allocate_memory(memory_size);
+		if (memory_block == NULL) {
+			status = nnp_status_out_of_memory;
+			goto cleanup;
+		}
+	} else {
+		if ((workspace_size == NULL) || (*workspace_size < memory_size)) {
+			status = nnp_status_insufficient_buffer;
+			goto cleanup;
+		}
+
+		if (((uintptr_t) workspace_buffer) % 64 != 0) {
+			status = nnp_status_misaligned_buffer;
+			goto cleanup;
+		}
+
+		memory_block = workspace_buffer;
 	}
 
 	float* grad_output_transform = memory_block;
@@ -560,7 +564,57 @@ enum nnp_status nnp_convolution_input_gradient(
 		profile);
 
 cleanup:
-	release_memory(memory_block, memory_size);
+	if (workspace_buffer == NULL) {
+		release_memory(memory_block, memory_size);
+	}
 	NNP_TOTAL_END(profile)
 	return status;
 }
+
+enum nnp_status nnp_convolution_input_gradient(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float grad_output[],
+	const float kernel[],
+	float grad_input[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_input_gradient(
+		algorithm,
+		batch_size, input_channels, output_channels,
+		input_size, input_padding, kernel_size,
+		grad_output, kernel, grad_input,
+		NULL, NULL,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_input_gradient_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float grad_output[],
+	const float kernel[],
+	float grad_input[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_input_gradient(
+		algorithm,
+		batch_size, input_channels, output_channels,
+		input_size, input_padding, kernel_size,
+		grad_output, kernel, grad_input,
+		workspace_buffer, workspace_size,
+		threadpool, profile);
+}
@@ -0,0 +1,290 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/hwinfo.h>
+
+#include <nnpack/transformed-kernel.h>
+#include <nnpack/transform.h>
+
+
+struct NNP_CACHE_ALIGN kernel_transform_context {
+	nnp_transform_2d transform_function;
+	const float* kernel;
+	float* kernel_transform;
+
+	size_t tuple_elements;
+	size_t tile_elements;
+	size_t input_channels;
+	size_t input_channels_block_max;
+	size_t output_channels;
+	struct nnp_size kernel_size;
+};
+
+/* Layout of nnp_convolution_output: coefficients are grouped into tuples, and tuples with the same index are stored together */
+static void compute_output_kernel_transform(
+	const struct kernel_transform_context context[restrict static 1],
+	size_t input_channel,       size_t output_channels_subblock_start,
+	size_t input_channel_range, size_t output_channels_subblock_size)
+{
+	const size_t tuple_elements           = context->tuple_elements;
+	const size_t input_channels           = context->input_channels;
+	const size_t input_channels_block_max = context->input_channels_block_max;
+	const size_t output_channels          = context->output_channels;
+	const struct nnp_size kernel_size     = context->kernel_size;
+
+	const float (*kernel)[input_channels][kernel_size.width * kernel_size.height] =
+		(const float(*)[input_channels][kernel_size.width * kernel_size.height]) context->kernel;
+	float* kernel_transform             = context->kernel_transform;
+	nnp_transform_2d transform_function = context->transform_function;
+
+	const size_t input_channels_block_start = round_down(input_channel, input_channels_block_max);
+	const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
+	const size_t input_channels_block_offset = input_channel - input_channels_block_start;
+
+	for (size_t output_channels_subblock_offset = 0; output_channels_subblock_offset < output_channels_subblock_size; output_channels_subblock_offset += 1) {
+		const size_t output_channel = output_channels_subblock_start + output_channels_subblock_offset;
+		transform_function(
+			kernel[output_channel][input_channel],
+			kernel_transform +
+				(input_channels_block_start * output_channels + output_channels_subblock_start * input_channels_block_size + input_channels_block_offset * output_channels_subblock_size + output_channels_subblock_offset) * tuple_elements,
+			kernel_size.width,
+			output_channels * input_channels * tuple_elements * sizeof(float),
+			kernel_size.height, kernel_size.width, 0, 0);
+	}
+}
+
+/* Layout of nnp_convolution_inference: all coefficients of a transformed kernel are stored together */
+static void compute_inference_kernel_transform(
+	const struct kernel_transform_context context[restrict static 1],
+	size_t output_channel,       size_t input_channels_subblock_start,
+	size_t output_channel_range, size_t input_channels_subblock_size)
+{
+	const size_t tuple_elements           = context->tuple_elements;
+	const size_t tile_elements            = context->tile_elements;
+	const size_t input_channels           = context->input_channels;
+	const size_t input_channels_block_max = context->input_channels_block_max;
+	const size_t output_channels          = context->output_channels;
+	const struct nnp_size kernel_size     = context->kernel_size;
+
+	const float (*kernel)[input_channels][kernel_size.width * kernel_size.height] =
+		(const float(*)[input_channels][kernel_size.width * kernel_size.height]) context->kernel;
+	float* kernel_transform             = context->kernel_transform;
+	nnp_transform_2d transform_function = context->transform_function;
+
+	for (size_t input_channels_subblock_offset = 0; input_channels_subblock_offset < input_channels_subblock_size; input_channels_subblock_offset += 1) {
+		const size_t input_channel = input_channels_subblock_start + input_channels_subblock_offset;
+		const size_t input_channels_block_start  = round_down(input_channel, input_channels_block_max);
+		const size_t input_channels_block_size   = min(input_channels - input_channels_block_start, input_channels_block_max);
+		const size_t input_channels_block_offset = input_channel - input_channels_block_start;
+		transform_function(
+			kernel[output_channel][input_channel],
+			kernel_transform +
+				(input_channels_block_start * output_channels + output_channel * input_channels_block_size + input_channels_block_offset) * tile_elements,
+			kernel_size.width,
+			tuple_elements * sizeof(float),
+			kernel_size.height, kernel_size.width, 0, 0);
+	}
+}
+
+static enum nnp_status validate_kernel_transform_arguments(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_layout layout,
+	size_t input_channels, size_t output_channels,
+	struct nnp_size kernel_size,
+	struct nnp_size* tile_size_out,
+	bool* fourier_transform_out)
+{
+	if (!nnp_hwinfo.initialized) {
+		return nnp_status_uninitialized;
+	}
+
+	if (!nnp_hwinfo.supported) {
+		return nnp_status_unsupported_hardware;
+	}
+
+	if (input_channels == 0) {
+		return nnp_status_invalid_input_channels;
+	}
+
+	if (output_channels == 0) {
+		return nnp_status_invalid_output_channels;
+	}
+
+	if (min(kernel_size.height, kernel_size.width) == 0) {
+		return nnp_status_invalid_kernel_size;
+	}
+
+	switch (layout) {
+		case nnp_convolution_kernel_transform_layout_output:
+		case nnp_convolution_kernel_transform_layout_inference:
+			break;
+		default:
+			return nnp_status_invalid_kernel_transform_layout;
+	}
+
+	struct nnp_size tile_size;
+	bool fourier_transform;
+	switch (algorithm) {
+		case nnp_convolution_algorithm_ft8x8:
+			tile_size = (struct nnp_size) { .height = 8, .width = 8 };
+			fourier_transform = true;
+			break;
+		case nnp_convolution_algorithm_ft16x16:
+			tile_size = (struct nnp_size) { .height = 16, .width = 16 };
+			fourier_transform = true;
+			break;
+		case nnp_convolution_algorithm_wt8x8:
+			if ((kernel_size.height != 3) || (kernel_size.width != 3)) {
+				return nnp_status_unsupported_kernel_size;
+			}
+			tile_size = (struct nnp_size) { .height = 8, .width = 8 };
+			fourier_transform = false;
+			break;
+		case nnp_convolution_algorithm_auto:
+			/* The optimal algorithm depends on input size, which is not known at this point */
+		default:
+			return nnp_status_unsupported_algorithm;
+	}
+
+	if ((kernel_size.height > tile_size.height) || (kernel_size.width > tile_size.width)) {
+		return nnp_status_unsupported_kernel_size;
+	}
+
+	*tile_size_out = tile_size;
+	*fourier_transform_out = fourier_transform;
+	return nnp_status_success;
+}
+
+enum nnp_status nnp_convolution_kernel_transform_size(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_layout layout,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size kernel_size,
+	size_t* transformed_kernel_size)
+{
+	struct nnp_size tile_size;
+	bool fourier_transform;
+	enum nnp_status status = validate_kernel_transform_arguments(
+		algorithm, layout, input_channels, output_channels, kernel_size,
+		&tile_size, &fourier_transform);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	*transformed_kernel_size = sizeof(struct nnp_transformed_kernel) +
+		output_channels * input_channels * tile_size.height * tile_size.width * sizeof(float);
+	return nnp_status_success;
+}
+
+enum nnp_status nnp_convolution_kernel_transform(
+	enum nnp_convolution_algorithm algorithm,
+	enum nnp_convolution_kernel_transform_layout layout,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size kernel_size,
+	const float kernel[],
+	void* transformed_kernel,
+	size_t transformed_kernel_size,
+	pthreadpool_t threadpool)
+{
+	struct nnp_size tile_size;
+	bool fourier_transform;
+	enum nnp_status status = validate_kernel_transform_arguments(
+		algorithm, layout, input_channels, output_channels, kernel_size,
+		&tile_size, &fourier_transform);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	const size_t simd_width = nnp_hwinfo.simd_width;
+	const size_t tuple_elements = (fourier_transform ? simd_width * 2 : simd_width);
+	const size_t tile_elements = tile_size.height * tile_size.width;
+
+	if (transformed_kernel_size < sizeof(struct nnp_transformed_kernel) + output_channels * input_channels * tile_elements * sizeof(float)) {
+		return nnp_status_insufficient_buffer;
+	}
+
+	if (((uintptr_t) transformed_kernel) % sizeof(struct nnp_transformed_kernel) != 0) {
+		return nnp_status_misaligned_buffer;
+	}
+
+	nnp_transform_2d transform_function;
+	switch (algorithm) {
+		case nnp_convolution_algorithm_ft8x8:
+			transform_function = nnp_hwinfo.transforms.fft8x8_and_stream;
+			break;
+		case nnp_convolution_algorithm_ft16x16:
+			transform_function = nnp_hwinfo.transforms.fft16x16_and_stream;
+			break;
+		case nnp_convolution_algorithm_wt8x8:
+			transform_function = nnp_hwinfo.transforms.kwt_f6x6_3x3_and_stream;
+			break;
+		default:
+			NNP_UNREACHABLE;
+	}
+
+	/* Blocking parameters must match the ones in nnp_convolution_output and nnp_convolution_inference */
+	const size_t batch_subblock_max = (fourier_transform ? nnp_hwinfo.cxgemm.mr : nnp_hwinfo.sxgemm.mr);
+	const size_t output_channels_subblock_max = (fourier_transform ? nnp_hwinfo.cxgemm.nr : nnp_hwinfo.sxgemm.nr);
+	const size_t input_channels_subblock_max = 4;
+	size_t input_channels_block_max;
+	switch (layout) {
+		case nnp_convolution_kernel_transform_layout_output:
+		{
+			const size_t cache_elements_l1 = nnp_hwinfo.blocking.l1 / (tuple_elements * sizeof(float));
+			input_channels_block_max =
+				round_down(cache_elements_l1 / (batch_subblock_max + output_channels_subblock_max), 2);
+			break;
+		}
+		case nnp_convolution_kernel_transform_layout_inference:
+			input_channels_block_max = 16 / (tile_elements / 64);
+			break;
+		default:
+			NNP_UNREACHABLE;
+	}
+
+	struct nnp_transformed_kernel* header = transformed_kernel;
+	*header = (struct nnp_transformed_kernel) {
+		.magic = NNP_TRANSFORMED_KERNEL_MAGIC,
+		.version = NNP_TRANSFORMED_KERNEL_VERSION,
+		.algorithm = (uint32_t) algorithm,
+		.layout = (uint32_t) layout,
+		.input_channels = input_channels,
+		.output_channels = output_channels,
+		.kernel_height = kernel_size.height,
+		.kernel_width = kernel_size.width,
+		.input_channels_block_max = input_channels_block_max,
+		.tuple_format = (uint32_t) nnp_hwinfo.tuple_format,
+	};
+
+	struct kernel_transform_context kernel_transform_context = {
+		.transform_function = transform_function,
+		.kernel = kernel,
+		.kernel_transform = (float*) (header + 1),
+		.tuple_elements = tuple_elements,
+		.tile_elements = tile_elements,
+		.input_channels = input_channels,
+		.input_channels_block_max = input_channels_block_max,
+		.output_channels = output_channels,
+		.kernel_size = kernel_size,
+	};
+	if (layout == nnp_convolution_kernel_transform_layout_output) {
+		pthreadpool_compute_2d_tiled(threadpool,
+			(pthreadpool_function_2d_tiled_t) compute_output_kernel_transform,
+			&kernel_transform_context,
+			input_channels, output_channels,
+			1,              output_channels_subblock_max);
+	} else {
+		pthreadpool_compute_2d_tiled(threadpool,
+			(pthreadpool_function_2d_tiled_t) compute_inference_kernel_transform,
+			&kernel_transform_context,
+			output_channels, input_channels,
+			1,               input_channels_subblock_max);
+	}
+
+	return nnp_status_success;
+}
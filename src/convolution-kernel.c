@@ -110,6 +110,7 @@ struct NNP_CACHE_ALIGN grad_kernel_transform_context {
 	size_t output_channels;
 	size_t output_channels_block_max;
 	struct nnp_size kernel_size;
+	float scale;
 	const float* grad_kernel_transform;
 	float* grad_kernel;
 	nnp_transform_2d transform_function;
@@ -147,6 +148,48 @@ static void compute_grad_kernel_transform(
 	}
 }
 
+/*
+ * Fuses SGD update into the inverse transform: gradient of a kernel is reconstructed into a small on-stack block
+ * and immediately accumulated into the kernel as kernel += scale * grad_kernel.
+ */
+static void compute_kernel_update_transform(
+	const struct grad_kernel_transform_context context[restrict static 1],
+	size_t output_channel,       size_t input_channels_subblock_start,
+	size_t output_channel_range, size_t input_channels_subblock_size)
+{
+	const size_t tuple_elements            = context->tuple_elements;
+	const size_t input_channels            = context->input_channels;
+	const size_t output_channels           = context->output_channels;
+	const size_t output_channels_block_max = context->output_channels_block_max;
+	const struct nnp_size kernel_size      = context->kernel_size;
+	const float scale                      = context->scale;
+	const float* grad_kernel_transform     = context->grad_kernel_transform;
+	float* kernel                          = context->grad_kernel;
+	const nnp_transform_2d transform       = context->transform_function;
+
+	const size_t output_channels_block_start  = round_down(output_channel, output_channels_block_max);
+	const size_t output_channels_block_size   = min(output_channels - output_channels_block_start, output_channels_block_max);
+	const size_t output_channels_block_offset = output_channel - output_channels_block_start;
+	const size_t kernel_elements = kernel_size.height * kernel_size.width;
+
+	NNP_SIMD_ALIGN float grad_kernel[kernel_elements];
+	for (size_t input_channels_subblock_offset = 0; input_channels_subblock_offset < input_channels_subblock_size; input_channels_subblock_offset += 1) {
+		const size_t input_channel = input_channels_subblock_start + input_channels_subblock_offset;
+		transform(
+			grad_kernel_transform +
+				(output_channels_block_start * input_channels + input_channels_subblock_start * output_channels_block_size + output_channels_block_offset * input_channels_subblock_size + input_channels_subblock_offset) * tuple_elements,
+			grad_kernel,
+			output_channels * input_channels * tuple_elements * sizeof(float),
+			kernel_size.width,
+			kernel_size.height, kernel_size.width, 0, 0);
+
+		float* kernel_tile = kernel + (output_channel * input_channels + input_channel) * kernel_elements;
+		for (size_t i = 0; i < kernel_elements; i++) {
+			kernel_tile[i] += scale * grad_kernel[i];
+		}
+	}
+}
+
 struct NNP_CACHE_ALIGN matrix_multiplication_context {
 	size_t tuple_elements;
 	size_t batch_size;
@@ -161,7 +204,7 @@ struct NNP_CACHE_ALIGN matrix_multiplication_context {
 	const float* input_transform;
 	float* grad_kernel_transform;
 
-	nnp_tuple_gemm_function cgemm[2][2];
+	nnp_tuple_gemm_function (*cgemm)[3];
 };
 
 static void compute_complex_matrix_multiplication(
@@ -181,11 +224,10 @@ static void compute_complex_matrix_multiplication(
 	const float* grad_output_transform        = context->grad_output_transform;
 	const float* input_transform              = context->input_transform;
 	float* grad_kernel_transform              = context->grad_kernel_transform;
-	const nnp_tuple_gemm_function* cgemms     = context->cgemm[input_channels_subblock_size - 1];
 
 	for (size_t output_channels_subblock_start = 0; output_channels_subblock_start < output_channels_block_size; output_channels_subblock_start += output_channels_subblock_max) {
 		const size_t output_channels_subblock_size = min(output_channels_block_size - output_channels_subblock_start, output_channels_subblock_max);
-		const nnp_tuple_gemm_function cgemm = cgemms[output_channels_subblock_size - 1];
+		const nnp_tuple_gemm_function cgemm = context->cgemm[output_channels_subblock_size - 1][input_channels_subblock_size - 1];
 		cgemm(
 			batch_block_size, batch_block_update,
 			grad_output_transform +
@@ -218,6 +260,8 @@ static void compute_convolution_kernel_gradient(
 	const float* input_pointer,
 	const float* grad_output_pointer,
 	float* grad_kernel,
+	bool kernel_update,
+	float scale,
 	float* input_transform,
 	float* grad_output_transform,
 	float* grad_kernel_transform,
@@ -228,7 +272,7 @@ static void compute_convolution_kernel_gradient(
 	struct nnp_profile* profile)
 {
 	const size_t tuple_count = (transform_tile.height * transform_tile.width) / tuple_elements;
-	const float (*input)[input_channels][input_size.height][input_size.height] =
+	const float (*input)[input_channels][input_size.height][input_size.width] =
 		(const float(*)[input_channels][input_size.height][input_size.width]) input_pointer;
 	const float (*grad_output)[output_channels][output_size.height][output_size.width] =
 		(const float(*)[output_channels][output_size.height][output_size.width]) grad_output_pointer;
@@ -307,17 +351,8 @@ static void compute_convolution_kernel_gradient(
 							.grad_kernel_transform = grad_kernel_transform +
 								tuple_index * tuple_elements * output_channels * input_channels,
 						};
-						if (tuple_index == 0) {
-							matrix_multiplication_context.cgemm[0][0] = nnp_s4c6gemmca1x1__fma3;
-							matrix_multiplication_context.cgemm[0][1] = nnp_s4c6gemmca2x1__fma3;
-							matrix_multiplication_context.cgemm[1][0] = nnp_s4c6gemmca1x2__fma3;
-							matrix_multiplication_context.cgemm[1][1] = nnp_s4c6gemmca2x2__fma3;
-						} else {
-							matrix_multiplication_context.cgemm[0][0] = nnp_c8gemmca1x1__fma3;
-							matrix_multiplication_context.cgemm[0][1] = nnp_c8gemmca2x1__fma3;
-							matrix_multiplication_context.cgemm[1][0] = nnp_c8gemmca1x2__fma3;
-							matrix_multiplication_context.cgemm[1][1] = nnp_c8gemmca2x2__fma3;
-						}
+						matrix_multiplication_context.cgemm = (tuple_index == 0 ?
+							nnp_hwinfo.cxgemm.s4cX_conja_functions : nnp_hwinfo.cxgemm.cX_conja_functions);
 						pthreadpool_compute_2d_tiled(threadpool,
 							(pthreadpool_function_2d_tiled_t) compute_complex_matrix_multiplication,
 							&matrix_multiplication_context,
@@ -331,7 +366,7 @@ static void compute_convolution_kernel_gradient(
 			}
 		}
 	}
-	/* Grad kernel transform */
+	/* Grad kernel transform (if kernel_update is set, grad_kernel points to the updated kernel) */
 	NNP_KERNEL_TRANSFORM_START(profile)
 	struct grad_kernel_transform_context grad_kernel_transform_context = {
 		.tuple_elements = tuple_elements,
@@ -339,12 +374,15 @@ static void compute_convolution_kernel_gradient(
 		.output_channels = output_channels,
 		.output_channels_block_max = output_channels_block_max,
 		.kernel_size = kernel_size,
+		.scale = scale,
 		.grad_kernel = grad_kernel,
 		.grad_kernel_transform = grad_kernel_transform,
 		.transform_function = grad_kernel_transform_function,
 	};
 	pthreadpool_compute_2d_tiled(threadpool,
-		(pthreadpool_function_2d_tiled_t) compute_grad_kernel_transform,
+		kernel_update ?
+			(pthreadpool_function_2d_tiled_t) compute_kernel_update_transform :
+			(pthreadpool_function_2d_tiled_t) compute_grad_kernel_transform,
 		&grad_kernel_transform_context,
 		output_channels, input_channels,
 		1,               input_channels_subblock_max);
@@ -352,7 +390,12 @@ static void compute_convolution_kernel_gradient(
 }
 
 
-enum nnp_status nnp_convolution_kernel_gradient(
+/*
+ * If workspace_buffer is NULL, temporary buffers are allocated for the duration of the call.
+ * If kernel_update is true, grad_kernel is not computed: instead scale * grad_kernel is added to the kernel tensor
+ * passed in place of grad_kernel.
+ */
+static enum nnp_status convolution_kernel_gradient(
 	enum nnp_convolution_algorithm algorithm,
 	size_t batch_size,
 	size_t input_channels,
@@ -363,6 +406,10 @@ enum nnp_status nnp_convolution_kernel_gradient(
 	const float* input,
 	const float* grad_output,
 	float* grad_kernel,
+	bool kernel_update,
+	float scale,
+	void* workspace_buffer,
+	size_t* workspace_size,
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile)
 {
@@ -372,7 +419,8 @@ enum nnp_status nnp_convolution_kernel_gradient(
 	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
 	enum nnp_status status = validate_convolution_arguments(
 		batch_size, input_channels, output_channels,
-		input_size, input_padding, kernel_size);
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 });
 	if (status != nnp_status_success) {
 		goto cleanup;
 	}
@@ -409,15 +457,15 @@ enum nnp_status nnp_convolution_kernel_gradient(
 	nnp_transform_2d grad_kernel_transform_function;
 	switch (algorithm) {
 		case nnp_convolution_algorithm_ft8x8:
-			input_transform_function = nnp_fft8x8_and_stream__avx2;
-			grad_output_transform_function = nnp_fft8x8_and_stream__avx2;
-			grad_kernel_transform_function = nnp_ifft8x8__avx2;
+			input_transform_function = nnp_hwinfo.transforms.fft8x8_and_stream;
+			grad_output_transform_function = nnp_hwinfo.transforms.fft8x8_and_stream;
+			grad_kernel_transform_function = nnp_hwinfo.transforms.ifft8x8;
 			transform_tile = (struct nnp_size) { .height = 8, .width = 8 };
 			break;
 		case nnp_convolution_algorithm_ft16x16:
-			input_transform_function = nnp_fft16x16_and_stream__avx2;
-			grad_output_transform_function = nnp_fft16x16_and_stream__avx2;
-			grad_kernel_transform_function = nnp_ifft16x16__avx2;
+			input_transform_function = nnp_hwinfo.transforms.fft16x16_and_stream;
+			grad_output_transform_function = nnp_hwinfo.transforms.fft16x16_and_stream;
+			grad_kernel_transform_function = nnp_hwinfo.transforms.ifft16x16;
 			transform_tile = (struct nnp_size) { .height = 16, .width = 16 };
 			break;
 		case nnp_convolution_algorithm_wt8x8:
@@ -440,7 +488,7 @@ enum nnp_status nnp_convolution_kernel_gradient(
 		goto cleanup;
 	}
 
-	const size_t tuple_elements = 16;
+	const size_t tuple_elements = nnp_hwinfo.simd_width * 2;
 	const size_t transform_tile_elements = transform_tile.height * transform_tile.width;
 
 	/* Calculate cache blocking parameters */
@@ -448,8 +496,8 @@ enum nnp_status nnp_convolution_kernel_gradient(
 	const size_t cache_elements_l2 = nnp_hwinfo.blocking.l2 / (tuple_elements * sizeof(float));
 	const size_t cache_elements_l3 = nnp_hwinfo.blocking.l3 / (tuple_elements * sizeof(float));
 
-	const size_t input_channels_subblock_max = 2;
-	const size_t output_channels_subblock_max = 2;
+	const size_t input_channels_subblock_max = nnp_hwinfo.cxgemm.nr;
+	const size_t output_channels_subblock_max = nnp_hwinfo.cxgemm.mr;
 
 	const size_t batch_block_max =
 		round_down(cache_elements_l1 / (input_channels_subblock_max + output_channels_subblock_max), 2);
@@ -464,10 +512,30 @@ enum nnp_status nnp_convolution_kernel_gradient(
 	const size_t grad_kernel_transform_size = output_channels * input_channels * transform_tile_elements * sizeof(float);
 	const size_t memory_size = input_transform_size + grad_output_transform_size + grad_kernel_transform_size;
 
-	memory_block = allocate_memory(memory_size);
-	if (memory_block == NULL) {
-		status = nnp_status_out_of_memory;
-		goto cleanup;
+	if (workspace_buffer == NULL) {
+		if (workspace_size != NULL) {
+			/* Workspace size query: report the required size and skip the computation */
+			*workspace_size = memory_size;
+			goto cleanup;
+		}
+
+		memory_block = allocate_memory(memory_size);
+		if (memory_block == NULL) {
+			status = nnp_status_out_of_memory;
+			goto cleanup;
+		}
+	} else {
+		if ((workspace_size == NULL) || (*workspace_size < memory_size)) {
+			status = nnp_status_insufficient_buffer;
+			goto cleanup;
+		}
+
+		if (((uintptr_t) workspace_buffer) % 64 != 0) {
+			status = nnp_status_misaligned_buffer;
+			goto cleanup;
+		}
+
+		memory_block = workspace_buffer;
 	}
 
 	float* input_transform = memory_block;
@@ -487,14 +555,88 @@ enum nnp_status nnp_convolution_kernel_gradient(
 		output_channels, output_channels_block_max, output_channels_subblock_max,
 		input_size, input_padding, kernel_size, output_size,
 		transform_tile, output_tile,
-		input, grad_output, grad_kernel,
+		input, grad_output, grad_kernel, kernel_update, scale,
 		input_transform, grad_output_transform, grad_kernel_transform,
 		input_transform_function, grad_output_transform_function, grad_kernel_transform_function,
 		threadpool,
 		profile);
 
 cleanup:
-	release_memory(memory_block, memory_size);
+	if (workspace_buffer == NULL) {
+		release_memory(memory_block, memory_size);
+	}
 	NNP_TOTAL_END(profile)
 	return status;
 }
+
+enum nnp_status nnp_convolution_kernel_gradient(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float* input,
+	const float* grad_output,
+	float* grad_kernel,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_kernel_gradient(
+		algorithm,
+		batch_size, input_channels, output_channels,
+		input_size, input_padding, kernel_size,
+		input, grad_output, grad_kernel, false, 0.0f,
+		NULL, NULL,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_kernel_gradient_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float* input,
+	const float* grad_output,
+	float* grad_kernel,
+	void* workspace_buffer,
+	size_t* workspace_size,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_kernel_gradient(
+		algorithm,
+		batch_size, input_channels, output_channels,
+		input_size, input_padding, kernel_size,
+		input, grad_output, grad_kernel, false, 0.0f,
+		workspace_buffer, workspace_size,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_kernel_update(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float* input,
+	const float* grad_output,
+	float* kernel,
+	float scale,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_kernel_gradient(
+		algorithm,
+		batch_size, input_channels, output_channels,
+		input_size, input_padding, kernel_size,
+		input, grad_output, kernel, true, scale,
+		NULL, NULL,
+		threadpool, profile);
+}
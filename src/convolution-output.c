@@ -12,7 +12,10 @@
 #include <nnpack/hwinfo.h>
 
 #include <nnpack/validation.h>
+#include <nnpack/convolution.h>
 #include <nnpack/transform.h>
+#include <nnpack/transformed-kernel.h>
+#include <nnpack/autotune.h>
 #include <nnpack/blas.h>
 
 
@@ -26,8 +29,10 @@ NNP_CACHE_ALIGN struct kernel_transform_context {
 	size_t input_channels;
 	size_t input_channels_block_max;
 	struct nnp_size kernel_size;
+	struct nnp_size kernel_dilation;
 };
 
+/* Dilated kernels are scattered into a sparse kernel of the dilated size on the stack, and transformed as dense kernels */
 static void compute_kernel_transform(const struct kernel_transform_context context[restrict static 1],
 	size_t input_channel,       size_t output_channels_subblock_start,
 	size_t input_channel_range, size_t output_channels_subblock_size)
@@ -37,6 +42,7 @@ static void compute_kernel_transform(const struct kernel_transform_context conte
 	const size_t input_channels           = context->input_channels;
 	const size_t input_channels_block_max = context->input_channels_block_max;
 	const struct nnp_size kernel_size     = context->kernel_size;
+	const struct nnp_size kernel_dilation = context->kernel_dilation;
 
 	const float (*kernel)[input_channels][kernel_size.width * kernel_size.height] =
 		(const float(*)[input_channels][kernel_size.width * kernel_size.height]) context->kernel;
@@ -47,18 +53,31 @@ static void compute_kernel_transform(const struct kernel_transform_context conte
 	const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
 	const size_t input_channels_block_offset = input_channel - input_channels_block_start;
 
+	const bool dilated = (kernel_dilation.height | kernel_dilation.width) != 1;
+	const struct nnp_size dilated_kernel_size = nnp_convolution_dilated_kernel_size(kernel_size, kernel_dilation);
+	NNP_SIMD_ALIGN float dilated_kernel[dilated_kernel_size.height * dilated_kernel_size.width];
 	for (size_t output_channels_subblock_offset = 0; output_channels_subblock_offset < output_channels_subblock_size; output_channels_subblock_offset += 1) {
 		const size_t output_channel = output_channels_subblock_start + output_channels_subblock_offset;
+		const float* kernel_data = kernel[output_channel][input_channel];
+		if (dilated) {
+			nnp_convolution_dilate_kernel(kernel_data, dilated_kernel, kernel_size, kernel_dilation);
+			kernel_data = dilated_kernel;
+		}
 		transform_function(
-			kernel[output_channel][input_channel],
+			kernel_data,
 			kernel_transform +
 				(input_channels_block_start * output_channels + output_channels_subblock_start * input_channels_block_size + input_channels_block_offset * output_channels_subblock_size + output_channels_subblock_offset) * tuple_elements,
-			kernel_size.width,
+			dilated_kernel_size.width,
 			output_channels * input_channels * tuple_elements * sizeof(float),
-			kernel_size.height, kernel_size.width, 0, 0);
+			dilated_kernel_size.height, dilated_kernel_size.width, 0, 0);
 	}
 }
 
+/*
+ * A block of output tiles is processed as a batch of tile_batch_size = tiles_block_size * batch_size transformed images.
+ * Image tile_image of the tile batch is the sample (tile_image % batch_size) of the tile (tile_image / batch_size),
+ * and tiles are numbered in row-major order from tiles_block_start.
+ */
 NNP_CACHE_ALIGN struct input_transform_context {
 	nnp_transform_2d transform_function;
 	const float* input;
@@ -66,31 +85,40 @@ NNP_CACHE_ALIGN struct input_transform_context {
 
 	size_t tuple_elements;
 	size_t batch_size;
+	size_t tile_batch_size;
 	size_t input_channels;
 	size_t input_channels_block_max;
+	/* Channels of an input image, more than input_channels if the channels are computed in groups */
+	size_t input_image_channels;
 	struct nnp_size input_size;
-	size_t row_offset;
-	size_t row_count;
-	size_t column_offset;
-	size_t column_count;
+	struct nnp_padding input_padding;
+	struct nnp_size output_subsampling;
+	struct nnp_size transform_tile;
+	struct nnp_size output_tile;
+	size_t tiles_x;
+	size_t tiles_block_start;
 };
 
 static void compute_input_transform(const struct input_transform_context context[restrict static 1],
-	size_t input_channel,       size_t batch_subblock_start,
-	size_t input_channel_range, size_t batch_subblock_size)
+	size_t input_channel,       size_t tile_batch_subblock_start,
+	size_t input_channel_range, size_t tile_batch_subblock_size)
 {
-	const size_t tuple_elements           = context->tuple_elements;
-	const size_t batch_size               = context->batch_size;
-	const size_t input_channels           = context->input_channels;
-	const size_t input_channels_block_max = context->input_channels_block_max;
-	const struct nnp_size input_size      = context->input_size;
-	const size_t row_offset               = context->row_offset;
-	const size_t row_count                = context->row_count;
-	const size_t column_offset            = context->column_offset;
-	const size_t column_count             = context->column_count;
-
-	const float (*input)[input_channels][input_size.width * input_size.height] =
-		(const float(*)[input_channels][input_size.width * input_size.height]) context->input;
+	const size_t tuple_elements              = context->tuple_elements;
+	const size_t batch_size                  = context->batch_size;
+	const size_t tile_batch_size             = context->tile_batch_size;
+	const size_t input_channels              = context->input_channels;
+	const size_t input_channels_block_max    = context->input_channels_block_max;
+	const size_t input_image_channels        = context->input_image_channels;
+	const struct nnp_size input_size         = context->input_size;
+	const struct nnp_padding input_padding   = context->input_padding;
+	const struct nnp_size output_subsampling = context->output_subsampling;
+	const struct nnp_size transform_tile     = context->transform_tile;
+	const struct nnp_size output_tile        = context->output_tile;
+	const size_t tiles_x                     = context->tiles_x;
+	const size_t tiles_block_start           = context->tiles_block_start;
+
+	const float (*input)[input_image_channels][input_size.width * input_size.height] =
+		(const float(*)[input_image_channels][input_size.width * input_size.height]) context->input;
 	float* input_transform              = context->input_transform;
 	nnp_transform_2d transform_function = context->transform_function;
 
@@ -98,69 +126,131 @@ static void compute_input_transform(const struct input_transform_context context
 	const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
 	const size_t input_channels_block_offset = input_channel - input_channels_block_start;
 
-	for (size_t batch_subblock_offset = 0; batch_subblock_offset < batch_subblock_size; batch_subblock_offset += 1) {
-		const size_t sample = batch_subblock_start + batch_subblock_offset;
+	for (size_t tile_batch_subblock_offset = 0; tile_batch_subblock_offset < tile_batch_subblock_size; tile_batch_subblock_offset += 1) {
+		const size_t tile_image = tile_batch_subblock_start + tile_batch_subblock_offset;
+		const size_t sample = tile_image % batch_size;
+		const size_t tile = tiles_block_start + tile_image / batch_size;
+
+		/* Tiles are positioned in the space of non-subsampled outputs */
+		const size_t dense_y = (tile / tiles_x) * output_tile.height * output_subsampling.height;
+		const size_t dense_x = (tile % tiles_x) * output_tile.width * output_subsampling.width;
+		const size_t input_y = min(doz(dense_y, input_padding.top), input_size.height);
+		const size_t input_x = min(doz(dense_x, input_padding.left), input_size.width);
+
 		transform_function(
-			input[sample][input_channel],
+			&input[sample][input_channel][input_y * input_size.width + input_x],
 			input_transform +
-				(input_channels_block_start * batch_size + batch_subblock_start * input_channels_block_size + input_channels_block_offset * batch_subblock_size + batch_subblock_offset) * tuple_elements,
+				(input_channels_block_start * tile_batch_size + tile_batch_subblock_start * input_channels_block_size + input_channels_block_offset * tile_batch_subblock_size + tile_batch_subblock_offset) * tuple_elements,
 			input_size.width,
-			batch_size * input_channels * tuple_elements * sizeof(float),
-			row_count, column_count, row_offset, column_offset);
+			tile_batch_size * input_channels * tuple_elements * sizeof(float),
+			min(transform_tile.height, input_size.height - input_y),
+			min(transform_tile.width, input_size.width - input_x),
+			doz(input_padding.top, dense_y),
+			doz(input_padding.left, dense_x));
 	}
 }
 
 NNP_CACHE_ALIGN struct output_transform_context {
 	nnp_transform_2d_with_bias transform_function;
+	/* Replaces transform_function if activation is not NULL */
+	nnp_transform_2d_with_bias_and_activation activation_transform_function;
+	const struct nnp_fused_activation* activation;
 	float* output;
 	const float* output_transform;
 	const float* bias;
 
 	size_t tuple_elements;
 	size_t output_channels;
+	/* Channels of an output image, more than output_channels if the channels are computed in groups */
+	size_t output_image_channels;
 	size_t batch_size;
+	size_t tile_batch_size;
 	size_t batch_block_max;
 	struct nnp_size output_size;
-	size_t row_offset;
-	size_t row_count;
-	size_t column_offset;
-	size_t column_count;
+	struct nnp_size output_subsampling;
+	struct nnp_size transform_tile;
+	struct nnp_size output_tile;
+	size_t tiles_x;
+	size_t tiles_block_start;
 };
 
+static inline void output_transform_tile(const struct output_transform_context context[restrict static 1],
+	const float* transform, float* output, const float* bias,
+	size_t transform_stride, size_t output_stride, size_t row_count, size_t column_count)
+{
+	if (context->activation != NULL) {
+		context->activation_transform_function(transform, output, bias,
+			transform_stride, output_stride, row_count, column_count, context->activation);
+	} else {
+		context->transform_function(transform, output, bias,
+			transform_stride, output_stride, row_count, column_count);
+	}
+}
+
 static void compute_output_transform(const struct output_transform_context context[restrict static 1],
-	size_t sample,       size_t output_channels_subblock_start,
-	size_t sample_range, size_t output_channels_subblock_size)
+	size_t tile_image,       size_t output_channels_subblock_start,
+	size_t tile_image_range, size_t output_channels_subblock_size)
 {
-	const size_t tuple_elements       = context->tuple_elements;
-	const size_t batch_size           = context->batch_size;
-	const size_t output_channels      = context->output_channels;
-	const size_t batch_block_max      = context->batch_block_max;
-	const struct nnp_size output_size = context->output_size;
-	const size_t row_offset           = context->row_offset;
-	const size_t row_count            = context->row_count;
-	const size_t column_offset        = context->column_offset;
-	const size_t column_count         = context->column_count;
-
-	float (*output)[output_channels][output_size.width * output_size.height] =
-		(float(*)[output_channels][output_size.width * output_size.height]) context->output;
-	const float* output_transform                 = context->output_transform;
-	const float* bias                             = context->bias;
-	nnp_transform_2d_with_bias transform_function = context->transform_function;
-
-	const size_t batch_block_start = round_down(sample, batch_block_max);
-	const size_t batch_block_size = min(batch_size - batch_block_start, batch_block_max);
-	const size_t batch_block_offset = sample - batch_block_start;
+	const size_t tuple_elements              = context->tuple_elements;
+	const size_t batch_size                  = context->batch_size;
+	const size_t tile_batch_size             = context->tile_batch_size;
+	const size_t output_channels             = context->output_channels;
+	const size_t output_image_channels       = context->output_image_channels;
+	const size_t batch_block_max             = context->batch_block_max;
+	const struct nnp_size output_size        = context->output_size;
+	const struct nnp_size output_subsampling = context->output_subsampling;
+	const struct nnp_size transform_tile     = context->transform_tile;
+	const struct nnp_size output_tile        = context->output_tile;
+	const size_t tiles_x                     = context->tiles_x;
+	const size_t tiles_block_start           = context->tiles_block_start;
+
+	float (*output)[output_image_channels][output_size.width * output_size.height] =
+		(float(*)[output_image_channels][output_size.width * output_size.height]) context->output;
+	const float* output_transform = context->output_transform;
+	const float* bias             = context->bias;
+
+	const size_t batch_block_start = round_down(tile_image, batch_block_max);
+	const size_t batch_block_size = min(tile_batch_size - batch_block_start, batch_block_max);
+	const size_t batch_block_offset = tile_image - batch_block_start;
+
+	const size_t sample = tile_image % batch_size;
+	const size_t tile = tiles_block_start + tile_image / batch_size;
+	const size_t y = (tile / tiles_x) * output_tile.height;
+	const size_t x = (tile % tiles_x) * output_tile.width;
+	const size_t row_count = min(output_tile.height, output_size.height - y);
+	const size_t column_count = min(output_tile.width, output_size.width - x);
 
+	const bool subsampled = (output_subsampling.height | output_subsampling.width) != 1;
+	NNP_SIMD_ALIGN float block[subsampled ? transform_tile.height * transform_tile.width : 1];
 	for (size_t output_channels_subblock_offset = 0; output_channels_subblock_offset < output_channels_subblock_size; output_channels_subblock_offset += 1) {
 		const size_t output_channel = output_channels_subblock_start + output_channels_subblock_offset;
-		transform_function(
-			output_transform +
-				(batch_block_start * output_channels + output_channels_subblock_start * batch_block_size + batch_block_offset * output_channels_subblock_size + output_channels_subblock_offset) * tuple_elements,
-			output[sample][output_channel],
-			&bias[output_channel],
-			batch_size * output_channels * tuple_elements * sizeof(float),
-			output_size.width,
-			row_count, column_count);
+		const float* output_transform_tuple = output_transform +
+			(batch_block_start * output_channels + output_channels_subblock_start * batch_block_size + batch_block_offset * output_channels_subblock_size + output_channels_subblock_offset) * tuple_elements;
+		float* output_tile_pointer = &output[sample][output_channel][y * output_size.width + x];
+		if (subsampled) {
+			/* Inverse transform produces a dense block of outputs, only every output_subsampling-th of them is stored */
+			output_transform_tile(context,
+				output_transform_tuple,
+				block,
+				&bias[output_channel],
+				tile_batch_size * output_channels * tuple_elements * sizeof(float),
+				transform_tile.width,
+				(row_count - 1) * output_subsampling.height + 1,
+				(column_count - 1) * output_subsampling.width + 1);
+			nnp_store_subsampled_tile(
+				block, transform_tile.width,
+				output_tile_pointer, output_size.width,
+				row_count, column_count,
+				output_subsampling);
+		} else {
+			output_transform_tile(context,
+				output_transform_tuple,
+				output_tile_pointer,
+				&bias[output_channel],
+				tile_batch_size * output_channels * tuple_elements * sizeof(float),
+				output_size.width,
+				row_count, column_count);
+		}
 	}
 }
 
@@ -176,8 +266,8 @@ NNP_CACHE_ALIGN struct matrix_multiplication_context {
 	float* output_transform;
 
 	union {
-		nnp_tuple_gemm_function cgemm[2][2];
-		nnp_tuple_gemm_function sgemm[3][4];
+		nnp_tuple_gemm_function (*cgemm)[3];
+		nnp_tuple_gemm_function (*sgemm)[6];
 	};
 };
 
@@ -261,175 +351,233 @@ static void compute_convolution_output(
 	size_t batch_subblock_max,
 	size_t input_channels,
 	size_t input_channels_block_max,
+	size_t input_image_channels,
 	size_t output_channels,
 	size_t output_channels_block_max,
 	size_t output_channels_subblock_max,
+	size_t output_image_channels,
+	size_t tiles_block_max,
 	struct nnp_size input_size,
 	struct nnp_padding input_padding,
-	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
 	struct nnp_size output_size,
 	struct nnp_size transform_tile,
 	struct nnp_size output_tile,
-	const float* input_pointer,
-	const float* kernel,
+	const float* input,
 	const float* bias,
-	float* output_pointer,
+	float* output,
 	float* input_transform,
-	float* kernel_transform,
+	const float* kernel_transform,
 	float* output_transform,
 	nnp_transform_2d input_transform_function,
-	nnp_transform_2d kernel_transform_function,
 	nnp_transform_2d_with_bias output_transform_function,
+	nnp_transform_2d_with_bias_and_activation output_activation_transform_function,
+	const struct nnp_fused_activation* activation,
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile)
 {
 	const size_t tuple_count = (transform_tile.height * transform_tile.width) / tuple_elements;
-	const float (*input)[input_channels][input_size.width * input_size.height] =
-		(const float(*)[input_channels][input_size.width * input_size.height]) input_pointer;
-	float (*output)[output_channels][output_size.width * output_size.height] =
-		(float(*)[output_channels][output_size.width * output_size.height]) output_pointer;
-
-	NNP_KERNEL_TRANSFORM_START(profile)
-	struct kernel_transform_context kernel_transform_context = {
-		.transform_function = kernel_transform_function,
-		.kernel = kernel,
-		.kernel_transform = kernel_transform,
-		.tuple_elements = tuple_elements,
-		.output_channels = output_channels,
-		.input_channels = input_channels,
-		.input_channels_block_max = input_channels_block_max,
-		.kernel_size = kernel_size,
-	};
-	pthreadpool_compute_2d_tiled(threadpool,
-		(pthreadpool_function_2d_tiled_t) compute_kernel_transform,
-		&kernel_transform_context,
-		input_channels, output_channels,
-		1,              output_channels_subblock_max);
-	NNP_KERNEL_TRANSFORM_END(profile)
-
-	for (size_t y = 0; y < output_size.height; y += output_tile.height) {
-		const size_t input_y = min(doz(y, input_padding.top), input_size.height);
-		for (size_t x = 0; x < output_size.width; x += output_tile.width) {
-			const size_t input_x = min(doz(x, input_padding.left), input_size.width);
-
-			NNP_INPUT_TRANSFORM_START(profile)
-			struct input_transform_context input_transform_context = {
-				.transform_function = input_transform_function,
-				.input = &input[0][0][input_y * input_size.width + input_x],
-				.input_transform = input_transform,
-				.tuple_elements = tuple_elements,
-				.batch_size = batch_size,
-				.input_channels = input_channels,
-				.input_channels_block_max = input_channels_block_max,
-				.input_size = input_size,
-				.row_offset = doz(input_padding.top, y),
-				.row_count = min(transform_tile.height, input_size.height - input_y),
-				.column_offset = doz(input_padding.left, x),
-				.column_count = min(transform_tile.width, input_size.width - input_x),
-			};
-			pthreadpool_compute_2d_tiled(threadpool,
-				(pthreadpool_function_2d_tiled_t) compute_input_transform,
-				&input_transform_context,
-				input_channels, batch_size,
-				1, batch_subblock_max);
-			NNP_INPUT_TRANSFORM_END(profile)
-
-			NNP_BLOCK_MULTIPLICATION_START(profile)
-			for (size_t tuple_index = 0; tuple_index < tuple_count; tuple_index += 1) {
-				for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
-					const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
-					for (size_t batch_block_start = 0; batch_block_start < batch_size; batch_block_start += batch_block_max) {
-						const size_t batch_block_size = min(batch_size - batch_block_start, batch_block_max);
-						struct matrix_multiplication_context matrix_multiplication_context = {
-							.tuple_elements = tuple_elements,
-							.batch_block_size = batch_block_size,
-							.input_channels_block_start = input_channels_block_start,
-							.input_channels_block_size = input_channels_block_size,
-							.output_channels_subblock_max = output_channels_subblock_max,
-							.input_transform = input_transform +
-								tuple_index * tuple_elements * batch_size * input_channels +
-								input_channels_block_start * batch_size * tuple_elements +
-								batch_block_start * input_channels_block_size * tuple_elements,
-							.kernel_transform = kernel_transform +
-								tuple_index * tuple_elements * output_channels * input_channels +
-								input_channels_block_start * output_channels * tuple_elements,
-							.output_transform = output_transform + tuple_index * tuple_elements * batch_size * output_channels +
-								batch_block_start * output_channels * tuple_elements,
-						};
-						if (fourier_transform) {
-							if (tuple_index == 0) {
-								matrix_multiplication_context.cgemm[0][0] = nnp_s4c6gemmcb1x1__fma3;
-								matrix_multiplication_context.cgemm[0][1] = nnp_s4c6gemmcb1x2__fma3;
-								matrix_multiplication_context.cgemm[1][0] = nnp_s4c6gemmcb2x1__fma3;
-								matrix_multiplication_context.cgemm[1][1] = nnp_s4c6gemmcb2x2__fma3;
-							} else {
-								matrix_multiplication_context.cgemm[0][0] = nnp_c8gemmcb1x1__fma3;
-								matrix_multiplication_context.cgemm[0][1] = nnp_c8gemmcb1x2__fma3;
-								matrix_multiplication_context.cgemm[1][0] = nnp_c8gemmcb2x1__fma3;
-								matrix_multiplication_context.cgemm[1][1] = nnp_c8gemmcb2x2__fma3;
-							}
-						} else {
-							matrix_multiplication_context.sgemm[0][0] = nnp_s8gemm1x1__fma3;
-							matrix_multiplication_context.sgemm[0][1] = nnp_s8gemm1x2__fma3;
-							matrix_multiplication_context.sgemm[0][2] = nnp_s8gemm1x3__fma3;
-							matrix_multiplication_context.sgemm[0][3] = nnp_s8gemm1x4__fma3;
-							matrix_multiplication_context.sgemm[1][0] = nnp_s8gemm2x1__fma3;
-							matrix_multiplication_context.sgemm[1][1] = nnp_s8gemm2x2__fma3;
-							matrix_multiplication_context.sgemm[1][2] = nnp_s8gemm2x3__fma3;
-							matrix_multiplication_context.sgemm[1][3] = nnp_s8gemm2x4__fma3;
-							matrix_multiplication_context.sgemm[2][0] = nnp_s8gemm3x1__fma3;
-							matrix_multiplication_context.sgemm[2][1] = nnp_s8gemm3x2__fma3;
-							matrix_multiplication_context.sgemm[2][2] = nnp_s8gemm3x3__fma3;
-							matrix_multiplication_context.sgemm[2][3] = nnp_s8gemm3x4__fma3;
-						}
-						pthreadpool_compute_2d_tiled(threadpool,
-							(pthreadpool_function_2d_tiled_t) (fourier_transform ?
-								compute_complex_matrix_multiplication :
-								compute_real_matrix_multiplication),
-							&matrix_multiplication_context,
-							output_channels,          batch_block_size,
-							output_channels_block_max, batch_subblock_max);
+	const size_t tiles_x = divide_round_up(output_size.width, output_tile.width);
+	const size_t tiles_count = divide_round_up(output_size.height, output_tile.height) * tiles_x;
+
+	/* Every block of tiles takes one parallel region per phase */
+	for (size_t tiles_block_start = 0; tiles_block_start < tiles_count; tiles_block_start += tiles_block_max) {
+		const size_t tiles_block_size = min(tiles_count - tiles_block_start, tiles_block_max);
+		const size_t tile_batch_size = tiles_block_size * batch_size;
+
+		NNP_INPUT_TRANSFORM_START(profile)
+		struct input_transform_context input_transform_context = {
+			.transform_function = input_transform_function,
+			.input = input,
+			.input_transform = input_transform,
+			.tuple_elements = tuple_elements,
+			.batch_size = batch_size,
+			.tile_batch_size = tile_batch_size,
+			.input_channels = input_channels,
+			.input_channels_block_max = input_channels_block_max,
+			.input_image_channels = input_image_channels,
+			.input_size = input_size,
+			.input_padding = input_padding,
+			.output_subsampling = output_subsampling,
+			.transform_tile = transform_tile,
+			.output_tile = output_tile,
+			.tiles_x = tiles_x,
+			.tiles_block_start = tiles_block_start,
+		};
+		pthreadpool_compute_2d_tiled(threadpool,
+			(pthreadpool_function_2d_tiled_t) compute_input_transform,
+			&input_transform_context,
+			input_channels, tile_batch_size,
+			1,              batch_subblock_max);
+		NNP_INPUT_TRANSFORM_END(profile)
+
+		NNP_BLOCK_MULTIPLICATION_START(profile)
+		for (size_t tuple_index = 0; tuple_index < tuple_count; tuple_index += 1) {
+			for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
+				const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
+				for (size_t batch_block_start = 0; batch_block_start < tile_batch_size; batch_block_start += batch_block_max) {
+					const size_t batch_block_size = min(tile_batch_size - batch_block_start, batch_block_max);
+					struct matrix_multiplication_context matrix_multiplication_context = {
+						.tuple_elements = tuple_elements,
+						.batch_block_size = batch_block_size,
+						.input_channels_block_start = input_channels_block_start,
+						.input_channels_block_size = input_channels_block_size,
+						.output_channels_subblock_max = output_channels_subblock_max,
+						.input_transform = input_transform +
+							tuple_index * tuple_elements * tile_batch_size * input_channels +
+							input_channels_block_start * tile_batch_size * tuple_elements +
+							batch_block_start * input_channels_block_size * tuple_elements,
+						.kernel_transform = kernel_transform +
+							tuple_index * tuple_elements * output_channels * input_channels +
+							input_channels_block_start * output_channels * tuple_elements,
+						.output_transform = output_transform + tuple_index * tuple_elements * tile_batch_size * output_channels +
+							batch_block_start * output_channels * tuple_elements,
+					};
+					if (fourier_transform) {
+						matrix_multiplication_context.cgemm = (tuple_index == 0 ?
+							nnp_hwinfo.cxgemm.s4cX_conjb_functions : nnp_hwinfo.cxgemm.cX_conjb_functions);
+					} else {
+						matrix_multiplication_context.sgemm = nnp_hwinfo.sxgemm.functions;
 					}
+					pthreadpool_compute_2d_tiled(threadpool,
+						(pthreadpool_function_2d_tiled_t) (fourier_transform ?
+							compute_complex_matrix_multiplication :
+							compute_real_matrix_multiplication),
+						&matrix_multiplication_context,
+						output_channels,          batch_block_size,
+						output_channels_block_max, batch_subblock_max);
 				}
 			}
-			NNP_BLOCK_MULTIPLICATION_END(profile)
-
-			NNP_OUTPUT_TRANSFORM_START(profile)
-			struct output_transform_context output_transform_context = {
-				.transform_function = output_transform_function,
-				.output = &output[0][0][y * output_size.width + x],
-				.output_transform = output_transform,
-				.bias = bias,
-				.tuple_elements = tuple_elements,
-				.output_channels = output_channels,
-				.batch_size = batch_size,
-				.batch_block_max = batch_block_max,
-				.output_size = output_size,
-				.row_count = min(output_tile.height, output_size.height - y),
-				.column_count = min(output_tile.width, output_size.width - x),
-			};
-			pthreadpool_compute_2d_tiled(threadpool,
-				(pthreadpool_function_2d_tiled_t) compute_output_transform,
-				&output_transform_context,
-				batch_size, output_channels,
-				1,          output_channels_subblock_max);
-			NNP_OUTPUT_TRANSFORM_END(profile)
 		}
+		NNP_BLOCK_MULTIPLICATION_END(profile)
+
+		NNP_OUTPUT_TRANSFORM_START(profile)
+		struct output_transform_context output_transform_context = {
+			.transform_function = output_transform_function,
+			.activation_transform_function = output_activation_transform_function,
+			.activation = activation,
+			.output = output,
+			.output_transform = output_transform,
+			.bias = bias,
+			.tuple_elements = tuple_elements,
+			.output_channels = output_channels,
+			.output_image_channels = output_image_channels,
+			.batch_size = batch_size,
+			.tile_batch_size = tile_batch_size,
+			.batch_block_max = batch_block_max,
+			.output_size = output_size,
+			.output_subsampling = output_subsampling,
+			.transform_tile = transform_tile,
+			.output_tile = output_tile,
+			.tiles_x = tiles_x,
+			.tiles_block_start = tiles_block_start,
+		};
+		pthreadpool_compute_2d_tiled(threadpool,
+			(pthreadpool_function_2d_tiled_t) compute_output_transform,
+			&output_transform_context,
+			tile_batch_size, output_channels,
+			1,               output_channels_subblock_max);
+		NNP_OUTPUT_TRANSFORM_END(profile)
 	}
 }
 
-enum nnp_status nnp_convolution_output(
+/*
+ * Cache blocking of the tiled algorithms. Block sizes follow the capacity of caches available to the threads, and
+ * non-zero fields of a per-layer override replace them. The transformed kernel, if precomputed, fixes the block of
+ * input channels, and the other blocks are derived from it.
+ */
+static struct nnp_convolution_blocking choose_blocking(
+	const struct nnp_autotune_key* layer_key,
+	bool fourier_transform,
+	const struct nnp_transformed_kernel* transformed_kernel)
+{
+	const size_t simd_width = nnp_hwinfo.simd_width;
+	const size_t tuple_elements = (fourier_transform ? simd_width * 2 : simd_width);
+	const struct cache_blocking_info cache_blocking = nnp_cache_blocking(layer_key->threads);
+	const size_t cache_elements_l1 = cache_blocking.l1 / (tuple_elements * sizeof(float));
+	const size_t cache_elements_l2 = cache_blocking.l2 / (tuple_elements * sizeof(float));
+	const size_t cache_elements_l3 = cache_blocking.l3 / (tuple_elements * sizeof(float));
+
+	const size_t batch_subblock_max = (fourier_transform ? nnp_hwinfo.cxgemm.mr : nnp_hwinfo.sxgemm.mr);
+	const size_t output_channels_subblock_max = (fourier_transform ? nnp_hwinfo.cxgemm.nr : nnp_hwinfo.sxgemm.nr);
+
+	struct nnp_convolution_blocking blocking_override = { 0 };
+	nnp_autotune_lookup_blocking(layer_key, &blocking_override);
+
+	size_t input_channels_block =
+		max(round_down(cache_elements_l1 / (batch_subblock_max + output_channels_subblock_max), 2), 2);
+	if (transformed_kernel != NULL) {
+		/* Coefficients are laid out with the blocking recorded in the kernel transform */
+		input_channels_block = transformed_kernel->input_channels_block_max;
+	} else if (blocking_override.input_channels_block != 0) {
+		input_channels_block = blocking_override.input_channels_block;
+	}
+
+	size_t batch_block = cache_elements_l3 / input_channels_block;
+	if (blocking_override.batch_block != 0) {
+		batch_block = blocking_override.batch_block;
+	}
+	size_t output_channels_block = cache_elements_l2 / input_channels_block;
+	if (blocking_override.output_channels_block != 0) {
+		output_channels_block = blocking_override.output_channels_block;
+	}
+
+	return (struct nnp_convolution_blocking) {
+		.input_channels_block = input_channels_block,
+		.batch_block = max(round_down(batch_block, batch_subblock_max), batch_subblock_max),
+		.output_channels_block =
+			max(round_down(output_channels_block, output_channels_subblock_max), output_channels_subblock_max),
+	};
+}
+
+/* Arguments of convolution_output which stay the same while auto-tuning measures the algorithms */
+struct convolution_output_autotune_context {
+	size_t batch_size;
+	size_t input_channels;
+	size_t output_channels;
+	struct nnp_size input_size;
+	struct nnp_padding input_padding;
+	struct nnp_size kernel_size;
+	struct nnp_size output_subsampling;
+	const float* input;
+	const float* kernel;
+	const float* bias;
+	float* output;
+	enum nnp_activation activation;
+	const void* activation_parameters;
+	pthreadpool_t threadpool;
+};
+
+static enum nnp_status autotune_convolution_output(
+	const struct convolution_output_autotune_context* context,
+	enum nnp_convolution_algorithm algorithm,
+	void* workspace_buffer, size_t* workspace_size);
+
+/*
+ * Exactly one of kernel and transformed_kernel must be non-NULL, and transformed_kernel implies groups == 1.
+ * Kernel dilation other than 1x1 implies groups == 1 and no transformed_kernel.
+ * If workspace_buffer is NULL, temporary buffers are allocated for the duration of the call.
+ */
+static enum nnp_status convolution_output(
 	enum nnp_convolution_algorithm algorithm,
 	size_t batch_size,
+	size_t groups,
 	size_t input_channels,
 	size_t output_channels,
 	struct nnp_size input_size,
 	struct nnp_padding input_padding,
 	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
 	const float input[],
 	const float kernel[],
+	const struct nnp_transformed_kernel* transformed_kernel,
 	const float bias[],
 	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile)
 {
@@ -439,61 +587,159 @@ enum nnp_status nnp_convolution_output(
 	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
 	enum nnp_status status = validate_convolution_arguments(
 		batch_size, input_channels, output_channels,
-		input_size, input_padding, kernel_size);
+		input_size, input_padding, kernel_size, kernel_dilation, output_subsampling);
+	if (status != nnp_status_success) {
+		goto cleanup;
+	}
+
+	status = validate_convolution_groups(groups, input_channels, output_channels);
+	if (status != nnp_status_success) {
+		goto cleanup;
+	}
+
+	status = validate_activation(activation, activation_parameters);
 	if (status != nnp_status_success) {
 		goto cleanup;
 	}
+	struct nnp_fused_activation fused_activation;
+	if (activation != nnp_activation_identity) {
+		fused_activation = nnp_fused_activation_init(activation, activation_parameters);
+	}
+	const struct nnp_fused_activation* output_activation =
+		(activation != nnp_activation_identity ? &fused_activation : NULL);
+
+	const bool dilated = (kernel_dilation.height | kernel_dilation.width) != 1;
+	const struct nnp_size dilated_kernel_size = nnp_convolution_dilated_kernel_size(kernel_size, kernel_dilation);
+	const struct nnp_size output_size =
+		nnp_convolution_output_size(input_size, input_padding, dilated_kernel_size, output_subsampling);
+	const size_t group_input_channels = input_channels / groups;
+	const size_t group_output_channels = output_channels / groups;
+
+	/* Precomputed kernel transform determines the algorithm */
+	if (transformed_kernel != NULL) {
+		status = validate_transformed_kernel(transformed_kernel,
+			algorithm, nnp_convolution_kernel_transform_layout_output,
+			input_channels, output_channels, kernel_size);
+		if (status != nnp_status_success) {
+			goto cleanup;
+		}
+		algorithm = (enum nnp_convolution_algorithm) transformed_kernel->algorithm;
+	}
 
-	const struct nnp_size output_size = {
-		.width = input_padding.left + input_size.width + input_padding.right - kernel_size.width + 1,
-		.height = input_padding.top + input_size.height + input_padding.bottom - kernel_size.height + 1
+	/*
+	 * Layer parameters which auto-tuning results and blocking overrides are keyed by. Groups are computed one by one,
+	 * and the blocking of a group is the blocking of a convolution with the channels of the group. Transforms of a
+	 * dilated kernel are blocked as transforms of a dense kernel of the dilated size.
+	 */
+	const struct nnp_autotune_key layer_key = {
+		.operation = nnp_autotune_operation_convolution_output,
+		.threads = (threadpool != NULL ? pthreadpool_get_threads_count(threadpool) : 1),
+		.batch_size = batch_size,
+		.input_channels = group_input_channels,
+		.output_channels = group_output_channels,
+		.input_size = input_size,
+		.input_padding = input_padding,
+		.kernel_size = dilated_kernel_size,
+		.output_subsampling = output_subsampling,
 	};
 
-	/* If requested, choose optimal convolution algorithm */
-	if (algorithm == nnp_convolution_algorithm_auto) {
-		if (max(kernel_size.width, kernel_size.height) > 8) {
-			algorithm = nnp_convolution_algorithm_ft16x16;
-		} else {
-			const size_t tile_count_8x8 =
-				divide_round_up(output_size.height, 8 - kernel_size.height + 1) *
-				divide_round_up(output_size.width, 8 - kernel_size.width + 1);
-			const size_t tile_count_16x16 =
-				divide_round_up(output_size.height, 16 - kernel_size.height + 1) *
-				divide_round_up(output_size.width, 16 - kernel_size.width + 1);
-			if (tile_count_8x8 <= 4 * tile_count_16x16) {
-				/* 8x8 tiles are more efficient */
-				algorithm = nnp_convolution_algorithm_ft8x8;
-			} else {
-				algorithm = nnp_convolution_algorithm_ft16x16;
+	/* If auto-tuning is enabled, choose the algorithm which was measured to be the fastest for this layer */
+	if ((algorithm == nnp_convolution_algorithm_auto) && (groups == 1) && !dilated && nnp_autotune_enabled()) {
+		algorithm = nnp_autotune_lookup(&layer_key);
+		if (algorithm == nnp_convolution_algorithm_auto) {
+			struct convolution_output_autotune_context autotune_context = {
+				.batch_size = batch_size,
+				.input_channels = input_channels,
+				.output_channels = output_channels,
+				.input_size = input_size,
+				.input_padding = input_padding,
+				.kernel_size = kernel_size,
+				.output_subsampling = output_subsampling,
+				.input = input,
+				.kernel = kernel,
+				.bias = bias,
+				.output = output,
+				.activation = activation,
+				.activation_parameters = activation_parameters,
+				.threadpool = threadpool,
+			};
+			if ((workspace_buffer == NULL) && (workspace_size != NULL)) {
+				/* Workspace size query: until the layer is measured, the workspace must fit any algorithm */
+				status = nnp_autotune_workspace_size(
+					(nnp_autotune_function) autotune_convolution_output, &autotune_context,
+					workspace_size);
+				goto cleanup;
 			}
+			/* Measurements overwrite the output, and the layer is then computed again with the fastest algorithm */
+			algorithm = nnp_autotune_measure(&layer_key,
+				(nnp_autotune_function) autotune_convolution_output, &autotune_context,
+				workspace_buffer, workspace_size);
 		}
 	}
 
+	/* Depthwise convolution has no reduction over channels to amortize transforms, and is computed directly */
+	if ((algorithm == nnp_convolution_algorithm_auto) && (groups > 1) && (group_input_channels == 1)) {
+		status = nnp_convolution_depthwise(
+			batch_size, input_channels, output_channels,
+			input_size, input_padding, kernel_size, output_subsampling,
+			input, kernel, bias, output,
+			workspace_buffer, workspace_size,
+			output_activation,
+			threadpool, profile);
+		goto cleanup;
+	}
+
+	/* If requested, choose optimal convolution algorithm */
+	if (algorithm == nnp_convolution_algorithm_auto) {
+		algorithm = nnp_convolution_select_algorithm(batch_size, group_input_channels, group_output_channels,
+			kernel_size, kernel_dilation, output_subsampling, output_size, false);
+	}
+
+	if (algorithm == nnp_convolution_algorithm_implicit_gemm) {
+		status = nnp_convolution_implicit_gemm(
+			batch_size, groups, input_channels, output_channels,
+			input_size, input_padding, kernel_size, kernel_dilation, output_subsampling,
+			input, kernel, bias, output,
+			workspace_buffer, workspace_size,
+			output_activation,
+			threadpool, profile);
+		goto cleanup;
+	}
+
 	/* Choose tiling parameters and transform functions depending on convolution algorithm */
 	struct nnp_size transform_tile;
 	bool fourier_transform;
 	nnp_transform_2d input_transform_function;
 	nnp_transform_2d kernel_transform_function;
 	nnp_transform_2d_with_bias output_transform_function;
+	nnp_transform_2d_with_bias_and_activation output_activation_transform_function;
 	switch (algorithm) {
 		case nnp_convolution_algorithm_ft8x8:
-			kernel_transform_function = nnp_fft8x8_and_stream__avx2;
-			input_transform_function = nnp_fft8x8_and_stream__avx2;
-			output_transform_function = nnp_ifft8x8_with_bias__avx2;
+			kernel_transform_function = nnp_hwinfo.transforms.fft8x8_and_stream;
+			input_transform_function = nnp_hwinfo.transforms.fft8x8_and_stream;
+			output_transform_function = nnp_hwinfo.transforms.ifft8x8_with_bias;
+			output_activation_transform_function = nnp_hwinfo.transforms.ifft8x8_with_bias_activation;
 			transform_tile = (struct nnp_size) { .height = 8, .width = 8 };
 			fourier_transform = true;
 			break;
 		case nnp_convolution_algorithm_ft16x16:
-			kernel_transform_function = nnp_fft16x16_and_stream__avx2;
-			input_transform_function = nnp_fft16x16_and_stream__avx2;
-			output_transform_function = nnp_ifft16x16_with_bias__avx2;
+			kernel_transform_function = nnp_hwinfo.transforms.fft16x16_and_stream;
+			input_transform_function = nnp_hwinfo.transforms.fft16x16_and_stream;
+			output_transform_function = nnp_hwinfo.transforms.ifft16x16_with_bias;
+			output_activation_transform_function = nnp_hwinfo.transforms.ifft16x16_with_bias_activation;
 			transform_tile = (struct nnp_size) { .height = 16, .width = 16 };
 			fourier_transform = true;
 			break;
 		case nnp_convolution_algorithm_wt8x8:
-			kernel_transform_function = nnp_kwt8x8_3x3_and_stream__avx2;
-			input_transform_function = nnp_iwt8x8_3x3_and_stream__avx2;
-			output_transform_function = nnp_owt8x8_3x3_with_bias__avx2;
+			/* Winograd transform is specific to dense 3x3 kernels */
+			if (dilated) {
+				status = nnp_status_unsupported_algorithm;
+				goto cleanup;
+			}
+			kernel_transform_function = nnp_hwinfo.transforms.kwt_f6x6_3x3_and_stream;
+			input_transform_function = nnp_hwinfo.transforms.iwt_f6x6_3x3_and_stream;
+			output_transform_function = nnp_hwinfo.transforms.owt_f6x6_3x3_with_bias;
+			output_activation_transform_function = nnp_hwinfo.transforms.owt_f6x6_3x3_with_bias_activation;
 			transform_tile = (struct nnp_size) { .height = 8, .width = 8 };
 			fourier_transform = false;
 			break;
@@ -505,67 +751,481 @@ enum nnp_status nnp_convolution_output(
 	}
 
 	/* Detect incompatibilities between kernel size and algorithm */
-	if ((kernel_size.height > transform_tile.height) || (kernel_size.width > transform_tile.width)) {
+	if ((dilated_kernel_size.height > transform_tile.height) || (dilated_kernel_size.width > transform_tile.width)) {
 		status = nnp_status_unsupported_kernel_size;
 		goto cleanup;
 	}
 
-	const size_t simd_width = 8;
+	const size_t simd_width = nnp_hwinfo.simd_width;
 	const size_t tuple_elements = (fourier_transform ? simd_width * 2 : simd_width);
 	const size_t transform_tile_elements = transform_tile.height * transform_tile.width;
 
-	/* Calculate memory footprint and allocate memory */
-	const size_t kernel_transform_size = output_channels * input_channels * transform_tile_elements * sizeof(float);
-	const size_t input_transform_size = batch_size * input_channels * transform_tile_elements * sizeof(float);
-	const size_t output_transform_size = batch_size * output_channels * transform_tile_elements * sizeof(float);
+	/* Calculate cache blocking parameters */
+	const struct nnp_convolution_blocking blocking = choose_blocking(&layer_key, fourier_transform, transformed_kernel);
+	const size_t input_channels_block_max = blocking.input_channels_block;
+	const size_t batch_block_max = blocking.batch_block;
+	const size_t output_channels_block_max = blocking.output_channels_block;
+	const size_t batch_subblock_max = (fourier_transform ? nnp_hwinfo.cxgemm.mr : nnp_hwinfo.sxgemm.mr);
+	const size_t output_channels_subblock_max = (fourier_transform ? nnp_hwinfo.cxgemm.nr : nnp_hwinfo.sxgemm.nr);
+
+	const struct nnp_size output_tile = {
+		.height = divide_round_up(transform_tile.height - dilated_kernel_size.height + 1, output_subsampling.height),
+		.width = divide_round_up(transform_tile.width - dilated_kernel_size.width + 1, output_subsampling.width)
+	};
+	const size_t tiles_count =
+		divide_round_up(output_size.height, output_tile.height) * divide_round_up(output_size.width, output_tile.width);
+
+	/*
+	 * A batch smaller than a cache block would leave the matrix multiplication with few rows, and cost three or more
+	 * parallel regions per tile. Instead, tiles are grouped so that their images fill a block of the batch.
+	 */
+	const size_t tiles_block_max = min(max(batch_block_max / batch_size, 1), tiles_count);
+
+	/* Calculate memory footprint and allocate memory. Groups are computed one by one and reuse the buffers. */
+	const size_t kernel_transform_size = (transformed_kernel != NULL ? 0 :
+		group_output_channels * group_input_channels * transform_tile_elements * sizeof(float));
+	const size_t input_transform_size =
+		tiles_block_max * batch_size * group_input_channels * transform_tile_elements * sizeof(float);
+	const size_t output_transform_size =
+		tiles_block_max * batch_size * group_output_channels * transform_tile_elements * sizeof(float);
 	const size_t memory_size = kernel_transform_size + input_transform_size + output_transform_size;
 
-	memory_block = allocate_memory(memory_size);
-	if (memory_block == NULL) {
-		status = nnp_status_out_of_memory;
-		goto cleanup;
+	if (workspace_buffer == NULL) {
+		if (workspace_size != NULL) {
+			/* Workspace size query: report the required size and skip the computation */
+			*workspace_size = memory_size;
+			goto cleanup;
+		}
+
+		memory_block = allocate_memory(memory_size);
+		if (memory_block == NULL) {
+			status = nnp_status_out_of_memory;
+			goto cleanup;
+		}
+	} else {
+		if ((workspace_size == NULL) || (*workspace_size < memory_size)) {
+			status = nnp_status_insufficient_buffer;
+			goto cleanup;
+		}
+
+		if (((uintptr_t) workspace_buffer) % 64 != 0) {
+			status = nnp_status_misaligned_buffer;
+			goto cleanup;
+		}
+
+		memory_block = workspace_buffer;
 	}
 
 	float* input_transform = memory_block;
 	float* kernel_transform = memory_block + input_transform_size;
 	float* output_transform = memory_block + input_transform_size + kernel_transform_size;
 
-	/* Calculate cache blocking parameters */
-	const size_t cache_elements_l1 = nnp_hwinfo.blocking.l1 / (tuple_elements * sizeof(float));
-	const size_t cache_elements_l2 = nnp_hwinfo.blocking.l2 / (tuple_elements * sizeof(float));
-	const size_t cache_elements_l3 = nnp_hwinfo.blocking.l3 / (tuple_elements * sizeof(float));
+	const size_t input_pixels = input_size.height * input_size.width;
+	const size_t output_pixels = output_size.height * output_size.width;
+	const size_t kernel_elements = kernel_size.height * kernel_size.width;
+	for (size_t group = 0; group < groups; group++) {
+		if (transformed_kernel == NULL) {
+			NNP_KERNEL_TRANSFORM_START(profile)
+			struct kernel_transform_context kernel_transform_context = {
+				.transform_function = kernel_transform_function,
+				.kernel = kernel + group * group_output_channels * group_input_channels * kernel_elements,
+				.kernel_transform = kernel_transform,
+				.tuple_elements = tuple_elements,
+				.output_channels = group_output_channels,
+				.input_channels = group_input_channels,
+				.input_channels_block_max = input_channels_block_max,
+				.kernel_size = kernel_size,
+				.kernel_dilation = kernel_dilation,
+			};
+			pthreadpool_compute_2d_tiled(threadpool,
+				(pthreadpool_function_2d_tiled_t) compute_kernel_transform,
+				&kernel_transform_context,
+				group_input_channels, group_output_channels,
+				1,                    output_channels_subblock_max);
+			NNP_KERNEL_TRANSFORM_END(profile)
+		}
 
-	const size_t batch_subblock_max = (fourier_transform ? 2 : 3);
-	const size_t output_channels_subblock_max = (fourier_transform ? 2 : 4);
+		compute_convolution_output(
+			fourier_transform, tuple_elements,
+			batch_size, batch_block_max, batch_subblock_max,
+			group_input_channels, input_channels_block_max, input_channels,
+			group_output_channels, output_channels_block_max, output_channels_subblock_max, output_channels,
+			tiles_block_max,
+			input_size, input_padding, output_subsampling, output_size,
+			transform_tile, output_tile,
+			input + group * group_input_channels * input_pixels,
+			bias + group * group_output_channels,
+			output + group * group_output_channels * output_pixels,
+			input_transform,
+			(transformed_kernel != NULL ? nnp_transformed_kernel_data(transformed_kernel) : kernel_transform),
+			output_transform,
+			input_transform_function, output_transform_function, output_activation_transform_function,
+			output_activation,
+			threadpool,
+			profile);
+	}
 
-	const size_t input_channels_block_max =
-		round_down(cache_elements_l1 / (batch_subblock_max + output_channels_subblock_max), 2);
-	const size_t batch_block_max =
-		round_down(cache_elements_l3 / input_channels_block_max, batch_subblock_max);
-	const size_t output_channels_block_max =
-		round_down(cache_elements_l2 / input_channels_block_max, output_channels_subblock_max);
+cleanup:
+	if (workspace_buffer == NULL) {
+		release_memory(memory_block, memory_size);
+	}
+	NNP_TOTAL_END(profile)
+	return status;
+}
 
-	/* Calculate remaining parameters and do the computation */
-	const struct nnp_size output_tile = {
-		.height = transform_tile.height - kernel_size.height + 1,
-		.width = transform_tile.width - kernel_size.width + 1
+static enum nnp_status autotune_convolution_output(
+	const struct convolution_output_autotune_context* context,
+	enum nnp_convolution_algorithm algorithm,
+	void* workspace_buffer, size_t* workspace_size)
+{
+	return convolution_output(
+		algorithm,
+		context->batch_size, 1, context->input_channels, context->output_channels,
+		context->input_size, context->input_padding,
+		context->kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, context->output_subsampling,
+		context->input, context->kernel, NULL, context->bias, context->output,
+		workspace_buffer, workspace_size,
+		context->activation, context->activation_parameters,
+		context->threadpool, NULL);
+}
+
+enum nnp_status nnp_convolution_output(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_output(
+		algorithm,
+		batch_size, 1, input_channels, output_channels,
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 },
+		input, kernel, NULL, bias, output,
+		NULL, NULL,
+		nnp_activation_identity, NULL,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_output_with_activation(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_output(
+		algorithm,
+		batch_size, 1, input_channels, output_channels,
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 },
+		input, kernel, NULL, bias, output,
+		NULL, NULL,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_output_precomputed(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const void* transformed_kernel,
+	const float bias[],
+	float output[],
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	if (transformed_kernel == NULL) {
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	return convolution_output(
+		algorithm,
+		batch_size, 1, input_channels, output_channels,
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 },
+		input, NULL, transformed_kernel, bias, output,
+		NULL, NULL,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_output_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_output(
+		algorithm,
+		batch_size, 1, input_channels, output_channels,
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 },
+		input, kernel, NULL, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_output_precomputed_with_workspace(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	const float input[],
+	const void* transformed_kernel,
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	if (transformed_kernel == NULL) {
+		return nnp_status_invalid_transformed_kernel;
+	}
+
+	return convolution_output(
+		algorithm,
+		batch_size, 1, input_channels, output_channels,
+		input_size, input_padding,
+		kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, (struct nnp_size) { .height = 1, .width = 1 },
+		input, NULL, transformed_kernel, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_output_strided(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_output(
+		algorithm,
+		batch_size, 1, input_channels, output_channels,
+		input_size, input_padding, kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, output_subsampling,
+		input, kernel, NULL, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_output_grouped(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t groups,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_output(
+		algorithm,
+		batch_size, groups, input_channels, output_channels,
+		input_size, input_padding, kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, output_subsampling,
+		input, kernel, NULL, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_output_dilated(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
+	const float input[],
+	const float kernel[],
+	const float bias[],
+	float output[],
+	void* workspace_buffer,
+	size_t* workspace_size,
+	enum nnp_activation activation,
+	const void* activation_parameters,
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	return convolution_output(
+		algorithm,
+		batch_size, 1, input_channels, output_channels,
+		input_size, input_padding, kernel_size, kernel_dilation, output_subsampling,
+		input, kernel, NULL, bias, output,
+		workspace_buffer, workspace_size,
+		activation, activation_parameters,
+		threadpool, profile);
+}
+
+enum nnp_status nnp_convolution_output_blocking(
+	enum nnp_convolution_algorithm algorithm,
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	pthreadpool_t threadpool,
+	struct nnp_convolution_blocking* blocking)
+{
+	const enum nnp_status status = validate_convolution_arguments(
+		batch_size, input_channels, output_channels,
+		input_size, input_padding, kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, output_subsampling);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	const struct nnp_autotune_key layer_key = {
+		.operation = nnp_autotune_operation_convolution_output,
+		.threads = (threadpool != NULL ? pthreadpool_get_threads_count(threadpool) : 1),
+		.batch_size = batch_size,
+		.input_channels = input_channels,
+		.output_channels = output_channels,
+		.input_size = input_size,
+		.input_padding = input_padding,
+		.kernel_size = kernel_size,
+		.output_subsampling = output_subsampling,
 	};
 
-	compute_convolution_output(
-		fourier_transform, tuple_elements,
-		batch_size, batch_block_max,batch_subblock_max,
-		input_channels, input_channels_block_max,
-		output_channels, output_channels_block_max, output_channels_subblock_max,
-		input_size, input_padding, kernel_size, output_size,
-		transform_tile, output_tile,
-		input, kernel, bias, output,
-		input_transform, kernel_transform, output_transform,
-		input_transform_function, kernel_transform_function, output_transform_function,
-		threadpool,
-		profile);
+	/* Resolve nnp_convolution_algorithm_auto as convolution_output would, but without measurements */
+	if ((algorithm == nnp_convolution_algorithm_auto) && nnp_autotune_enabled()) {
+		algorithm = nnp_autotune_lookup(&layer_key);
+	}
+	if (algorithm == nnp_convolution_algorithm_auto) {
+		const struct nnp_size output_size =
+			nnp_convolution_output_size(input_size, input_padding, kernel_size, output_subsampling);
+		algorithm = nnp_convolution_select_algorithm(batch_size, input_channels, output_channels,
+			kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, output_subsampling, output_size, false);
+	}
 
-cleanup:
-	release_memory(memory_block, memory_size);
-	NNP_TOTAL_END(profile)
-	return status;
+	struct nnp_size transform_tile;
+	bool fourier_transform;
+	switch (algorithm) {
+		case nnp_convolution_algorithm_ft8x8:
+			transform_tile = (struct nnp_size) { .height = 8, .width = 8 };
+			fourier_transform = true;
+			break;
+		case nnp_convolution_algorithm_ft16x16:
+			transform_tile = (struct nnp_size) { .height = 16, .width = 16 };
+			fourier_transform = true;
+			break;
+		case nnp_convolution_algorithm_wt8x8:
+			transform_tile = (struct nnp_size) { .height = 8, .width = 8 };
+			fourier_transform = false;
+			break;
+		default:
+			return nnp_status_unsupported_algorithm;
+	}
+
+	if ((kernel_size.height > transform_tile.height) || (kernel_size.width > transform_tile.width)) {
+		return nnp_status_unsupported_kernel_size;
+	}
+
+	*blocking = choose_blocking(&layer_key, fourier_transform, NULL);
+	return nnp_status_success;
+}
+
+enum nnp_status nnp_convolution_output_set_blocking(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size kernel_size,
+	struct nnp_size output_subsampling,
+	const struct nnp_convolution_blocking* blocking)
+{
+	const enum nnp_status status = validate_convolution_arguments(
+		batch_size, input_channels, output_channels,
+		input_size, input_padding, kernel_size, (struct nnp_size) { .height = 1, .width = 1 }, output_subsampling);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	const struct nnp_autotune_key layer_key = {
+		.operation = nnp_autotune_operation_convolution_output,
+		.batch_size = batch_size,
+		.input_channels = input_channels,
+		.output_channels = output_channels,
+		.input_size = input_size,
+		.input_padding = input_padding,
+		.kernel_size = kernel_size,
+		.output_subsampling = output_subsampling,
+	};
+	return nnp_autotune_set_blocking(&layer_key, blocking);
 }
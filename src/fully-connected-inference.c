@@ -9,6 +9,7 @@
 #include <nnpack/system.h>
 #include <nnpack/utils.h>
 #include <nnpack/simd.h>
+#include <nnpack/hwinfo.h>
 
 #include <nnpack/validation.h>
 #include <nnpack/blas.h>
@@ -18,7 +19,7 @@ struct NNP_CACHE_ALIGN fully_connected_inference_context {
 	const float* input;
 	const float* kernel;
 	float* output;
-	nnp_sdotxf_function sdotxf[8];
+	const nnp_sdotxf_function* sdotxf;
 };
 
 static void compute_fully_connected_inference(
@@ -34,6 +35,190 @@ static void compute_fully_connected_inference(
 	sdotxf(input, &kernel[output_channels_subblock_start * input_channels], input_channels, &output[output_channels_subblock_start], input_channels);
 }
 
+/*
+ * Packed input matrix is split into blocks of input channels. Within a block, each subblock of batch_subblock_max
+ * input vectors is stored as input_channels_block_size rows of batch_subblock_max elements, as the sgemm micro-kernels
+ * expect. The whole minibatch fits into one block of the batch dimension.
+ */
+struct NNP_CACHE_ALIGN input_packing_context {
+	const float* input;
+	float* packed_input;
+	size_t batch_size;
+	size_t batch_subblock_max;
+	size_t input_channels;
+};
+
+static void pack_input(
+	const struct input_packing_context context[restrict static 1],
+	size_t input_channels_block_start, size_t input_channels_block_size)
+{
+	const float* input              = context->input;
+	float* packed_input             = context->packed_input;
+	const size_t batch_size         = context->batch_size;
+	const size_t batch_subblock_max = context->batch_subblock_max;
+	const size_t input_channels     = context->input_channels;
+
+	const size_t batch_stride = round_up(batch_size, batch_subblock_max);
+	float* packed_block = packed_input + input_channels_block_start * batch_stride;
+	for (size_t sample = 0; sample < batch_size; sample++) {
+		const size_t batch_subblock_start = round_down(sample, batch_subblock_max);
+		const size_t batch_subblock_offset = sample - batch_subblock_start;
+		for (size_t input_channels_block_offset = 0; input_channels_block_offset < input_channels_block_size; input_channels_block_offset++) {
+			packed_block[batch_subblock_start * input_channels_block_size + input_channels_block_offset * batch_subblock_max + batch_subblock_offset] =
+				input[sample * input_channels + input_channels_block_start + input_channels_block_offset];
+		}
+	}
+}
+
+/*
+ * Each task computes one register block of output channels for the whole minibatch. The task packs the rows of the
+ * kernel matrix block by block of input channels, and multiplies every packed block by all input vectors while it is in
+ * L1 cache, so the kernel matrix is read from memory only once for the minibatch.
+ */
+struct NNP_CACHE_ALIGN batch_inference_context {
+	const float* packed_input;
+	const float* kernel;
+	float* output;
+	float* packed_kernel;
+	size_t batch_size;
+	size_t batch_subblock_max;
+	size_t input_channels;
+	size_t input_channels_block_max;
+	size_t output_channels;
+	size_t simd_width;
+	const uint32_t* column_mask;
+	nnp_sgemm_function (*sgemm_functions)[3];
+};
+
+static void compute_batch_inference(
+	const struct batch_inference_context context[restrict static 1],
+	size_t output_channels_subblock_start, size_t output_channels_subblock_size)
+{
+	const float* packed_input             = context->packed_input;
+	const float* kernel                   = context->kernel;
+	float* output                         = context->output;
+	const size_t batch_size               = context->batch_size;
+	const size_t batch_subblock_max       = context->batch_subblock_max;
+	const size_t input_channels           = context->input_channels;
+	const size_t input_channels_block_max = context->input_channels_block_max;
+	const size_t output_channels          = context->output_channels;
+	const size_t simd_width               = context->simd_width;
+	const uint32_t* column_mask           = context->column_mask + ((-output_channels_subblock_size) & (simd_width - 1));
+	const size_t sgemm_index              = (output_channels_subblock_size - 1) / simd_width;
+
+	/* Tasks start at multiples of the register block of output channels, so their parts of the buffer do not overlap */
+	float* packed_kernel = context->packed_kernel + output_channels_subblock_start * input_channels_block_max;
+	const size_t output_channels_subblock_max = nnp_hwinfo.sgemm.nr;
+	const size_t batch_stride = round_up(batch_size, batch_subblock_max);
+
+	for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
+		const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
+
+		for (size_t input_channels_block_offset = 0; input_channels_block_offset < input_channels_block_size; input_channels_block_offset++) {
+			for (size_t output_channels_subblock_offset = 0; output_channels_subblock_offset < output_channels_subblock_size; output_channels_subblock_offset++) {
+				packed_kernel[input_channels_block_offset * output_channels_subblock_max + output_channels_subblock_offset] =
+					kernel[(output_channels_subblock_start + output_channels_subblock_offset) * input_channels + input_channels_block_start + input_channels_block_offset];
+			}
+		}
+
+		const float* packed_input_block = packed_input + input_channels_block_start * batch_stride;
+		for (size_t batch_subblock_start = 0; batch_subblock_start < batch_size; batch_subblock_start += batch_subblock_max) {
+			const size_t batch_subblock_size = min(batch_size - batch_subblock_start, batch_subblock_max);
+			context->sgemm_functions[batch_subblock_size - 1][sgemm_index](
+				input_channels_block_size, input_channels_block_start,
+				&packed_input_block[batch_subblock_start * input_channels_block_size],
+				packed_kernel,
+				&output[batch_subblock_start * output_channels + output_channels_subblock_start],
+				output_channels,
+				column_mask);
+		}
+	}
+}
+
+enum nnp_status nnp_fully_connected_inference_batch(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input[],
+	const float kernel[],
+	float output[],
+	pthreadpool_t threadpool)
+{
+	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
+	enum nnp_status status = validate_fully_connected_arguments(batch_size, input_channels, output_channels);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	if (batch_size == 1) {
+		return nnp_fully_connected_inference(input_channels, output_channels, input, kernel, output, threadpool);
+	}
+
+	const size_t simd_width = nnp_hwinfo.simd_width;
+	const size_t batch_subblock_max = nnp_hwinfo.sgemm.mr;
+	const size_t output_channels_subblock_max = nnp_hwinfo.sgemm.nr;
+
+	/* A block of packed kernel and a subblock of packed input share L1 cache. Even block size keeps packed blocks SIMD-aligned. */
+	const size_t cache_elements_l1 = nnp_hwinfo.blocking.l1 / sizeof(float);
+	const size_t input_channels_block_max = max(round_down(cache_elements_l1 / (batch_subblock_max + output_channels_subblock_max), 2), 2);
+
+	/* Calculate memory footprint and allocate memory */
+	const size_t packed_input_size = round_up(batch_size, batch_subblock_max) * input_channels * sizeof(float);
+	/* Extra alignment on 64 is needed to ensure that packed_kernel is always SIMD-aligned */
+	const size_t packed_kernel_offset = round_up(packed_input_size, 64);
+	const size_t packed_kernel_size = round_up(output_channels, output_channels_subblock_max) * input_channels_block_max * sizeof(float);
+	const size_t memory_size = packed_kernel_offset + packed_kernel_size;
+
+	void* memory_block = allocate_memory(memory_size);
+	if (memory_block == NULL) {
+		return nnp_status_out_of_memory;
+	}
+
+	float* packed_input = memory_block;
+	float* packed_kernel = memory_block + packed_kernel_offset;
+
+	/* Do the computation */
+	struct input_packing_context input_packing_context = {
+		.input = input,
+		.packed_input = packed_input,
+		.batch_size = batch_size,
+		.batch_subblock_max = batch_subblock_max,
+		.input_channels = input_channels,
+	};
+	pthreadpool_compute_1d_tiled(threadpool,
+		(pthreadpool_function_1d_tiled_t) pack_input,
+		&input_packing_context,
+		input_channels, input_channels_block_max);
+
+	/* From entry 16 - simd_width on, simd_width ones are followed by simd_width zeros, for any simd_width up to 16 */
+	NNP_SIMD_ALIGN const uint32_t column_mask[32] = {
+		UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+		UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	};
+	struct batch_inference_context batch_inference_context = {
+		.packed_input = packed_input,
+		.kernel = kernel,
+		.output = output,
+		.packed_kernel = packed_kernel,
+		.batch_size = batch_size,
+		.batch_subblock_max = batch_subblock_max,
+		.input_channels = input_channels,
+		.input_channels_block_max = input_channels_block_max,
+		.output_channels = output_channels,
+		.simd_width = simd_width,
+		.column_mask = &column_mask[16 - simd_width],
+		.sgemm_functions = nnp_hwinfo.sgemm.functions,
+	};
+	pthreadpool_compute_1d_tiled(threadpool,
+		(pthreadpool_function_1d_tiled_t) compute_batch_inference,
+		&batch_inference_context,
+		output_channels, output_channels_subblock_max);
+
+	release_memory(memory_block, memory_size);
+	return nnp_status_success;
+}
+
 enum nnp_status nnp_fully_connected_inference(
 	size_t input_channels,
 	size_t output_channels,
@@ -55,16 +240,7 @@ enum nnp_status nnp_fully_connected_inference(
 		.input = input,
 		.kernel = kernel,
 		.output = output,
-		.sdotxf = {
-			[0] = nnp_sdotxf1__avx2,
-			[1] = nnp_sdotxf2__avx2,
-			[2] = nnp_sdotxf3__avx2,
-			[3] = nnp_sdotxf4__avx2,
-			[4] = nnp_sdotxf5__avx2,
-			[5] = nnp_sdotxf6__avx2,
-			[6] = nnp_sdotxf7__avx2,
-			[7] = nnp_sdotxf8__avx2,
-		},
+		.sdotxf = nnp_hwinfo.sdotxf.functions,
 	};
 	pthreadpool_compute_1d_tiled(threadpool,
 		(pthreadpool_function_1d_tiled_t) compute_fully_connected_inference,
@@ -9,16 +9,25 @@
 #include <nnpack/system.h>
 #include <nnpack/utils.h>
 #include <nnpack/simd.h>
+#include <nnpack/hwinfo.h>
 
 #include <nnpack/validation.h>
+#include <nnpack/packed-kernel.h>
 #include <nnpack/blas.h>
 
+/*
+ * Packing functions read element [outer][input_channel] of the source matrix at
+ * outer * outer_stride + input_channel * input_channel_stride, thus the same code packs
+ * both row-major matrices (as in forward propagation) and transposed matrices (as in backward propagation).
+ */
 struct NNP_CACHE_ALIGN input_packing_context {
 	const float* matrix;
 	float* packed_matrix;
 
 	size_t input_channels;
 	size_t outer_subblock_max;
+	size_t outer_stride;
+	size_t input_channel_stride;
 };
 
 static void pack_input_matrix(
@@ -30,6 +39,8 @@ static void pack_input_matrix(
 	float* packed_matrix            = context->packed_matrix;
 	const size_t input_channels     = context->input_channels;
 	const size_t outer_subblock_max = context->outer_subblock_max;
+	const size_t outer_stride         = context->outer_stride;
+	const size_t input_channel_stride = context->input_channel_stride;
 
 	const size_t outer_block_stride = round_up(outer_block_size, outer_subblock_max);
 
@@ -38,7 +49,7 @@ static void pack_input_matrix(
 		for (size_t input_channels_block_offset = 0; input_channels_block_offset < input_channels_block_size; input_channels_block_offset += 1) {
 			const size_t input_channel = input_channels_block_start + input_channels_block_offset;
 			for (size_t outer_subblock_offset = 0; outer_subblock_offset < outer_subblock_size; outer_subblock_offset += 1) {
-				const size_t index = (outer_block_start + outer_subblock_start + outer_subblock_offset) * input_channels + input_channel;
+				const size_t index = (outer_block_start + outer_subblock_start + outer_subblock_offset) * outer_stride + input_channel * input_channel_stride;
 				const size_t packed_index = outer_block_start * input_channels + input_channels_block_start * outer_block_stride +
 					outer_subblock_start * input_channels_block_size + input_channels_block_offset * outer_subblock_max + outer_subblock_offset;
 				packed_matrix[packed_index] = matrix[index];
@@ -51,8 +62,9 @@ struct NNP_CACHE_ALIGN kernel_packing_context {
 	const float* matrix;
 	float* packed_matrix;
 
-	size_t input_channels;
 	size_t outer_subblock_max;
+	size_t outer_stride;
+	size_t input_channel_stride;
 	size_t input_channels_block_start;
 	size_t input_channels_block_size;
 };
@@ -63,10 +75,11 @@ static void pack_kernel_matrix(
 {
 	const float* matrix                    = context->matrix;
 	float* packed_matrix                   = context->packed_matrix;
-	const size_t input_channels            = context->input_channels;
 	const size_t outer_subblock_max        = context->outer_subblock_max;
 	const size_t input_channels_block_start = context->input_channels_block_start;
 	const size_t input_channels_block_size  = context->input_channels_block_size;
+	const size_t outer_stride               = context->outer_stride;
+	const size_t input_channel_stride       = context->input_channel_stride;
 
 	const size_t outer_block_stride = round_up(outer_block_size, outer_subblock_max);
 
@@ -75,7 +88,7 @@ static void pack_kernel_matrix(
 		for (size_t input_channels_block_offset = 0; input_channels_block_offset < input_channels_block_size; input_channels_block_offset += 1) {
 			const size_t input_channel = input_channels_block_start + input_channels_block_offset;
 			for (size_t outer_subblock_offset = 0; outer_subblock_offset < outer_subblock_size; outer_subblock_offset += 1) {
-				const size_t index = (outer_block_start + outer_subblock_start + outer_subblock_offset) * input_channels + input_channel;
+				const size_t index = (outer_block_start + outer_subblock_start + outer_subblock_offset) * outer_stride + input_channel * input_channel_stride;
 				const size_t packed_index = (outer_block_start + outer_subblock_start) * input_channels_block_size +
 					input_channels_block_offset * outer_subblock_max + outer_subblock_offset;
 				packed_matrix[packed_index] = matrix[index];
@@ -98,7 +111,7 @@ struct NNP_CACHE_ALIGN matrix_multiplication_context {
 	size_t batch_subblock_max;
 	size_t simd_width;
 	const uint32_t* column_mask;
-	nnp_sgemm_function sgemm_functions[4][3];
+	nnp_sgemm_function (*sgemm_functions)[3];
 };
 
 static void compute_matrix_multiplication(
@@ -146,7 +159,10 @@ static void compute_fully_connected_output(
 	size_t output_channels,
 	size_t output_channels_block_max,
 	size_t output_channels_subblock_max,
-	const float* input,	const float* kernel, float* output,
+	const float* input, size_t input_outer_stride, size_t input_channel_stride,
+	const float* kernel, size_t kernel_outer_stride, size_t kernel_channel_stride,
+	const float* prepacked_kernel,
+	float* output,
 	float* packed_input, float* packed_kernel,
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile)
@@ -157,6 +173,8 @@ static void compute_fully_connected_output(
 		.packed_matrix = packed_input,
 		.input_channels = input_channels,
 		.outer_subblock_max = batch_subblock_max,
+		.outer_stride = input_outer_stride,
+		.input_channel_stride = input_channel_stride,
 	};
 	pthreadpool_compute_2d_tiled(threadpool,
 		(pthreadpool_function_2d_tiled_t) pack_input_matrix,
@@ -165,57 +183,49 @@ static void compute_fully_connected_output(
 		batch_block_max, input_channels_block_max);
 	NNP_INPUT_TRANSFORM_END(profile)
 
-	NNP_SIMD_ALIGN const uint32_t column_mask[16] = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, 0, 0, 0, 0, 0, 0, 0, 0 };
+	/* From entry 16 - simd_width on, simd_width ones are followed by simd_width zeros, for any simd_width up to 16 */
+	NNP_SIMD_ALIGN const uint32_t column_mask[32] = {
+		UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+		UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	};
 	struct matrix_multiplication_context matrix_multiplication_context = {
 		.input = packed_input,
-		.kernel = packed_kernel,
 		.output = output,
 		.input_channels = input_channels,
 		.output_channels = output_channels,
 		.output_channels_subblock_max = output_channels_subblock_max,
 		.batch_subblock_max = batch_subblock_max,
 		.simd_width = simd_width,
-		.column_mask = column_mask,
-		.sgemm_functions = {
-			[0] = {
-				[0] = nnp_sgemm_1x8__fma3,
-				[1] = nnp_sgemm_1x16__fma3,
-				[2] = nnp_sgemm_1x24__fma3,
-			},
-			[1] = {
-				[0] = nnp_sgemm_2x8__fma3,
-				[1] = nnp_sgemm_2x16__fma3,
-				[2] = nnp_sgemm_2x24__fma3,
-			},
-			[2] = {
-				[0] = nnp_sgemm_3x8__fma3,
-				[1] = nnp_sgemm_3x16__fma3,
-				[2] = nnp_sgemm_3x24__fma3,
-			},
-			[3] = {
-				[0] = nnp_sgemm_4x8__fma3,
-				[1] = nnp_sgemm_4x16__fma3,
-				[2] = nnp_sgemm_4x24__fma3,
-			},
-		},
+		.column_mask = &column_mask[16 - simd_width],
+		.sgemm_functions = nnp_hwinfo.sgemm.functions,
 	};
 	for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
 		const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
 
-		NNP_KERNEL_TRANSFORM_START(profile)
-		struct kernel_packing_context kernel_packing_context = {
-			.matrix = kernel,
-			.packed_matrix = packed_kernel,
-			.input_channels = input_channels,
-			.outer_subblock_max = output_channels_subblock_max,
-			.input_channels_block_start = input_channels_block_start,
-			.input_channels_block_size = input_channels_block_size,
-		};
-		pthreadpool_compute_1d_tiled(threadpool,
-			(pthreadpool_function_1d_tiled_t) pack_kernel_matrix,
-			&kernel_packing_context,
-			output_channels, output_channels_block_max);
-		NNP_KERNEL_TRANSFORM_END(profile)
+		if (prepacked_kernel != NULL) {
+			/* Blocks of input channels in a prepacked kernel follow each other */
+			matrix_multiplication_context.kernel =
+				prepacked_kernel + input_channels_block_start * round_up(output_channels, output_channels_subblock_max);
+		} else {
+			NNP_KERNEL_TRANSFORM_START(profile)
+			struct kernel_packing_context kernel_packing_context = {
+				.matrix = kernel,
+				.packed_matrix = packed_kernel,
+				.outer_subblock_max = output_channels_subblock_max,
+				.outer_stride = kernel_outer_stride,
+				.input_channel_stride = kernel_channel_stride,
+				.input_channels_block_start = input_channels_block_start,
+				.input_channels_block_size = input_channels_block_size,
+			};
+			pthreadpool_compute_1d_tiled(threadpool,
+				(pthreadpool_function_1d_tiled_t) pack_kernel_matrix,
+				&kernel_packing_context,
+				output_channels, output_channels_block_max);
+			NNP_KERNEL_TRANSFORM_END(profile)
+
+			matrix_multiplication_context.kernel = packed_kernel;
+		}
 
 		NNP_BLOCK_MULTIPLICATION_START(profile)
 		matrix_multiplication_context.input_channels_block_start = input_channels_block_start;
@@ -235,34 +245,41 @@ static void compute_fully_connected_output(
 	}
 }
 
-enum nnp_status nnp_fully_connected_output(
+/* A block of packed kernel and a subblock of packed input share L1 cache */
+static size_t default_input_channels_block_max(void) {
+	const size_t cache_elements_l1 = nnp_hwinfo.blocking.l1 / sizeof(float);
+	return cache_elements_l1 / (nnp_hwinfo.sgemm.mr + nnp_hwinfo.sgemm.nr);
+}
+
+/*
+ * Computes output[batch_size][output_channels] = input * transpose(kernel), where the input matrix is either
+ * input[batch_size][input_channels] or, if input_transposed is true, input[input_channels][batch_size], and the kernel
+ * matrix is either kernel[output_channels][input_channels] or, if kernel_transposed is true,
+ * kernel[input_channels][output_channels]. Backward propagation maps onto the same blocked product with
+ * different roles of the dimensions. If prepacked_kernel is not NULL, the kernel matrix is taken from it instead,
+ * and input channels are blocked as in the prepacked kernel.
+ */
+static enum nnp_status compute_fully_connected_product(
 	size_t batch_size,
 	size_t input_channels,
 	size_t output_channels,
-	const float input[],
-	const float kernel[],
+	const float input[], bool input_transposed,
+	const float kernel[], bool kernel_transposed,
+	const struct nnp_packed_kernel* prepacked_kernel,
 	float output[],
 	pthreadpool_t threadpool,
 	struct nnp_profile* profile)
 {
-	void* memory_block = NULL;
-	NNP_TOTAL_START(profile)
+	/* Register blocking of the sgemm micro-kernels, whose column variants step by simd_width */
+	const size_t simd_width = nnp_hwinfo.simd_width;
+	const size_t batch_subblock_max = nnp_hwinfo.sgemm.mr;
+	const size_t output_channels_subblock_max = nnp_hwinfo.sgemm.nr;
 
-	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
-	enum nnp_status status = validate_fully_connected_arguments(batch_size, input_channels, output_channels);
-	if (status != nnp_status_success) {
-		goto cleanup;
-	}
-
-	const size_t cache_elements_l1 = nnp_hwinfo.blocking.l1 / sizeof(float);
 	const size_t cache_elements_l2 = nnp_hwinfo.blocking.l2 / sizeof(float);
 	const size_t cache_elements_l3 = nnp_hwinfo.blocking.l3 / sizeof(float);
 
-	const size_t simd_width = 8;
-	const size_t batch_subblock_max = 4;
-	const size_t output_channels_subblock_max = 24;
-
-	const size_t input_channels_block_max = cache_elements_l1 / (batch_subblock_max + output_channels_subblock_max);
+	const size_t input_channels_block_max = (prepacked_kernel != NULL) ?
+		prepacked_kernel->input_channels_block_max : default_input_channels_block_max();
 	const size_t batch_block_max = round_down(cache_elements_l3 / input_channels_block_max, batch_subblock_max);
 	const size_t output_channels_block_max = round_down(cache_elements_l2 / input_channels_block_max, output_channels_subblock_max);
 
@@ -270,13 +287,13 @@ enum nnp_status nnp_fully_connected_output(
 	const size_t packed_input_size = round_up(batch_size, batch_subblock_max) * input_channels * sizeof(float);
 	/* Extra alignment on 64 is needed to ensure that packed_kernel is always SIMD-aligned */
 	const size_t packed_kernel_offset = round_up(packed_input_size, 64);
-	const size_t packed_kernel_size = round_up(output_channels, output_channels_subblock_max) * input_channels_block_max * sizeof(float);
+	const size_t packed_kernel_size = (prepacked_kernel != NULL) ? 0 :
+		round_up(output_channels, output_channels_subblock_max) * input_channels_block_max * sizeof(float);
 	const size_t memory_size = packed_kernel_offset + packed_kernel_size;
 
-	memory_block = allocate_memory(memory_size);
+	void* memory_block = allocate_memory(memory_size);
 	if (memory_block == NULL) {
-		status = nnp_status_out_of_memory;
-		goto cleanup;
+		return nnp_status_out_of_memory;
 	}
 
 	float* packed_input = memory_block;
@@ -288,13 +305,209 @@ enum nnp_status nnp_fully_connected_output(
 		batch_size, batch_block_max, batch_subblock_max,
 		input_channels, input_channels_block_max,
 		output_channels, output_channels_block_max, output_channels_subblock_max,
-		input, kernel, output,
+		input,
+			input_transposed ? 1 : input_channels,
+			input_transposed ? batch_size : 1,
+		kernel,
+			kernel_transposed ? 1 : input_channels,
+			kernel_transposed ? output_channels : 1,
+		(prepacked_kernel != NULL) ? nnp_packed_kernel_data(prepacked_kernel) : NULL,
+		output,
 		packed_input, packed_kernel,
 		threadpool,
 		profile);
 
-cleanup:
 	release_memory(memory_block, memory_size);
+	return nnp_status_success;
+}
+
+enum nnp_status nnp_fully_connected_output(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input[],
+	const float kernel[],
+	float output[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	NNP_TOTAL_START(profile)
+
+	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
+	enum nnp_status status = validate_fully_connected_arguments(batch_size, input_channels, output_channels);
+	if (status == nnp_status_success) {
+		status = compute_fully_connected_product(
+			batch_size, input_channels, output_channels,
+			input, false,
+			kernel, false,
+			NULL,
+			output,
+			threadpool, profile);
+	}
+
+	NNP_TOTAL_END(profile)
+	return status;
+}
+
+enum nnp_status nnp_fully_connected_input_gradient(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float grad_output[],
+	const float kernel[],
+	float grad_input[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	NNP_TOTAL_START(profile)
+
+	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
+	enum nnp_status status = validate_fully_connected_arguments(batch_size, input_channels, output_channels);
+	if (status == nnp_status_success) {
+		/* grad_input[batch_size][input_channels] = grad_output[batch_size][output_channels] * kernel[output_channels][input_channels] */
+		status = compute_fully_connected_product(
+			batch_size, output_channels, input_channels,
+			grad_output, false,
+			kernel, true,
+			NULL,
+			grad_input,
+			threadpool, profile);
+	}
+
+	NNP_TOTAL_END(profile)
+	return status;
+}
+
+enum nnp_status nnp_fully_connected_kernel_gradient(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input[],
+	const float grad_output[],
+	float grad_kernel[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	NNP_TOTAL_START(profile)
+
+	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
+	enum nnp_status status = validate_fully_connected_arguments(batch_size, input_channels, output_channels);
+	if (status == nnp_status_success) {
+		/* grad_kernel[output_channels][input_channels] = transpose(grad_output[batch_size][output_channels]) * input[batch_size][input_channels] */
+		status = compute_fully_connected_product(
+			output_channels, batch_size, input_channels,
+			grad_output, true,
+			input, true,
+			NULL,
+			grad_kernel,
+			threadpool, profile);
+	}
+
+	NNP_TOTAL_END(profile)
+	return status;
+}
+
+enum nnp_status nnp_fully_connected_packed_kernel_size(
+	size_t input_channels,
+	size_t output_channels,
+	size_t* packed_kernel_size)
+{
+	enum nnp_status status = validate_fully_connected_arguments(1, input_channels, output_channels);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	*packed_kernel_size = sizeof(struct nnp_packed_kernel) +
+		round_up(output_channels, nnp_hwinfo.sgemm.nr) * input_channels * sizeof(float);
+	return nnp_status_success;
+}
+
+enum nnp_status nnp_fully_connected_pack_kernel(
+	size_t input_channels,
+	size_t output_channels,
+	const float kernel[],
+	void* packed_kernel,
+	size_t packed_kernel_size,
+	pthreadpool_t threadpool)
+{
+	enum nnp_status status = validate_fully_connected_arguments(1, input_channels, output_channels);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	const size_t output_channels_subblock_max = nnp_hwinfo.sgemm.nr;
+	if (packed_kernel_size < sizeof(struct nnp_packed_kernel) + round_up(output_channels, output_channels_subblock_max) * input_channels * sizeof(float)) {
+		return nnp_status_insufficient_buffer;
+	}
+
+	if (((uintptr_t) packed_kernel) % sizeof(struct nnp_packed_kernel) != 0) {
+		return nnp_status_misaligned_buffer;
+	}
+
+	/* Blocking must match the one in compute_fully_connected_product */
+	const size_t input_channels_block_max = default_input_channels_block_max();
+	const size_t output_channels_block_max =
+		round_down(nnp_hwinfo.blocking.l2 / sizeof(float) / input_channels_block_max, output_channels_subblock_max);
+
+	struct nnp_packed_kernel* header = packed_kernel;
+	*header = (struct nnp_packed_kernel) {
+		.magic = NNP_PACKED_KERNEL_MAGIC,
+		.version = NNP_PACKED_KERNEL_VERSION,
+		.input_channels = input_channels,
+		.output_channels = output_channels,
+		.input_channels_block_max = input_channels_block_max,
+		.output_channels_subblock_max = output_channels_subblock_max,
+	};
+
+	float* packed_matrix = (float*) (header + 1);
+	for (size_t input_channels_block_start = 0; input_channels_block_start < input_channels; input_channels_block_start += input_channels_block_max) {
+		const size_t input_channels_block_size = min(input_channels - input_channels_block_start, input_channels_block_max);
+
+		struct kernel_packing_context kernel_packing_context = {
+			.matrix = kernel,
+			.packed_matrix = packed_matrix + input_channels_block_start * round_up(output_channels, output_channels_subblock_max),
+			.outer_subblock_max = output_channels_subblock_max,
+			.outer_stride = input_channels,
+			.input_channel_stride = 1,
+			.input_channels_block_start = input_channels_block_start,
+			.input_channels_block_size = input_channels_block_size,
+		};
+		pthreadpool_compute_1d_tiled(threadpool,
+			(pthreadpool_function_1d_tiled_t) pack_kernel_matrix,
+			&kernel_packing_context,
+			output_channels, output_channels_block_max);
+	}
+
+	return nnp_status_success;
+}
+
+enum nnp_status nnp_fully_connected_output_packed(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input[],
+	const void* packed_kernel,
+	float output[],
+	pthreadpool_t threadpool,
+	struct nnp_profile* profile)
+{
+	NNP_TOTAL_START(profile)
+
+	/* Basic validation of parameters. This check detects invalid, but not unsupported parameters. */
+	enum nnp_status status = validate_fully_connected_arguments(batch_size, input_channels, output_channels);
+	if (status == nnp_status_success) {
+		status = validate_packed_kernel(packed_kernel, input_channels, output_channels, nnp_hwinfo.sgemm.nr);
+	}
+	if (status == nnp_status_success) {
+		status = compute_fully_connected_product(
+			batch_size, input_channels, output_channels,
+			input, false,
+			NULL, false,
+			packed_kernel,
+			output,
+			threadpool, profile);
+	}
+
 	NNP_TOTAL_END(profile)
 	return status;
 }
@@ -3,11 +3,15 @@
 #include <stddef.h>
 
 #include <pthread.h>
+#include <unistd.h>
 
 #include <cpuid.h>
 #ifndef bit_AVX2
 	#define bit_AVX2 0x00000020
 #endif
+#ifndef bit_AVX512F
+	#define bit_AVX512F 0x00010000
+#endif
 
 #if __native_client__
 	#define NNP_NACL_CODE_BUNDLE_SIZE 32
@@ -16,6 +20,8 @@
 
 #include <nnpack.h>
 #include <nnpack/hwinfo.h>
+#include <nnpack/utils.h>
+#include <nnpack/autotune.h>
 
 struct hardware_info nnp_hwinfo = { };
 static pthread_once_t hwinfo_init_control = PTHREAD_ONCE_INIT;
@@ -38,6 +44,398 @@ struct cpu_info {
 	uint32_t edx;
 };
 
+/*
+ * SSE2 kernels are the baseline for x86-64 processors without AVX2 and FMA3.
+ * They keep the tile and tuple sizes of the AVX2 kernels, so the drivers do not need to know which kernels are in use.
+ */
+static void init_sse2_kernels(void) {
+	nnp_hwinfo.isa.name = "sse2";
+	nnp_hwinfo.simd_width = 8;
+	nnp_hwinfo.tuple_format = tuple_format_sse2;
+
+	nnp_hwinfo.transforms = (struct transforms) {
+		.fft8x8_and_store = nnp_fft8x8_and_store__sse2,
+		.fft8x8_and_stream = nnp_fft8x8_and_stream__sse2,
+		.fft8x8_and_macc = nnp_fft8x8_and_macc__sse2,
+		.ifft8x8 = nnp_ifft8x8__sse2,
+		.ifft8x8_with_bias = nnp_ifft8x8_with_bias__sse2,
+		.ifft8x8_with_bias_activation = nnp_ifft8x8_with_bias_activation__sse2,
+		.fft16x16_and_store = nnp_fft16x16_and_store__sse2,
+		.fft16x16_and_stream = nnp_fft16x16_and_stream__sse2,
+		.fft16x16_and_macc = nnp_fft16x16_and_macc__sse2,
+		.ifft16x16 = nnp_ifft16x16__sse2,
+		.ifft16x16_with_bias = nnp_ifft16x16_with_bias__sse2,
+		.ifft16x16_with_bias_activation = nnp_ifft16x16_with_bias_activation__sse2,
+		.iwt_f6x6_3x3_and_store = nnp_iwt8x8_3x3_and_store__sse2,
+		.iwt_f6x6_3x3_and_stream = nnp_iwt8x8_3x3_and_stream__sse2,
+		.kwt_f6x6_3x3_and_stream = nnp_kwt8x8_3x3_and_stream__sse2,
+		.kwt_f6x6_3x3_and_mac = nnp_kwt8x8_3x3_and_mac__sse2,
+		.kwt_f6x6_3Rx3R_and_stream = nnp_kwt8x8_3Rx3R_and_stream__sse2,
+		.owt_f6x6_3x3 = nnp_owt8x8_3x3__sse2,
+		.owt_f6x6_3x3_with_bias = nnp_owt8x8_3x3_with_bias__sse2,
+		.owt_f6x6_3x3_with_bias_activation = nnp_owt8x8_3x3_with_bias_activation__sse2,
+	};
+
+	nnp_hwinfo.sgemm = (struct sgemm) {
+		.mr = 4,
+		.nr = 24,
+		.functions = {
+			{ nnp_sgemm_1x8__sse2, nnp_sgemm_1x16__sse2, nnp_sgemm_1x24__sse2 },
+			{ nnp_sgemm_2x8__sse2, nnp_sgemm_2x16__sse2, nnp_sgemm_2x24__sse2 },
+			{ nnp_sgemm_3x8__sse2, nnp_sgemm_3x16__sse2, nnp_sgemm_3x24__sse2 },
+			{ nnp_sgemm_4x8__sse2, nnp_sgemm_4x16__sse2, nnp_sgemm_4x24__sse2 },
+		},
+	};
+
+	nnp_hwinfo.sxgemm = (struct sxgemm) {
+		.mr = 3,
+		.nr = 4,
+		.functions = {
+			{ nnp_s8gemm1x1__sse2, nnp_s8gemm1x2__sse2, nnp_s8gemm1x3__sse2, nnp_s8gemm1x4__sse2 },
+			{ nnp_s8gemm2x1__sse2, nnp_s8gemm2x2__sse2, nnp_s8gemm2x3__sse2, nnp_s8gemm2x4__sse2 },
+			{ nnp_s8gemm3x1__sse2, nnp_s8gemm3x2__sse2, nnp_s8gemm3x3__sse2, nnp_s8gemm3x4__sse2 },
+		},
+		.tile8x8 = nnp_s8x8gemm__sse2,
+	};
+
+	nnp_hwinfo.cxgemm = (struct cxgemm) {
+		.mr = 2,
+		.nr = 2,
+		.s4cX_functions = {
+			{ nnp_s4c6gemm1x1__sse2, nnp_s4c6gemm1x2__sse2 },
+			{ nnp_s4c6gemm2x1__sse2, nnp_s4c6gemm2x2__sse2 },
+		},
+		.cX_functions = {
+			{ nnp_c8gemm1x1__sse2, nnp_c8gemm1x2__sse2 },
+			{ nnp_c8gemm2x1__sse2, nnp_c8gemm2x2__sse2 },
+		},
+		.s4cX_conja_functions = {
+			{ nnp_s4c6gemmca1x1__sse2, nnp_s4c6gemmca1x2__sse2 },
+			{ nnp_s4c6gemmca2x1__sse2, nnp_s4c6gemmca2x2__sse2 },
+		},
+		.cX_conja_functions = {
+			{ nnp_c8gemmca1x1__sse2, nnp_c8gemmca1x2__sse2 },
+			{ nnp_c8gemmca2x1__sse2, nnp_c8gemmca2x2__sse2 },
+		},
+		.s4cX_conjb_functions = {
+			{ nnp_s4c6gemmcb1x1__sse2, nnp_s4c6gemmcb1x2__sse2 },
+			{ nnp_s4c6gemmcb2x1__sse2, nnp_s4c6gemmcb2x2__sse2 },
+		},
+		.cX_conjb_functions = {
+			{ nnp_c8gemmcb1x1__sse2, nnp_c8gemmcb1x2__sse2 },
+			{ nnp_c8gemmcb2x1__sse2, nnp_c8gemmcb2x2__sse2 },
+		},
+		.tile8x8 = nnp_ft8x8gemmc__sse2,
+		.tile16x16 = nnp_ft16x16gemmc__sse2,
+	};
+
+	nnp_hwinfo.sdotxf = (struct sdotxf) {
+		.fusion = 8,
+		.functions = {
+			nnp_sdotxf1__sse2, nnp_sdotxf2__sse2, nnp_sdotxf3__sse2, nnp_sdotxf4__sse2,
+			nnp_sdotxf5__sse2, nnp_sdotxf6__sse2, nnp_sdotxf7__sse2, nnp_sdotxf8__sse2,
+		},
+	};
+
+	nnp_hwinfo.pooling = (struct pooling) {
+		.max_2x2_2x2 = nnp_maxpool_2x2_2x2__sse2,
+		.max_3x3_2x2 = nnp_maxpool_3x3_2x2__sse2,
+		.max_3x3_1x1 = nnp_maxpool_3x3_1x1__sse2,
+		.max_generic = nnp_maxpool_generic__sse2,
+		.max_argmax_generic = nnp_maxpool_argmax_generic__sse2,
+		.average_generic = nnp_avgpool_generic__sse2,
+		.global_average = nnp_global_avgpool__sse2,
+	};
+
+	nnp_hwinfo.softmax = (struct softmax) {
+		.vector_max = nnp_vector_max__sse2,
+		.vector_exp_minus_c_and_sum = nnp_vector_exp_minus_c_and_sum__sse2,
+		.vector_scale = nnp_vector_scale__sse2,
+	};
+
+	nnp_hwinfo.activations = (struct activations) {
+		.relu = nnp_relu__sse2,
+		.grad_relu = nnp_grad_relu__sse2,
+	};
+
+	nnp_hwinfo.depthwise = (struct depthwise) {
+		.conv3x3 = nnp_dwconv3x3__sse2,
+	};
+}
+
+static void init_avx2_kernels(void) {
+	nnp_hwinfo.isa.name = "avx2";
+	nnp_hwinfo.simd_width = 8;
+	nnp_hwinfo.tuple_format = tuple_format_avx2;
+
+	nnp_hwinfo.transforms = (struct transforms) {
+		.fft8x8_and_store = nnp_fft8x8_and_store__avx2,
+		.fft8x8_and_stream = nnp_fft8x8_and_stream__avx2,
+		.fft8x8_and_macc = nnp_fft8x8_and_macc__avx2,
+		.ifft8x8 = nnp_ifft8x8__avx2,
+		.ifft8x8_with_bias = nnp_ifft8x8_with_bias__avx2,
+		.ifft8x8_with_bias_activation = nnp_ifft8x8_with_bias_activation__avx2,
+		.fft16x16_and_store = nnp_fft16x16_and_store__avx2,
+		.fft16x16_and_stream = nnp_fft16x16_and_stream__avx2,
+		.fft16x16_and_macc = nnp_fft16x16_and_macc__avx2,
+		.ifft16x16 = nnp_ifft16x16__avx2,
+		.ifft16x16_with_bias = nnp_ifft16x16_with_bias__avx2,
+		.ifft16x16_with_bias_activation = nnp_ifft16x16_with_bias_activation__avx2,
+		.iwt_f6x6_3x3_and_store = nnp_iwt8x8_3x3_and_store__avx2,
+		.iwt_f6x6_3x3_and_stream = nnp_iwt8x8_3x3_and_stream__avx2,
+		.kwt_f6x6_3x3_and_stream = nnp_kwt8x8_3x3_and_stream__avx2,
+		.kwt_f6x6_3x3_and_mac = nnp_kwt8x8_3x3_and_mac__avx2,
+		.kwt_f6x6_3Rx3R_and_stream = nnp_kwt8x8_3Rx3R_and_stream__avx2,
+		.owt_f6x6_3x3 = nnp_owt8x8_3x3__avx2,
+		.owt_f6x6_3x3_with_bias = nnp_owt8x8_3x3_with_bias__avx2,
+		.owt_f6x6_3x3_with_bias_activation = nnp_owt8x8_3x3_with_bias_activation__avx2,
+	};
+
+	nnp_hwinfo.sgemm = (struct sgemm) {
+		.mr = 4,
+		.nr = 24,
+		.functions = {
+			{ nnp_sgemm_1x8__fma3, nnp_sgemm_1x16__fma3, nnp_sgemm_1x24__fma3 },
+			{ nnp_sgemm_2x8__fma3, nnp_sgemm_2x16__fma3, nnp_sgemm_2x24__fma3 },
+			{ nnp_sgemm_3x8__fma3, nnp_sgemm_3x16__fma3, nnp_sgemm_3x24__fma3 },
+			{ nnp_sgemm_4x8__fma3, nnp_sgemm_4x16__fma3, nnp_sgemm_4x24__fma3 },
+		},
+	};
+
+	nnp_hwinfo.sxgemm = (struct sxgemm) {
+		.mr = 3,
+		.nr = 4,
+		.functions = {
+			{ nnp_s8gemm1x1__fma3, nnp_s8gemm1x2__fma3, nnp_s8gemm1x3__fma3, nnp_s8gemm1x4__fma3 },
+			{ nnp_s8gemm2x1__fma3, nnp_s8gemm2x2__fma3, nnp_s8gemm2x3__fma3, nnp_s8gemm2x4__fma3 },
+			{ nnp_s8gemm3x1__fma3, nnp_s8gemm3x2__fma3, nnp_s8gemm3x3__fma3, nnp_s8gemm3x4__fma3 },
+		},
+		.tile8x8 = nnp_s8x8gemm__fma3,
+	};
+
+	nnp_hwinfo.cxgemm = (struct cxgemm) {
+		.mr = 2,
+		.nr = 2,
+		.s4cX_functions = {
+			{ nnp_s4c6gemm1x1__fma3, nnp_s4c6gemm1x2__fma3 },
+			{ nnp_s4c6gemm2x1__fma3, nnp_s4c6gemm2x2__fma3 },
+		},
+		.cX_functions = {
+			{ nnp_c8gemm1x1__fma3, nnp_c8gemm1x2__fma3 },
+			{ nnp_c8gemm2x1__fma3, nnp_c8gemm2x2__fma3 },
+		},
+		.s4cX_conja_functions = {
+			{ nnp_s4c6gemmca1x1__fma3, nnp_s4c6gemmca1x2__fma3 },
+			{ nnp_s4c6gemmca2x1__fma3, nnp_s4c6gemmca2x2__fma3 },
+		},
+		.cX_conja_functions = {
+			{ nnp_c8gemmca1x1__fma3, nnp_c8gemmca1x2__fma3 },
+			{ nnp_c8gemmca2x1__fma3, nnp_c8gemmca2x2__fma3 },
+		},
+		.s4cX_conjb_functions = {
+			{ nnp_s4c6gemmcb1x1__fma3, nnp_s4c6gemmcb1x2__fma3 },
+			{ nnp_s4c6gemmcb2x1__fma3, nnp_s4c6gemmcb2x2__fma3 },
+		},
+		.cX_conjb_functions = {
+			{ nnp_c8gemmcb1x1__fma3, nnp_c8gemmcb1x2__fma3 },
+			{ nnp_c8gemmcb2x1__fma3, nnp_c8gemmcb2x2__fma3 },
+		},
+		.tile8x8 = nnp_ft8x8gemmc__fma3,
+		.tile16x16 = nnp_ft16x16gemmc__fma3,
+	};
+
+	nnp_hwinfo.sdotxf = (struct sdotxf) {
+		.fusion = 8,
+		.functions = {
+			nnp_sdotxf1__avx2, nnp_sdotxf2__avx2, nnp_sdotxf3__avx2, nnp_sdotxf4__avx2,
+			nnp_sdotxf5__avx2, nnp_sdotxf6__avx2, nnp_sdotxf7__avx2, nnp_sdotxf8__avx2,
+		},
+	};
+
+	nnp_hwinfo.pooling = (struct pooling) {
+		.max_2x2_2x2 = nnp_maxpool_2x2_2x2__avx2,
+		.max_3x3_2x2 = nnp_maxpool_3x3_2x2__avx2,
+		.max_3x3_1x1 = nnp_maxpool_3x3_1x1__avx2,
+		.max_generic = nnp_maxpool_generic__avx2,
+		.max_argmax_generic = nnp_maxpool_argmax_generic__avx2,
+		.average_generic = nnp_avgpool_generic__avx2,
+		.global_average = nnp_global_avgpool__avx2,
+	};
+
+	nnp_hwinfo.softmax = (struct softmax) {
+		.vector_max = nnp_vector_max__avx2,
+		.vector_exp_minus_c_and_sum = nnp_vector_exp_minus_c_and_sum__avx2,
+		.vector_scale = nnp_vector_scale__avx2,
+	};
+
+	nnp_hwinfo.activations = (struct activations) {
+		.relu = nnp_relu__avx2,
+		.grad_relu = nnp_grad_relu__avx2,
+	};
+
+	nnp_hwinfo.depthwise = (struct depthwise) {
+		.conv3x3 = nnp_dwconv3x3__avx2,
+	};
+}
+
+/*
+ * AVX-512 kernels pack transformed coefficients into 16-element tuples, which take one ZMM register per real tuple
+ * and two per complex tuple. Their layout differs from the AVX2 kernels, so all transforms and tuple GEMMs are replaced.
+ */
+static void init_avx512f_kernels(void) {
+	nnp_hwinfo.isa.name = "avx512f";
+	nnp_hwinfo.simd_width = 16;
+	nnp_hwinfo.tuple_format = tuple_format_avx512f;
+
+	nnp_hwinfo.transforms = (struct transforms) {
+		.fft8x8_and_store = nnp_fft8x8_and_store__avx512f,
+		.fft8x8_and_stream = nnp_fft8x8_and_stream__avx512f,
+		.fft8x8_and_macc = nnp_fft8x8_and_macc__avx512f,
+		.ifft8x8 = nnp_ifft8x8__avx512f,
+		.ifft8x8_with_bias = nnp_ifft8x8_with_bias__avx512f,
+		.ifft8x8_with_bias_activation = nnp_ifft8x8_with_bias_activation__avx512f,
+		.fft16x16_and_store = nnp_fft16x16_and_store__avx512f,
+		.fft16x16_and_stream = nnp_fft16x16_and_stream__avx512f,
+		.fft16x16_and_macc = nnp_fft16x16_and_macc__avx512f,
+		.ifft16x16 = nnp_ifft16x16__avx512f,
+		.ifft16x16_with_bias = nnp_ifft16x16_with_bias__avx512f,
+		.ifft16x16_with_bias_activation = nnp_ifft16x16_with_bias_activation__avx512f,
+		.iwt_f6x6_3x3_and_store = nnp_iwt8x8_3x3_and_store__avx512f,
+		.iwt_f6x6_3x3_and_stream = nnp_iwt8x8_3x3_and_stream__avx512f,
+		.kwt_f6x6_3x3_and_stream = nnp_kwt8x8_3x3_and_stream__avx512f,
+		.kwt_f6x6_3x3_and_mac = nnp_kwt8x8_3x3_and_mac__avx512f,
+		.kwt_f6x6_3Rx3R_and_stream = nnp_kwt8x8_3Rx3R_and_stream__avx512f,
+		.owt_f6x6_3x3 = nnp_owt8x8_3x3__avx512f,
+		.owt_f6x6_3x3_with_bias = nnp_owt8x8_3x3_with_bias__avx512f,
+		.owt_f6x6_3x3_with_bias_activation = nnp_owt8x8_3x3_with_bias_activation__avx512f,
+	};
+
+	nnp_hwinfo.sxgemm = (struct sxgemm) {
+		.mr = 4,
+		.nr = 6,
+		.functions = {
+			{ nnp_s16gemm1x1__avx512f, nnp_s16gemm1x2__avx512f, nnp_s16gemm1x3__avx512f, nnp_s16gemm1x4__avx512f, nnp_s16gemm1x5__avx512f, nnp_s16gemm1x6__avx512f },
+			{ nnp_s16gemm2x1__avx512f, nnp_s16gemm2x2__avx512f, nnp_s16gemm2x3__avx512f, nnp_s16gemm2x4__avx512f, nnp_s16gemm2x5__avx512f, nnp_s16gemm2x6__avx512f },
+			{ nnp_s16gemm3x1__avx512f, nnp_s16gemm3x2__avx512f, nnp_s16gemm3x3__avx512f, nnp_s16gemm3x4__avx512f, nnp_s16gemm3x5__avx512f, nnp_s16gemm3x6__avx512f },
+			{ nnp_s16gemm4x1__avx512f, nnp_s16gemm4x2__avx512f, nnp_s16gemm4x3__avx512f, nnp_s16gemm4x4__avx512f, nnp_s16gemm4x5__avx512f, nnp_s16gemm4x6__avx512f },
+		},
+		.tile8x8 = nnp_s8x8gemm__avx512f,
+	};
+
+	nnp_hwinfo.cxgemm = (struct cxgemm) {
+		.mr = 3,
+		.nr = 3,
+		.s4cX_functions = {
+			{ nnp_s4c14gemm1x1__avx512f, nnp_s4c14gemm1x2__avx512f, nnp_s4c14gemm1x3__avx512f },
+			{ nnp_s4c14gemm2x1__avx512f, nnp_s4c14gemm2x2__avx512f, nnp_s4c14gemm2x3__avx512f },
+			{ nnp_s4c14gemm3x1__avx512f, nnp_s4c14gemm3x2__avx512f, nnp_s4c14gemm3x3__avx512f },
+		},
+		.cX_functions = {
+			{ nnp_c16gemm1x1__avx512f, nnp_c16gemm1x2__avx512f, nnp_c16gemm1x3__avx512f },
+			{ nnp_c16gemm2x1__avx512f, nnp_c16gemm2x2__avx512f, nnp_c16gemm2x3__avx512f },
+			{ nnp_c16gemm3x1__avx512f, nnp_c16gemm3x2__avx512f, nnp_c16gemm3x3__avx512f },
+		},
+		.s4cX_conja_functions = {
+			{ nnp_s4c14gemmca1x1__avx512f, nnp_s4c14gemmca1x2__avx512f, nnp_s4c14gemmca1x3__avx512f },
+			{ nnp_s4c14gemmca2x1__avx512f, nnp_s4c14gemmca2x2__avx512f, nnp_s4c14gemmca2x3__avx512f },
+			{ nnp_s4c14gemmca3x1__avx512f, nnp_s4c14gemmca3x2__avx512f, nnp_s4c14gemmca3x3__avx512f },
+		},
+		.cX_conja_functions = {
+			{ nnp_c16gemmca1x1__avx512f, nnp_c16gemmca1x2__avx512f, nnp_c16gemmca1x3__avx512f },
+			{ nnp_c16gemmca2x1__avx512f, nnp_c16gemmca2x2__avx512f, nnp_c16gemmca2x3__avx512f },
+			{ nnp_c16gemmca3x1__avx512f, nnp_c16gemmca3x2__avx512f, nnp_c16gemmca3x3__avx512f },
+		},
+		.s4cX_conjb_functions = {
+			{ nnp_s4c14gemmcb1x1__avx512f, nnp_s4c14gemmcb1x2__avx512f, nnp_s4c14gemmcb1x3__avx512f },
+			{ nnp_s4c14gemmcb2x1__avx512f, nnp_s4c14gemmcb2x2__avx512f, nnp_s4c14gemmcb2x3__avx512f },
+			{ nnp_s4c14gemmcb3x1__avx512f, nnp_s4c14gemmcb3x2__avx512f, nnp_s4c14gemmcb3x3__avx512f },
+		},
+		.cX_conjb_functions = {
+			{ nnp_c16gemmcb1x1__avx512f, nnp_c16gemmcb1x2__avx512f, nnp_c16gemmcb1x3__avx512f },
+			{ nnp_c16gemmcb2x1__avx512f, nnp_c16gemmcb2x2__avx512f, nnp_c16gemmcb2x3__avx512f },
+			{ nnp_c16gemmcb3x1__avx512f, nnp_c16gemmcb3x2__avx512f, nnp_c16gemmcb3x3__avx512f },
+		},
+		.tile8x8 = nnp_ft8x8gemmc__avx512f,
+		.tile16x16 = nnp_ft16x16gemmc__avx512f,
+	};
+
+	nnp_hwinfo.sgemm = (struct sgemm) {
+		.mr = 4,
+		.nr = 48,
+		.functions = {
+			{ nnp_sgemm_1x16__avx512f, nnp_sgemm_1x32__avx512f, nnp_sgemm_1x48__avx512f },
+			{ nnp_sgemm_2x16__avx512f, nnp_sgemm_2x32__avx512f, nnp_sgemm_2x48__avx512f },
+			{ nnp_sgemm_3x16__avx512f, nnp_sgemm_3x32__avx512f, nnp_sgemm_3x48__avx512f },
+			{ nnp_sgemm_4x16__avx512f, nnp_sgemm_4x32__avx512f, nnp_sgemm_4x48__avx512f },
+		},
+	};
+
+	nnp_hwinfo.sdotxf = (struct sdotxf) {
+		.fusion = 8,
+		.functions = {
+			nnp_sdotxf1__avx512f, nnp_sdotxf2__avx512f, nnp_sdotxf3__avx512f, nnp_sdotxf4__avx512f,
+			nnp_sdotxf5__avx512f, nnp_sdotxf6__avx512f, nnp_sdotxf7__avx512f, nnp_sdotxf8__avx512f,
+		},
+	};
+
+	nnp_hwinfo.activations = (struct activations) {
+		.relu = nnp_relu__avx512f,
+		.grad_relu = nnp_grad_relu__avx512f,
+	};
+}
+
+/*
+ * Threads are assumed to be spread evenly over the caches of a level, so threads get caches of their own before
+ * they start to share one.
+ */
+static size_t threads_per_cache(const struct cache_info* cache, size_t threads) {
+	const size_t cache_threads = max(cache->threads, 1);
+	const size_t caches = max(nnp_hwinfo.processors / cache_threads, 1);
+	return min(divide_round_up(max(threads, 1), caches), cache_threads);
+}
+
+struct cache_blocking_info nnp_cache_blocking(size_t threads) {
+	/* CPUID leaf 4 is not implemented by some processors and hypervisors: assume typical cache sizes for blocking */
+	struct cache_blocking_info blocking = {
+		.l1 = 32 * 1024,
+		.l2 = 256 * 1024,
+		.l3 = 2 * 1024 * 1024,
+		.l4 = nnp_hwinfo.cache.l4.size,
+	};
+
+	/* Blocks in L1 and L2 are private to a thread: split the cache between the threads which share it */
+	const size_t l1_threads = threads_per_cache(&nnp_hwinfo.cache.l1, threads);
+	if (nnp_hwinfo.cache.l1.size != 0) {
+		blocking.l1 = nnp_hwinfo.cache.l1.size / l1_threads;
+	}
+	const size_t l2_threads = threads_per_cache(&nnp_hwinfo.cache.l2, threads);
+	if (nnp_hwinfo.cache.l2.size != 0) {
+		size_t l2 = nnp_hwinfo.cache.l2.size;
+		if (nnp_hwinfo.cache.l2.inclusive) {
+			l2 = doz(l2, nnp_hwinfo.cache.l1.size);
+		}
+		if (l2 != 0) {
+			blocking.l2 = l2 / l2_threads;
+		}
+	}
+
+	/*
+	 * Blocks in L3 are shared by all threads, so the cache is not split. However, an inclusive L3 also holds copies
+	 * of the L2 caches of all the cores which run the threads.
+	 */
+	if (nnp_hwinfo.cache.l3.size != 0) {
+		size_t l3 = nnp_hwinfo.cache.l3.size;
+		if (nnp_hwinfo.cache.l3.inclusive) {
+			const size_t l3_threads = threads_per_cache(&nnp_hwinfo.cache.l3, threads);
+			l3 = doz(l3, nnp_hwinfo.cache.l2.size * divide_round_up(l3_threads, l2_threads));
+		}
+		if (l3 != 0) {
+			blocking.l3 = l3;
+		}
+	}
+	return blocking;
+}
+
 static void init_hwinfo(void) {
 	const uint32_t max_base_info = __get_cpuid_max(0, NULL);
 	const uint32_t max_extended_info = __get_cpuid_max(0x80000000, NULL);
@@ -111,7 +509,10 @@ static void init_hwinfo(void) {
 		/* OSXSAVE: ecx[bit 27] in basic info */
 		const bool osxsave = !!(basic_info.ecx & bit_OSXSAVE);
 		/* Check that AVX[bit 2] and SSE[bit 1] registers are preserved by OS */
-		const bool ymm_regs = (osxsave ? ((xgetbv(0) & 0b110ul) == 0b110ul) : false);
+		const uint64_t xcr0 = (osxsave ? xgetbv(0) : 0);
+		const bool ymm_regs = ((xcr0 & 0b110ul) == 0b110ul);
+		/* Check that opmask[bit 5], upper ZMM[bits 6-7], and AVX registers are preserved by OS */
+		const bool zmm_regs = ((xcr0 & 0b11100110ul) == 0b11100110ul);
 
 		struct cpu_info structured_info = { 0 };
 		if (max_base_info >= 7) {
@@ -126,6 +527,10 @@ static void init_hwinfo(void) {
 			/* AVX2: ebx[bit 5] in structured feature info */
 			nnp_hwinfo.isa.has_avx2 = !!(structured_info.ebx & bit_AVX2);
 		}
+		if (zmm_regs) {
+			/* AVX512F: ebx[bit 16] in structured feature info */
+			nnp_hwinfo.isa.has_avx512f = !!(structured_info.ebx & bit_AVX512F);
+		}
 	}
 #endif
 
@@ -195,33 +600,28 @@ static void init_hwinfo(void) {
 		}
 	}
 
-	/* Compute high-level cache blocking parameters */
-	nnp_hwinfo.blocking.l1 = nnp_hwinfo.cache.l1.size;
-	if (nnp_hwinfo.cache.l1.threads > 1) {
-		nnp_hwinfo.blocking.l1 /= nnp_hwinfo.cache.l1.threads;
-	}
-	if (nnp_hwinfo.cache.l2.size != 0) {
-		nnp_hwinfo.blocking.l2 = nnp_hwinfo.cache.l2.size;
-		if (nnp_hwinfo.cache.l2.inclusive) {
-			nnp_hwinfo.blocking.l2 -= nnp_hwinfo.cache.l1.size;
-		}
-		if (nnp_hwinfo.cache.l2.threads > 1) {
-			nnp_hwinfo.blocking.l2 /= nnp_hwinfo.cache.l2.threads;
-		}
-	}
-	if (nnp_hwinfo.cache.l3.size != 0) {
-		nnp_hwinfo.blocking.l3 = nnp_hwinfo.cache.l3.size;
-		if (nnp_hwinfo.cache.l3.inclusive) {
-			nnp_hwinfo.blocking.l3 -= nnp_hwinfo.cache.l2.size;
-		}
+	/* Detect the number of logical processors which the caches are shared between */
+	nnp_hwinfo.processors = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+	const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+	if (processors > 1) {
+		nnp_hwinfo.processors = (uint32_t) processors;
 	}
-	nnp_hwinfo.blocking.l4 = nnp_hwinfo.cache.l4.size;
+#endif
 
-	if (nnp_hwinfo.isa.has_avx2 && nnp_hwinfo.isa.has_fma3 &&
-		nnp_hwinfo.cache.l1.size && nnp_hwinfo.cache.l2.size && nnp_hwinfo.cache.l3.size)
-	{
-		nnp_hwinfo.supported = true;
+	/* Default blocking parameters assume that every logical processor runs a thread */
+	nnp_hwinfo.blocking = nnp_cache_blocking(nnp_hwinfo.processors);
+
+	if (nnp_hwinfo.isa.has_avx2 && nnp_hwinfo.isa.has_fma3) {
+		init_avx2_kernels();
+		if (nnp_hwinfo.isa.has_avx512f) {
+			init_avx512f_kernels();
+		}
+	} else {
+		/* SSE2 is part of the x86-64 baseline */
+		init_sse2_kernels();
 	}
+	nnp_hwinfo.supported = true;
 
 	nnp_hwinfo.initialized = true;
 }
@@ -236,5 +636,7 @@ enum nnp_status nnp_initialize(void) {
 }
 
 enum nnp_status nnp_deinitialize(void) {
+	nnp_autotune_disable();
+	nnp_autotune_release_blocking();
 	return nnp_status_success;
 }
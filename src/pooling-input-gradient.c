@@ -0,0 +1,90 @@
+#include <stdint.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+
+#include <nnpack/validation.h>
+
+
+struct NNP_CACHE_ALIGN pooling_input_gradient_context {
+	const float* grad_output_pointer;
+	const uint32_t* indices_pointer;
+	float* grad_input_pointer;
+
+	size_t channels;
+	size_t input_elements;
+	size_t output_elements;
+};
+
+static void compute_max_pooling_input_gradient(
+	const struct pooling_input_gradient_context context[restrict static 1],
+	size_t sample, size_t channel)
+{
+	const size_t channels        = context->channels;
+	const size_t input_elements  = context->input_elements;
+	const size_t output_elements = context->output_elements;
+
+	const float (*grad_output)[channels][output_elements] =
+		(const float(*)[channels][output_elements]) context->grad_output_pointer;
+	const uint32_t (*indices)[channels][output_elements] =
+		(const uint32_t(*)[channels][output_elements]) context->indices_pointer;
+	float (*grad_input)[channels][input_elements] =
+		(float(*)[channels][input_elements]) context->grad_input_pointer;
+
+	float* grad_input_image = grad_input[sample][channel];
+	for (size_t i = 0; i < input_elements; i++) {
+		grad_input_image[i] = 0.0f;
+	}
+
+	const float* grad_output_image = grad_output[sample][channel];
+	const uint32_t* indices_image = indices[sample][channel];
+	for (size_t i = 0; i < output_elements; i++) {
+		const uint32_t index = indices_image[i];
+		/* Windows which cover only padding have no maximum, and do not propagate gradient */
+		if (index < input_elements) {
+			grad_input_image[index] += grad_output_image[i];
+		}
+	}
+}
+
+enum nnp_status nnp_max_pooling_input_gradient(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float grad_output[],
+	const uint32_t indices[],
+	float grad_input[],
+	pthreadpool_t threadpool)
+{
+	enum nnp_status status = validate_pooling_arguments(
+		batch_size, channels,
+		input_size, input_padding,
+		pooling_size, pooling_stride);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	const struct nnp_size output_size = {
+		.height = pooling_output_dimension(input_size.height, input_padding.top, input_padding.bottom, pooling_size.height, pooling_stride.height),
+		.width = pooling_output_dimension(input_size.width, input_padding.left, input_padding.right, pooling_size.width, pooling_stride.width),
+	};
+
+	struct pooling_input_gradient_context pooling_input_gradient_context = {
+		.grad_output_pointer = grad_output,
+		.indices_pointer = indices,
+		.grad_input_pointer = grad_input,
+		.channels = channels,
+		.input_elements = input_size.height * input_size.width,
+		.output_elements = output_size.height * output_size.width,
+	};
+	pthreadpool_compute_2d(threadpool,
+		(pthreadpool_function_2d_t) compute_max_pooling_input_gradient,
+		&pooling_input_gradient_context,
+		batch_size, channels);
+
+	return nnp_status_success;
+}
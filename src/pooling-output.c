@@ -8,19 +8,23 @@
 #include <nnpack.h>
 #include <nnpack/pooling.h>
 #include <nnpack/utils.h>
+#include <nnpack/hwinfo.h>
 
 #include <nnpack/validation.h>
 
 extern bool is_haswell_compatible_isa(void);
 
 struct NNP_CACHE_ALIGN pooling_context {
-	void (*pooling_function)(const float*, float*, size_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+	nnp_pooling_function pooling_function;
+	nnp_image_pooling_function image_pooling_function;
 	const float* input_pointer;
 	float* output_pointer;
+	uint32_t* indices_pointer;
 
 	size_t channels;
 	struct nnp_size input_size;
 	struct nnp_padding input_padding;
+	struct nnp_size pooling_size;
 	struct nnp_size pooling_stride;
 	struct nnp_size output_size;
 	struct nnp_size input_tile;
@@ -46,12 +50,12 @@ static void compute_pooling_output(
 
 	for (size_t y = 0; y < output_size.height; y += output_tile.height) {
 		const size_t input_y = min(doz(y * pooling_stride.height, input_padding.top), input_size.height);
-		const size_t input_row_offset = doz(input_padding.top, y);
+		const size_t input_row_offset = doz(input_padding.top, y * pooling_stride.height);
 		const size_t input_row_count = min(input_tile.height, doz(input_size.height, input_y));
 		const size_t output_row_count = min(output_tile.height, output_size.height - y);
 		for (size_t x = 0; x < output_size.width; x += output_tile.width) {
 			const size_t input_x = min(doz(x * pooling_stride.width, input_padding.left), input_size.width);
-			const size_t input_column_offset = doz(input_padding.left, x);
+			const size_t input_column_offset = doz(input_padding.left, x * pooling_stride.width);
 			const size_t input_column_count = min(input_tile.width, doz(input_size.width, input_x));
 			const size_t output_column_count = min(output_tile.width, output_size.width - x);
 			context->pooling_function(
@@ -67,7 +71,89 @@ static void compute_pooling_output(
 	}
 }
 
-enum nnp_status nnp_max_pooling_output(
+static void compute_generic_pooling_output(
+	const struct pooling_context context[restrict static 1],
+	size_t sample, size_t channel)
+{
+	const size_t channels                  = context->channels;
+	const struct nnp_size input_size       = context->input_size;
+	const struct nnp_padding input_padding = context->input_padding;
+	const struct nnp_size pooling_size     = context->pooling_size;
+	const struct nnp_size pooling_stride   = context->pooling_stride;
+	const struct nnp_size output_size      = context->output_size;
+
+	const float (*input)[channels][input_size.height * input_size.width] =
+		(const float(*)[channels][input_size.height * input_size.width]) context->input_pointer;
+	float (*output)[channels][output_size.height * output_size.width] =
+		(float(*)[channels][output_size.height * output_size.width]) context->output_pointer;
+
+	context->image_pooling_function(
+		input[sample][channel], output[sample][channel],
+		input_size, input_padding, pooling_size, pooling_stride, output_size);
+}
+
+static void compute_argmax_pooling_output(
+	const struct pooling_context context[restrict static 1],
+	size_t sample, size_t channel)
+{
+	const size_t channels                  = context->channels;
+	const struct nnp_size input_size       = context->input_size;
+	const struct nnp_padding input_padding = context->input_padding;
+	const struct nnp_size pooling_size     = context->pooling_size;
+	const struct nnp_size pooling_stride   = context->pooling_stride;
+	const struct nnp_size output_size      = context->output_size;
+
+	const float (*input)[channels][input_size.height * input_size.width] =
+		(const float(*)[channels][input_size.height * input_size.width]) context->input_pointer;
+	float (*output)[channels][output_size.height * output_size.width] =
+		(float(*)[channels][output_size.height * output_size.width]) context->output_pointer;
+	uint32_t (*indices)[channels][output_size.height * output_size.width] =
+		(uint32_t(*)[channels][output_size.height * output_size.width]) context->indices_pointer;
+
+	nnp_hwinfo.pooling.max_argmax_generic(
+		input[sample][channel], output[sample][channel], indices[sample][channel],
+		input_size, input_padding, pooling_size, pooling_stride, output_size);
+}
+
+struct NNP_CACHE_ALIGN global_pooling_context {
+	const float* input_pointer;
+	float* output_pointer;
+
+	size_t channels;
+	size_t input_elements;
+};
+
+static void compute_global_average_pooling_output(
+	const struct global_pooling_context context[restrict static 1],
+	size_t sample,       size_t channels_subblock_start,
+	size_t sample_range, size_t channels_subblock_size)
+{
+	const size_t channels       = context->channels;
+	const size_t input_elements = context->input_elements;
+
+	const float (*input)[channels][input_elements] =
+		(const float(*)[channels][input_elements]) context->input_pointer;
+	float (*output)[channels] =
+		(float(*)[channels]) context->output_pointer;
+
+	nnp_hwinfo.pooling.global_average(
+		input[sample][channels_subblock_start],
+		&output[sample][channels_subblock_start],
+		channels_subblock_size, input_elements);
+}
+
+static inline struct nnp_size pooling_output_size(
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride)
+{
+	return (struct nnp_size) {
+		.height = pooling_output_dimension(input_size.height, input_padding.top, input_padding.bottom, pooling_size.height, pooling_stride.height),
+		.width = pooling_output_dimension(input_size.width, input_padding.left, input_padding.right, pooling_size.width, pooling_stride.width),
+	};
+}
+
+/* If indices_pointer is not NULL, indices of maxima are stored too, and specialized kernels are not used */
+static enum nnp_status max_pooling_output(
 	size_t batch_size,
 	size_t channels,
 	struct nnp_size input_size,
@@ -76,6 +162,7 @@ enum nnp_status nnp_max_pooling_output(
 	struct nnp_size pooling_stride,
 	const float input_pointer[],
 	float output_pointer[],
+	uint32_t indices_pointer[],
 	pthreadpool_t threadpool)
 {
 	enum nnp_status status = validate_pooling_arguments(
@@ -86,43 +173,151 @@ enum nnp_status nnp_max_pooling_output(
 		return status;
 	}
 
-	const struct nnp_size output_size = {
-		.height = divide_round_up(input_padding.top + input_size.height + input_padding.bottom - pooling_size.height, pooling_stride.height) + 1,
-		.width = divide_round_up(input_padding.left + input_size.width + input_padding.right - pooling_size.width, pooling_stride.width) + 1,
-	};
+	const struct nnp_size output_size = pooling_output_size(input_size, input_padding, pooling_size, pooling_stride);
 
 	struct pooling_context pooling_context = {
 		.channels = channels,
 		.input_pointer = input_pointer,
 		.output_pointer = output_pointer,
+		.indices_pointer = indices_pointer,
 		.input_size = input_size,
+		.input_padding = input_padding,
+		.pooling_size = pooling_size,
 		.pooling_stride = pooling_stride,
 		.output_size = output_size,
 	};
 
-	if ((pooling_stride.height != 2) || (pooling_stride.width != 2)) {
-		return nnp_status_unsupported_pooling_stride;
+	/* Common pooling configurations use specialized kernels which process a tile of 8 output pixels */
+	pthreadpool_function_2d_t compute_function = (pthreadpool_function_2d_t) compute_pooling_output;
+	if (indices_pointer != NULL) {
+		compute_function = (pthreadpool_function_2d_t) compute_argmax_pooling_output;
+	} else if ((pooling_size.height == 2) && (pooling_size.width == 2) && (pooling_stride.height == 2) && (pooling_stride.width == 2)) {
+		pooling_context.pooling_function = nnp_hwinfo.pooling.max_2x2_2x2;
+		pooling_context.input_tile = (struct nnp_size) { .height = 2, .width = 16 };
+		pooling_context.output_tile = (struct nnp_size) { .height = 1, .width = 8 };
+	} else if ((pooling_size.height == 3) && (pooling_size.width == 3) && (pooling_stride.height == 2) && (pooling_stride.width == 2)) {
+		pooling_context.pooling_function = nnp_hwinfo.pooling.max_3x3_2x2;
+		pooling_context.input_tile = (struct nnp_size) { .height = 3, .width = 17 };
+		pooling_context.output_tile = (struct nnp_size) { .height = 1, .width = 8 };
+	} else if ((pooling_size.height == 3) && (pooling_size.width == 3) && (pooling_stride.height == 1) && (pooling_stride.width == 1)) {
+		pooling_context.pooling_function = nnp_hwinfo.pooling.max_3x3_1x1;
+		pooling_context.input_tile = (struct nnp_size) { .height = 3, .width = 10 };
+		pooling_context.output_tile = (struct nnp_size) { .height = 1, .width = 8 };
+	} else {
+		pooling_context.image_pooling_function = nnp_hwinfo.pooling.max_generic;
+		compute_function = (pthreadpool_function_2d_t) compute_generic_pooling_output;
 	}
 
-	if (pooling_size.width != pooling_size.height) {
-		return nnp_status_unsupported_pooling_size;
-	}
-	switch (pooling_size.width) {
-		case 2:
-			pooling_context.pooling_function = nnp_maxpool_2x2_2x2__avx2;
-			pooling_context.input_tile = (struct nnp_size) { .height = 2, .width = 16 };
-			pooling_context.output_tile = (struct nnp_size) { .height = 1, .width = 8 };
-			break;
-		case 3:
-			return nnp_status_unsupported_pooling_size;
-		default:
-			return nnp_status_unsupported_pooling_size;
+	pthreadpool_compute_2d(threadpool,
+		compute_function,
+		&pooling_context,
+		batch_size, channels);
+
+	return nnp_status_success;
+}
+
+enum nnp_status nnp_max_pooling_output(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float input[],
+	float output[],
+	pthreadpool_t threadpool)
+{
+	return max_pooling_output(
+		batch_size, channels,
+		input_size, input_padding, pooling_size, pooling_stride,
+		input, output, NULL,
+		threadpool);
+}
+
+enum nnp_status nnp_max_pooling_output_with_indices(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float input[],
+	float output[],
+	uint32_t indices[],
+	pthreadpool_t threadpool)
+{
+	return max_pooling_output(
+		batch_size, channels,
+		input_size, input_padding, pooling_size, pooling_stride,
+		input, output, indices,
+		threadpool);
+}
+
+enum nnp_status nnp_average_pooling_output(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float input_pointer[],
+	float output_pointer[],
+	pthreadpool_t threadpool)
+{
+	enum nnp_status status = validate_pooling_arguments(
+		batch_size, channels,
+		input_size, input_padding,
+		pooling_size, pooling_stride);
+	if (status != nnp_status_success) {
+		return status;
 	}
 
+	struct pooling_context pooling_context = {
+		.image_pooling_function = nnp_hwinfo.pooling.average_generic,
+		.channels = channels,
+		.input_pointer = input_pointer,
+		.output_pointer = output_pointer,
+		.input_size = input_size,
+		.input_padding = input_padding,
+		.pooling_size = pooling_size,
+		.pooling_stride = pooling_stride,
+		.output_size = pooling_output_size(input_size, input_padding, pooling_size, pooling_stride),
+	};
 	pthreadpool_compute_2d(threadpool,
-		(pthreadpool_function_2d_t) compute_pooling_output,
+		(pthreadpool_function_2d_t) compute_generic_pooling_output,
 		&pooling_context,
 		batch_size, channels);
 
 	return nnp_status_success;
 }
+
+enum nnp_status nnp_global_average_pooling_output(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	const float input_pointer[],
+	float output_pointer[],
+	pthreadpool_t threadpool)
+{
+	enum nnp_status status = validate_global_pooling_arguments(batch_size, channels, input_size);
+	if (status != nnp_status_success) {
+		return status;
+	}
+
+	/* Images are small, so every task averages several channels */
+	const size_t channels_subblock_max = 16;
+
+	struct global_pooling_context global_pooling_context = {
+		.input_pointer = input_pointer,
+		.output_pointer = output_pointer,
+		.channels = channels,
+		.input_elements = input_size.height * input_size.width,
+	};
+	pthreadpool_compute_2d_tiled(threadpool,
+		(pthreadpool_function_2d_tiled_t) compute_global_average_pooling_output,
+		&global_pooling_context,
+		batch_size, channels,
+		1,          channels_subblock_max);
+
+	return nnp_status_success;
+}
@@ -2,11 +2,14 @@
 #include <nnpack/reference.h>
 
 struct convolution_output_context {
+	size_t groups;
 	size_t input_channels;
 	size_t output_channels;
 	struct nnp_size input_size;
 	struct nnp_size kernel_size;
+	struct nnp_size kernel_dilation;
 	struct nnp_size output_size;
+	struct nnp_size output_subsampling;
 	struct nnp_padding input_padding;
 	const float* input_pointer;
 	const float* kernel_pointer;
@@ -18,31 +21,37 @@ static void compute_convolution_output(
 	const struct convolution_output_context context[restrict static 1],
 	size_t sample, size_t output_channel)
 {
+	const size_t groups                    = context->groups;
 	const size_t input_channels            = context->input_channels;
 	const size_t output_channels           = context->output_channels;
 	const struct nnp_size input_size       = context->input_size;
 	const struct nnp_padding input_padding = context->input_padding;
 	const struct nnp_size kernel_size      = context->kernel_size;
+	const struct nnp_size kernel_dilation  = context->kernel_dilation;
 	const struct nnp_size output_size      = context->output_size;
+	const struct nnp_size output_subsampling = context->output_subsampling;
 
 	const float (*input)[input_channels][input_size.height][input_size.width] =
 		(const float(*)[input_channels][input_size.height][input_size.width]) context->input_pointer;
-	const float (*kernel)[input_channels][kernel_size.height][kernel_size.width] =
-		(const float(*)[input_channels][kernel_size.height][kernel_size.width]) context->kernel_pointer;
+	const float (*kernel)[input_channels / groups][kernel_size.height][kernel_size.width] =
+		(const float(*)[input_channels / groups][kernel_size.height][kernel_size.width]) context->kernel_pointer;
 	float (*output)[output_channels][output_size.height][output_size.width] =
 		(float(*)[output_channels][output_size.height][output_size.width]) context->output_pointer;
 
+	const size_t group_input_channels = input_channels / groups;
+	const size_t input_channels_start = (output_channel / (output_channels / groups)) * group_input_channels;
 	for (size_t y = 0; y < output_size.height; y++) {
 		for (size_t x = 0; x < output_size.width; x++) {
 			double v = 0.0;
-			for (size_t input_channel = 0; input_channel < input_channels; input_channel++) {
+			for (size_t group_input_channel = 0; group_input_channel < group_input_channels; group_input_channel++) {
+				const size_t input_channel = input_channels_start + group_input_channel;
 				for (size_t i = 0; i < kernel_size.height; i++) {
-					const size_t s = y + i - input_padding.top;
+					const size_t s = y * output_subsampling.height + i * kernel_dilation.height - input_padding.top;
 					if (s < input_size.height) {
 						for (size_t j = 0; j < kernel_size.width; j++) {
-							const size_t t = x + j - input_padding.left;
+							const size_t t = x * output_subsampling.width + j * kernel_dilation.width - input_padding.left;
 							if (t < input_size.width) {
-								v += input[sample][input_channel][s][t] * kernel[output_channel][input_channel][i][j];
+								v += input[sample][input_channel][s][t] * kernel[output_channel][group_input_channel][i][j];
 							}
 						}
 					}
@@ -55,28 +64,38 @@ static void compute_convolution_output(
 
 void nnp_convolution_output__reference(
 	size_t batch_size,
+	size_t groups,
 	size_t input_channels,
 	size_t output_channels,
 	struct nnp_size input_size,
 	struct nnp_padding input_padding,
 	struct nnp_size kernel_size,
+	struct nnp_size kernel_dilation,
+	struct nnp_size output_subsampling,
 	const float input_pointer[],
 	const float kernel_pointer[],
 	const float bias[],
 	float output_pointer[],
 	pthreadpool_t threadpool)
 {
+	const struct nnp_size dilated_kernel_size = {
+		.width = (kernel_size.width - 1) * kernel_dilation.width + 1,
+		.height = (kernel_size.height - 1) * kernel_dilation.height + 1
+	};
 	const struct nnp_size output_size = {
-		.width = input_padding.left + input_size.width + input_padding.right - kernel_size.width + 1,
-		.height = input_padding.top + input_size.height + input_padding.bottom - kernel_size.height + 1
+		.width = (input_padding.left + input_size.width + input_padding.right - dilated_kernel_size.width) / output_subsampling.width + 1,
+		.height = (input_padding.top + input_size.height + input_padding.bottom - dilated_kernel_size.height) / output_subsampling.height + 1
 	};
 	struct convolution_output_context convolution_output_context = {
+		.groups = groups,
 		.input_channels = input_channels,
 		.output_channels = output_channels,
 		.input_size = input_size,
 		.input_padding = input_padding,
 		.kernel_size = kernel_size,
+		.kernel_dilation = kernel_dilation,
 		.output_size = output_size,
+		.output_subsampling = output_subsampling,
 		.input_pointer = input_pointer,
 		.kernel_pointer = kernel_pointer,
 		.bias = bias,
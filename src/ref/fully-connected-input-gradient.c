@@ -0,0 +1,51 @@
+#include <nnpack.h>
+#include <nnpack/reference.h>
+
+struct fully_connected_input_gradient_context {
+	size_t input_channels;
+	size_t output_channels;
+	const float* grad_output_pointer;
+	const float* kernel_pointer;
+	float* grad_input_pointer;
+};
+
+static void compute_fully_connected_input_gradient(
+	const struct fully_connected_input_gradient_context* context,
+	size_t sample, size_t input_channel)
+{
+	const size_t input_channels = context->input_channels;
+	const size_t output_channels = context->output_channels;
+
+	const float (*grad_output)[output_channels] = (const float(*)[output_channels]) context->grad_output_pointer;
+	const float (*kernel)[input_channels] = (const float(*)[input_channels]) context->kernel_pointer;
+	float (*grad_input)[input_channels] = (float(*)[input_channels]) context->grad_input_pointer;
+
+	double v = 0.0;
+	for (size_t output_channel = 0; output_channel < output_channels; output_channel++) {
+		v += grad_output[sample][output_channel] * kernel[output_channel][input_channel];
+	}
+	grad_input[sample][input_channel] = v;
+}
+
+void nnp_fully_connected_input_gradient__reference(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float grad_output_pointer[],
+	const float kernel_pointer[],
+	float grad_input_pointer[],
+	pthreadpool_t threadpool)
+{
+	struct fully_connected_input_gradient_context fully_connected_input_gradient_context = {
+		.input_channels = input_channels,
+		.output_channels = output_channels,
+		.grad_output_pointer = grad_output_pointer,
+		.kernel_pointer = kernel_pointer,
+		.grad_input_pointer = grad_input_pointer
+	};
+
+	pthreadpool_compute_2d(threadpool,
+		(pthreadpool_function_2d_t) compute_fully_connected_input_gradient,
+		&fully_connected_input_gradient_context,
+		batch_size, input_channels);
+}
@@ -0,0 +1,54 @@
+#include <nnpack.h>
+#include <nnpack/reference.h>
+
+struct fully_connected_kernel_gradient_context {
+	size_t batch_size;
+	size_t input_channels;
+	size_t output_channels;
+	const float* input_pointer;
+	const float* grad_output_pointer;
+	float* grad_kernel_pointer;
+};
+
+static void compute_fully_connected_kernel_gradient(
+	const struct fully_connected_kernel_gradient_context* context,
+	size_t output_channel, size_t input_channel)
+{
+	const size_t batch_size = context->batch_size;
+	const size_t input_channels = context->input_channels;
+	const size_t output_channels = context->output_channels;
+
+	const float (*input)[input_channels] = (const float(*)[input_channels]) context->input_pointer;
+	const float (*grad_output)[output_channels] = (const float(*)[output_channels]) context->grad_output_pointer;
+	float (*grad_kernel)[input_channels] = (float(*)[input_channels]) context->grad_kernel_pointer;
+
+	double v = 0.0;
+	for (size_t sample = 0; sample < batch_size; sample++) {
+		v += grad_output[sample][output_channel] * input[sample][input_channel];
+	}
+	grad_kernel[output_channel][input_channel] = v;
+}
+
+void nnp_fully_connected_kernel_gradient__reference(
+	size_t batch_size,
+	size_t input_channels,
+	size_t output_channels,
+	const float input_pointer[],
+	const float grad_output_pointer[],
+	float grad_kernel_pointer[],
+	pthreadpool_t threadpool)
+{
+	struct fully_connected_kernel_gradient_context fully_connected_kernel_gradient_context = {
+		.batch_size = batch_size,
+		.input_channels = input_channels,
+		.output_channels = output_channels,
+		.input_pointer = input_pointer,
+		.grad_output_pointer = grad_output_pointer,
+		.grad_kernel_pointer = grad_kernel_pointer
+	};
+
+	pthreadpool_compute_2d(threadpool,
+		(pthreadpool_function_2d_t) compute_fully_connected_kernel_gradient,
+		&fully_connected_kernel_gradient_context,
+		output_channels, input_channels);
+}
@@ -0,0 +1,101 @@
+#include <nnpack.h>
+#include <nnpack/reference.h>
+#include <nnpack/utils.h>
+
+struct max_pooling_input_gradient_context {
+	size_t channels;
+	struct nnp_size input_size;
+	struct nnp_padding input_padding;
+	struct nnp_size pooling_size;
+	struct nnp_size pooling_stride;
+	struct nnp_size output_size;
+	const float* input_pointer;
+	const float* grad_output_pointer;
+	float* grad_input_pointer;
+};
+
+static void compute_max_pooling_input_gradient(
+	const struct max_pooling_input_gradient_context context[restrict static 1],
+	size_t sample, size_t channel)
+{
+	const size_t channels                  = context->channels;
+	const struct nnp_size input_size       = context->input_size;
+	const struct nnp_padding input_padding = context->input_padding;
+	const struct nnp_size pooling_size     = context->pooling_size;
+	const struct nnp_size pooling_stride   = context->pooling_stride;
+	const struct nnp_size output_size      = context->output_size;
+
+	const float (*input)[channels][input_size.height][input_size.width] =
+		(const float(*)[channels][input_size.height][input_size.width]) context->input_pointer;
+	const float (*grad_output)[channels][output_size.height][output_size.width] =
+		(const float(*)[channels][output_size.height][output_size.width]) context->grad_output_pointer;
+	float (*grad_input)[channels][input_size.height][input_size.width] =
+		(float(*)[channels][input_size.height][input_size.width]) context->grad_input_pointer;
+
+	for (size_t s = 0; s < input_size.height; s++) {
+		for (size_t t = 0; t < input_size.width; t++) {
+			grad_input[sample][channel][s][t] = 0.0f;
+		}
+	}
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		for (size_t x = 0; x < output_size.width; x++) {
+			/* Among equal maxima the leftmost column, and then the topmost row, receives the gradient */
+			float max_value = -__builtin_inff();
+			size_t max_s = SIZE_MAX, max_t = SIZE_MAX;
+			for (size_t j = 0; j < pooling_size.width; j++) {
+				const size_t t = x * pooling_stride.width + j - input_padding.left;
+				if (t < input_size.width) {
+					for (size_t i = 0; i < pooling_size.height; i++) {
+						const size_t s = y * pooling_stride.height + i - input_padding.top;
+						if (s < input_size.height) {
+							if (input[sample][channel][s][t] > max_value) {
+								max_value = input[sample][channel][s][t];
+								max_s = s;
+								max_t = t;
+							}
+						}
+					}
+				}
+			}
+			if (max_s != SIZE_MAX) {
+				grad_input[sample][channel][max_s][max_t] += grad_output[sample][channel][y][x];
+			}
+		}
+	}
+}
+
+void nnp_max_pooling_input_gradient__reference(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float* input_pointer,
+	const float* grad_output_pointer,
+	float* grad_input_pointer,
+	pthreadpool_t threadpool)
+{
+	const struct nnp_size output_size = {
+		.height = pooling_output_dimension(input_size.height, input_padding.top, input_padding.bottom, pooling_size.height, pooling_stride.height),
+		.width = pooling_output_dimension(input_size.width, input_padding.left, input_padding.right, pooling_size.width, pooling_stride.width),
+	};
+
+	struct max_pooling_input_gradient_context max_pooling_input_gradient_context = {
+		.channels = channels,
+		.input_size = input_size,
+		.input_padding = input_padding,
+		.pooling_size = pooling_size,
+		.pooling_stride = pooling_stride,
+		.output_size = output_size,
+		.input_pointer = input_pointer,
+		.grad_output_pointer = grad_output_pointer,
+		.grad_input_pointer = grad_input_pointer,
+	};
+
+	pthreadpool_compute_2d(threadpool,
+		(pthreadpool_function_2d_t) compute_max_pooling_input_gradient,
+		&max_pooling_input_gradient_context,
+		batch_size, channels);
+}
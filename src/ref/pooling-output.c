@@ -60,8 +60,8 @@ void nnp_max_pooling_output__reference(
 	pthreadpool_t threadpool)
 {
 	const struct nnp_size output_size = {
-		.height = divide_round_up(input_padding.top + input_size.height + input_padding.bottom - pooling_size.height, pooling_stride.height) + 1,
-		.width = divide_round_up(input_padding.left + input_size.width + input_padding.right - pooling_size.width, pooling_stride.width) + 1,
+		.height = pooling_output_dimension(input_size.height, input_padding.top, input_padding.bottom, pooling_size.height, pooling_stride.height),
+		.width = pooling_output_dimension(input_size.width, input_padding.left, input_padding.right, pooling_size.width, pooling_stride.width),
 	};
 
 	struct max_pooling_output_context max_pooling_output_context = {
@@ -80,3 +80,95 @@ void nnp_max_pooling_output__reference(
 		&max_pooling_output_context,
 		batch_size, channels);
 }
+
+static void compute_average_pooling_output(
+	const struct max_pooling_output_context context[restrict static 1],
+	size_t sample, size_t channel)
+{
+	const size_t channels                  = context->channels;
+	const struct nnp_size input_size       = context->input_size;
+	const struct nnp_padding input_padding = context->input_padding;
+	const struct nnp_size pooling_size      = context->pooling_size;
+	const struct nnp_size pooling_stride    = context->pooling_stride;
+	const struct nnp_size output_size      = context->output_size;
+
+	const float (*input)[channels][input_size.height][input_size.width] =
+		(const float(*)[channels][input_size.height][input_size.width]) context->input_pointer;
+	float (*output)[channels][output_size.height][output_size.width] =
+		(float(*)[channels][output_size.height][output_size.width]) context->output_pointer;
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		for (size_t x = 0; x < output_size.width; x++) {
+			double sum = 0.0;
+			size_t count = 0;
+			for (size_t i = 0; i < pooling_size.height; i++) {
+				const size_t s = y * pooling_stride.height + i - input_padding.top;
+				if (s < input_size.height) {
+					for (size_t j = 0; j < pooling_size.width; j++) {
+						const size_t t = x * pooling_stride.width + j - input_padding.left;
+						if (t < input_size.width) {
+							sum += input[sample][channel][s][t];
+							count += 1;
+						}
+					}
+				}
+			}
+			output[sample][channel][y][x] = count != 0 ? sum / (double) count : 0.0;
+		}
+	}
+}
+
+void nnp_average_pooling_output__reference(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	struct nnp_padding input_padding,
+	struct nnp_size pooling_size,
+	struct nnp_size pooling_stride,
+	const float* input_pointer,
+	float* output_pointer,
+	pthreadpool_t threadpool)
+{
+	const struct nnp_size output_size = {
+		.height = pooling_output_dimension(input_size.height, input_padding.top, input_padding.bottom, pooling_size.height, pooling_stride.height),
+		.width = pooling_output_dimension(input_size.width, input_padding.left, input_padding.right, pooling_size.width, pooling_stride.width),
+	};
+
+	struct max_pooling_output_context average_pooling_output_context = {
+		.channels = channels,
+		.input_size = input_size,
+		.input_padding = input_padding,
+		.pooling_size = pooling_size,
+		.pooling_stride = pooling_stride,
+		.output_size = output_size,
+		.input_pointer = input_pointer,
+		.output_pointer = output_pointer
+	};
+
+	pthreadpool_compute_2d(threadpool,
+		(pthreadpool_function_2d_t) compute_average_pooling_output,
+		&average_pooling_output_context,
+		batch_size, channels);
+}
+
+void nnp_global_average_pooling_output__reference(
+	size_t batch_size,
+	size_t channels,
+	struct nnp_size input_size,
+	const float* input_pointer,
+	float* output_pointer,
+	pthreadpool_t threadpool)
+{
+	const size_t input_elements = input_size.height * input_size.width;
+	const float (*input)[channels][input_elements] = (const float(*)[channels][input_elements]) input_pointer;
+	float (*output)[channels] = (float(*)[channels]) output_pointer;
+	for (size_t sample = 0; sample < batch_size; sample++) {
+		for (size_t channel = 0; channel < channels; channel++) {
+			double sum = 0.0;
+			for (size_t i = 0; i < input_elements; i++) {
+				sum += input[sample][channel][i];
+			}
+			output[sample][channel] = sum / (double) input_elements;
+		}
+	}
+}
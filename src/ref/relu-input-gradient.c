@@ -0,0 +1,18 @@
+#include <nnpack.h>
+#include <nnpack/reference.h>
+
+#include <math.h>
+
+void nnp_relu_input_gradient__reference(
+	size_t batch_size,
+	size_t channels,
+	const float* grad_output,
+	const float* input,
+	float* grad_input,
+	float negative_slope,
+	pthreadpool_t threadpool)
+{
+	for (size_t i = 0; i < batch_size * channels; i++) {
+		grad_input[i] = signbit(input[i]) ? grad_output[i] * negative_slope : grad_output[i];
+	}
+}
@@ -0,0 +1,18 @@
+#include <nnpack.h>
+#include <nnpack/reference.h>
+
+#include <math.h>
+
+void nnp_relu_output__reference(
+	size_t batch_size,
+	size_t channels,
+	const float* input,
+	float* output,
+	float negative_slope,
+	pthreadpool_t threadpool)
+{
+	for (size_t i = 0; i < batch_size * channels; i++) {
+		const float data = input[i];
+		output[i] = signbit(data) ? data * negative_slope : data;
+	}
+}
@@ -0,0 +1,71 @@
+#include <stddef.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/hwinfo.h>
+
+#include <nnpack/activations.h>
+
+
+struct NNP_CACHE_ALIGN grad_relu_context {
+	const float* grad_output;
+	const float* input;
+	float* grad_input;
+	float negative_slope;
+};
+
+static void compute_grad_relu(
+	const struct grad_relu_context context[restrict static 1],
+	size_t block_start, size_t block_size)
+{
+	const float* grad_output = context->grad_output;
+	const float* input = context->input;
+	float* grad_input = context->grad_input;
+	const float negative_slope = context->negative_slope;
+
+	nnp_hwinfo.activations.grad_relu(grad_output + block_start, input + block_start, grad_input + block_start, block_size, negative_slope);
+}
+
+enum nnp_status nnp_relu_input_gradient(
+	size_t batch_size,
+	size_t channels,
+	const float grad_output[],
+	const float input[],
+	float grad_input[],
+	float negative_slope,
+	pthreadpool_t threadpool)
+{
+	if (!nnp_hwinfo.initialized) {
+		return nnp_status_uninitialized;
+	}
+
+	if (!nnp_hwinfo.supported) {
+		return nnp_status_unsupported_hardware;
+	}
+
+	if (batch_size == 0) {
+		return nnp_status_invalid_batch_size;
+	}
+
+	if (channels == 0) {
+		return nnp_status_invalid_channels;
+	}
+
+	/* Each block reads two arrays and writes one, so blocks are half as long as in nnp_relu_output */
+	const size_t simd_width = 8;
+	const size_t block_size = round_down(nnp_hwinfo.blocking.l1 / (2 * sizeof(float)), simd_width);
+
+	struct grad_relu_context grad_relu_context = {
+		.grad_output = grad_output,
+		.input = input,
+		.grad_input = grad_input,
+		.negative_slope = negative_slope,
+	};
+	pthreadpool_compute_1d_tiled(threadpool,
+		(pthreadpool_function_1d_tiled_t) compute_grad_relu,
+		&grad_relu_context,
+		batch_size * channels, block_size);
+
+	return nnp_status_success;
+}
@@ -0,0 +1,67 @@
+#include <stddef.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/hwinfo.h>
+
+#include <nnpack/activations.h>
+
+
+struct NNP_CACHE_ALIGN relu_context {
+	const float* input;
+	float* output;
+	float negative_slope;
+};
+
+static void compute_relu_output(
+	const struct relu_context context[restrict static 1],
+	size_t block_start, size_t block_size)
+{
+	const float* input = context->input;
+	float* output = context->output;
+	const float negative_slope = context->negative_slope;
+
+	nnp_hwinfo.activations.relu(input + block_start, output + block_start, block_size, negative_slope);
+}
+
+enum nnp_status nnp_relu_output(
+	size_t batch_size,
+	size_t channels,
+	const float input[],
+	float output[],
+	float negative_slope,
+	pthreadpool_t threadpool)
+{
+	if (!nnp_hwinfo.initialized) {
+		return nnp_status_uninitialized;
+	}
+
+	if (!nnp_hwinfo.supported) {
+		return nnp_status_unsupported_hardware;
+	}
+
+	if (batch_size == 0) {
+		return nnp_status_invalid_batch_size;
+	}
+
+	if (channels == 0) {
+		return nnp_status_invalid_channels;
+	}
+
+	/* The layer is elementwise, so the input is processed as a single vector split into L1-sized blocks */
+	const size_t simd_width = 8;
+	const size_t block_size = round_down(nnp_hwinfo.blocking.l1 / sizeof(float), simd_width);
+
+	struct relu_context relu_context = {
+		.input = input,
+		.output = output,
+		.negative_slope = negative_slope,
+	};
+	pthreadpool_compute_1d_tiled(threadpool,
+		(pthreadpool_function_1d_tiled_t) compute_relu_output,
+		&relu_context,
+		batch_size * channels, block_size);
+
+	return nnp_status_success;
+}
@@ -0,0 +1,65 @@
+#include <stddef.h>
+
+#include <nnpack.h>
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/hwinfo.h>
+
+#include <nnpack/softmax.h>
+
+
+struct NNP_CACHE_ALIGN softmax_context {
+	size_t channels;
+	const float* input;
+	float* output;
+};
+
+static void compute_softmax_output(
+	const struct softmax_context context[restrict static 1],
+	size_t sample)
+{
+	const size_t channels = context->channels;
+
+	const float (*input)[channels] = (const float(*)[channels]) context->input;
+	float (*output)[channels] = (float(*)[channels]) context->output;
+
+	const float max_element = nnp_hwinfo.softmax.vector_max(channels, input[sample]);
+	const float sum_exp = nnp_hwinfo.softmax.vector_exp_minus_c_and_sum(channels, input[sample], output[sample], max_element);
+	nnp_hwinfo.softmax.vector_scale(channels, output[sample], 1.0f / sum_exp);
+}
+
+enum nnp_status nnp_softmax_output(
+	size_t batch_size,
+	size_t channels,
+	const float input[],
+	float output[],
+	pthreadpool_t threadpool)
+{
+	if (!nnp_hwinfo.initialized) {
+		return nnp_status_uninitialized;
+	}
+
+	if (!nnp_hwinfo.supported) {
+		return nnp_status_unsupported_hardware;
+	}
+
+	if (batch_size == 0) {
+		return nnp_status_invalid_batch_size;
+	}
+
+	if (channels == 0) {
+		return nnp_status_invalid_channels;
+	}
+
+	struct softmax_context softmax_context = {
+		.channels = channels,
+		.input = input,
+		.output = output,
+	};
+	pthreadpool_compute_1d(threadpool,
+		(pthreadpool_function_1d_t) compute_softmax_output,
+		&softmax_context,
+		batch_size);
+
+	return nnp_status_success;
+}
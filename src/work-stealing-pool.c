@@ -0,0 +1,432 @@
+/*
+ * Work-stealing implementation of the pthreadpool interface.
+ *
+ * Every parallel region is linearized into a range of items, and the range is split into contiguous parts, one per
+ * thread. A thread processes items of its part from the front. When its part is exhausted, it steals items from the
+ * back of the parts of other threads, trying the threads on its own NUMA node before the remote ones.
+ *
+ * Threads are pinned to the processors which the process may run on. Parts are split in the same way on every call,
+ * so pages of a buffer which are first touched in a parallel region are allocated on the node of the thread which
+ * processes them, and later regions over the buffer mostly access local memory.
+ */
+
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__)
+	#include <sched.h>
+	#include <dirent.h>
+	#define MAX_PROCESSORS CPU_SETSIZE
+#else
+	#define MAX_PROCESSORS 1
+#endif
+
+#include <pthreadpool.h>
+
+#include <nnpack/macros.h>
+
+
+typedef void (*thread_function_t)(void* argument, size_t item);
+
+struct NNP_CACHE_ALIGN thread_info {
+	/* Items [range_start, range_end) of the current region which are not processed yet */
+	atomic_size_t range_start;
+	atomic_size_t range_end;
+	/* The number of items in the part which are not claimed yet, by the owner or by thieves */
+	atomic_size_t range_length;
+
+	size_t thread_number;
+	/* Processor which the thread is pinned to, or -1 if the thread is not pinned */
+	int processor;
+	uint32_t numa_node;
+	pthread_t thread_object;
+	struct pthreadpool* threadpool;
+};
+
+struct NNP_CACHE_ALIGN pthreadpool {
+	/* Serializes parallel regions submitted from different caller threads */
+	pthread_mutex_t execution_mutex;
+	/* Protects the fields below, up to threads_count */
+	pthread_mutex_t state_mutex;
+	pthread_cond_t command_condvar;
+	pthread_cond_t completion_condvar;
+	size_t command_generation;
+	size_t active_threads;
+	bool terminate;
+	thread_function_t function;
+	void* argument;
+
+	size_t threads_count;
+	struct thread_info threads[];
+};
+
+static size_t min(size_t a, size_t b) {
+	return a < b ? a : b;
+}
+
+static size_t divide_round_up(size_t dividend, size_t divisor) {
+	return (dividend + divisor - 1) / divisor;
+}
+
+/* Atomically decrements the value unless it is zero. Returns false if the value was zero. */
+static bool try_decrement(atomic_size_t* value) {
+	size_t actual_value = atomic_load_explicit(value, memory_order_relaxed);
+	while (actual_value != 0) {
+		if (atomic_compare_exchange_weak_explicit(value, &actual_value, actual_value - 1,
+			memory_order_relaxed, memory_order_relaxed))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static void run_items(struct pthreadpool* threadpool, struct thread_info* thread) {
+	const thread_function_t function = threadpool->function;
+	void* argument = threadpool->argument;
+	const size_t threads_count = threadpool->threads_count;
+
+	/* Process own items from the front of the part */
+	while (try_decrement(&thread->range_length)) {
+		const size_t item = atomic_fetch_add_explicit(&thread->range_start, 1, memory_order_relaxed);
+		function(argument, item);
+	}
+
+	/* Steal items from the back of other parts: first on the same NUMA node, then on the other nodes */
+	for (size_t pass = 0; pass < 2; pass++) {
+		const bool local_pass = (pass == 0);
+		for (size_t offset = 1; offset < threads_count; offset++) {
+			struct thread_info* victim = &threadpool->threads[(thread->thread_number + offset) % threads_count];
+			if ((victim->numa_node == thread->numa_node) != local_pass) {
+				continue;
+			}
+			while (try_decrement(&victim->range_length)) {
+				const size_t item = atomic_fetch_sub_explicit(&victim->range_end, 1, memory_order_relaxed) - 1;
+				function(argument, item);
+			}
+		}
+	}
+}
+
+static void pin_thread(struct thread_info* thread) {
+#if defined(__linux__)
+	if (thread->processor >= 0) {
+		cpu_set_t processors;
+		CPU_ZERO(&processors);
+		CPU_SET(thread->processor, &processors);
+		/* Pinning is an optimization: an unpinned thread still computes correct results */
+		pthread_setaffinity_np(pthread_self(), sizeof(processors), &processors);
+	}
+#endif
+}
+
+static void* thread_main(void* argument) {
+	struct thread_info* thread = (struct thread_info*) argument;
+	struct pthreadpool* threadpool = thread->threadpool;
+	pin_thread(thread);
+
+	size_t last_generation = 0;
+	for (;;) {
+		pthread_mutex_lock(&threadpool->state_mutex);
+		while ((threadpool->command_generation == last_generation) && !threadpool->terminate) {
+			pthread_cond_wait(&threadpool->command_condvar, &threadpool->state_mutex);
+		}
+		if (threadpool->terminate) {
+			pthread_mutex_unlock(&threadpool->state_mutex);
+			break;
+		}
+		last_generation = threadpool->command_generation;
+		pthread_mutex_unlock(&threadpool->state_mutex);
+
+		run_items(threadpool, thread);
+
+		pthread_mutex_lock(&threadpool->state_mutex);
+		if (--threadpool->active_threads == 0) {
+			pthread_cond_signal(&threadpool->completion_condvar);
+		}
+		pthread_mutex_unlock(&threadpool->state_mutex);
+	}
+	return NULL;
+}
+
+/* Returns the NUMA node of the processor, or 0 if the system does not report it */
+static uint32_t processor_numa_node(int processor) {
+	uint32_t numa_node = 0;
+#if defined(__linux__)
+	char path[64];
+	snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", processor);
+	DIR* directory = opendir(path);
+	if (directory != NULL) {
+		struct dirent* entry;
+		while ((entry = readdir(directory)) != NULL) {
+			unsigned int node;
+			if (sscanf(entry->d_name, "node%u", &node) == 1) {
+				numa_node = node;
+				break;
+			}
+		}
+		closedir(directory);
+	}
+#endif
+	return numa_node;
+}
+
+static void parallelize(struct pthreadpool* threadpool, thread_function_t function, void* argument, size_t range) {
+	pthread_mutex_lock(&threadpool->execution_mutex);
+
+	/* Parts are split in the same way on every call to keep first-touched pages local to the threads */
+	const size_t threads_count = threadpool->threads_count;
+	for (size_t thread_number = 0; thread_number < threads_count; thread_number++) {
+		struct thread_info* thread = &threadpool->threads[thread_number];
+		const size_t range_start = range * thread_number / threads_count;
+		const size_t range_end = range * (thread_number + 1) / threads_count;
+		atomic_store_explicit(&thread->range_start, range_start, memory_order_relaxed);
+		atomic_store_explicit(&thread->range_end, range_end, memory_order_relaxed);
+		atomic_store_explicit(&thread->range_length, range_end - range_start, memory_order_relaxed);
+	}
+
+	/* The state mutex publishes the parts to the threads, and their results back to the caller */
+	pthread_mutex_lock(&threadpool->state_mutex);
+	threadpool->function = function;
+	threadpool->argument = argument;
+	threadpool->active_threads = threads_count;
+	threadpool->command_generation += 1;
+	pthread_cond_broadcast(&threadpool->command_condvar);
+	while (threadpool->active_threads != 0) {
+		pthread_cond_wait(&threadpool->completion_condvar, &threadpool->state_mutex);
+	}
+	pthread_mutex_unlock(&threadpool->state_mutex);
+
+	pthread_mutex_unlock(&threadpool->execution_mutex);
+}
+
+pthreadpool_t pthreadpool_create(size_t threads_count) {
+	int processors[MAX_PROCESSORS];
+	size_t processors_count = 0;
+#if defined(__linux__)
+	cpu_set_t process_processors;
+	if (sched_getaffinity(0, sizeof(process_processors), &process_processors) == 0) {
+		for (int processor = 0; processor < CPU_SETSIZE; processor++) {
+			if (CPU_ISSET(processor, &process_processors)) {
+				processors[processors_count++] = processor;
+			}
+		}
+	}
+#endif
+
+	if (threads_count == 0) {
+		if (processors_count != 0) {
+			threads_count = processors_count;
+		} else {
+			const long online_processors = sysconf(_SC_NPROCESSORS_ONLN);
+			threads_count = (online_processors > 0 ? (size_t) online_processors : 1);
+		}
+	}
+
+	struct pthreadpool* threadpool = NULL;
+	if (posix_memalign((void**) &threadpool, 64, sizeof(struct pthreadpool) + threads_count * sizeof(struct thread_info)) != 0) {
+		return NULL;
+	}
+	pthread_mutex_init(&threadpool->execution_mutex, NULL);
+	pthread_mutex_init(&threadpool->state_mutex, NULL);
+	pthread_cond_init(&threadpool->command_condvar, NULL);
+	pthread_cond_init(&threadpool->completion_condvar, NULL);
+	threadpool->command_generation = 0;
+	threadpool->active_threads = 0;
+	threadpool->terminate = false;
+	threadpool->function = NULL;
+	threadpool->argument = NULL;
+	threadpool->threads_count = threads_count;
+
+	for (size_t thread_number = 0; thread_number < threads_count; thread_number++) {
+		struct thread_info* thread = &threadpool->threads[thread_number];
+		atomic_init(&thread->range_start, 0);
+		atomic_init(&thread->range_end, 0);
+		atomic_init(&thread->range_length, 0);
+		thread->thread_number = thread_number;
+		thread->threadpool = threadpool;
+		/* Threads beyond the number of processors share them, and then are not pinned */
+		if (thread_number < processors_count) {
+			thread->processor = processors[thread_number];
+			thread->numa_node = processor_numa_node(thread->processor);
+		} else {
+			thread->processor = -1;
+			thread->numa_node = 0;
+		}
+	}
+
+	for (size_t thread_number = 0; thread_number < threads_count; thread_number++) {
+		struct thread_info* thread = &threadpool->threads[thread_number];
+		if (pthread_create(&thread->thread_object, NULL, &thread_main, thread) != 0) {
+			/* Shut down the threads which were created */
+			threadpool->threads_count = thread_number;
+			pthreadpool_destroy(threadpool);
+			return NULL;
+		}
+	}
+	return threadpool;
+}
+
+size_t pthreadpool_get_threads_count(pthreadpool_t threadpool) {
+	return threadpool->threads_count;
+}
+
+struct compute_1d_tiled_context {
+	pthreadpool_function_1d_tiled_t function;
+	void* argument;
+	size_t range;
+	size_t tile;
+};
+
+static void compute_1d_tiled(const struct compute_1d_tiled_context* context, size_t item) {
+	const size_t start = item * context->tile;
+	context->function(context->argument, start, min(context->range - start, context->tile));
+}
+
+struct compute_2d_context {
+	pthreadpool_function_2d_t function;
+	void* argument;
+	size_t range_j;
+};
+
+static void compute_2d(const struct compute_2d_context* context, size_t item) {
+	context->function(context->argument, item / context->range_j, item % context->range_j);
+}
+
+struct compute_2d_tiled_context {
+	pthreadpool_function_2d_tiled_t function;
+	void* argument;
+	size_t range_i;
+	size_t range_j;
+	size_t tile_i;
+	size_t tile_j;
+	size_t tiles_j;
+};
+
+static void compute_2d_tiled(const struct compute_2d_tiled_context* context, size_t item) {
+	const size_t start_i = (item / context->tiles_j) * context->tile_i;
+	const size_t start_j = (item % context->tiles_j) * context->tile_j;
+	context->function(context->argument, start_i, start_j,
+		min(context->range_i - start_i, context->tile_i), min(context->range_j - start_j, context->tile_j));
+}
+
+void pthreadpool_compute_1d(
+	pthreadpool_t threadpool,
+	pthreadpool_function_1d_t function,
+	void* argument,
+	size_t range)
+{
+	if (threadpool == NULL) {
+		/* No thread pool provided: execute function sequentially on the calling thread */
+		for (size_t i = 0; i < range; i++) {
+			function(argument, i);
+		}
+	} else {
+		parallelize(threadpool, (thread_function_t) function, argument, range);
+	}
+}
+
+void pthreadpool_compute_1d_tiled(
+	pthreadpool_t threadpool,
+	pthreadpool_function_1d_tiled_t function,
+	void* argument,
+	size_t range,
+	size_t tile)
+{
+	if (threadpool == NULL) {
+		for (size_t i = 0; i < range; i += tile) {
+			function(argument, i, min(range - i, tile));
+		}
+	} else {
+		struct compute_1d_tiled_context context = {
+			.function = function,
+			.argument = argument,
+			.range = range,
+			.tile = tile,
+		};
+		parallelize(threadpool, (thread_function_t) compute_1d_tiled, &context, divide_round_up(range, tile));
+	}
+}
+
+void pthreadpool_compute_2d(
+	pthreadpool_t threadpool,
+	pthreadpool_function_2d_t function,
+	void* argument,
+	size_t range_i,
+	size_t range_j)
+{
+	if (threadpool == NULL) {
+		for (size_t i = 0; i < range_i; i++) {
+			for (size_t j = 0; j < range_j; j++) {
+				function(argument, i, j);
+			}
+		}
+	} else {
+		struct compute_2d_context context = {
+			.function = function,
+			.argument = argument,
+			.range_j = range_j,
+		};
+		parallelize(threadpool, (thread_function_t) compute_2d, &context, range_i * range_j);
+	}
+}
+
+void pthreadpool_compute_2d_tiled(
+	pthreadpool_t threadpool,
+	pthreadpool_function_2d_tiled_t function,
+	void* argument,
+	size_t range_i,
+	size_t range_j,
+	size_t tile_i,
+	size_t tile_j)
+{
+	if (threadpool == NULL) {
+		for (size_t i = 0; i < range_i; i += tile_i) {
+			for (size_t j = 0; j < range_j; j += tile_j) {
+				function(argument, i, j, min(range_i - i, tile_i), min(range_j - j, tile_j));
+			}
+		}
+	} else {
+		const size_t tiles_i = divide_round_up(range_i, tile_i);
+		const size_t tiles_j = divide_round_up(range_j, tile_j);
+		struct compute_2d_tiled_context context = {
+			.function = function,
+			.argument = argument,
+			.range_i = range_i,
+			.range_j = range_j,
+			.tile_i = tile_i,
+			.tile_j = tile_j,
+			.tiles_j = tiles_j,
+		};
+		parallelize(threadpool, (thread_function_t) compute_2d_tiled, &context, tiles_i * tiles_j);
+	}
+}
+
+void pthreadpool_destroy(pthreadpool_t threadpool) {
+	if (threadpool != NULL) {
+		pthread_mutex_lock(&threadpool->state_mutex);
+		threadpool->terminate = true;
+		pthread_cond_broadcast(&threadpool->command_condvar);
+		pthread_mutex_unlock(&threadpool->state_mutex);
+
+		for (size_t thread_number = 0; thread_number < threadpool->threads_count; thread_number++) {
+			pthread_join(threadpool->threads[thread_number].thread_object, NULL);
+		}
+
+		pthread_mutex_destroy(&threadpool->execution_mutex);
+		pthread_mutex_destroy(&threadpool->state_mutex);
+		pthread_cond_destroy(&threadpool->command_condvar);
+		pthread_cond_destroy(&threadpool->completion_condvar);
+		free(threadpool);
+	}
+}
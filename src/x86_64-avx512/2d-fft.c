@@ -0,0 +1,475 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/transform.h>
+#include <nnpack/activations.h>
+
+/*
+ * 2D real-to-complex FFT of 8x8 and 16x16 tiles.
+ *
+ * Each row of the tile takes one ZMM register (only the low 8 elements are used for 8x8 tiles), so FFTs along columns
+ * of the tile are computed with vector operations across registers:
+ *   1. A real FFT down the columns packs rows 2k and 2k+1 into a complex FFT of N/2 points. Its output is the
+ *      non-redundant half of the column spectra: X[0][*] and X[N/2][*] are real, X[1...N/2-1][*] are complex.
+ *   2. After a transpose, register c holds element c of all these spectra: real parts of X[0...N/2-1][c] in the low
+ *      half of the register, and imaginary parts in the high half, with X[N/2][c] in place of the imaginary part of
+ *      the real X[0][c].
+ *   3. A complex FFT of N points across the registers computes N/2 row spectra per register. Complex multiplication
+ *      of such half-split registers swaps the two halves.
+ *   4. X[0][*] + i X[N/2][*] is the FFT of two real rows at once; it is split into the non-redundant halves of both.
+ *
+ * The N*N/2 + 2 independent spectrum elements are packed into tuples of 16 real parts and 16 imaginary parts.
+ * Elements 0 and 8 of the first tuple are pairs of purely real coefficients, X[0][0], X[0][N/2] and X[N/2][0],
+ * X[N/2][N/2], stored as real and imaginary parts. Tuples are consumed only by the AVX-512 tuple GEMMs, which multiply
+ * coefficients element-wise, so the order of the other elements only has to match between forward and inverse FFT.
+ */
+
+/* Forces inlining, so that loops over the constant tile size are fully unrolled and data stays in registers */
+#define NNP_AVX512F_INLINE static inline __attribute__((__always_inline__))
+
+/* cos(2 pi k / 16) and sin(2 pi k / 16) */
+static const float cos_2pi_over_16[8] = {
+	0x1.000000p+0f,  0x1.D906BCp-1f,  0x1.6A09E6p-1f,  0x1.87DE2Ap-2f,
+	0.0f,           -0x1.87DE2Ap-2f, -0x1.6A09E6p-1f, -0x1.D906BCp-1f,
+};
+static const float sin_2pi_over_16[8] = {
+	0.0f,            0x1.87DE2Ap-2f,  0x1.6A09E6p-1f,  0x1.D906BCp-1f,
+	0x1.000000p+0f,  0x1.D906BCp-1f,  0x1.6A09E6p-1f,  0x1.87DE2Ap-2f,
+};
+
+/*
+ * Vector of complex numbers: either the real and imaginary parts are in separate registers (split), or a single
+ * register holds real parts in the low half and imaginary parts in the high half (half-split, only re is used).
+ */
+struct complex_vector {
+	__m512 re;
+	__m512 im;
+};
+
+/* Swaps the halves of the low n elements of a half-split register */
+NNP_AVX512F_INLINE __m512 swap_halves(size_t n, __m512 x) {
+	if (n == 16) {
+		return _mm512_shuffle_f32x4(x, x, _MM_SHUFFLE(1, 0, 3, 2));
+	} else {
+		return _mm512_shuffle_f32x4(x, x, _MM_SHUFFLE(3, 2, 0, 1));
+	}
+}
+
+/* Multiplies x by (c + i s) */
+NNP_AVX512F_INLINE struct complex_vector multiply_twiddle(size_t n, bool half_split, struct complex_vector x, float c, float s) {
+	if (half_split) {
+		/* (re + i im) * (c + i s) = (re * c - im * s) + i (im * c + re * s) */
+		const __mmask16 high_half = (n == 16) ? 0xFF00 : 0x00F0;
+		const __m512 signed_s = _mm512_mask_blend_ps(high_half, _mm512_set1_ps(-s), _mm512_set1_ps(s));
+		const __m512 swapped_s = _mm512_mul_ps(swap_halves(n, x.re), signed_s);
+		x.re = (c == 0.0f) ? swapped_s : _mm512_fmadd_ps(x.re, _mm512_set1_ps(c), swapped_s);
+	} else {
+		const __m512 re = x.re;
+		if (c == 0.0f) {
+			x.re = _mm512_mul_ps(x.im, _mm512_set1_ps(-s));
+			x.im = _mm512_mul_ps(re, _mm512_set1_ps(s));
+		} else {
+			x.re = _mm512_fnmadd_ps(x.im, _mm512_set1_ps(s), _mm512_mul_ps(re, _mm512_set1_ps(c)));
+			x.im = _mm512_fmadd_ps(re, _mm512_set1_ps(s), _mm512_mul_ps(x.im, _mm512_set1_ps(c)));
+		}
+	}
+	return x;
+}
+
+NNP_AVX512F_INLINE struct complex_vector add(bool half_split, struct complex_vector a, struct complex_vector b) {
+	a.re = _mm512_add_ps(a.re, b.re);
+	if (!half_split) {
+		a.im = _mm512_add_ps(a.im, b.im);
+	}
+	return a;
+}
+
+NNP_AVX512F_INLINE struct complex_vector subtract(bool half_split, struct complex_vector a, struct complex_vector b) {
+	a.re = _mm512_sub_ps(a.re, b.re);
+	if (!half_split) {
+		a.im = _mm512_sub_ps(a.im, b.im);
+	}
+	return a;
+}
+
+/*
+ * Radix-2 decimation-in-time complex FFT of `points` vectors, without normalization.
+ * n is the tile size, which defines the layout of half-split registers.
+ */
+NNP_AVX512F_INLINE void fft(size_t points, size_t n, bool half_split, bool inverse, struct complex_vector x[restrict static points]) {
+	struct complex_vector y[16];
+	for (size_t i = 0; i < points; i++) {
+		size_t reversed_i = 0;
+		for (size_t bit = 1; bit < points; bit *= 2) {
+			reversed_i = reversed_i * 2 + ((i / bit) & 1);
+		}
+		y[reversed_i] = x[i];
+	}
+
+	for (size_t length = 2; length <= points; length *= 2) {
+		for (size_t start = 0; start < points; start += length) {
+			for (size_t j = 0; j < length / 2; j++) {
+				struct complex_vector t = y[start + j + length / 2];
+				if (j != 0) {
+					const size_t k = j * (16 / length);
+					const float s = sin_2pi_over_16[k];
+					t = multiply_twiddle(n, half_split, t, cos_2pi_over_16[k], inverse ? s : -s);
+				}
+				y[start + j + length / 2] = subtract(half_split, y[start + j], t);
+				y[start + j] = add(half_split, y[start + j], t);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < points; i++) {
+		x[i] = y[i];
+	}
+}
+
+NNP_AVX512F_INLINE void transpose(size_t n, __m512 rows[restrict static 16]) {
+	if (n == 8) {
+		__m256 t[8], u[8];
+		for (size_t i = 0; i < 8; i += 2) {
+			t[i] = _mm256_unpacklo_ps(_mm512_castps512_ps256(rows[i]), _mm512_castps512_ps256(rows[i + 1]));
+			t[i + 1] = _mm256_unpackhi_ps(_mm512_castps512_ps256(rows[i]), _mm512_castps512_ps256(rows[i + 1]));
+		}
+		for (size_t i = 0; i < 8; i += 4) {
+			u[i + 0] = _mm256_shuffle_ps(t[i + 0], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+			u[i + 1] = _mm256_shuffle_ps(t[i + 0], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+			u[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+			u[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+		}
+		for (size_t i = 0; i < 4; i++) {
+			rows[i] = _mm512_castps256_ps512(_mm256_permute2f128_ps(u[i], u[i + 4], 0x20));
+			rows[i + 4] = _mm512_castps256_ps512(_mm256_permute2f128_ps(u[i], u[i + 4], 0x31));
+		}
+	} else {
+		__m512 t[16], u[16];
+		for (size_t i = 0; i < 16; i += 2) {
+			t[i] = _mm512_unpacklo_ps(rows[i], rows[i + 1]);
+			t[i + 1] = _mm512_unpackhi_ps(rows[i], rows[i + 1]);
+		}
+		/* Afterwards, 128-bit lane j of u[4 * g + k] holds element 4 * j + k of rows 4 * g ... 4 * g + 3 */
+		for (size_t i = 0; i < 16; i += 4) {
+			u[i + 0] = _mm512_castpd_ps(_mm512_unpacklo_pd(_mm512_castps_pd(t[i + 0]), _mm512_castps_pd(t[i + 2])));
+			u[i + 1] = _mm512_castpd_ps(_mm512_unpackhi_pd(_mm512_castps_pd(t[i + 0]), _mm512_castps_pd(t[i + 2])));
+			u[i + 2] = _mm512_castpd_ps(_mm512_unpacklo_pd(_mm512_castps_pd(t[i + 1]), _mm512_castps_pd(t[i + 3])));
+			u[i + 3] = _mm512_castpd_ps(_mm512_unpackhi_pd(_mm512_castps_pd(t[i + 1]), _mm512_castps_pd(t[i + 3])));
+		}
+		for (size_t k = 0; k < 4; k++) {
+			const __m512 p01 = _mm512_shuffle_f32x4(u[k], u[k + 4], _MM_SHUFFLE(1, 0, 1, 0));
+			const __m512 q01 = _mm512_shuffle_f32x4(u[k + 8], u[k + 12], _MM_SHUFFLE(1, 0, 1, 0));
+			const __m512 p23 = _mm512_shuffle_f32x4(u[k], u[k + 4], _MM_SHUFFLE(3, 2, 3, 2));
+			const __m512 q23 = _mm512_shuffle_f32x4(u[k + 8], u[k + 12], _MM_SHUFFLE(3, 2, 3, 2));
+			rows[k] = _mm512_shuffle_f32x4(p01, q01, _MM_SHUFFLE(2, 0, 2, 0));
+			rows[k + 4] = _mm512_shuffle_f32x4(p01, q01, _MM_SHUFFLE(3, 1, 3, 1));
+			rows[k + 8] = _mm512_shuffle_f32x4(p23, q23, _MM_SHUFFLE(2, 0, 2, 0));
+			rows[k + 12] = _mm512_shuffle_f32x4(p23, q23, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+	}
+}
+
+/* Mask of tile columns column_offset ... column_offset + column_count - 1, clipped to the tile */
+NNP_AVX512F_INLINE __mmask16 column_mask(size_t n, uint32_t column_count, uint32_t column_offset) {
+	return (__mmask16) (((UINT32_C(1) << min(n, column_offset + column_count)) - 1) & ~((UINT32_C(1) << column_offset) - 1));
+}
+
+/*
+ * Computes the spectrum of an n x n tile with row_count x column_count loaded elements (the rest is zero),
+ * and packs it into n*n/32 contiguous tuples.
+ */
+NNP_AVX512F_INLINE void fft2d(size_t n,
+	const float t[], size_t stride_t,
+	uint32_t row_count, uint32_t column_count,
+	uint32_t row_offset, uint32_t column_offset,
+	float packed[restrict static n * n])
+{
+	const size_t h = n / 2;
+	const __mmask16 load_mask = column_mask(n, column_count, column_offset);
+	__m512 rows[16];
+	for (uint32_t row = 0; row < n; row++) {
+		rows[row] = _mm512_setzero_ps();
+		if (row - row_offset < row_count) {
+			/* Masked elements are not loaded, so the offset address may point before the row */
+			rows[row] = _mm512_maskz_loadu_ps(load_mask, t + (row - row_offset) * stride_t - column_offset);
+		}
+	}
+
+	/* Real FFT down the columns: rows 2k and 2k+1 are the real and imaginary parts of a complex FFT of h points */
+	struct complex_vector z[8];
+	for (size_t k = 0; k < h; k++) {
+		z[k] = (struct complex_vector) { .re = rows[2 * k], .im = rows[2 * k + 1] };
+	}
+	fft(h, n, false, false, z);
+	rows[0] = _mm512_add_ps(z[0].re, z[0].im);
+	rows[h] = _mm512_sub_ps(z[0].re, z[0].im);
+	const __m512 half = _mm512_set1_ps(0.5f);
+	for (size_t u = 1; u < h; u++) {
+		/* X[u] = E[u] + exp(-2 pi i u / n) O[u], where E = (Z[u] + conj(Z[h-u])) / 2 and O = (Z[u] - conj(Z[h-u])) / 2i */
+		const __m512 even_re = _mm512_mul_ps(_mm512_add_ps(z[u].re, z[h - u].re), half);
+		const __m512 even_im = _mm512_mul_ps(_mm512_sub_ps(z[u].im, z[h - u].im), half);
+		const __m512 odd_re = _mm512_mul_ps(_mm512_add_ps(z[u].im, z[h - u].im), half);
+		const __m512 odd_im = _mm512_mul_ps(_mm512_sub_ps(z[h - u].re, z[u].re), half);
+		const __m512 c = _mm512_set1_ps(cos_2pi_over_16[u * (16 / n)]);
+		const __m512 s = _mm512_set1_ps(sin_2pi_over_16[u * (16 / n)]);
+		rows[u] = _mm512_add_ps(even_re, _mm512_fmadd_ps(odd_re, c, _mm512_mul_ps(odd_im, s)));
+		rows[h + u] = _mm512_add_ps(even_im, _mm512_fmsub_ps(odd_im, c, _mm512_mul_ps(odd_re, s)));
+	}
+
+	transpose(n, rows);
+
+	/* Complex FFT along rows of the tile, on half-split registers */
+	struct complex_vector w[16];
+	for (size_t column = 0; column < n; column++) {
+		w[column].re = rows[column];
+	}
+	fft(n, n, true, false, w);
+
+	float spectrum[16 * 16] NNP_SIMD_ALIGN;
+	for (size_t v = 0; v < n; v++) {
+		if (n == 16) {
+			_mm512_store_ps(&spectrum[v * n], w[v].re);
+		} else {
+			_mm256_store_ps(&spectrum[v * n], _mm512_castps512_ps256(w[v].re));
+		}
+	}
+
+	/*
+	 * Element 0 of each register holds Y[v] = A[v] + i B[v], where A and B are spectra of rows 0 and h of the column
+	 * spectra. Its real and imaginary parts are elements 0 and h of register v, and are replaced with
+	 * (A[0], A[h]) for v = 0, (B[0], B[h]) for v = h, A[v] for 0 < v < h, and B[v - h] for h < v < n.
+	 */
+	float a_re[8], a_im[8], b_re[8], b_im[8];
+	for (size_t v = 1; v < h; v++) {
+		const float y_re = spectrum[v * n], y_im = spectrum[v * n + h];
+		const float yc_re = spectrum[(n - v) * n], yc_im = spectrum[(n - v) * n + h];
+		a_re[v] = 0.5f * (y_re + yc_re);
+		a_im[v] = 0.5f * (y_im - yc_im);
+		b_re[v] = 0.5f * (y_im + yc_im);
+		b_im[v] = 0.5f * (yc_re - y_re);
+	}
+	const float y0_im = spectrum[h], yh_re = spectrum[h * n];
+	spectrum[h] = yh_re;
+	spectrum[h * n] = y0_im;
+	for (size_t v = 1; v < h; v++) {
+		spectrum[v * n] = a_re[v];
+		spectrum[v * n + h] = a_im[v];
+		spectrum[(h + v) * n] = b_re[v];
+		spectrum[(h + v) * n + h] = b_im[v];
+	}
+
+	for (size_t tuple = 0; tuple < n * n / 32; tuple++) {
+		if (n == 16) {
+			/* Tuple t holds registers t and t + 8 */
+			const __m512 low = _mm512_load_ps(&spectrum[tuple * 16]);
+			const __m512 high = _mm512_load_ps(&spectrum[(tuple + 8) * 16]);
+			_mm512_store_ps(&packed[tuple * 32], _mm512_shuffle_f32x4(low, high, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm512_store_ps(&packed[tuple * 32 + 16], _mm512_shuffle_f32x4(low, high, _MM_SHUFFLE(3, 2, 3, 2)));
+		} else {
+			/* Tuple t holds registers 2t, 2t + 1, 2t + 4, and 2t + 5 */
+			const __m512 low = _mm512_load_ps(&spectrum[tuple * 16]);
+			const __m512 high = _mm512_load_ps(&spectrum[tuple * 16 + 32]);
+			_mm512_store_ps(&packed[tuple * 32], _mm512_shuffle_f32x4(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm512_store_ps(&packed[tuple * 32 + 16], _mm512_shuffle_f32x4(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+		}
+	}
+}
+
+NNP_AVX512F_INLINE __m512 activation(__m512 x, const struct nnp_fused_activation* activation) {
+	const __mmask16 negative = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+	x = _mm512_mask_mul_ps(x, negative, x, _mm512_set1_ps(activation->negative_slope));
+	x = _mm512_max_ps(x, _mm512_set1_ps(activation->lower_bound));
+	return _mm512_min_ps(x, _mm512_set1_ps(activation->upper_bound));
+}
+
+/*
+ * Unpacks n*n/32 contiguous tuples into an n x n spectrum, computes the inverse FFT, adds bias, applies the activation
+ * unless it is NULL, and stores row_count x column_count elements starting from (row_offset, column_offset).
+ */
+NNP_AVX512F_INLINE void ifft2d(size_t n,
+	const float packed[restrict static n * n],
+	float t[], size_t stride_t,
+	float bias, const struct nnp_fused_activation* fused_activation,
+	uint32_t row_count, uint32_t column_count,
+	uint32_t row_offset, uint32_t column_offset)
+{
+	const size_t h = n / 2;
+	float spectrum[16 * 16] NNP_SIMD_ALIGN;
+	for (size_t tuple = 0; tuple < n * n / 32; tuple++) {
+		const __m512 re = _mm512_load_ps(&packed[tuple * 32]);
+		const __m512 im = _mm512_load_ps(&packed[tuple * 32 + 16]);
+		if (n == 16) {
+			_mm512_store_ps(&spectrum[tuple * 16], _mm512_shuffle_f32x4(re, im, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm512_store_ps(&spectrum[(tuple + 8) * 16], _mm512_shuffle_f32x4(re, im, _MM_SHUFFLE(3, 2, 3, 2)));
+		} else {
+			const __m512 low = _mm512_shuffle_f32x4(re, im, _MM_SHUFFLE(1, 0, 1, 0));
+			const __m512 high = _mm512_shuffle_f32x4(re, im, _MM_SHUFFLE(3, 2, 3, 2));
+			_mm512_store_ps(&spectrum[tuple * 16], _mm512_shuffle_f32x4(low, low, _MM_SHUFFLE(3, 1, 2, 0)));
+			_mm512_store_ps(&spectrum[tuple * 16 + 32], _mm512_shuffle_f32x4(high, high, _MM_SHUFFLE(3, 1, 2, 0)));
+		}
+	}
+
+	/* Recombines spectra of rows 0 and h of the column spectra into Y[v] = A[v] + i B[v] */
+	float y_re[16], y_im[16];
+	y_re[0] = spectrum[0];
+	y_im[0] = spectrum[h * n];
+	y_re[h] = spectrum[h];
+	y_im[h] = spectrum[h * n + h];
+	for (size_t v = 1; v < h; v++) {
+		const float a_re = spectrum[v * n], a_im = spectrum[v * n + h];
+		const float b_re = spectrum[(h + v) * n], b_im = spectrum[(h + v) * n + h];
+		y_re[v] = a_re - b_im;
+		y_im[v] = a_im + b_re;
+		y_re[n - v] = a_re + b_im;
+		y_im[n - v] = b_re - a_im;
+	}
+	struct complex_vector w[16];
+	for (size_t v = 0; v < n; v++) {
+		spectrum[v * n] = y_re[v];
+		spectrum[v * n + h] = y_im[v];
+		if (n == 16) {
+			w[v].re = _mm512_load_ps(&spectrum[v * n]);
+		} else {
+			w[v].re = _mm512_castps256_ps512(_mm256_load_ps(&spectrum[v * n]));
+		}
+	}
+
+	/* Inverse complex FFT along rows of the tile, on half-split registers */
+	fft(n, n, true, true, w);
+
+	__m512 rows[16];
+	for (size_t column = 0; column < n; column++) {
+		rows[column] = w[column].re;
+	}
+	transpose(n, rows);
+
+	/* Inverse real FFT down the columns: Z[u] = E[u] + i O[u], without the factors 1/2 */
+	struct complex_vector z[8];
+	z[0] = (struct complex_vector) {
+		.re = _mm512_add_ps(rows[0], rows[h]),
+		.im = _mm512_sub_ps(rows[0], rows[h]),
+	};
+	for (size_t u = 1; u < h; u++) {
+		const __m512 x_re = rows[u], x_im = rows[h + u];
+		const __m512 xc_re = rows[h - u], xc_im = rows[n - u];
+		const __m512 even_re = _mm512_add_ps(x_re, xc_re);
+		const __m512 even_im = _mm512_sub_ps(x_im, xc_im);
+		const __m512 difference_re = _mm512_sub_ps(x_re, xc_re);
+		const __m512 difference_im = _mm512_add_ps(x_im, xc_im);
+		const __m512 c = _mm512_set1_ps(cos_2pi_over_16[u * (16 / n)]);
+		const __m512 s = _mm512_set1_ps(sin_2pi_over_16[u * (16 / n)]);
+		/* O[u] = (X[u] - conj(X[h-u])) * exp(2 pi i u / n) */
+		const __m512 odd_re = _mm512_fmsub_ps(difference_re, c, _mm512_mul_ps(difference_im, s));
+		const __m512 odd_im = _mm512_fmadd_ps(difference_re, s, _mm512_mul_ps(difference_im, c));
+		z[u] = (struct complex_vector) {
+			.re = _mm512_sub_ps(even_re, odd_im),
+			.im = _mm512_add_ps(even_im, odd_re),
+		};
+	}
+	fft(h, n, false, true, z);
+
+	const __mmask16 store_mask = column_mask(n, column_count, column_offset);
+	const __m512 scale = _mm512_set1_ps(1.0f / (float) (n * n));
+	const __m512 vbias = _mm512_set1_ps(bias);
+	for (uint32_t row = 0; row < n; row++) {
+		if (row - row_offset < row_count) {
+			__m512 data = _mm512_fmadd_ps(row % 2 == 0 ? z[row / 2].re : z[row / 2].im, scale, vbias);
+			if (fused_activation != NULL) {
+				data = activation(data, fused_activation);
+			}
+			/* Masked elements are not stored, so the offset address may point before the row */
+			_mm512_mask_storeu_ps(t + (row - row_offset) * stride_t - column_offset, store_mask, data);
+		}
+	}
+}
+
+NNP_AVX512F_INLINE void fft2d_and_store(size_t n, bool stream,
+	const float t[], float f[], size_t stride_t, size_t stride_f,
+	uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset)
+{
+	float packed[16 * 16] NNP_SIMD_ALIGN;
+	fft2d(n, t, stride_t, row_count, column_count, row_offset, column_offset, packed);
+	for (size_t tuple = 0; tuple < n * n / 32; tuple++) {
+		float* f_tuple = (float*) ((char*) f + tuple * stride_f);
+		for (size_t i = 0; i < 32; i += 16) {
+			const __m512 data = _mm512_load_ps(&packed[tuple * 32 + i]);
+			if (stream) {
+				_mm512_stream_ps(f_tuple + i, data);
+			} else {
+				_mm512_store_ps(f_tuple + i, data);
+			}
+		}
+	}
+}
+
+NNP_AVX512F_INLINE void ifft2d_and_store(size_t n,
+	const float f[], float t[], size_t stride_f, size_t stride_t,
+	float bias, const struct nnp_fused_activation* activation,
+	uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset)
+{
+	float packed[16 * 16] NNP_SIMD_ALIGN;
+	for (size_t tuple = 0; tuple < n * n / 32; tuple++) {
+		const float* f_tuple = (const float*) ((const char*) f + tuple * stride_f);
+		for (size_t i = 0; i < 32; i += 16) {
+			_mm512_store_ps(&packed[tuple * 32 + i], _mm512_load_ps(f_tuple + i));
+		}
+	}
+	ifft2d(n, packed, t, stride_t, bias, activation, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft8x8_and_store__avx512f(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	fft2d_and_store(8, false, t, f, stride_t, stride_f, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft8x8_and_stream__avx512f(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	fft2d_and_store(8, true, t, f, stride_t, stride_f, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft8x8_and_macc__avx512f(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	float packed[8 * 8] NNP_SIMD_ALIGN;
+	fft2d(8, t, stride_t, row_count, column_count, row_offset, column_offset, packed);
+	nnp_ft8x8gemmc__avx512f(f, x, packed);
+}
+
+void nnp_ifft8x8__avx512f(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	ifft2d_and_store(8, f, t, stride_f, stride_t, 0.0f, NULL, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_ifft8x8_with_bias__avx512f(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count) {
+	ifft2d_and_store(8, f, t, stride_f, stride_t, *bias, NULL, row_count, column_count, 0, 0);
+}
+
+void nnp_ifft8x8_with_bias_activation__avx512f(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation) {
+	ifft2d_and_store(8, f, t, stride_f, stride_t, *bias, activation, row_count, column_count, 0, 0);
+}
+
+void nnp_fft16x16_and_store__avx512f(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	fft2d_and_store(16, false, t, f, stride_t, stride_f, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft16x16_and_stream__avx512f(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	fft2d_and_store(16, true, t, f, stride_t, stride_f, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft16x16_and_macc__avx512f(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	float packed[16 * 16] NNP_SIMD_ALIGN;
+	fft2d(16, t, stride_t, row_count, column_count, row_offset, column_offset, packed);
+	nnp_ft16x16gemmc__avx512f(f, x, packed);
+}
+
+void nnp_ifft16x16__avx512f(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	ifft2d_and_store(16, f, t, stride_f, stride_t, 0.0f, NULL, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_ifft16x16_with_bias__avx512f(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count) {
+	ifft2d_and_store(16, f, t, stride_f, stride_t, *bias, NULL, row_count, column_count, 0, 0);
+}
+
+void nnp_ifft16x16_with_bias_activation__avx512f(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation) {
+	ifft2d_and_store(16, f, t, stride_f, stride_t, *bias, activation, row_count, column_count, 0, 0);
+}
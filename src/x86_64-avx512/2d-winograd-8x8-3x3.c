@@ -0,0 +1,267 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/transform.h>
+#include <nnpack/activations.h>
+
+/*
+ * Winograd F(6x6, 3x3) transforms of 8x8 tiles.
+ * Each row of 8 elements takes one YMM register, and transformed tiles are stored transposed as 4 tuples of 16 elements,
+ * two rows per tuple, which are loaded and stored with ZMM registers.
+ */
+
+/* Forces inlining, so that row and column loops over constant bounds are fully unrolled */
+#define NNP_AVX512F_INLINE static inline __attribute__((__always_inline__))
+
+NNP_AVX512F_INLINE __m256 madd(__m256 acc, __m256 x, float c) {
+	return _mm256_add_ps(acc, _mm256_mul_ps(x, _mm256_set1_ps(c)));
+}
+
+NNP_AVX512F_INLINE __m512 join_rows(__m256 lo, __m256 hi) {
+	return _mm512_castpd_ps(_mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(lo)), _mm256_castps_pd(hi), 1));
+}
+
+NNP_AVX512F_INLINE __m256 lower_row(__m512 rows) {
+	return _mm512_castps512_ps256(rows);
+}
+
+NNP_AVX512F_INLINE __m256 upper_row(__m512 rows) {
+	return _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(rows), 1));
+}
+
+NNP_AVX512F_INLINE void input_transform(__m256 rows[restrict static 8]) {
+	const __m256 d[8] = { rows[0], rows[1], rows[2], rows[3], rows[4], rows[5], rows[6], rows[7] };
+	/* wd0 = d6 - 36 * d0 + 49 * d2 - 14 * d4 */
+	rows[0] = madd(madd(madd(d[6], d[0], -36.0f), d[2], 49.0f), d[4], -14.0f);
+	/* wd1, wd2 = (d6 + 36 * d2 - 13 * d4) +- (d5 + 36 * d1 - 13 * d3) */
+	const __m256 even36 = madd(madd(d[6], d[2], 36.0f), d[4], -13.0f);
+	const __m256 odd36 = madd(madd(d[5], d[1], 36.0f), d[3], -13.0f);
+	rows[1] = _mm256_add_ps(even36, odd36);
+	rows[2] = _mm256_sub_ps(even36, odd36);
+	/* wd3, wd4 = (d6 + 9 * d2 - 10 * d4) +- 2 * (d5 + 9 * d1 - 10 * d3) */
+	const __m256 even9 = madd(madd(d[6], d[2], 9.0f), d[4], -10.0f);
+	const __m256 odd9 = madd(madd(d[5], d[1], 9.0f), d[3], -10.0f);
+	rows[3] = madd(even9, odd9, 2.0f);
+	rows[4] = madd(even9, odd9, -2.0f);
+	/* wd5, wd6 = (d6 + 4 * d2 - 5 * d4) +- 3 * (d5 + 4 * d1 - 5 * d3) */
+	const __m256 even4 = madd(madd(d[6], d[2], 4.0f), d[4], -5.0f);
+	const __m256 odd4 = madd(madd(d[5], d[1], 4.0f), d[3], -5.0f);
+	rows[5] = madd(even4, odd4, 3.0f);
+	rows[6] = madd(even4, odd4, -3.0f);
+	/* wd7 = d7 - 36 * d1 + 49 * d3 - 14 * d5 */
+	rows[7] = madd(madd(madd(d[7], d[1], -36.0f), d[3], 49.0f), d[5], -14.0f);
+}
+
+NNP_AVX512F_INLINE void output_transform(__m256 rows[restrict static 8]) {
+	const __m256 m1_add_m2 = _mm256_add_ps(rows[1], rows[2]);
+	const __m256 m1_sub_m2 = _mm256_sub_ps(rows[1], rows[2]);
+	const __m256 m3_add_m4 = _mm256_add_ps(rows[3], rows[4]);
+	const __m256 m3_sub_m4 = _mm256_sub_ps(rows[3], rows[4]);
+	const __m256 m5_add_m6 = _mm256_add_ps(rows[5], rows[6]);
+	const __m256 m5_sub_m6 = _mm256_sub_ps(rows[5], rows[6]);
+
+	rows[0] = _mm256_add_ps(_mm256_add_ps(rows[0], m1_add_m2), _mm256_add_ps(m3_add_m4, m5_add_m6));
+	rows[1] = madd(madd(m1_sub_m2, m3_sub_m4, 2.0f), m5_sub_m6, 3.0f);
+	rows[2] = madd(madd(m1_add_m2, m3_add_m4, 4.0f), m5_add_m6, 9.0f);
+	rows[3] = madd(madd(m1_sub_m2, m3_sub_m4, 8.0f), m5_sub_m6, 27.0f);
+	rows[4] = madd(madd(m1_add_m2, m3_add_m4, 16.0f), m5_add_m6, 81.0f);
+	rows[5] = madd(madd(_mm256_add_ps(rows[7], m1_sub_m2), m3_sub_m4, 32.0f), m5_sub_m6, 243.0f);
+	rows[6] = rows[7] = _mm256_setzero_ps();
+}
+
+NNP_AVX512F_INLINE void transpose8x8(__m256 rows[restrict static 8]) {
+	__m256 t[8], u[8];
+	for (size_t i = 0; i < 8; i += 2) {
+		t[i] = _mm256_unpacklo_ps(rows[i], rows[i + 1]);
+		t[i + 1] = _mm256_unpackhi_ps(rows[i], rows[i + 1]);
+	}
+	for (size_t i = 0; i < 8; i += 4) {
+		u[i + 0] = _mm256_shuffle_ps(t[i + 0], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+		u[i + 1] = _mm256_shuffle_ps(t[i + 0], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+		u[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+		u[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+	}
+	for (size_t i = 0; i < 4; i++) {
+		rows[i] = _mm256_permute2f128_ps(u[i], u[i + 4], 0x20);
+		rows[i + 4] = _mm256_permute2f128_ps(u[i], u[i + 4], 0x31);
+	}
+}
+
+/* Stores rows 2*k and 2*k+1 as the k-th tuple */
+NNP_AVX512F_INLINE void store_rows(float* data, size_t stride_bytes, const __m256 rows[restrict static 8], bool stream) {
+	for (size_t tuple = 0; tuple < 4; tuple++) {
+		float* data_tuple = (float*) ((char*) data + tuple * stride_bytes);
+		const __m512 data_rows = join_rows(rows[tuple * 2], rows[tuple * 2 + 1]);
+		if (stream) {
+			_mm512_stream_ps(data_tuple, data_rows);
+		} else {
+			_mm512_store_ps(data_tuple, data_rows);
+		}
+	}
+}
+
+NNP_AVX512F_INLINE void iwt8x8_3x3(const float d[], float wd[], size_t stride_d, size_t stride_wd,
+	uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset, bool stream)
+{
+	/* Elements which would fall outside of the 8x8 tile are not loaded, as in the AVX2 version */
+	const __mmask16 column_mask = (__mmask16) (((UINT32_C(1) << min(8, column_offset + column_count)) - 1) &
+		~((UINT32_C(1) << column_offset) - 1));
+	__m256 rows[8];
+	for (uint32_t row = 0; row < 8; row++) {
+		rows[row] = _mm256_setzero_ps();
+		if (row - row_offset < row_count) {
+			/* Masked elements are not loaded, so the offset address may point before the row */
+			const float* d_row = d + (row - row_offset) * stride_d - column_offset;
+			rows[row] = _mm512_castps512_ps256(_mm512_maskz_loadu_ps(column_mask, d_row));
+		}
+	}
+	input_transform(rows);
+	transpose8x8(rows);
+	input_transform(rows);
+	store_rows(wd, stride_wd, rows, stream);
+}
+
+/*
+ * Kernel transform matrix, including the normalization factors:
+ *   wg0 = g0 * (-1/36)
+ *   wg1, wg2 = (g0 +- g1 + g2) * (1/48)
+ *   wg3, wg4 = (g0 +- 2 * g1 + 4 * g2) * (-1/120)
+ *   wg5, wg6 = (g0 +- 3 * g1 + 9 * g2) * (1/720)
+ *   wg7 = g2
+ */
+static const float kernel_transform_matrix[8][3] = {
+	{ -1.0f / 36.0f,           0.0f,           0.0f },
+	{  1.0f / 48.0f,   1.0f / 48.0f,   1.0f / 48.0f },
+	{  1.0f / 48.0f,  -1.0f / 48.0f,   1.0f / 48.0f },
+	{ -1.0f / 120.0f, -2.0f / 120.0f, -4.0f / 120.0f },
+	{ -1.0f / 120.0f,  2.0f / 120.0f, -4.0f / 120.0f },
+	{  1.0f / 720.0f,  3.0f / 720.0f,  9.0f / 720.0f },
+	{  1.0f / 720.0f, -3.0f / 720.0f,  9.0f / 720.0f },
+	{           0.0f,           0.0f,           1.0f },
+};
+
+NNP_AVX512F_INLINE void kwt8x8_3x3(const float g[], size_t stride_g, bool reverse_kernel, __m256 rows[restrict static 8]) {
+	/* Transform columns of the kernel: wg[i][c] = sum(G[i][r] * g[r][c]), stored transposed as 3 rows of 8 elements */
+	float wg_columns[3][8] NNP_SIMD_ALIGN;
+	for (size_t c = 0; c < 3; c++) {
+		for (size_t i = 0; i < 8; i++) {
+			float sum = 0.0f;
+			for (size_t r = 0; r < 3; r++) {
+				const float element = reverse_kernel ?
+					g[(2 - r) * stride_g + (2 - c)] : g[r * stride_g + c];
+				sum += kernel_transform_matrix[i][r] * element;
+			}
+			wg_columns[c][i] = sum;
+		}
+	}
+
+	/* Transform rows of the transposed result */
+	const __m256 p0 = _mm256_load_ps(wg_columns[0]);
+	const __m256 p1 = _mm256_load_ps(wg_columns[1]);
+	const __m256 p2 = _mm256_load_ps(wg_columns[2]);
+	for (size_t j = 0; j < 8; j++) {
+		rows[j] = madd(madd(
+			_mm256_mul_ps(p0, _mm256_set1_ps(kernel_transform_matrix[j][0])),
+			p1, kernel_transform_matrix[j][1]),
+			p2, kernel_transform_matrix[j][2]);
+	}
+}
+
+NNP_AVX512F_INLINE void kwt8x8_3x3_and_mac(const float g[], float wg[], const float x[], size_t stride_g, bool reverse_kernel) {
+	__m256 rows[8];
+	kwt8x8_3x3(g, stride_g, reverse_kernel, rows);
+	for (size_t tuple = 0; tuple < 4; tuple++) {
+		float* wg_tuple = wg + tuple * 16;
+		_mm512_store_ps(wg_tuple, _mm512_fmadd_ps(join_rows(rows[tuple * 2], rows[tuple * 2 + 1]),
+			_mm512_load_ps(x + tuple * 16), _mm512_load_ps(wg_tuple)));
+	}
+}
+
+/* Negative elements are scaled by the slope, then clamped to the bounds; NaN elements produce the lower bound */
+NNP_AVX512F_INLINE __m512 activation(__m512 x, const struct nnp_fused_activation* activation) {
+	const __mmask16 negative = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+	x = _mm512_mask_mul_ps(x, negative, x, _mm512_set1_ps(activation->negative_slope));
+	x = _mm512_max_ps(x, _mm512_set1_ps(activation->lower_bound));
+	return _mm512_min_ps(x, _mm512_set1_ps(activation->upper_bound));
+}
+
+NNP_AVX512F_INLINE void owt8x8_3x3(const float m[], float s[], size_t stride_m, size_t stride_s,
+	uint32_t row_count, uint32_t column_count, float bias, const struct nnp_fused_activation* fused_activation)
+{
+	__m256 rows[8];
+	for (size_t tuple = 0; tuple < 4; tuple++) {
+		const __m512 m_rows = _mm512_load_ps((const float*) ((const char*) m + tuple * stride_m));
+		rows[tuple * 2] = lower_row(m_rows);
+		rows[tuple * 2 + 1] = upper_row(m_rows);
+	}
+	output_transform(rows);
+	transpose8x8(rows);
+	output_transform(rows);
+
+	const __mmask16 column_mask = (__mmask16) ((UINT32_C(1) << column_count) - 1);
+	const __m512 vbias = _mm512_set1_ps(bias);
+	for (uint32_t row = 0; row < row_count; row++) {
+		__m512 data = _mm512_add_ps(_mm512_castps256_ps512(rows[row]), vbias);
+		if (fused_activation != NULL) {
+			data = activation(data, fused_activation);
+		}
+		_mm512_mask_storeu_ps(s + row * stride_s, column_mask, data);
+	}
+}
+
+void nnp_iwt8x8_3x3_and_store__avx512f(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	iwt8x8_3x3(d, wd, stride_d, stride_wd, row_count, column_count, row_offset, column_offset, false);
+}
+
+void nnp_iwt8x8_3x3_and_stream__avx512f(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	iwt8x8_3x3(d, wd, stride_d, stride_wd, row_count, column_count, row_offset, column_offset, true);
+}
+
+void nnp_kwt8x8_3x3_and_store__avx512f(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	__m256 rows[8];
+	kwt8x8_3x3(g, stride_g, false, rows);
+	store_rows(wg, stride_wg, rows, false);
+}
+
+void nnp_kwt8x8_3x3_and_stream__avx512f(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	__m256 rows[8];
+	kwt8x8_3x3(g, stride_g, false, rows);
+	store_rows(wg, stride_wg, rows, true);
+}
+
+void nnp_kwt8x8_3x3_and_mac__avx512f(const float g[], float wg[], const float x[], size_t stride_g) {
+	kwt8x8_3x3_and_mac(g, wg, x, stride_g, false);
+}
+
+void nnp_kwt8x8_3Rx3R_and_store__avx512f(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	__m256 rows[8];
+	kwt8x8_3x3(g, stride_g, true, rows);
+	store_rows(wg, stride_wg, rows, false);
+}
+
+void nnp_kwt8x8_3Rx3R_and_stream__avx512f(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	__m256 rows[8];
+	kwt8x8_3x3(g, stride_g, true, rows);
+	store_rows(wg, stride_wg, rows, true);
+}
+
+void nnp_kwt8x8_3Rx3R_and_mac__avx512f(const float g[], float wg[], const float x[], size_t stride_g) {
+	kwt8x8_3x3_and_mac(g, wg, x, stride_g, true);
+}
+
+void nnp_owt8x8_3x3__avx512f(const float m[], float s[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	owt8x8_3x3(m, s, stride_m, stride_s, row_count, column_count, 0.0f, NULL);
+}
+
+void nnp_owt8x8_3x3_with_bias__avx512f(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count) {
+	owt8x8_3x3(m, s, stride_m, stride_s, row_count, column_count, *bias, NULL);
+}
+
+void nnp_owt8x8_3x3_with_bias_activation__avx512f(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation) {
+	owt8x8_3x3(m, s, stride_m, stride_s, row_count, column_count, *bias, activation);
+}
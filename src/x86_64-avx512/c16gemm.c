@@ -0,0 +1,173 @@
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/blas.h>
+#include <nnpack/transform.h>
+
+#define MR_MAX 3
+#define NR_MAX 3
+
+/*
+ * A complex tuple is 16 real parts followed by 16 imaginary parts, and takes two ZMM registers.
+ * In mixed (s4c14) tuples elements 0 and 8 of both the real and the imaginary part are independent real numbers,
+ * and are multiplied element-wise instead of as complex numbers.
+ */
+#define MIXED_ELEMENTS ((__mmask16) 0x0101)
+
+struct tuple {
+	__m512 re;
+	__m512 im;
+};
+
+static inline struct tuple load_tuple(const float* data) {
+	return (struct tuple) {
+		.re = _mm512_load_ps(data),
+		.im = _mm512_load_ps(data + 16),
+	};
+}
+
+static inline void store_tuple(float* data, struct tuple t) {
+	_mm512_store_ps(data, t.re);
+	_mm512_store_ps(data + 16, t.im);
+}
+
+/*
+ * Multiplier operand, pre-processed for mixed tuples:
+ * re_for_im holds the elements which multiply x.im, and im has zeroes instead of the real-only elements.
+ */
+struct multiplier {
+	__m512 re;
+	__m512 re_for_im;
+	__m512 im;
+};
+
+static inline struct multiplier prepare_multiplier(struct tuple y, bool mixed) {
+	if (mixed) {
+		return (struct multiplier) {
+			.re = y.re,
+			.re_for_im = _mm512_mask_mov_ps(y.re, MIXED_ELEMENTS, y.im),
+			.im = _mm512_maskz_mov_ps((__mmask16) ~MIXED_ELEMENTS, y.im),
+		};
+	} else {
+		return (struct multiplier) {
+			.re = y.re,
+			.re_for_im = y.re,
+			.im = y.im,
+		};
+	}
+}
+
+/* acc += x * y, or acc += x * conj(y) */
+static inline __attribute__((__always_inline__)) struct tuple multiply_accumulate(struct tuple acc, struct tuple x, struct multiplier y, bool conjugate_y) {
+	acc.re = _mm512_fmadd_ps(x.re, y.re, acc.re);
+	acc.im = _mm512_fmadd_ps(x.im, y.re_for_im, acc.im);
+	if (conjugate_y) {
+		acc.re = _mm512_fmadd_ps(x.im, y.im, acc.re);
+		acc.im = _mm512_fnmadd_ps(x.re, y.im, acc.im);
+	} else {
+		acc.re = _mm512_fnmadd_ps(x.im, y.im, acc.re);
+		acc.im = _mm512_fmadd_ps(x.re, y.im, acc.im);
+	}
+	return acc;
+}
+
+/*
+ * A 3x3 block of C keeps 18 accumulators in registers.
+ * Always inlined, so that loops over mr and nr are fully unrolled.
+ */
+static inline __attribute__((__always_inline__)) void cgemm(size_t mr, size_t nr, bool mixed, bool conjugate_a, bool conjugate_b,
+	size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride_c, size_t column_stride_c)
+{
+	struct tuple vc[MR_MAX][NR_MAX];
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nr; n++) {
+			vc[m][n] = (struct tuple) { .re = _mm512_setzero_ps(), .im = _mm512_setzero_ps() };
+		}
+	}
+
+	for (; k != 0; k--) {
+		if (conjugate_a) {
+			/* conj(a) * b is computed as b * conj(a) */
+			struct tuple vb[NR_MAX];
+			for (size_t n = 0; n < nr; n++) {
+				vb[n] = load_tuple(b + n * 32);
+			}
+			for (size_t m = 0; m < mr; m++) {
+				const struct multiplier ya = prepare_multiplier(load_tuple(a + m * 32), mixed);
+				for (size_t n = 0; n < nr; n++) {
+					vc[m][n] = multiply_accumulate(vc[m][n], vb[n], ya, true);
+				}
+			}
+		} else {
+			struct tuple va[MR_MAX];
+			for (size_t m = 0; m < mr; m++) {
+				va[m] = load_tuple(a + m * 32);
+			}
+			for (size_t n = 0; n < nr; n++) {
+				const struct multiplier yb = prepare_multiplier(load_tuple(b + n * 32), mixed);
+				for (size_t m = 0; m < mr; m++) {
+					vc[m][n] = multiply_accumulate(vc[m][n], va[m], yb, conjugate_b);
+				}
+			}
+		}
+
+		a += mr * 32;
+		b += nr * 32;
+	}
+
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nr; n++) {
+			float* c_mn = c + m * row_stride_c + n * column_stride_c;
+			if (k_tile != 0) {
+				const struct tuple c_old = load_tuple(c_mn);
+				vc[m][n].re = _mm512_add_ps(vc[m][n].re, c_old.re);
+				vc[m][n].im = _mm512_add_ps(vc[m][n].im, c_old.im);
+			}
+			store_tuple(c_mn, vc[m][n]);
+		}
+	}
+}
+
+#define NNP_CGEMM_AVX512F(TYPE, CONJUGATE, MR, NR, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	void nnp_##TYPE##gemm##CONJUGATE##MR##x##NR##__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride_c, size_t column_stride_c) { \
+		cgemm(MR, NR, MIXED, CONJUGATE_A, CONJUGATE_B, k, k_tile, a, b, c, row_stride_c, column_stride_c); \
+	}
+
+#define NNP_CGEMM_AVX512F_BLOCKS(TYPE, CONJUGATE, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 1, 1, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 1, 2, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 1, 3, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 2, 1, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 2, 2, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 2, 3, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 3, 1, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 3, 2, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	NNP_CGEMM_AVX512F(TYPE, CONJUGATE, 3, 3, MIXED, CONJUGATE_A, CONJUGATE_B)
+
+NNP_CGEMM_AVX512F_BLOCKS(c16,   , false, false, false)
+NNP_CGEMM_AVX512F_BLOCKS(s4c14, , true,  false, false)
+NNP_CGEMM_AVX512F_BLOCKS(c16,   ca, false, true, false)
+NNP_CGEMM_AVX512F_BLOCKS(s4c14, ca, true,  true, false)
+NNP_CGEMM_AVX512F_BLOCKS(c16,   cb, false, false, true)
+NNP_CGEMM_AVX512F_BLOCKS(s4c14, cb, true,  false, true)
+
+/* Accumulates x * conj(y) over a tile of tuple_count complex tuples, where the first tuple is mixed */
+static inline void tile_gemmc(size_t tuple_count, float* acc, const float* x, const float* y) {
+	for (size_t tuple = 0; tuple < tuple_count; tuple++) {
+		const struct multiplier vy = prepare_multiplier(load_tuple(y), tuple == 0);
+		store_tuple(acc, multiply_accumulate(load_tuple(acc), load_tuple(x), vy, true));
+		acc += 32;
+		x += 32;
+		y += 32;
+	}
+}
+
+void nnp_ft8x8gemmc__avx512f(float acc[], const float x[], const float y[]) {
+	tile_gemmc(2, acc, x, y);
+}
+
+void nnp_ft16x16gemmc__avx512f(float acc[], const float x[], const float y[]) {
+	tile_gemmc(8, acc, x, y);
+}
@@ -0,0 +1,45 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/activations.h>
+
+/* Multiplies elements with the sign bit set (including -0.0) by the slope, as the AVX2 kernels do */
+static inline __m512 relu(__m512 data, __m512 negative_slope, __m512 sign_source) {
+	const __mmask16 negative = _mm512_test_epi32_mask(_mm512_castps_si512(sign_source), _mm512_set1_epi32(INT32_MIN));
+	return _mm512_mask_mul_ps(data, negative, data, negative_slope);
+}
+
+void nnp_relu__avx512f(const float* input, float* output, size_t length, float negative_slope) {
+	const __m512 vslope = _mm512_set1_ps(negative_slope);
+	for (; length >= 16; length -= 16) {
+		const __m512 vdata = _mm512_loadu_ps(input);
+		_mm512_storeu_ps(output, relu(vdata, vslope, vdata));
+		input += 16;
+		output += 16;
+	}
+	if (length != 0) {
+		const __mmask16 mask = (__mmask16) ((UINT32_C(1) << length) - 1);
+		const __m512 vdata = _mm512_maskz_loadu_ps(mask, input);
+		_mm512_mask_storeu_ps(output, mask, relu(vdata, vslope, vdata));
+	}
+}
+
+void nnp_grad_relu__avx512f(const float* output_gradient, const float* input, float* input_gradient, size_t length, float negative_slope) {
+	const __m512 vslope = _mm512_set1_ps(negative_slope);
+	for (; length >= 16; length -= 16) {
+		const __m512 vgradient = _mm512_loadu_ps(output_gradient);
+		const __m512 vinput = _mm512_loadu_ps(input);
+		_mm512_storeu_ps(input_gradient, relu(vgradient, vslope, vinput));
+		output_gradient += 16;
+		input += 16;
+		input_gradient += 16;
+	}
+	if (length != 0) {
+		const __mmask16 mask = (__mmask16) ((UINT32_C(1) << length) - 1);
+		const __m512 vgradient = _mm512_maskz_loadu_ps(mask, output_gradient);
+		const __m512 vinput = _mm512_maskz_loadu_ps(mask, input);
+		_mm512_mask_storeu_ps(input_gradient, mask, relu(vgradient, vslope, vinput));
+	}
+}
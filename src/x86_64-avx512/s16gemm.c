@@ -0,0 +1,85 @@
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/blas.h>
+#include <nnpack/transform.h>
+
+#define MR_MAX 4
+#define NR_MAX 6
+
+/*
+ * Every 16-element tuple takes one ZMM register. A 4x6 block of C keeps 24 accumulators in registers,
+ * and leaves enough of the 32 registers for 4 tuples of A and a tuple of B.
+ * Always inlined, so that loops over mr and nr are fully unrolled.
+ */
+static inline __attribute__((__always_inline__)) void s16gemm(size_t mr, size_t nr, size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride_c, size_t column_stride_c) {
+	__m512 vc[MR_MAX][NR_MAX];
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nr; n++) {
+			vc[m][n] = _mm512_setzero_ps();
+		}
+	}
+
+	for (; k != 0; k--) {
+		__m512 va[MR_MAX];
+		for (size_t m = 0; m < mr; m++) {
+			va[m] = _mm512_load_ps(a + m * 16);
+		}
+		for (size_t n = 0; n < nr; n++) {
+			const __m512 vb = _mm512_load_ps(b + n * 16);
+			for (size_t m = 0; m < mr; m++) {
+				vc[m][n] = _mm512_fmadd_ps(va[m], vb, vc[m][n]);
+			}
+		}
+
+		a += mr * 16;
+		b += nr * 16;
+	}
+
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nr; n++) {
+			float* c_mn = c + m * row_stride_c + n * column_stride_c;
+			if (k_tile != 0) {
+				vc[m][n] = _mm512_add_ps(vc[m][n], _mm512_load_ps(c_mn));
+			}
+			_mm512_store_ps(c_mn, vc[m][n]);
+		}
+	}
+}
+
+#define NNP_S16GEMM_AVX512F(MR, NR) \
+	void nnp_s16gemm##MR##x##NR##__avx512f(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride_c, size_t column_stride_c) { \
+		s16gemm(MR, NR, k, k_tile, a, b, c, row_stride_c, column_stride_c); \
+	}
+
+NNP_S16GEMM_AVX512F(1, 1)
+NNP_S16GEMM_AVX512F(1, 2)
+NNP_S16GEMM_AVX512F(1, 3)
+NNP_S16GEMM_AVX512F(1, 4)
+NNP_S16GEMM_AVX512F(1, 5)
+NNP_S16GEMM_AVX512F(1, 6)
+NNP_S16GEMM_AVX512F(2, 1)
+NNP_S16GEMM_AVX512F(2, 2)
+NNP_S16GEMM_AVX512F(2, 3)
+NNP_S16GEMM_AVX512F(2, 4)
+NNP_S16GEMM_AVX512F(2, 5)
+NNP_S16GEMM_AVX512F(2, 6)
+NNP_S16GEMM_AVX512F(3, 1)
+NNP_S16GEMM_AVX512F(3, 2)
+NNP_S16GEMM_AVX512F(3, 3)
+NNP_S16GEMM_AVX512F(3, 4)
+NNP_S16GEMM_AVX512F(3, 5)
+NNP_S16GEMM_AVX512F(3, 6)
+NNP_S16GEMM_AVX512F(4, 1)
+NNP_S16GEMM_AVX512F(4, 2)
+NNP_S16GEMM_AVX512F(4, 3)
+NNP_S16GEMM_AVX512F(4, 4)
+NNP_S16GEMM_AVX512F(4, 5)
+NNP_S16GEMM_AVX512F(4, 6)
+
+void nnp_s8x8gemm__avx512f(float acc[], const float x[], const float y[]) {
+	for (size_t i = 0; i < 64; i += 16) {
+		_mm512_store_ps(acc + i, _mm512_fmadd_ps(_mm512_load_ps(x + i), _mm512_load_ps(y + i), _mm512_load_ps(acc + i)));
+	}
+}
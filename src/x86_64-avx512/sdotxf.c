@@ -0,0 +1,48 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/blas.h>
+
+/* Always inlined, so that the loop over fused vectors is fully unrolled and accumulators stay in registers */
+static inline __attribute__((__always_inline__)) void sdotxf(size_t fusion_factor, const float* x, const float* y, size_t stride_y, float* sum, size_t n) {
+	__m512 vacc[8];
+	for (size_t f = 0; f < fusion_factor; f++) {
+		vacc[f] = _mm512_setzero_ps();
+	}
+
+	for (; n >= 16; n -= 16) {
+		const __m512 vx = _mm512_loadu_ps(x);
+		for (size_t f = 0; f < fusion_factor; f++) {
+			vacc[f] = _mm512_fmadd_ps(vx, _mm512_loadu_ps(y + f * stride_y), vacc[f]);
+		}
+		x += 16;
+		y += 16;
+	}
+	if (n != 0) {
+		const __mmask16 mask = (__mmask16) ((UINT32_C(1) << n) - 1);
+		const __m512 vx = _mm512_maskz_loadu_ps(mask, x);
+		for (size_t f = 0; f < fusion_factor; f++) {
+			vacc[f] = _mm512_fmadd_ps(vx, _mm512_maskz_loadu_ps(mask, y + f * stride_y), vacc[f]);
+		}
+	}
+
+	for (size_t f = 0; f < fusion_factor; f++) {
+		sum[f] = _mm512_reduce_add_ps(vacc[f]);
+	}
+}
+
+#define NNP_SDOTXF_AVX512F(FUSION_FACTOR) \
+	void nnp_sdotxf##FUSION_FACTOR##__avx512f(const float* x, const float* y, size_t stride_y, float* sum, size_t n) { \
+		sdotxf(FUSION_FACTOR, x, y, stride_y, sum, n); \
+	}
+
+NNP_SDOTXF_AVX512F(1)
+NNP_SDOTXF_AVX512F(2)
+NNP_SDOTXF_AVX512F(3)
+NNP_SDOTXF_AVX512F(4)
+NNP_SDOTXF_AVX512F(5)
+NNP_SDOTXF_AVX512F(6)
+NNP_SDOTXF_AVX512F(7)
+NNP_SDOTXF_AVX512F(8)
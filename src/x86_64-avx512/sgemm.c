@@ -0,0 +1,78 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/blas.h>
+
+/*
+ * The packed panels hold mr_max elements of A and nr_max elements of B per k, as for the FMA3 kernels, but the register
+ * block is 4x48: a row of C takes three full ZMM registers, thus 12 accumulators, 3 vectors of B and a broadcast of A
+ * stay in registers. Column variants step by 16, and the last 16 columns of C are updated only where col_mask is non-zero.
+ */
+#define MR_MAX 4
+#define NR_MAX 48
+
+/* Returns a mask of 16 bits, one for each 32-bit element of the column mask */
+static inline __mmask16 column_mask_bits(const void* col_mask) {
+	const __m512i mask = _mm512_loadu_si512(col_mask);
+	return _mm512_test_epi32_mask(mask, mask);
+}
+
+/* Always inlined, so that loops over mr and nr are fully unrolled and accumulators stay in registers */
+static inline __attribute__((__always_inline__)) void sgemm(size_t mr, size_t nr, size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask) {
+	/* Number of ZMM registers per row of C */
+	const size_t nv = nr / 16;
+	const __mmask16 last_mask = column_mask_bits(col_mask);
+
+	__m512 vc[MR_MAX][NR_MAX / 16];
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nv; n++) {
+			vc[m][n] = _mm512_setzero_ps();
+		}
+	}
+
+	do {
+		__m512 vb[NR_MAX / 16];
+		for (size_t n = 0; n < nv; n++) {
+			vb[n] = _mm512_loadu_ps(b + n * 16);
+		}
+		for (size_t m = 0; m < mr; m++) {
+			const __m512 va = _mm512_set1_ps(a[m]);
+			for (size_t n = 0; n < nv; n++) {
+				vc[m][n] = _mm512_fmadd_ps(va, vb[n], vc[m][n]);
+			}
+		}
+		a += MR_MAX;
+		b += NR_MAX;
+	} while (--k);
+
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nv; n++) {
+			const __mmask16 mask = (n + 1 == nv) ? last_mask : 0xFFFF;
+			if (k_block_number != 0) {
+				vc[m][n] = _mm512_add_ps(vc[m][n], _mm512_maskz_loadu_ps(mask, c + n * 16));
+			}
+			_mm512_mask_storeu_ps(c + n * 16, mask, vc[m][n]);
+		}
+		c += row_stride_c;
+	}
+}
+
+#define NNP_SGEMM_AVX512F(MR, NR) \
+	void nnp_sgemm_##MR##x##NR##__avx512f(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask) { \
+		sgemm(MR, NR, k, k_block_number, a, b, c, row_stride_c, col_mask); \
+	}
+
+NNP_SGEMM_AVX512F(1, 16)
+NNP_SGEMM_AVX512F(1, 32)
+NNP_SGEMM_AVX512F(1, 48)
+NNP_SGEMM_AVX512F(2, 16)
+NNP_SGEMM_AVX512F(2, 32)
+NNP_SGEMM_AVX512F(2, 48)
+NNP_SGEMM_AVX512F(3, 16)
+NNP_SGEMM_AVX512F(3, 32)
+NNP_SGEMM_AVX512F(3, 48)
+NNP_SGEMM_AVX512F(4, 16)
+NNP_SGEMM_AVX512F(4, 32)
+NNP_SGEMM_AVX512F(4, 48)
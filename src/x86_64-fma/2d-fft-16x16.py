@@ -1,4 +1,5 @@
 import fft16x16
+from common import load_activation
 import fft.complex_soa
 import fft.two_real_to_two_complex_soa_perm_planar
 import fft.two_complex_soa_perm_to_two_real_planar
@@ -202,12 +203,17 @@ arg_row_count = Argument(uint32_t, name="row_count")
 arg_column_count = Argument(uint32_t, name="column_count")
 arg_row_offset = Argument(uint32_t, name="row_offset")
 arg_column_offset = Argument(uint32_t, name="column_offset")
-for with_bias in [False, True]:
+arg_activation = Argument(ptr(const_float_), name="activation")
+for with_bias, with_activation in [(False, False), (True, False), (True, True)]:
     if with_bias:
         ifft16x16_arguments = (arg_f_pointer, arg_t_pointer, arg_bias, arg_f_stride, arg_t_stride, arg_row_count, arg_column_count)
+        if with_activation:
+            ifft16x16_arguments += (arg_activation,)
     else:
         ifft16x16_arguments = (arg_f_pointer, arg_t_pointer, arg_f_stride, arg_t_stride, arg_row_count, arg_column_count, arg_row_offset, arg_column_offset)
-    with Function("nnp_ifft16x16{with_bias}__avx2".format(with_bias="_with_bias" if with_bias else ""),
+    with Function("nnp_ifft16x16{with_bias}{with_activation}__avx2".format(
+            with_bias="_with_bias" if with_bias else "",
+            with_activation="_activation" if with_activation else ""),
         ifft16x16_arguments, target=uarch.default + isa.fma3 + isa.avx2):
 
         reg_f = GeneralPurposeRegister64()
@@ -220,6 +226,16 @@ for with_bias in [False, True]:
             reg_bias = GeneralPurposeRegister64()
             LOAD.ARGUMENT(reg_bias, arg_bias)
 
+        activation_parameters = None
+        if with_activation:
+            # Parameters are kept in memory: the inverse transform occupies all registers
+            reg_activation = GeneralPurposeRegister64()
+            LOAD.ARGUMENT(reg_activation, arg_activation)
+
+            activation_parameters = [LocalVariable(YMMRegister.size) for _ in range(3)]
+            for parameter, ymm_parameter in zip(activation_parameters, load_activation(reg_activation)):
+                VMOVAPS(parameter, ymm_parameter)
+
         reg_f_stride = GeneralPurposeRegister64()
         LOAD.ARGUMENT(reg_f_stride, arg_f_stride)
 
@@ -346,14 +362,14 @@ for with_bias in [False, True]:
         LEA(reg_t8_column_8, [reg_t8 + YMMRegister.size])
 
         fft16x16.inverse_vfft(reg_t0, reg_t8, reg_t_stride, data_in=vfft_columns_0_to_8,
-            reg_row_start=reg_row_start, reg_row_end=reg_row_end, store_mask=store_mask_columns_0_to_8)
+            reg_row_start=reg_row_start, reg_row_end=reg_row_end, store_mask=store_mask_columns_0_to_8, activation_parameters=activation_parameters)
 
         with Block() as store_columns_8_to_16:
             CMP(reg_column_end, 8)
             JB(store_columns_8_to_16.end)
 
             fft16x16.inverse_vfft(reg_t0_column_8, reg_t8_column_8, reg_t_stride, data_in=vfft_columns_8_to_16,
-                reg_row_start=reg_row_start, reg_row_end=reg_row_end, store_mask=store_mask_columns_8_to_16)
+                reg_row_start=reg_row_start, reg_row_end=reg_row_end, store_mask=store_mask_columns_8_to_16, activation_parameters=activation_parameters)
 
 
         RETURN()
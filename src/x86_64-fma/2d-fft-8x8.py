@@ -4,6 +4,7 @@ import fft.complex_soa_perm_to_real
 import fft.two_real_to_two_complex_soa_perm_planar
 import fft.two_complex_soa_perm_to_two_real_planar
 import block8x8
+from common import activation, load_activation
 
 
 arg_t_pointer = Argument(ptr(const_float_), name="t_pointer")
@@ -127,12 +128,17 @@ arg_row_offset = Argument(uint32_t, name="row_offset")
 arg_row_count = Argument(uint32_t, name="row_count")
 arg_column_offset = Argument(uint32_t, name="column_offset")
 arg_column_count = Argument(uint32_t, name="column_count")
-for with_bias in [False, True]:
+arg_activation = Argument(ptr(const_float_), name="activation")
+for with_bias, with_activation in [(False, False), (True, False), (True, True)]:
     if with_bias:
         ifft8x8_arguments = (arg_f_pointer, arg_t_pointer, arg_bias, arg_f_stride, arg_t_stride, arg_row_count, arg_column_count)
+        if with_activation:
+            ifft8x8_arguments += (arg_activation,)
     else:
         ifft8x8_arguments = (arg_f_pointer, arg_t_pointer, arg_f_stride, arg_t_stride, arg_row_count, arg_column_count, arg_row_offset, arg_column_offset)
-    with Function("nnp_ifft8x8{with_bias}__avx2".format(with_bias="_with_bias" if with_bias else ""),
+    with Function("nnp_ifft8x8{with_bias}{with_activation}__avx2".format(
+            with_bias="_with_bias" if with_bias else "",
+            with_activation="_activation" if with_activation else ""),
         ifft8x8_arguments,
         target=uarch.default + isa.fma3 + isa.avx2):
 
@@ -189,6 +195,12 @@ for with_bias in [False, True]:
         fft.complex_soa.fft8_within_rows(ymm_real, ymm_imag, transformation="inverse")
         fft.complex_soa_perm_to_real.ifft8_across_rows(ymm_data)
 
+        if with_activation:
+            reg_activation = GeneralPurposeRegister64()
+            LOAD.ARGUMENT(reg_activation, arg_activation)
+
+            activation(ymm_data, load_activation(reg_activation))
+
         block8x8.store_packed(ymm_data, reg_t, reg_t_stride, reg_row_count, reg_column_end, reg_row_start, reg_column_start)
 
         RETURN()
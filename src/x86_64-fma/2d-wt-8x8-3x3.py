@@ -1,6 +1,6 @@
 import winograd.o6x6k3x3
 import block8x8
-from common import _MM_SHUFFLE
+from common import _MM_SHUFFLE, activation, load_activation
 
 
 for post_operation in ["store", "stream"]:
@@ -174,12 +174,17 @@ arg_row_count = Argument(uint32_t, name="row_count")
 arg_column_count = Argument(uint32_t, name="column_count")
 arg_row_offset = Argument(uint32_t, name="row_offset")
 arg_column_offset = Argument(uint32_t, name="column_offset")
-for with_bias in [False, True]:
+arg_activation = Argument(ptr(const_float_), name="activation")
+for with_bias, with_activation in [(False, False), (True, False), (True, True)]:
     if with_bias:
         owt8x8_arguments = (arg_m_pointer, arg_s_pointer, arg_bias, arg_m_stride, arg_s_stride, arg_row_count, arg_column_count)
+        if with_activation:
+            owt8x8_arguments += (arg_activation,)
     else:
         owt8x8_arguments = (arg_m_pointer, arg_s_pointer, arg_m_stride, arg_s_stride, arg_row_count, arg_column_count, arg_row_offset, arg_column_offset)
-    with Function("nnp_owt8x8_3x3{with_bias}__avx2".format(with_bias="_with_bias" if with_bias else ""),
+    with Function("nnp_owt8x8_3x3{with_bias}{with_activation}__avx2".format(
+            with_bias="_with_bias" if with_bias else "",
+            with_activation="_activation" if with_activation else ""),
         owt8x8_arguments, target=uarch.default + isa.fma3 + isa.avx2):
 
         reg_m = GeneralPurposeRegister64()
@@ -223,6 +228,12 @@ for with_bias in [False, True]:
 
         ymm_s = winograd.o6x6k3x3.output_transform(ymm_tt)
 
+        if with_activation:
+            reg_activation = GeneralPurposeRegister64()
+            LOAD.ARGUMENT(reg_activation, arg_activation)
+
+            activation(ymm_s, load_activation(reg_activation))
+
         block8x8.store_packed(ymm_s, reg_s, reg_s_stride, reg_row_count, reg_column_count)
 
         RETURN()
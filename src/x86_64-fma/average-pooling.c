@@ -0,0 +1,124 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/pooling.h>
+
+static const int32_t mask_table[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+/* Returns a mask which enables the first min(count, 8) elements of a vector */
+static inline __m256i prefix_mask(size_t count) {
+	return _mm256_loadu_si256((const __m256i*) &mask_table[8 - min(count, 8)]);
+}
+
+static inline float _mm256_reduce_add_ps(__m256 x) {
+	__m128 y = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+	y = _mm_add_ps(y, _mm_movehl_ps(y, y));
+	y = _mm_add_ss(y, _mm_movehdup_ps(y));
+	return _mm_cvtss_f32(y);
+}
+
+/*
+ * Same two-pass structure as nnp_maxpool_generic__avx2, but the row buffer is padded with zeroes,
+ * and every window sum is divided by the number of input (non-padding) pixels in the window.
+ */
+void nnp_avgpool_generic__avx2(const float* input, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size)
+{
+	/* The last pooling window may extend up to pooling_stride.width - 1 elements past the right padding */
+	const size_t row_size = round_up(input_padding.left + input_size.width + input_padding.right + pooling_stride.width, 8) + 8;
+	NNP_SIMD_ALIGN float row[row_size];
+	for (size_t x = 0; x < input_padding.left; x++) {
+		row[x] = 0.0f;
+	}
+	for (size_t x = input_padding.left + input_size.width; x < row_size; x++) {
+		row[x] = 0.0f;
+	}
+	float* row_data = row + input_padding.left;
+
+	const __m256i column_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i stride_width = _mm256_set1_epi32((int32_t) pooling_stride.width);
+	const __m256i gather_index = _mm256_mullo_epi32(column_index, stride_width);
+	const __m256i padding_left = _mm256_set1_epi32((int32_t) input_padding.left);
+	const __m256i pooling_width = _mm256_set1_epi32((int32_t) pooling_size.width);
+	const __m256i input_width = _mm256_set1_epi32((int32_t) input_size.width);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		const size_t window_start = y * pooling_stride.height;
+		const size_t input_row_start = doz(window_start, input_padding.top);
+		const size_t input_row_end = min(doz(window_start + pooling_size.height, input_padding.top), input_size.height);
+		const __m256i input_row_count = _mm256_set1_epi32((int32_t) doz(input_row_end, input_row_start));
+
+		/* Vertical pass */
+		for (size_t x = 0; x < input_size.width; x += 8) {
+			const __m256i mask = prefix_mask(input_size.width - x);
+			__m256 sum = _mm256_setzero_ps();
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				sum = _mm256_add_ps(sum, _mm256_maskload_ps(&input[input_row * input_size.width + x], mask));
+			}
+			_mm256_maskstore_ps(&row_data[x], mask, sum);
+		}
+
+		/* Horizontal pass */
+		float* output_row = output + y * output_size.width;
+		for (size_t x = 0; x < output_size.width; x += 8) {
+			const __m256i mask = prefix_mask(output_size.width - x);
+			const float* window = row + x * pooling_stride.width;
+			__m256 sum = _mm256_setzero_ps();
+			if (pooling_stride.width == 1) {
+				for (size_t i = 0; i < pooling_size.width; i++) {
+					sum = _mm256_add_ps(sum, _mm256_loadu_ps(&window[i]));
+				}
+			} else {
+				for (size_t i = 0; i < pooling_size.width; i++) {
+					sum = _mm256_add_ps(sum,
+						_mm256_mask_i32gather_ps(_mm256_setzero_ps(), &window[i], gather_index, _mm256_castsi256_ps(mask), sizeof(float)));
+				}
+			}
+
+			/* Number of input columns in the window: [window_start - padding_left, window_end - padding_left) clipped to [0, input_width) */
+			const __m256i window_column_start = _mm256_sub_epi32(
+				_mm256_mullo_epi32(_mm256_add_epi32(column_index, _mm256_set1_epi32((int32_t) x)), stride_width),
+				padding_left);
+			const __m256i input_column_start = _mm256_max_epi32(window_column_start, zero);
+			const __m256i input_column_end = _mm256_min_epi32(_mm256_add_epi32(window_column_start, pooling_width), input_width);
+			const __m256i input_column_count = _mm256_max_epi32(_mm256_sub_epi32(input_column_end, input_column_start), zero);
+
+			/* Windows without input pixels produce zero */
+			const __m256 input_pixel_count = _mm256_max_ps(
+				_mm256_cvtepi32_ps(_mm256_mullo_epi32(input_row_count, input_column_count)), one);
+			_mm256_maskstore_ps(&output_row[x], mask, _mm256_div_ps(sum, input_pixel_count));
+		}
+	}
+}
+
+void nnp_global_avgpool__avx2(const float* input, float* output, size_t channels, size_t image_elements) {
+	const float scale = 1.0f / (float) image_elements;
+	for (size_t channel = 0; channel < channels; channel++) {
+		__m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps(), sum2 = _mm256_setzero_ps(), sum3 = _mm256_setzero_ps();
+		size_t length = image_elements;
+		for (; length >= 32; length -= 32) {
+			sum0 = _mm256_add_ps(sum0, _mm256_loadu_ps(input));
+			sum1 = _mm256_add_ps(sum1, _mm256_loadu_ps(input + 8));
+			sum2 = _mm256_add_ps(sum2, _mm256_loadu_ps(input + 16));
+			sum3 = _mm256_add_ps(sum3, _mm256_loadu_ps(input + 24));
+			input += 32;
+		}
+		for (; length >= 8; length -= 8) {
+			sum0 = _mm256_add_ps(sum0, _mm256_loadu_ps(input));
+			input += 8;
+		}
+		if (length != 0) {
+			sum1 = _mm256_add_ps(sum1, _mm256_maskload_ps(input, prefix_mask(length)));
+			input += length;
+		}
+		output[channel] = _mm256_reduce_add_ps(_mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3))) * scale;
+	}
+}
@@ -198,6 +198,33 @@ def transpose2x2x2x64(ymm_a, ymm_b, use_blend=True):
         SWAP.REGISTERS(ymm_b, ymm_new_b)
 
 
+def load_activation(reg_activation):
+    # Broadcasts negative_slope, lower_bound, and upper_bound of struct nnp_fused_activation
+    assert isinstance(reg_activation, GeneralPurposeRegister64)
+
+    ymm_parameters = [YMMRegister() for _ in range(3)]
+    for i, ymm_parameter in enumerate(ymm_parameters):
+        VBROADCASTSS(ymm_parameter, [reg_activation + i * 4])
+    return ymm_parameters
+
+
+def activation(ymm_rows, parameters):
+    # f(x) := min(max(x < 0 ? negative_slope * x : x, lower_bound), upper_bound)
+    assert isinstance(ymm_rows, (list, tuple)) and all(isinstance(ymm_row, YMMRegister) for ymm_row in ymm_rows)
+    assert len(parameters) == 3
+    assert all(isinstance(parameter, YMMRegister) or \
+        isinstance(parameter, LocalVariable) and parameter.size == YMMRegister.size for parameter in parameters)
+
+    negative_slope, lower_bound, upper_bound = parameters
+    for ymm_row in ymm_rows:
+        ymm_scaled_row = YMMRegister()
+        VMULPS(ymm_scaled_row, ymm_row, negative_slope)
+        # Select the scaled element where the sign bit is set
+        VBLENDVPS(ymm_row, ymm_row, ymm_scaled_row, ymm_row)
+        VMAXPS(ymm_row, ymm_row, lower_bound)
+        VMINPS(ymm_row, ymm_row, upper_bound)
+
+
 def compute_masks(masks, reg_column_offset, reg_column_count):
     assert isinstance(masks, list) and all(isinstance(mask, (YMMRegister, LocalVariable)) for mask in masks)
     assert isinstance(reg_column_offset, GeneralPurposeRegister64)
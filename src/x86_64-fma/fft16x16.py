@@ -3,7 +3,7 @@ from peachpy.x86_64 import *
 from common import butterfly, sqrt2_over_2
 
 
-from common import butterfly, sqrt2_over_2, cos_npi_over_8, interleave
+from common import butterfly, sqrt2_over_2, cos_npi_over_8, interleave, activation
 
 
 def fft8_bitreverse(n):
@@ -290,13 +290,14 @@ def forward_vfft(reg_t0, reg_t8, reg_t_stride, data_out, reg_row_start=None, reg
     store_ymm_result(out_imag[5], ymm_two_w5_imag)
 
 
-def inverse_vfft(reg_t0, reg_t8, reg_t_stride, data_in, reg_row_start=None, reg_row_end=None, store_mask=None):
+def inverse_vfft(reg_t0, reg_t8, reg_t_stride, data_in, reg_row_start=None, reg_row_end=None, store_mask=None, activation_parameters=None):
     assert isinstance(reg_t0, GeneralPurposeRegister64)
     assert isinstance(reg_t8, GeneralPurposeRegister64)
     assert isinstance(reg_t_stride, GeneralPurposeRegister64)
     assert isinstance(data_in, list) and len(data_in) == 16
     assert reg_row_end is None or isinstance(reg_row_end, GeneralPurposeRegister32)
     assert store_mask is None or isinstance(store_mask, LocalVariable) and store_mask.size == YMMRegister.size
+    assert activation_parameters is None or isinstance(activation_parameters, list) and len(activation_parameters) == 3
 
     in_real, in_imag = data_in[0::2], data_in[1::2]
 
@@ -487,6 +488,9 @@ def inverse_vfft(reg_t0, reg_t8, reg_t_stride, data_in, reg_row_start=None, reg_
     if store_mask:
         VMOVAPS(ymm_store_mask, store_mask)
 
+    if activation_parameters:
+        data_hi_spill = LocalVariable(YMMRegister.size)
+
     # FFT8: butterfly
     with Block() as store_data:
         for i, (data_lo, data_hi) in enumerate(zip(data[0:8], data[8:16])):
@@ -499,6 +503,11 @@ def inverse_vfft(reg_t0, reg_t8, reg_t_stride, data_in, reg_row_start=None, reg_
                     negate_b=fft8_negate_b.get(id(data_hi), False),
                     writeback=False)
 
+            if activation_parameters:
+                # All registers are occupied by the transform: spill the high row to free a temporary register
+                VMOVAPS(data_hi_spill, ymm_data_hi)
+                activation([ymm_data_lo], activation_parameters)
+
             with Block() as store_data_lo:
                 if reg_row_start:
                     CMP(reg_row_start, row_lo)
@@ -516,6 +525,11 @@ def inverse_vfft(reg_t0, reg_t8, reg_t_stride, data_in, reg_row_start=None, reg_
                 if i + 1 != 8:
                     ADD(reg_t0, reg_t_stride)
 
+            if activation_parameters:
+                ymm_data_hi = YMMRegister()
+                VMOVAPS(ymm_data_hi, data_hi_spill)
+                activation([ymm_data_hi], activation_parameters)
+
             with Block() as store_data_hi:
                 if reg_row_start:
                     CMP(reg_row_start, row_hi)
@@ -0,0 +1,164 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/pooling.h>
+
+static const int32_t mask_table[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+/* Returns a mask which enables the first min(count, 8) elements of a vector */
+static inline __m256i prefix_mask(size_t count) {
+	return _mm256_loadu_si256((const __m256i*) &mask_table[8 - min(count, 8)]);
+}
+
+/*
+ * Pooling is decomposed into two passes for every output row:
+ * 1. Vertical max of the input rows in the pooling window, stored into a padded row buffer.
+ *    Padding elements of the buffer are set to -inf.
+ * 2. Horizontal max over the row buffer. Windows with unit stride are loaded directly, other strides use gathers.
+ */
+void nnp_maxpool_generic__avx2(const float* input, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size)
+{
+	const __m256 minus_inf = _mm256_set1_ps(-__builtin_inff());
+
+	/* The last pooling window may extend up to pooling_stride.width - 1 elements past the right padding */
+	const size_t row_size = round_up(input_padding.left + input_size.width + input_padding.right + pooling_stride.width, 8) + 8;
+	NNP_SIMD_ALIGN float row[row_size];
+	for (size_t x = 0; x < input_padding.left; x++) {
+		row[x] = -__builtin_inff();
+	}
+	for (size_t x = input_padding.left + input_size.width; x < row_size; x++) {
+		row[x] = -__builtin_inff();
+	}
+	float* row_data = row + input_padding.left;
+
+	const __m256i gather_index = _mm256_mullo_epi32(
+		_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+		_mm256_set1_epi32((int32_t) pooling_stride.width));
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		const size_t window_start = y * pooling_stride.height;
+		const size_t input_row_start = doz(window_start, input_padding.top);
+		const size_t input_row_end = min(doz(window_start + pooling_size.height, input_padding.top), input_size.height);
+
+		/* Vertical pass */
+		for (size_t x = 0; x < input_size.width; x += 8) {
+			const __m256i mask = prefix_mask(input_size.width - x);
+			__m256 max = minus_inf;
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				max = _mm256_max_ps(max, _mm256_maskload_ps(&input[input_row * input_size.width + x], mask));
+			}
+			_mm256_maskstore_ps(&row_data[x], mask, max);
+		}
+
+		/* Horizontal pass */
+		float* output_row = output + y * output_size.width;
+		for (size_t x = 0; x < output_size.width; x += 8) {
+			const __m256i mask = prefix_mask(output_size.width - x);
+			const float* window = row + x * pooling_stride.width;
+			__m256 max = minus_inf;
+			if (pooling_stride.width == 1) {
+				for (size_t i = 0; i < pooling_size.width; i++) {
+					max = _mm256_max_ps(max, _mm256_loadu_ps(&window[i]));
+				}
+			} else {
+				for (size_t i = 0; i < pooling_size.width; i++) {
+					max = _mm256_max_ps(max,
+						_mm256_mask_i32gather_ps(minus_inf, &window[i], gather_index, _mm256_castsi256_ps(mask), sizeof(float)));
+				}
+			}
+			_mm256_maskstore_ps(&output_row[x], mask, max);
+		}
+	}
+}
+
+/*
+ * Same two-pass structure as nnp_maxpool_generic__avx2, but also tracks the index (y * input_size.width + x) of the
+ * maximum within the input image. Among equal maxima the leftmost column wins, and within a column the topmost row.
+ * Windows which cover only padding produce -inf and index UINT32_MAX.
+ */
+void nnp_maxpool_argmax_generic__avx2(const float* input, float* output, uint32_t* indices,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size)
+{
+	const __m256 minus_inf = _mm256_set1_ps(-__builtin_inff());
+	const __m256i invalid_index = _mm256_set1_epi32(-1);
+
+	/* The last pooling window may extend up to pooling_stride.width - 1 elements past the right padding */
+	const size_t row_size = round_up(input_padding.left + input_size.width + input_padding.right + pooling_stride.width, 8) + 8;
+	NNP_SIMD_ALIGN float row[row_size];
+	NNP_SIMD_ALIGN uint32_t row_indices[row_size];
+	for (size_t x = 0; x < input_padding.left; x++) {
+		row[x] = -__builtin_inff();
+		row_indices[x] = UINT32_MAX;
+	}
+	for (size_t x = input_padding.left + input_size.width; x < row_size; x++) {
+		row[x] = -__builtin_inff();
+		row_indices[x] = UINT32_MAX;
+	}
+	float* row_data = row + input_padding.left;
+	uint32_t* row_indices_data = row_indices + input_padding.left;
+
+	const __m256i column_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i gather_index = _mm256_mullo_epi32(column_index, _mm256_set1_epi32((int32_t) pooling_stride.width));
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		const size_t window_start = y * pooling_stride.height;
+		const size_t input_row_start = doz(window_start, input_padding.top);
+		const size_t input_row_end = min(doz(window_start + pooling_size.height, input_padding.top), input_size.height);
+
+		/* Vertical pass */
+		for (size_t x = 0; x < input_size.width; x += 8) {
+			const __m256i mask = prefix_mask(input_size.width - x);
+			__m256 max = minus_inf;
+			__m256i max_index = invalid_index;
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				const size_t offset = input_row * input_size.width + x;
+				const __m256 value = _mm256_maskload_ps(&input[offset], mask);
+				const __m256 greater = _mm256_cmp_ps(value, max, _CMP_GT_OQ);
+				max = _mm256_blendv_ps(max, value, greater);
+				max_index = _mm256_castps_si256(_mm256_blendv_ps(
+					_mm256_castsi256_ps(max_index),
+					_mm256_castsi256_ps(_mm256_add_epi32(column_index, _mm256_set1_epi32((int32_t) offset))),
+					greater));
+			}
+			_mm256_maskstore_ps(&row_data[x], mask, max);
+			_mm256_maskstore_epi32((int*) &row_indices_data[x], mask, max_index);
+		}
+
+		/* Horizontal pass */
+		float* output_row = output + y * output_size.width;
+		uint32_t* indices_row = indices + y * output_size.width;
+		for (size_t x = 0; x < output_size.width; x += 8) {
+			const __m256i mask = prefix_mask(output_size.width - x);
+			const float* window = row + x * pooling_stride.width;
+			const uint32_t* window_indices = row_indices + x * pooling_stride.width;
+			__m256 max = minus_inf;
+			__m256i max_index = invalid_index;
+			for (size_t i = 0; i < pooling_size.width; i++) {
+				__m256 value;
+				__m256i value_index;
+				if (pooling_stride.width == 1) {
+					value = _mm256_loadu_ps(&window[i]);
+					value_index = _mm256_loadu_si256((const __m256i*) &window_indices[i]);
+				} else {
+					value = _mm256_mask_i32gather_ps(minus_inf, &window[i], gather_index, _mm256_castsi256_ps(mask), sizeof(float));
+					value_index = _mm256_mask_i32gather_epi32(invalid_index, (const int*) &window_indices[i], gather_index, mask, sizeof(uint32_t));
+				}
+				const __m256 greater = _mm256_cmp_ps(value, max, _CMP_GT_OQ);
+				max = _mm256_blendv_ps(max, value, greater);
+				max_index = _mm256_castps_si256(_mm256_blendv_ps(
+					_mm256_castsi256_ps(max_index), _mm256_castsi256_ps(value_index), greater));
+			}
+			_mm256_maskstore_ps(&output_row[x], mask, max);
+			_mm256_maskstore_epi32((int*) &indices_row[x], mask, max_index);
+		}
+	}
+}
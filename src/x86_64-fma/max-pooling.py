@@ -131,3 +131,136 @@ with Function("nnp_maxpool_2x2_2x2__avx2",
     VMASKMOVPS([reg_dst_ptr], ymm_dst_mask_columns_0_to_8, ymm_out)
 
     RETURN()
+
+
+for stride in [2, 1]:
+    # 8 output pixels of a 3x3 pooling need 3 rows of (7 * stride + 3) input pixels
+    src_tile_width = 7 * stride + 3
+    src_tile_vectors = (src_tile_width + 7) // 8
+    with Function("nnp_maxpool_3x3_{stride}x{stride}__avx2".format(stride=stride),
+        (arg_src_pointer, arg_dst_pointer, arg_src_stride,
+        arg_src_row_offset, arg_src_row_count, arg_src_column_offset, arg_src_column_count,
+        arg_dst_column_count),
+        target=uarch.default + isa.fma3 + isa.avx2):
+
+        reg_src_ptr = GeneralPurposeRegister64()
+        LOAD.ARGUMENT(reg_src_ptr, arg_src_pointer)
+
+        reg_dst_ptr = GeneralPurposeRegister64()
+        LOAD.ARGUMENT(reg_dst_ptr, arg_dst_pointer)
+
+        reg_src_stride = GeneralPurposeRegister64()
+        LOAD.ARGUMENT(reg_src_stride, arg_src_stride)
+
+        reg_src_row_index = GeneralPurposeRegister32()
+        LOAD.ARGUMENT(reg_src_row_index, arg_src_row_offset)
+
+        reg_src_row_count = GeneralPurposeRegister32()
+        LOAD.ARGUMENT(reg_src_row_count, arg_src_row_count)
+
+        reg_src_column_start = GeneralPurposeRegister32()
+        LOAD.ARGUMENT(reg_src_column_start, arg_src_column_offset)
+
+        reg_src_column_end = GeneralPurposeRegister32()
+        LOAD.ARGUMENT(reg_src_column_end, arg_src_column_count)
+        ADD(reg_src_column_end, reg_src_column_start)
+
+        reg_dst_column_count = GeneralPurposeRegister32()
+        LOAD.ARGUMENT(reg_dst_column_count, arg_dst_column_count)
+
+        ymm_src_column_start, ymm_src_column_end, ymm_dst_column_count = YMMRegister(), YMMRegister(), YMMRegister()
+        VMOVD(ymm_src_column_start.as_xmm, reg_src_column_start)
+        VMOVD(ymm_src_column_end.as_xmm, reg_src_column_end)
+        VMOVD(ymm_dst_column_count.as_xmm, reg_dst_column_count)
+        VPBROADCASTD(ymm_src_column_start, ymm_src_column_start.as_xmm)
+        VPBROADCASTD(ymm_src_column_end, ymm_src_column_end.as_xmm)
+        VPBROADCASTD(ymm_dst_column_count, ymm_dst_column_count.as_xmm)
+
+        # Mask of columns [src_column_offset, src_column_offset + src_column_count) for each vector of the source tile
+        ymm_src_mask_columns = [YMMRegister() for i in range(src_tile_vectors)]
+        for i, ymm_src_mask in enumerate(ymm_src_mask_columns):
+            ymm_columns = YMMRegister()
+            VMOVDQA(ymm_columns, Constant.uint32x8(*range(i * 8, i * 8 + 8)))
+
+            ymm_src_column_start_gt_columns = YMMRegister()
+            VPCMPGTD(ymm_src_column_start_gt_columns, ymm_src_column_start, ymm_columns)
+            VPCMPGTD(ymm_src_mask, ymm_src_column_end, ymm_columns)
+            VPANDN(ymm_src_mask, ymm_src_column_start_gt_columns, ymm_src_mask)
+
+        ymm_dst_mask_columns_0_to_8 = YMMRegister()
+        VPCMPGTD(ymm_dst_mask_columns_0_to_8, ymm_dst_column_count, Constant.uint32x8(0, 1, 2, 3, 4, 5, 6, 7))
+
+        # data points to the first element, which is loaded into lane `reg_column_start`
+        # However, VMASKMOVPS expects pointer to the first lane, even if it is not loaded.
+        # Adjust the pointer by subtracting column_offset, in bytes
+        SHL(reg_src_column_start, 2)
+        SUB(reg_src_ptr, reg_src_column_start.as_qword)
+
+        # Multiply stride by sizeof(float) to convert from elements to bytes
+        SHL(reg_src_stride, 2)
+
+        ymm_minus_inf = YMMRegister()
+        VMOVAPS(ymm_minus_inf, Constant.float32x8(-float("inf")))
+
+        # Vertical max of the 3 rows of the source tile
+        ymm_max = [YMMRegister() for i in range(src_tile_vectors)]
+        for ymm_max_i in ymm_max:
+            VMOVAPS(ymm_max_i, ymm_minus_inf)
+
+        NEG(reg_src_row_index)
+
+        for row in range(3):
+            with Block() as load_row:
+                if row != 0:
+                    INC(reg_src_row_index)
+                CMP(reg_src_row_index, reg_src_row_count)
+                JAE(load_row.end)
+
+                for i, (ymm_max_i, ymm_src_mask) in enumerate(zip(ymm_max, ymm_src_mask_columns)):
+                    ymm_row = YMMRegister()
+                    VMASKMOVPS(ymm_row, ymm_src_mask, [reg_src_ptr + i * YMMRegister.size])
+                    VBLENDVPS(ymm_row, ymm_minus_inf, ymm_row, ymm_src_mask)
+                    VMAXPS(ymm_max_i, ymm_max_i, ymm_row)
+
+                if row != 2:
+                    ADD(reg_src_ptr, reg_src_stride)
+
+        ymm_out = YMMRegister()
+        if stride == 1:
+            # ymm_max[0] = ( x7  x6  x5  x4  x3  x2  x1 x0 )
+            # ymm_max[1] = ( x15 x14 x13 x12 x11 x10 x9 x8 )
+            # ymm_x4_to_x11 = ( x11 x10 x9 x8 x7 x6 x5 x4 )
+            ymm_x4_to_x11 = YMMRegister()
+            VPERM2F128(ymm_x4_to_x11, ymm_max[0], ymm_max[1], 0x21)
+
+            # ymm_x1_to_x8 = ( x8 x7 x6 x5 x4 x3 x2 x1 )
+            # ymm_x2_to_x9 = ( x9 x8 x7 x6 x5 x4 x3 x2 )
+            ymm_x1_to_x8, ymm_x2_to_x9 = YMMRegister(), YMMRegister()
+            VPALIGNR(ymm_x1_to_x8, ymm_x4_to_x11, ymm_max[0], 4)
+            VPALIGNR(ymm_x2_to_x9, ymm_x4_to_x11, ymm_max[0], 8)
+
+            VMAXPS(ymm_out, ymm_max[0], ymm_x1_to_x8)
+            VMAXPS(ymm_out, ymm_out, ymm_x2_to_x9)
+        else:
+            # ymm_even = ( x14 x12 x6 x4 x10 x8 x2 x0 )
+            # ymm_odd  = ( x15 x13 x7 x5 x11 x9 x3 x1 )
+            ymm_even, ymm_odd = YMMRegister(), YMMRegister()
+            VSHUFPS(ymm_even, ymm_max[0], ymm_max[1], _MM_SHUFFLE(2, 0, 2, 0))
+            VSHUFPS(ymm_odd, ymm_max[0], ymm_max[1], _MM_SHUFFLE(3, 1, 3, 1))
+
+            # ymm_next_even = ( x16 x14 x8 x6 x12 x10 x4 x2 )
+            ymm_next_even, ymm_permute_index = YMMRegister(), YMMRegister()
+            VMOVDQA(ymm_permute_index, Constant.uint32x8(1, 4, 3, 6, 5, 2, 7, 0))
+            VPERMPS(ymm_next_even, ymm_permute_index, ymm_even)
+            ymm_x16 = YMMRegister()
+            VBROADCASTSS(ymm_x16, ymm_max[2].as_xmm)
+            VBLENDPS(ymm_next_even, ymm_next_even, ymm_x16, 0x80)
+
+            # ymm_out = ( y7 y6 y3 y2 y5 y4 y1 y0 )
+            VMAXPS(ymm_out, ymm_even, ymm_odd)
+            VMAXPS(ymm_out, ymm_out, ymm_next_even)
+            VPERMPD(ymm_out, ymm_out, _MM_SHUFFLE(3, 1, 2, 0))
+
+        VMASKMOVPS([reg_dst_ptr], ymm_dst_mask_columns_0_to_8, ymm_out)
+
+        RETURN()
@@ -0,0 +1,139 @@
+simd_width = YMMRegister.size // float_.size
+
+
+def relu(ymm_data, ymm_negative_slope, ymm_sign):
+	# VBLENDVPS selects by the sign bit, thus negative inputs (including -0.0) are multiplied by the slope
+	ymm_scaled = YMMRegister()
+	VMULPS(ymm_scaled, ymm_data, ymm_negative_slope)
+	VBLENDVPS(ymm_data, ymm_data, ymm_scaled, ymm_sign)
+
+
+arg_input = Argument(ptr(const_float_), "input")
+arg_output = Argument(ptr(float_), "output")
+arg_length = Argument(size_t, "length")
+arg_negative_slope = Argument(float_, "negative_slope")
+with Function("nnp_relu__avx2",
+	(arg_input, arg_output, arg_length, arg_negative_slope),
+	target=uarch.default + isa.avx2):
+
+	reg_input = GeneralPurposeRegister64()
+	LOAD.ARGUMENT(reg_input, arg_input)
+
+	reg_output = GeneralPurposeRegister64()
+	LOAD.ARGUMENT(reg_output, arg_output)
+
+	reg_length = GeneralPurposeRegister64()
+	LOAD.ARGUMENT(reg_length, arg_length)
+
+	ymm_negative_slope = YMMRegister()
+	LOAD.ARGUMENT(ymm_negative_slope.as_xmm, arg_negative_slope)
+	VBROADCASTSS(ymm_negative_slope, ymm_negative_slope.as_xmm)
+
+	main_loop = Loop()
+	end_block = Block()
+
+	SUB(reg_length, simd_width)
+	JB(main_loop.end)
+
+	with main_loop:
+		# Each vector is loaded before it is stored, so input and output may alias
+		ymm_data = YMMRegister()
+		VMOVUPS(ymm_data, [reg_input])
+		ADD(reg_input, YMMRegister.size)
+
+		relu(ymm_data, ymm_negative_slope, ymm_data)
+
+		VMOVUPS([reg_output], ymm_data)
+		ADD(reg_output, YMMRegister.size)
+
+		SUB(reg_length, simd_width)
+		JAE(main_loop.begin)
+
+	ADD(reg_length, simd_width)
+	JE(end_block.end)
+
+	with end_block:
+		ymm_mask = YMMRegister()
+		VMOVD(ymm_mask.as_xmm, reg_length.as_dword)
+		VPBROADCASTD(ymm_mask, ymm_mask.as_xmm)
+		VPCMPGTD(ymm_mask, ymm_mask, Constant.uint32x8(0, 1, 2, 3, 4, 5, 6, 7))
+
+		ymm_data = YMMRegister()
+		VMASKMOVPS(ymm_data, ymm_mask, [reg_input])
+
+		relu(ymm_data, ymm_negative_slope, ymm_data)
+
+		VMASKMOVPS([reg_output], ymm_mask, ymm_data)
+
+	RETURN()
+
+
+arg_output_gradient = Argument(ptr(const_float_), "output_gradient")
+arg_input = Argument(ptr(const_float_), "input")
+arg_input_gradient = Argument(ptr(float_), "input_gradient")
+arg_length = Argument(size_t, "length")
+arg_negative_slope = Argument(float_, "negative_slope")
+with Function("nnp_grad_relu__avx2",
+	(arg_output_gradient, arg_input, arg_input_gradient, arg_length, arg_negative_slope),
+	target=uarch.default + isa.avx2):
+
+	reg_output_gradient = GeneralPurposeRegister64()
+	LOAD.ARGUMENT(reg_output_gradient, arg_output_gradient)
+
+	reg_input = GeneralPurposeRegister64()
+	LOAD.ARGUMENT(reg_input, arg_input)
+
+	reg_input_gradient = GeneralPurposeRegister64()
+	LOAD.ARGUMENT(reg_input_gradient, arg_input_gradient)
+
+	reg_length = GeneralPurposeRegister64()
+	LOAD.ARGUMENT(reg_length, arg_length)
+
+	ymm_negative_slope = YMMRegister()
+	LOAD.ARGUMENT(ymm_negative_slope.as_xmm, arg_negative_slope)
+	VBROADCASTSS(ymm_negative_slope, ymm_negative_slope.as_xmm)
+
+	main_loop = Loop()
+	end_block = Block()
+
+	SUB(reg_length, simd_width)
+	JB(main_loop.end)
+
+	with main_loop:
+		# Each vector is loaded before it is stored, so input gradient may alias output gradient or input
+		ymm_gradient = YMMRegister()
+		VMOVUPS(ymm_gradient, [reg_output_gradient])
+		ADD(reg_output_gradient, YMMRegister.size)
+
+		ymm_input = YMMRegister()
+		VMOVUPS(ymm_input, [reg_input])
+		ADD(reg_input, YMMRegister.size)
+
+		relu(ymm_gradient, ymm_negative_slope, ymm_input)
+
+		VMOVUPS([reg_input_gradient], ymm_gradient)
+		ADD(reg_input_gradient, YMMRegister.size)
+
+		SUB(reg_length, simd_width)
+		JAE(main_loop.begin)
+
+	ADD(reg_length, simd_width)
+	JE(end_block.end)
+
+	with end_block:
+		ymm_mask = YMMRegister()
+		VMOVD(ymm_mask.as_xmm, reg_length.as_dword)
+		VPBROADCASTD(ymm_mask, ymm_mask.as_xmm)
+		VPCMPGTD(ymm_mask, ymm_mask, Constant.uint32x8(0, 1, 2, 3, 4, 5, 6, 7))
+
+		ymm_gradient = YMMRegister()
+		VMASKMOVPS(ymm_gradient, ymm_mask, [reg_output_gradient])
+
+		ymm_input = YMMRegister()
+		VMASKMOVPS(ymm_input, ymm_mask, [reg_input])
+
+		relu(ymm_gradient, ymm_negative_slope, ymm_input)
+
+		VMASKMOVPS([reg_input_gradient], ymm_mask, ymm_gradient)
+
+	RETURN()
@@ -0,0 +1,99 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/softmax.h>
+
+#include "exp.h"
+
+static const int32_t mask_table[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+/* Returns a mask which enables the first (length % 8) elements of a vector, or all elements if length is a multiple of 8 */
+static inline __m256i remainder_mask(size_t length) {
+	return _mm256_loadu_si256((const __m256i*) &mask_table[(-length) & 7]);
+}
+
+static inline float _mm256_reduce_max_ps(__m256 x) {
+	__m128 y = _mm_max_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+	y = _mm_max_ps(y, _mm_movehl_ps(y, y));
+	y = _mm_max_ss(y, _mm_movehdup_ps(y));
+	return _mm_cvtss_f32(y);
+}
+
+static inline float _mm256_reduce_add_ps(__m256 x) {
+	__m128 y = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+	y = _mm_add_ps(y, _mm_movehl_ps(y, y));
+	y = _mm_add_ss(y, _mm_movehdup_ps(y));
+	return _mm_cvtss_f32(y);
+}
+
+float nnp_vector_max__avx2(size_t length, const float* input) {
+	const __m256 minus_inf = _mm256_set1_ps(-__builtin_inff());
+	__m256 max0 = minus_inf, max1 = minus_inf, max2 = minus_inf, max3 = minus_inf;
+	for (; length >= 32; length -= 32) {
+		max0 = _mm256_max_ps(max0, _mm256_loadu_ps(input));
+		max1 = _mm256_max_ps(max1, _mm256_loadu_ps(input + 8));
+		max2 = _mm256_max_ps(max2, _mm256_loadu_ps(input + 16));
+		max3 = _mm256_max_ps(max3, _mm256_loadu_ps(input + 24));
+		input += 32;
+	}
+	for (; length >= 8; length -= 8) {
+		max0 = _mm256_max_ps(max0, _mm256_loadu_ps(input));
+		input += 8;
+	}
+	if (length != 0) {
+		const __m256i mask = remainder_mask(length);
+		const __m256 x = _mm256_maskload_ps(input, mask);
+		max1 = _mm256_max_ps(max1, _mm256_blendv_ps(minus_inf, x, _mm256_castsi256_ps(mask)));
+	}
+	return _mm256_reduce_max_ps(_mm256_max_ps(_mm256_max_ps(max0, max1), _mm256_max_ps(max2, max3)));
+}
+
+float nnp_vector_exp_minus_c_and_sum__avx2(size_t length, const float* input, float* output, float c) {
+	const __m256 vc = _mm256_set1_ps(c);
+	__m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+	for (; length >= 16; length -= 16) {
+		const __m256 y0 = _mm256_exp_ps(_mm256_sub_ps(_mm256_loadu_ps(input), vc));
+		const __m256 y1 = _mm256_exp_ps(_mm256_sub_ps(_mm256_loadu_ps(input + 8), vc));
+		_mm256_storeu_ps(output, y0);
+		_mm256_storeu_ps(output + 8, y1);
+		sum0 = _mm256_add_ps(sum0, y0);
+		sum1 = _mm256_add_ps(sum1, y1);
+		input += 16;
+		output += 16;
+	}
+	for (; length >= 8; length -= 8) {
+		const __m256 y = _mm256_exp_ps(_mm256_sub_ps(_mm256_loadu_ps(input), vc));
+		_mm256_storeu_ps(output, y);
+		sum0 = _mm256_add_ps(sum0, y);
+		input += 8;
+		output += 8;
+	}
+	if (length != 0) {
+		const __m256i mask = remainder_mask(length);
+		const __m256 y = _mm256_and_ps(
+			_mm256_exp_ps(_mm256_sub_ps(_mm256_maskload_ps(input, mask), vc)),
+			_mm256_castsi256_ps(mask));
+		_mm256_maskstore_ps(output, mask, y);
+		sum1 = _mm256_add_ps(sum1, y);
+	}
+	return _mm256_reduce_add_ps(_mm256_add_ps(sum0, sum1));
+}
+
+void nnp_vector_scale__avx2(size_t length, float* data, float scale) {
+	const __m256 vscale = _mm256_set1_ps(scale);
+	for (; length >= 16; length -= 16) {
+		_mm256_storeu_ps(data, _mm256_mul_ps(_mm256_loadu_ps(data), vscale));
+		_mm256_storeu_ps(data + 8, _mm256_mul_ps(_mm256_loadu_ps(data + 8), vscale));
+		data += 16;
+	}
+	for (; length >= 8; length -= 8) {
+		_mm256_storeu_ps(data, _mm256_mul_ps(_mm256_loadu_ps(data), vscale));
+		data += 8;
+	}
+	if (length != 0) {
+		const __m256i mask = remainder_mask(length);
+		_mm256_maskstore_ps(data, mask, _mm256_mul_ps(_mm256_maskload_ps(data, mask), vscale));
+	}
+}
@@ -0,0 +1,276 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <complex.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/transform.h>
+#include <nnpack/activations.h>
+
+#include <fft/complex.h>
+
+/*
+ * 2D real-to-complex FFT of 8x8 and 16x16 tiles.
+ *
+ * Rows are transformed first, two real rows per complex FFT, then the non-redundant columns 0...N/2 of the
+ * spectrum are transformed as complex vectors. The N*N/2 + 2 independent spectrum elements are packed into tuples
+ * of 8 real parts and 8 imaginary parts:
+ *   - elements 0-1 of the real and imaginary parts of the first tuple hold the four purely real coefficients
+ *     X[0][0], X[0][N/2], X[N/2][0], X[N/2][N/2];
+ *   - the remaining elements hold, in order, X[1...N/2-1][0], X[1...N/2-1][N/2], and X[0...N-1][v] for v = 1...N/2-1.
+ * This layout differs from the one used by the AVX2 kernels, but only the tuple GEMMs of the same kernel tier
+ * ever see the transformed data, and they multiply elements independently of their position.
+ */
+
+/* Forces inlining, so that the tile size is a compile-time constant in every instantiation below */
+#define NNP_SSE2_INLINE static inline __attribute__((__always_inline__))
+
+NNP_SSE2_INLINE void fft_complex(size_t n, float _Complex w[], size_t stride) {
+	if (n == 8) {
+		fft8fc(&w[0 * stride], &w[1 * stride], &w[2 * stride], &w[3 * stride],
+			&w[4 * stride], &w[5 * stride], &w[6 * stride], &w[7 * stride]);
+	} else {
+		fft16fc(&w[0 * stride], &w[1 * stride], &w[2 * stride], &w[3 * stride],
+			&w[4 * stride], &w[5 * stride], &w[6 * stride], &w[7 * stride],
+			&w[8 * stride], &w[9 * stride], &w[10 * stride], &w[11 * stride],
+			&w[12 * stride], &w[13 * stride], &w[14 * stride], &w[15 * stride]);
+	}
+}
+
+NNP_SSE2_INLINE void ifft_complex(size_t n, float _Complex w[], size_t stride) {
+	if (n == 8) {
+		ifft8fc(&w[0 * stride], &w[1 * stride], &w[2 * stride], &w[3 * stride],
+			&w[4 * stride], &w[5 * stride], &w[6 * stride], &w[7 * stride]);
+	} else {
+		ifft16fc(&w[0 * stride], &w[1 * stride], &w[2 * stride], &w[3 * stride],
+			&w[4 * stride], &w[5 * stride], &w[6 * stride], &w[7 * stride],
+			&w[8 * stride], &w[9 * stride], &w[10 * stride], &w[11 * stride],
+			&w[12 * stride], &w[13 * stride], &w[14 * stride], &w[15 * stride]);
+	}
+}
+
+/* Address of the real part of the packed spectrum element with the given index; imaginary part follows 8 floats later */
+NNP_SSE2_INLINE float* packed_element(float packed[], size_t index) {
+	return &packed[(index / 8) * 16 + index % 8];
+}
+
+/*
+ * Computes the spectrum of an n x n tile with row_count x column_count loaded elements (the rest is zero),
+ * and packs it into n*n/16 contiguous tuples.
+ */
+NNP_SSE2_INLINE void fft2d(size_t n,
+	const float t[], size_t stride_t,
+	uint32_t row_count, uint32_t column_count,
+	uint32_t row_offset, uint32_t column_offset,
+	float packed[])
+{
+	/* Spectrum in row-major order; a flat array so that columns can be addressed with a stride */
+	float _Complex w[16 * 16];
+
+	/* Row FFTs: rows 2*k and 2*k+1 go to the real and imaginary parts of the same complex vector */
+	for (size_t k = 0; k < n / 2; k++) {
+		float _Complex z[16];
+		for (size_t column = 0; column < n; column++) {
+			float re = 0.0f, im = 0.0f;
+			if (column - column_offset < column_count) {
+				if (2 * k - row_offset < row_count) {
+					re = t[(2 * k - row_offset) * stride_t + column - column_offset];
+				}
+				if (2 * k + 1 - row_offset < row_count) {
+					im = t[(2 * k + 1 - row_offset) * stride_t + column - column_offset];
+				}
+			}
+			z[column] = CMPLXF(re, im);
+		}
+		fft_complex(n, z, 1);
+		for (size_t v = 0; v <= n / 2; v++) {
+			const float _Complex zv = z[v];
+			const float _Complex zc = conjf(z[(n - v) % n]);
+			w[(2 * k) * 16 + v] = 0.5f * (zv + zc);
+			w[(2 * k + 1) * 16 + v] = -0.5f * I * (zv - zc);
+		}
+	}
+
+	/* Column FFTs over the non-redundant half of the row spectra */
+	for (size_t v = 0; v <= n / 2; v++) {
+		fft_complex(n, &w[v], 16);
+	}
+
+	packed[0] = crealf(w[0]);
+	packed[1] = crealf(w[n / 2]);
+	packed[8] = crealf(w[(n / 2) * 16]);
+	packed[9] = crealf(w[(n / 2) * 16 + n / 2]);
+	size_t index = 2;
+	for (size_t u = 1; u < n / 2; u++, index++) {
+		float* element = packed_element(packed, index);
+		element[0] = crealf(w[u * 16]);
+		element[8] = cimagf(w[u * 16]);
+	}
+	for (size_t u = 1; u < n / 2; u++, index++) {
+		float* element = packed_element(packed, index);
+		element[0] = crealf(w[u * 16 + n / 2]);
+		element[8] = cimagf(w[u * 16 + n / 2]);
+	}
+	for (size_t v = 1; v < n / 2; v++) {
+		for (size_t u = 0; u < n; u++, index++) {
+			float* element = packed_element(packed, index);
+			element[0] = crealf(w[u * 16 + v]);
+			element[8] = cimagf(w[u * 16 + v]);
+		}
+	}
+}
+
+/*
+ * Unpacks n*n/16 contiguous tuples into an n x n spectrum, computes the inverse FFT, adds bias, applies the activation
+ * unless it is NULL, and stores row_count x column_count elements starting from (row_offset, column_offset).
+ */
+NNP_SSE2_INLINE void ifft2d(size_t n,
+	const float packed[],
+	float t[], size_t stride_t,
+	float bias, const struct nnp_fused_activation* activation,
+	uint32_t row_count, uint32_t column_count,
+	uint32_t row_offset, uint32_t column_offset)
+{
+	float _Complex w[16 * 16];
+
+	w[0] = packed[0];
+	w[n / 2] = packed[1];
+	w[(n / 2) * 16] = packed[8];
+	w[(n / 2) * 16 + n / 2] = packed[9];
+	size_t index = 2;
+	for (size_t u = 1; u < n / 2; u++, index++) {
+		const float* element = packed_element((float*) packed, index);
+		w[u * 16] = CMPLXF(element[0], element[8]);
+		w[(n - u) * 16] = conjf(w[u * 16]);
+	}
+	for (size_t u = 1; u < n / 2; u++, index++) {
+		const float* element = packed_element((float*) packed, index);
+		w[u * 16 + n / 2] = CMPLXF(element[0], element[8]);
+		w[(n - u) * 16 + n / 2] = conjf(w[u * 16 + n / 2]);
+	}
+	for (size_t v = 1; v < n / 2; v++) {
+		for (size_t u = 0; u < n; u++, index++) {
+			const float* element = packed_element((float*) packed, index);
+			w[u * 16 + v] = CMPLXF(element[0], element[8]);
+		}
+	}
+
+	/* Bias only affects the DC coefficient */
+	w[0] += bias * (float) (n * n);
+
+	for (size_t v = 0; v <= n / 2; v++) {
+		ifft_complex(n, &w[v], 16);
+	}
+
+	/* Inverse row FFTs: two Hermitian row spectra are combined into one complex vector */
+	for (size_t k = 0; k < n / 2; k++) {
+		float _Complex z[16];
+		for (size_t v = 0; v <= n / 2; v++) {
+			z[v] = w[(2 * k) * 16 + v] + I * w[(2 * k + 1) * 16 + v];
+		}
+		for (size_t v = n / 2 + 1; v < n; v++) {
+			z[v] = conjf(w[(2 * k) * 16 + n - v]) + I * conjf(w[(2 * k + 1) * 16 + n - v]);
+		}
+		ifft_complex(n, z, 1);
+		for (size_t parity = 0; parity < 2; parity++) {
+			const size_t row = 2 * k + parity;
+			if (row - row_offset < row_count) {
+				for (size_t column = column_offset; column < column_offset + column_count; column++) {
+					float value = parity == 0 ? crealf(z[column]) : cimagf(z[column]);
+					if (activation != NULL) {
+						value = nnp_fused_activation_apply(activation, value);
+					}
+					t[(row - row_offset) * stride_t + column - column_offset] = value;
+				}
+			}
+		}
+	}
+}
+
+NNP_SSE2_INLINE void fft2d_and_store(size_t n, bool stream,
+	const float t[], float f[], size_t stride_t, size_t stride_f,
+	uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset)
+{
+	float packed[16 * 16] NNP_SIMD_ALIGN;
+	fft2d(n, t, stride_t, row_count, column_count, row_offset, column_offset, packed);
+	for (size_t tuple = 0; tuple < n * n / 16; tuple++) {
+		float* f_tuple = (float*) ((char*) f + tuple * stride_f);
+		for (size_t i = 0; i < 16; i += 4) {
+			const __m128 data = _mm_load_ps(&packed[tuple * 16 + i]);
+			if (stream) {
+				_mm_stream_ps(f_tuple + i, data);
+			} else {
+				_mm_store_ps(f_tuple + i, data);
+			}
+		}
+	}
+}
+
+NNP_SSE2_INLINE void ifft2d_and_store(size_t n,
+	const float f[], float t[], size_t stride_f, size_t stride_t,
+	float bias, const struct nnp_fused_activation* activation,
+	uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset)
+{
+	float packed[16 * 16] NNP_SIMD_ALIGN;
+	for (size_t tuple = 0; tuple < n * n / 16; tuple++) {
+		const float* f_tuple = (const float*) ((const char*) f + tuple * stride_f);
+		for (size_t i = 0; i < 16; i += 4) {
+			_mm_store_ps(&packed[tuple * 16 + i], _mm_load_ps(f_tuple + i));
+		}
+	}
+	ifft2d(n, packed, t, stride_t, bias, activation, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft8x8_and_store__sse2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	fft2d_and_store(8, false, t, f, stride_t, stride_f, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft8x8_and_stream__sse2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	fft2d_and_store(8, true, t, f, stride_t, stride_f, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft8x8_and_macc__sse2(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	float packed[8 * 8] NNP_SIMD_ALIGN;
+	fft2d(8, t, stride_t, row_count, column_count, row_offset, column_offset, packed);
+	nnp_ft8x8gemmc__sse2(f, x, packed);
+}
+
+void nnp_ifft8x8__sse2(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	ifft2d_and_store(8, f, t, stride_f, stride_t, 0.0f, NULL, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_ifft8x8_with_bias__sse2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count) {
+	ifft2d_and_store(8, f, t, stride_f, stride_t, *bias, NULL, row_count, column_count, 0, 0);
+}
+
+void nnp_ifft8x8_with_bias_activation__sse2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation) {
+	ifft2d_and_store(8, f, t, stride_f, stride_t, *bias, activation, row_count, column_count, 0, 0);
+}
+
+void nnp_fft16x16_and_store__sse2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	fft2d_and_store(16, false, t, f, stride_t, stride_f, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft16x16_and_stream__sse2(const float t[], float f[], size_t stride_t, size_t stride_f, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	fft2d_and_store(16, true, t, f, stride_t, stride_f, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_fft16x16_and_macc__sse2(const float t[], float f[], const float x[], size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	float packed[16 * 16] NNP_SIMD_ALIGN;
+	fft2d(16, t, stride_t, row_count, column_count, row_offset, column_offset, packed);
+	nnp_ft16x16gemmc__sse2(f, x, packed);
+}
+
+void nnp_ifft16x16__sse2(const float f[], float t[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	ifft2d_and_store(16, f, t, stride_f, stride_t, 0.0f, NULL, row_count, column_count, row_offset, column_offset);
+}
+
+void nnp_ifft16x16_with_bias__sse2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count) {
+	ifft2d_and_store(16, f, t, stride_f, stride_t, *bias, NULL, row_count, column_count, 0, 0);
+}
+
+void nnp_ifft16x16_with_bias_activation__sse2(const float f[], float t[], const float bias[], size_t stride_f, size_t stride_t, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation) {
+	ifft2d_and_store(16, f, t, stride_f, stride_t, *bias, activation, row_count, column_count, 0, 0);
+}
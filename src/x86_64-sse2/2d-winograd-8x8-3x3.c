@@ -0,0 +1,283 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/transform.h>
+
+#include "activation.h"
+
+/*
+ * Winograd F(6x6, 3x3) transforms of 8x8 tiles.
+ * Each row of 8 elements takes two XMM registers, and every transform is applied to both halves independently.
+ * Transformed tiles are stored transposed, in the same layout as the AVX2 kernels produce.
+ */
+
+/* Forces inlining, so that row and column loops over constant bounds are fully unrolled */
+#define NNP_SSE2_INLINE static inline __attribute__((__always_inline__))
+
+NNP_SSE2_INLINE __m128 madd(__m128 acc, __m128 x, float c) {
+	return _mm_add_ps(acc, _mm_mul_ps(x, _mm_set1_ps(c)));
+}
+
+NNP_SSE2_INLINE void input_transform(const __m128 d[restrict static 8], __m128 wd[restrict static 8]) {
+	/* wd0 = d6 - 36 * d0 + 49 * d2 - 14 * d4 */
+	wd[0] = madd(madd(madd(d[6], d[0], -36.0f), d[2], 49.0f), d[4], -14.0f);
+	/* wd1, wd2 = (d6 + 36 * d2 - 13 * d4) +- (d5 + 36 * d1 - 13 * d3) */
+	const __m128 even36 = madd(madd(d[6], d[2], 36.0f), d[4], -13.0f);
+	const __m128 odd36 = madd(madd(d[5], d[1], 36.0f), d[3], -13.0f);
+	wd[1] = _mm_add_ps(even36, odd36);
+	wd[2] = _mm_sub_ps(even36, odd36);
+	/* wd3, wd4 = (d6 + 9 * d2 - 10 * d4) +- 2 * (d5 + 9 * d1 - 10 * d3) */
+	const __m128 even9 = madd(madd(d[6], d[2], 9.0f), d[4], -10.0f);
+	const __m128 odd9 = madd(madd(d[5], d[1], 9.0f), d[3], -10.0f);
+	wd[3] = madd(even9, odd9, 2.0f);
+	wd[4] = madd(even9, odd9, -2.0f);
+	/* wd5, wd6 = (d6 + 4 * d2 - 5 * d4) +- 3 * (d5 + 4 * d1 - 5 * d3) */
+	const __m128 even4 = madd(madd(d[6], d[2], 4.0f), d[4], -5.0f);
+	const __m128 odd4 = madd(madd(d[5], d[1], 4.0f), d[3], -5.0f);
+	wd[5] = madd(even4, odd4, 3.0f);
+	wd[6] = madd(even4, odd4, -3.0f);
+	/* wd7 = d7 - 36 * d1 + 49 * d3 - 14 * d5 */
+	wd[7] = madd(madd(madd(d[7], d[1], -36.0f), d[3], 49.0f), d[5], -14.0f);
+}
+
+NNP_SSE2_INLINE void output_transform(const __m128 m[restrict static 8], __m128 s[restrict static 6]) {
+	const __m128 m1_add_m2 = _mm_add_ps(m[1], m[2]);
+	const __m128 m1_sub_m2 = _mm_sub_ps(m[1], m[2]);
+	const __m128 m3_add_m4 = _mm_add_ps(m[3], m[4]);
+	const __m128 m3_sub_m4 = _mm_sub_ps(m[3], m[4]);
+	const __m128 m5_add_m6 = _mm_add_ps(m[5], m[6]);
+	const __m128 m5_sub_m6 = _mm_sub_ps(m[5], m[6]);
+
+	s[0] = _mm_add_ps(_mm_add_ps(m[0], m1_add_m2), _mm_add_ps(m3_add_m4, m5_add_m6));
+	s[1] = madd(madd(m1_sub_m2, m3_sub_m4, 2.0f), m5_sub_m6, 3.0f);
+	s[2] = madd(madd(m1_add_m2, m3_add_m4, 4.0f), m5_add_m6, 9.0f);
+	s[3] = madd(madd(m1_sub_m2, m3_sub_m4, 8.0f), m5_sub_m6, 27.0f);
+	s[4] = madd(madd(m1_add_m2, m3_add_m4, 16.0f), m5_add_m6, 81.0f);
+	s[5] = madd(madd(_mm_add_ps(m[7], m1_sub_m2), m3_sub_m4, 32.0f), m5_sub_m6, 243.0f);
+}
+
+/* Transposes an 8x8 block stored as rows of two halves */
+NNP_SSE2_INLINE void transpose8x8(__m128 rows[restrict static 8][2]) {
+	for (size_t block_row = 0; block_row < 2; block_row++) {
+		for (size_t half = 0; half < 2; half++) {
+			_MM_TRANSPOSE4_PS(rows[block_row * 4 + 0][half], rows[block_row * 4 + 1][half],
+				rows[block_row * 4 + 2][half], rows[block_row * 4 + 3][half]);
+		}
+	}
+	/* Swap the off-diagonal 4x4 blocks */
+	for (size_t row = 0; row < 4; row++) {
+		const __m128 upper_right = rows[row][1];
+		rows[row][1] = rows[row + 4][0];
+		rows[row + 4][0] = upper_right;
+	}
+}
+
+NNP_SSE2_INLINE void input_transform_rows(__m128 rows[restrict static 8][2]) {
+	for (size_t half = 0; half < 2; half++) {
+		__m128 d[8], wd[8];
+		for (size_t row = 0; row < 8; row++) {
+			d[row] = rows[row][half];
+		}
+		input_transform(d, wd);
+		for (size_t row = 0; row < 8; row++) {
+			rows[row][half] = wd[row];
+		}
+	}
+}
+
+NNP_SSE2_INLINE void output_transform_rows(__m128 rows[restrict static 8][2]) {
+	for (size_t half = 0; half < 2; half++) {
+		__m128 m[8], s[6];
+		for (size_t row = 0; row < 8; row++) {
+			m[row] = rows[row][half];
+		}
+		output_transform(m, s);
+		for (size_t row = 0; row < 6; row++) {
+			rows[row][half] = s[row];
+		}
+		rows[6][half] = rows[7][half] = _mm_setzero_ps();
+	}
+}
+
+NNP_SSE2_INLINE void store_rows(float* data, size_t stride_bytes, __m128 rows[restrict static 8][2], bool stream) {
+	for (size_t row = 0; row < 8; row++) {
+		float* data_row = (float*) ((char*) data + row * stride_bytes);
+		if (stream) {
+			_mm_stream_ps(data_row, rows[row][0]);
+			_mm_stream_ps(data_row + 4, rows[row][1]);
+		} else {
+			_mm_store_ps(data_row, rows[row][0]);
+			_mm_store_ps(data_row + 4, rows[row][1]);
+		}
+	}
+}
+
+NNP_SSE2_INLINE void iwt8x8_3x3(const float d[], float wd[], size_t stride_d, size_t stride_wd,
+	uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset, bool stream)
+{
+	/* Elements which would fall outside of the 8x8 tile are not loaded, as in the AVX2 version */
+	float block[8][8] NNP_SIMD_ALIGN = { { 0.0f } };
+	for (uint32_t row = row_offset; row < min(8, row_offset + row_count); row++) {
+		for (uint32_t column = column_offset; column < min(8, column_offset + column_count); column++) {
+			block[row][column] = d[(row - row_offset) * stride_d + (column - column_offset)];
+		}
+	}
+
+	__m128 rows[8][2];
+	for (size_t row = 0; row < 8; row++) {
+		rows[row][0] = _mm_load_ps(&block[row][0]);
+		rows[row][1] = _mm_load_ps(&block[row][4]);
+	}
+	input_transform_rows(rows);
+	transpose8x8(rows);
+	input_transform_rows(rows);
+	store_rows(wd, stride_wd, rows, stream);
+}
+
+/*
+ * Kernel transform matrix, including the normalization factors:
+ *   wg0 = g0 * (-1/36)
+ *   wg1, wg2 = (g0 +- g1 + g2) * (1/48)
+ *   wg3, wg4 = (g0 +- 2 * g1 + 4 * g2) * (-1/120)
+ *   wg5, wg6 = (g0 +- 3 * g1 + 9 * g2) * (1/720)
+ *   wg7 = g2
+ */
+static const float kernel_transform_matrix[8][3] = {
+	{ -1.0f / 36.0f,           0.0f,           0.0f },
+	{  1.0f / 48.0f,   1.0f / 48.0f,   1.0f / 48.0f },
+	{  1.0f / 48.0f,  -1.0f / 48.0f,   1.0f / 48.0f },
+	{ -1.0f / 120.0f, -2.0f / 120.0f, -4.0f / 120.0f },
+	{ -1.0f / 120.0f,  2.0f / 120.0f, -4.0f / 120.0f },
+	{  1.0f / 720.0f,  3.0f / 720.0f,  9.0f / 720.0f },
+	{  1.0f / 720.0f, -3.0f / 720.0f,  9.0f / 720.0f },
+	{           0.0f,           0.0f,           1.0f },
+};
+
+NNP_SSE2_INLINE void kwt8x8_3x3(const float g[], size_t stride_g, bool reverse_kernel, __m128 rows[restrict static 8][2]) {
+	/* Transform columns of the kernel: wg[i][c] = sum(G[i][r] * g[r][c]), stored transposed as 3 rows of 8 elements */
+	float wg_columns[3][8] NNP_SIMD_ALIGN;
+	for (size_t c = 0; c < 3; c++) {
+		for (size_t i = 0; i < 8; i++) {
+			float sum = 0.0f;
+			for (size_t r = 0; r < 3; r++) {
+				const float element = reverse_kernel ?
+					g[(2 - r) * stride_g + (2 - c)] : g[r * stride_g + c];
+				sum += kernel_transform_matrix[i][r] * element;
+			}
+			wg_columns[c][i] = sum;
+		}
+	}
+
+	/* Transform rows of the transposed result */
+	for (size_t half = 0; half < 2; half++) {
+		const __m128 p0 = _mm_load_ps(&wg_columns[0][half * 4]);
+		const __m128 p1 = _mm_load_ps(&wg_columns[1][half * 4]);
+		const __m128 p2 = _mm_load_ps(&wg_columns[2][half * 4]);
+		for (size_t j = 0; j < 8; j++) {
+			rows[j][half] = madd(madd(
+				_mm_mul_ps(p0, _mm_set1_ps(kernel_transform_matrix[j][0])),
+				p1, kernel_transform_matrix[j][1]),
+				p2, kernel_transform_matrix[j][2]);
+		}
+	}
+}
+
+NNP_SSE2_INLINE void kwt8x8_3x3_and_mac(const float g[], float wg[], const float x[], size_t stride_g, bool reverse_kernel) {
+	__m128 rows[8][2];
+	kwt8x8_3x3(g, stride_g, reverse_kernel, rows);
+	for (size_t row = 0; row < 8; row++) {
+		for (size_t half = 0; half < 2; half++) {
+			float* wg_half = wg + row * 8 + half * 4;
+			_mm_store_ps(wg_half, _mm_add_ps(_mm_load_ps(wg_half),
+				_mm_mul_ps(rows[row][half], _mm_load_ps(x + row * 8 + half * 4))));
+		}
+	}
+}
+
+NNP_SSE2_INLINE void owt8x8_3x3(const float m[], float s[], size_t stride_m, size_t stride_s,
+	uint32_t row_count, uint32_t column_count, float bias, const struct nnp_fused_activation* activation)
+{
+	__m128 rows[8][2];
+	for (size_t row = 0; row < 8; row++) {
+		const float* m_row = (const float*) ((const char*) m + row * stride_m);
+		rows[row][0] = _mm_load_ps(m_row);
+		rows[row][1] = _mm_load_ps(m_row + 4);
+	}
+	output_transform_rows(rows);
+	transpose8x8(rows);
+	output_transform_rows(rows);
+
+	float block[8][8] NNP_SIMD_ALIGN;
+	const __m128 vbias = _mm_set1_ps(bias);
+	for (size_t row = 0; row < 6; row++) {
+		for (size_t half = 0; half < 2; half++) {
+			__m128 data = _mm_add_ps(rows[row][half], vbias);
+			if (activation != NULL) {
+				data = _mm_activation_ps(data, activation);
+			}
+			_mm_store_ps(&block[row][half * 4], data);
+		}
+	}
+	for (uint32_t row = 0; row < row_count; row++) {
+		for (uint32_t column = 0; column < column_count; column++) {
+			s[row * stride_s + column] = block[row][column];
+		}
+	}
+}
+
+void nnp_iwt8x8_3x3_and_store__sse2(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	iwt8x8_3x3(d, wd, stride_d, stride_wd, row_count, column_count, row_offset, column_offset, false);
+}
+
+void nnp_iwt8x8_3x3_and_stream__sse2(const float d[], float wd[], size_t stride_d, size_t stride_wd, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	iwt8x8_3x3(d, wd, stride_d, stride_wd, row_count, column_count, row_offset, column_offset, true);
+}
+
+void nnp_kwt8x8_3x3_and_store__sse2(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	__m128 rows[8][2];
+	kwt8x8_3x3(g, stride_g, false, rows);
+	store_rows(wg, stride_wg, rows, false);
+}
+
+void nnp_kwt8x8_3x3_and_stream__sse2(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	__m128 rows[8][2];
+	kwt8x8_3x3(g, stride_g, false, rows);
+	store_rows(wg, stride_wg, rows, true);
+}
+
+void nnp_kwt8x8_3x3_and_mac__sse2(const float g[], float wg[], const float x[], size_t stride_g) {
+	kwt8x8_3x3_and_mac(g, wg, x, stride_g, false);
+}
+
+void nnp_kwt8x8_3Rx3R_and_store__sse2(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	__m128 rows[8][2];
+	kwt8x8_3x3(g, stride_g, true, rows);
+	store_rows(wg, stride_wg, rows, false);
+}
+
+void nnp_kwt8x8_3Rx3R_and_stream__sse2(const float g[], float wg[], size_t stride_g, size_t stride_wg, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	__m128 rows[8][2];
+	kwt8x8_3x3(g, stride_g, true, rows);
+	store_rows(wg, stride_wg, rows, true);
+}
+
+void nnp_kwt8x8_3Rx3R_and_mac__sse2(const float g[], float wg[], const float x[], size_t stride_g) {
+	kwt8x8_3x3_and_mac(g, wg, x, stride_g, true);
+}
+
+void nnp_owt8x8_3x3__sse2(const float m[], float s[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, uint32_t row_offset, uint32_t column_offset) {
+	owt8x8_3x3(m, s, stride_m, stride_s, row_count, column_count, 0.0f, NULL);
+}
+
+void nnp_owt8x8_3x3_with_bias__sse2(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count) {
+	owt8x8_3x3(m, s, stride_m, stride_s, row_count, column_count, *bias, NULL);
+}
+
+void nnp_owt8x8_3x3_with_bias_activation__sse2(const float m[], float s[], const float bias[], size_t stride_m, size_t stride_s, uint32_t row_count, uint32_t column_count, const struct nnp_fused_activation* activation) {
+	owt8x8_3x3(m, s, stride_m, stride_s, row_count, column_count, *bias, activation);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <x86intrin.h>
+
+#include <nnpack/activations.h>
+
+/*
+ * Fused activation for 4 single-precision elements, using only SSE2 instructions.
+ * Negative elements are scaled by the slope, then clamped to the bounds; NaN elements produce the lower bound.
+ */
+static inline __m128 _mm_activation_ps(__m128 x, const struct nnp_fused_activation* activation) {
+	const __m128 negative_mask = _mm_cmplt_ps(x, _mm_setzero_ps());
+	const __m128 scaled_x = _mm_mul_ps(x, _mm_set1_ps(activation->negative_slope));
+	x = _mm_or_ps(_mm_and_ps(negative_mask, scaled_x), _mm_andnot_ps(negative_mask, x));
+	x = _mm_max_ps(x, _mm_set1_ps(activation->lower_bound));
+	return _mm_min_ps(x, _mm_set1_ps(activation->upper_bound));
+}
@@ -0,0 +1,102 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/pooling.h>
+
+static inline float _mm_reduce_add_ps(__m128 x) {
+	x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+	x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(x);
+}
+
+/*
+ * Same two-pass structure as nnp_avgpool_generic__avx2, with 4-wide vectors in the vertical pass.
+ * SSE2 lacks gathers and 32-bit integer min/max, thus the horizontal pass and the pixel counts are scalar.
+ */
+void nnp_avgpool_generic__sse2(const float* input, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size)
+{
+	/* The last pooling window may extend up to pooling_stride.width - 1 elements past the right padding */
+	const size_t row_size = input_padding.left + input_size.width + input_padding.right + pooling_stride.width;
+	NNP_SIMD_ALIGN float row[row_size];
+	for (size_t x = 0; x < input_padding.left; x++) {
+		row[x] = 0.0f;
+	}
+	for (size_t x = input_padding.left + input_size.width; x < row_size; x++) {
+		row[x] = 0.0f;
+	}
+	float* row_data = row + input_padding.left;
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		const size_t window_start = y * pooling_stride.height;
+		const size_t input_row_start = doz(window_start, input_padding.top);
+		const size_t input_row_end = min(doz(window_start + pooling_size.height, input_padding.top), input_size.height);
+		const size_t input_row_count = doz(input_row_end, input_row_start);
+
+		/* Vertical pass */
+		size_t x = 0;
+		for (; x + 4 <= input_size.width; x += 4) {
+			__m128 sum = _mm_setzero_ps();
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				sum = _mm_add_ps(sum, _mm_loadu_ps(&input[input_row * input_size.width + x]));
+			}
+			_mm_storeu_ps(&row_data[x], sum);
+		}
+		for (; x < input_size.width; x++) {
+			float sum = 0.0f;
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				sum += input[input_row * input_size.width + x];
+			}
+			row_data[x] = sum;
+		}
+
+		/* Horizontal pass */
+		float* output_row = output + y * output_size.width;
+		for (size_t x = 0; x < output_size.width; x++) {
+			const size_t window_column_start = x * pooling_stride.width;
+			const float* window = row + window_column_start;
+			float sum = 0.0f;
+			for (size_t i = 0; i < pooling_size.width; i++) {
+				sum += window[i];
+			}
+
+			/* Number of input columns in the window, clipped to the input image */
+			const size_t input_column_start = doz(window_column_start, input_padding.left);
+			const size_t input_column_end = min(doz(window_column_start + pooling_size.width, input_padding.left), input_size.width);
+			const size_t input_pixel_count = input_row_count * doz(input_column_end, input_column_start);
+
+			/* Windows without input pixels produce zero */
+			output_row[x] = sum / (float) max(input_pixel_count, 1);
+		}
+	}
+}
+
+void nnp_global_avgpool__sse2(const float* input, float* output, size_t channels, size_t image_elements) {
+	const float scale = 1.0f / (float) image_elements;
+	for (size_t channel = 0; channel < channels; channel++) {
+		__m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps(), sum2 = _mm_setzero_ps(), sum3 = _mm_setzero_ps();
+		size_t length = image_elements;
+		for (; length >= 16; length -= 16) {
+			sum0 = _mm_add_ps(sum0, _mm_loadu_ps(input));
+			sum1 = _mm_add_ps(sum1, _mm_loadu_ps(input + 4));
+			sum2 = _mm_add_ps(sum2, _mm_loadu_ps(input + 8));
+			sum3 = _mm_add_ps(sum3, _mm_loadu_ps(input + 12));
+			input += 16;
+		}
+		for (; length >= 4; length -= 4) {
+			sum0 = _mm_add_ps(sum0, _mm_loadu_ps(input));
+			input += 4;
+		}
+		for (; length != 0; length -= 1) {
+			sum1 = _mm_add_ss(sum1, _mm_load_ss(input));
+			input += 1;
+		}
+		output[channel] = _mm_reduce_add_ps(_mm_add_ps(_mm_add_ps(sum0, sum1), _mm_add_ps(sum2, sum3))) * scale;
+	}
+}
@@ -0,0 +1,179 @@
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/blas.h>
+#include <nnpack/transform.h>
+
+/*
+ * A complex tuple is 8 real parts followed by 8 imaginary parts, and takes four XMM registers.
+ * In mixed (s4c6) tuples elements 0-1 of both the real and the imaginary part are independent real numbers,
+ * and are multiplied element-wise instead of as complex numbers.
+ */
+struct tuple {
+	__m128 re[2];
+	__m128 im[2];
+};
+
+static inline struct tuple load_tuple(const float* data) {
+	return (struct tuple) {
+		.re = { _mm_load_ps(data), _mm_load_ps(data + 4) },
+		.im = { _mm_load_ps(data + 8), _mm_load_ps(data + 12) },
+	};
+}
+
+static inline void store_tuple(float* data, struct tuple t) {
+	_mm_store_ps(data, t.re[0]);
+	_mm_store_ps(data + 4, t.re[1]);
+	_mm_store_ps(data + 8, t.im[0]);
+	_mm_store_ps(data + 12, t.im[1]);
+}
+
+static inline struct tuple add_tuple(struct tuple a, struct tuple b) {
+	return (struct tuple) {
+		.re = { _mm_add_ps(a.re[0], b.re[0]), _mm_add_ps(a.re[1], b.re[1]) },
+		.im = { _mm_add_ps(a.im[0], b.im[0]), _mm_add_ps(a.im[1], b.im[1]) },
+	};
+}
+
+/*
+ * Multiplier operand, pre-processed for mixed tuples:
+ * re_for_im holds the elements which multiply x.im, and im has zeroes instead of the real-only elements.
+ */
+struct multiplier {
+	__m128 re[2];
+	__m128 re_for_im[2];
+	__m128 im[2];
+};
+
+static inline struct multiplier prepare_multiplier(struct tuple y, bool mixed) {
+	struct multiplier result = {
+		.re = { y.re[0], y.re[1] },
+		.re_for_im = { y.re[0], y.re[1] },
+		.im = { y.im[0], y.im[1] },
+	};
+	if (mixed) {
+		result.re_for_im[0] = _mm_shuffle_ps(y.im[0], y.re[0], _MM_SHUFFLE(3, 2, 1, 0));
+		result.im[0] = _mm_shuffle_ps(_mm_setzero_ps(), y.im[0], _MM_SHUFFLE(3, 2, 1, 0));
+	}
+	return result;
+}
+
+/* acc += x * y, or acc += x * conj(y) */
+static inline __attribute__((__always_inline__)) struct tuple multiply_accumulate(struct tuple acc, struct tuple x, struct multiplier y, bool conjugate_y) {
+	for (size_t i = 0; i < 2; i++) {
+		acc.re[i] = _mm_add_ps(acc.re[i], _mm_mul_ps(x.re[i], y.re[i]));
+		acc.im[i] = _mm_add_ps(acc.im[i], _mm_mul_ps(x.im[i], y.re_for_im[i]));
+		if (conjugate_y) {
+			acc.re[i] = _mm_add_ps(acc.re[i], _mm_mul_ps(x.im[i], y.im[i]));
+			acc.im[i] = _mm_sub_ps(acc.im[i], _mm_mul_ps(x.re[i], y.im[i]));
+		} else {
+			acc.re[i] = _mm_sub_ps(acc.re[i], _mm_mul_ps(x.im[i], y.im[i]));
+			acc.im[i] = _mm_add_ps(acc.im[i], _mm_mul_ps(x.re[i], y.im[i]));
+		}
+	}
+	return acc;
+}
+
+/* Always inlined, so that loops over mr and nr are fully unrolled */
+static inline __attribute__((__always_inline__)) void cgemm(size_t mr, size_t nr, bool mixed, bool conjugate_a, bool conjugate_b,
+	size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride_c, size_t column_stride_c)
+{
+	const struct tuple zero = {
+		.re = { _mm_setzero_ps(), _mm_setzero_ps() },
+		.im = { _mm_setzero_ps(), _mm_setzero_ps() },
+	};
+	struct tuple vc[2][2] = { { zero, zero }, { zero, zero } };
+
+	for (; k != 0; k--) {
+		struct tuple va[2], vb[2];
+		for (size_t m = 0; m < mr; m++) {
+			va[m] = load_tuple(a + m * 16);
+		}
+		for (size_t n = 0; n < nr; n++) {
+			vb[n] = load_tuple(b + n * 16);
+		}
+
+		if (conjugate_a) {
+			/* conj(a) * b is computed as b * conj(a) */
+			for (size_t m = 0; m < mr; m++) {
+				const struct multiplier ya = prepare_multiplier(va[m], mixed);
+				for (size_t n = 0; n < nr; n++) {
+					vc[m][n] = multiply_accumulate(vc[m][n], vb[n], ya, true);
+				}
+			}
+		} else {
+			for (size_t n = 0; n < nr; n++) {
+				const struct multiplier yb = prepare_multiplier(vb[n], mixed);
+				for (size_t m = 0; m < mr; m++) {
+					vc[m][n] = multiply_accumulate(vc[m][n], va[m], yb, conjugate_b);
+				}
+			}
+		}
+
+		a += mr * 16;
+		b += nr * 16;
+	}
+
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nr; n++) {
+			float* c_mn = c + m * row_stride_c + n * column_stride_c;
+			if (k_tile != 0) {
+				vc[m][n] = add_tuple(vc[m][n], load_tuple(c_mn));
+			}
+			store_tuple(c_mn, vc[m][n]);
+		}
+	}
+}
+
+#define NNP_CGEMM_SSE2(TYPE, CONJUGATE, MR, NR, MIXED, CONJUGATE_A, CONJUGATE_B) \
+	void nnp_##TYPE##gemm##CONJUGATE##MR##x##NR##__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride_c, size_t column_stride_c) { \
+		cgemm(MR, NR, MIXED, CONJUGATE_A, CONJUGATE_B, k, k_tile, a, b, c, row_stride_c, column_stride_c); \
+	}
+
+NNP_CGEMM_SSE2(c8,   , 1, 1, false, false, false)
+NNP_CGEMM_SSE2(c8,   , 1, 2, false, false, false)
+NNP_CGEMM_SSE2(c8,   , 2, 1, false, false, false)
+NNP_CGEMM_SSE2(c8,   , 2, 2, false, false, false)
+NNP_CGEMM_SSE2(s4c6, , 1, 1, true,  false, false)
+NNP_CGEMM_SSE2(s4c6, , 1, 2, true,  false, false)
+NNP_CGEMM_SSE2(s4c6, , 2, 1, true,  false, false)
+NNP_CGEMM_SSE2(s4c6, , 2, 2, true,  false, false)
+
+NNP_CGEMM_SSE2(c8,   ca, 1, 1, false, true, false)
+NNP_CGEMM_SSE2(c8,   ca, 1, 2, false, true, false)
+NNP_CGEMM_SSE2(c8,   ca, 2, 1, false, true, false)
+NNP_CGEMM_SSE2(c8,   ca, 2, 2, false, true, false)
+NNP_CGEMM_SSE2(s4c6, ca, 1, 1, true,  true, false)
+NNP_CGEMM_SSE2(s4c6, ca, 1, 2, true,  true, false)
+NNP_CGEMM_SSE2(s4c6, ca, 2, 1, true,  true, false)
+NNP_CGEMM_SSE2(s4c6, ca, 2, 2, true,  true, false)
+
+NNP_CGEMM_SSE2(c8,   cb, 1, 1, false, false, true)
+NNP_CGEMM_SSE2(c8,   cb, 1, 2, false, false, true)
+NNP_CGEMM_SSE2(c8,   cb, 2, 1, false, false, true)
+NNP_CGEMM_SSE2(c8,   cb, 2, 2, false, false, true)
+NNP_CGEMM_SSE2(s4c6, cb, 1, 1, true,  false, true)
+NNP_CGEMM_SSE2(s4c6, cb, 1, 2, true,  false, true)
+NNP_CGEMM_SSE2(s4c6, cb, 2, 1, true,  false, true)
+NNP_CGEMM_SSE2(s4c6, cb, 2, 2, true,  false, true)
+
+/* Accumulates x * conj(y) over a tile of tuple_count complex tuples, where the first tuple is mixed */
+static inline void tile_gemmc(size_t tuple_count, float* acc, const float* x, const float* y) {
+	for (size_t tuple = 0; tuple < tuple_count; tuple++) {
+		const struct multiplier vy = prepare_multiplier(load_tuple(y), tuple == 0);
+		store_tuple(acc, multiply_accumulate(load_tuple(acc), load_tuple(x), vy, true));
+		acc += 16;
+		x += 16;
+		y += 16;
+	}
+}
+
+void nnp_ft8x8gemmc__sse2(float acc[], const float x[], const float y[]) {
+	tile_gemmc(4, acc, x, y);
+}
+
+void nnp_ft16x16gemmc__sse2(float acc[], const float x[], const float y[]) {
+	tile_gemmc(16, acc, x, y);
+}
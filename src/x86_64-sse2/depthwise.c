@@ -0,0 +1,129 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/depthwise.h>
+
+#include "activation.h"
+
+/*
+ * Copies an input row into a zero-padded buffer, split by phase of the horizontal subsampling: phase p holds elements
+ * p, p + stride, p + 2 * stride, ... of the padded row.
+ */
+static void load_row(const float* input_row, float* buffer,
+	size_t input_width, size_t padding_left, size_t stride, size_t phases, size_t phase_elements)
+{
+	if (stride == 1) {
+		const size_t copy_elements = min(input_width, phase_elements - padding_left);
+		memset(buffer, 0, padding_left * sizeof(float));
+		memcpy(buffer + padding_left, input_row, copy_elements * sizeof(float));
+		memset(buffer + padding_left + copy_elements, 0, (phase_elements - padding_left - copy_elements) * sizeof(float));
+		return;
+	}
+
+	for (size_t phase = 0; phase < phases; phase++) {
+		for (size_t i = 0; i < phase_elements; i++) {
+			/* Columns in the left padding wrap around to out-of-range unsigned values */
+			const size_t input_x = i * stride + phase - padding_left;
+			buffer[phase * phase_elements + i] = (input_x < input_width) ? input_row[input_x] : 0.0f;
+		}
+	}
+}
+
+/*
+ * Output pixel x reads kernel column c at element x + c / stride of phase c % stride of the row buffer, so the
+ * horizontal loop uses contiguous vector loads with any subsampling. Row buffers form a ring indexed by input row,
+ * thus without vertical subsampling every input row is copied once.
+ */
+static inline void dwconv3x3(const float* input, const float* kernel, float bias, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size output_subsampling, struct nnp_size output_size,
+	const struct nnp_fused_activation* activation)
+{
+	const size_t stride = output_subsampling.width;
+	const size_t phases = min(stride, 3);
+	const size_t phase_elements = round_up(output_size.width, 4) + 2;
+	const size_t row_elements = phases * phase_elements;
+
+	NNP_SIMD_ALIGN float rows[4][row_elements];
+	memset(rows[3], 0, row_elements * sizeof(float));
+	size_t ring_row[3] = { SIZE_MAX, SIZE_MAX, SIZE_MAX };
+
+	size_t column_offset[3];
+	for (size_t c = 0; c < 3; c++) {
+		column_offset[c] = (c % stride) * phase_elements + c / stride;
+	}
+
+	const __m128 k00 = _mm_set1_ps(kernel[0]), k01 = _mm_set1_ps(kernel[1]), k02 = _mm_set1_ps(kernel[2]);
+	const __m128 k10 = _mm_set1_ps(kernel[3]), k11 = _mm_set1_ps(kernel[4]), k12 = _mm_set1_ps(kernel[5]);
+	const __m128 k20 = _mm_set1_ps(kernel[6]), k21 = _mm_set1_ps(kernel[7]), k22 = _mm_set1_ps(kernel[8]);
+	const __m128 vbias = _mm_set1_ps(bias);
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		const float* row[3];
+		for (size_t i = 0; i < 3; i++) {
+			/* Rows in the top padding wrap around to out-of-range unsigned values and read the zero buffer */
+			const size_t input_y = y * output_subsampling.height + i - input_padding.top;
+			if (input_y < input_size.height) {
+				const size_t slot = input_y % 3;
+				if (ring_row[slot] != input_y) {
+					load_row(input + input_y * input_size.width, rows[slot],
+						input_size.width, input_padding.left, stride, phases, phase_elements);
+					ring_row[slot] = input_y;
+				}
+				row[i] = rows[slot];
+			} else {
+				row[i] = rows[3];
+			}
+		}
+
+		const float* row0c0 = row[0] + column_offset[0];
+		const float* row0c1 = row[0] + column_offset[1];
+		const float* row0c2 = row[0] + column_offset[2];
+		const float* row1c0 = row[1] + column_offset[0];
+		const float* row1c1 = row[1] + column_offset[1];
+		const float* row1c2 = row[1] + column_offset[2];
+		const float* row2c0 = row[2] + column_offset[0];
+		const float* row2c1 = row[2] + column_offset[1];
+		const float* row2c2 = row[2] + column_offset[2];
+		float* output_row = output + y * output_size.width;
+		for (size_t x = 0; x < output_size.width; x += 4) {
+			__m128 acc0 = _mm_add_ps(vbias, _mm_mul_ps(k00, _mm_loadu_ps(row0c0 + x)));
+			__m128 acc1 = _mm_mul_ps(k01, _mm_loadu_ps(row0c1 + x));
+			__m128 acc2 = _mm_mul_ps(k02, _mm_loadu_ps(row0c2 + x));
+			acc0 = _mm_add_ps(acc0, _mm_mul_ps(k10, _mm_loadu_ps(row1c0 + x)));
+			acc1 = _mm_add_ps(acc1, _mm_mul_ps(k11, _mm_loadu_ps(row1c1 + x)));
+			acc2 = _mm_add_ps(acc2, _mm_mul_ps(k12, _mm_loadu_ps(row1c2 + x)));
+			acc0 = _mm_add_ps(acc0, _mm_mul_ps(k20, _mm_loadu_ps(row2c0 + x)));
+			acc1 = _mm_add_ps(acc1, _mm_mul_ps(k21, _mm_loadu_ps(row2c1 + x)));
+			acc2 = _mm_add_ps(acc2, _mm_mul_ps(k22, _mm_loadu_ps(row2c2 + x)));
+			__m128 acc = _mm_add_ps(_mm_add_ps(acc0, acc1), acc2);
+			if (activation != NULL) {
+				acc = _mm_activation_ps(acc, activation);
+			}
+
+			if (x + 4 <= output_size.width) {
+				_mm_storeu_ps(output_row + x, acc);
+			} else {
+				NNP_SIMD_ALIGN float block[4];
+				_mm_store_ps(block, acc);
+				for (size_t i = 0; i < output_size.width - x; i++) {
+					output_row[x + i] = block[i];
+				}
+			}
+		}
+	}
+}
+
+void nnp_dwconv3x3__sse2(const float* input, const float* kernel, float bias, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size output_subsampling, struct nnp_size output_size,
+	const struct nnp_fused_activation* activation)
+{
+	dwconv3x3(input, kernel, bias, output, input_size, input_padding, output_subsampling, output_size, activation);
+}
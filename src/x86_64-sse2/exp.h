@@ -0,0 +1,57 @@
+#pragma once
+
+#include <x86intrin.h>
+
+/*
+ * Vectorized expf for 4 single-precision elements, using only SSE2 instructions.
+ * The argument is reduced as x = n * ln(2) + r with |r| <= ln(2) / 2, and exp(r) is approximated by a polynomial.
+ * The scale 2**n is applied in two steps, so that results which are denormal before scaling are not flushed.
+ * Inputs below the underflow cutoff produce 0, inputs above the overflow cutoff produce +inf, NaN inputs are preserved.
+ */
+static inline __m128 _mm_exp_ps(__m128 x) {
+	const __m128 magic_bias = _mm_set1_ps(0x1.800000p+23f);
+	const __m128 zero_cutoff = _mm_set1_ps(-0x1.9FE368p+6f); /* The smallest x for which expf(x) is non-zero */
+	const __m128 inf_cutoff = _mm_set1_ps(0x1.62E42Ep+6f); /* The largest x for which expf(x) is finite */
+	const __m128 log2e = _mm_set1_ps(0x1.715476p+0f);
+	const __m128 minus_ln2_hi = _mm_set1_ps(-0x1.62E400p-1f);
+	const __m128 minus_ln2_lo = _mm_set1_ps(-0x1.7F7D1Cp-20f);
+	const __m128 plus_inf = _mm_set1_ps(__builtin_inff());
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	const __m128 c2 = _mm_set1_ps(5.0000001201E-1f);
+	const __m128 c3 = _mm_set1_ps(1.6666665459E-1f);
+	const __m128 c4 = _mm_set1_ps(4.1665795894E-2f);
+	const __m128 c5 = _mm_set1_ps(8.3334519073E-3f);
+	const __m128 c6 = _mm_set1_ps(1.3981999507E-3f);
+	const __m128 c7 = _mm_set1_ps(1.9875691500E-4f);
+
+	const __m128 min_exponent = _mm_set1_ps(-126.0f);
+	const __m128 max_exponent = _mm_set1_ps(127.0f);
+	const __m128i default_exponent = _mm_set1_epi32(0x3F800000);
+
+	/* n = round(x / ln(2)) */
+	const __m128 n = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(x, log2e), magic_bias), magic_bias);
+	const __m128 n1 = _mm_min_ps(_mm_max_ps(n, min_exponent), max_exponent);
+	const __m128 n2 = _mm_sub_ps(n, n1);
+	const __m128 s1 = _mm_castsi128_ps(_mm_add_epi32(_mm_slli_epi32(_mm_cvttps_epi32(n1), 23), default_exponent));
+	const __m128 s2 = _mm_castsi128_ps(_mm_add_epi32(_mm_slli_epi32(_mm_cvttps_epi32(n2), 23), default_exponent));
+
+	const __m128 r = _mm_add_ps(_mm_mul_ps(n, minus_ln2_lo), _mm_add_ps(_mm_mul_ps(n, minus_ln2_hi), x));
+	__m128 p = _mm_add_ps(_mm_mul_ps(c7, r), c6);
+	p = _mm_add_ps(_mm_mul_ps(p, r), c5);
+	p = _mm_add_ps(_mm_mul_ps(p, r), c4);
+	p = _mm_add_ps(_mm_mul_ps(p, r), c3);
+	p = _mm_add_ps(_mm_mul_ps(p, r), c2);
+	p = _mm_add_ps(_mm_mul_ps(p, _mm_mul_ps(r, r)), _mm_add_ps(r, one));
+
+	__m128 f = _mm_mul_ps(s2, _mm_mul_ps(s1, p));
+	/* Fixup underflow to zero */
+	f = _mm_andnot_ps(_mm_cmplt_ps(x, zero_cutoff), f);
+	/* Fixup overflow */
+	const __m128 overflow = _mm_cmpgt_ps(x, inf_cutoff);
+	f = _mm_or_ps(_mm_and_ps(overflow, plus_inf), _mm_andnot_ps(overflow, f));
+	/* Fixup NaN */
+	const __m128 ordered = _mm_cmpeq_ps(x, x);
+	f = _mm_or_ps(_mm_and_ps(ordered, f), _mm_andnot_ps(ordered, x));
+	return f;
+}
@@ -0,0 +1,279 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/utils.h>
+#include <nnpack/pooling.h>
+
+/* Forces inlining, so that pooling size and stride are compile-time constants in every tile kernel below */
+#define NNP_SSE2_INLINE static inline __attribute__((__always_inline__))
+
+/*
+ * Max pooling of one tile: the input tile has pooling_height rows of (7 * stride + pooling_width) columns,
+ * elements outside of the loaded region are -inf. Produces up to 8 outputs of one row.
+ */
+NNP_SSE2_INLINE void maxpool_tile(size_t pooling_height, size_t pooling_width, size_t stride,
+	const float* src, float* dst, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count,
+	uint32_t src_column_offset, uint32_t src_column_count,
+	uint32_t dst_column_count)
+{
+	/* 24 columns fit the widest tile (17 columns) plus a vector of overread for the stride-2 deinterleave */
+	float block[3][24] NNP_SIMD_ALIGN;
+	for (size_t y = 0; y < pooling_height; y++) {
+		for (size_t x = 0; x < 24; x++) {
+			block[y][x] = -__builtin_inff();
+		}
+		if (y - src_row_offset < src_row_count) {
+			const float* src_row = src + (y - src_row_offset) * src_stride;
+			for (size_t x = 0; x < src_column_count; x++) {
+				block[y][src_column_offset + x] = src_row[x];
+			}
+		}
+	}
+
+	/* Vertical pass */
+	float row[24] NNP_SIMD_ALIGN;
+	for (size_t x = 0; x < 24; x += 4) {
+		__m128 max = _mm_load_ps(&block[0][x]);
+		for (size_t y = 1; y < pooling_height; y++) {
+			max = _mm_max_ps(max, _mm_load_ps(&block[y][x]));
+		}
+		_mm_store_ps(&row[x], max);
+	}
+
+	/* Horizontal pass */
+	float out[8] NNP_SIMD_ALIGN;
+	for (size_t half = 0; half < 2; half++) {
+		__m128 max = _mm_set1_ps(-__builtin_inff());
+		for (size_t i = 0; i < pooling_width; i++) {
+			const float* window = &row[half * 4 * stride + i];
+			if (stride == 1) {
+				max = _mm_max_ps(max, _mm_loadu_ps(window));
+			} else {
+				max = _mm_max_ps(max, _mm_shuffle_ps(_mm_loadu_ps(window), _mm_loadu_ps(window + 4), _MM_SHUFFLE(2, 0, 2, 0)));
+			}
+		}
+		_mm_store_ps(&out[half * 4], max);
+	}
+	for (size_t x = 0; x < dst_column_count; x++) {
+		dst[x] = out[x];
+	}
+}
+
+void nnp_maxpool_2x2_2x2__sse2(const float* src_pointer, float* dst_pointer, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count)
+{
+	maxpool_tile(2, 2, 2, src_pointer, dst_pointer, src_stride,
+		src_row_offset, src_row_count, src_column_offset, src_column_count, dst_column_count);
+}
+
+void nnp_maxpool_3x3_2x2__sse2(const float* src_pointer, float* dst_pointer, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count)
+{
+	maxpool_tile(3, 3, 2, src_pointer, dst_pointer, src_stride,
+		src_row_offset, src_row_count, src_column_offset, src_column_count, dst_column_count);
+}
+
+void nnp_maxpool_3x3_1x1__sse2(const float* src_pointer, float* dst_pointer, size_t src_stride,
+	uint32_t src_row_offset, uint32_t src_row_count, uint32_t src_column_offset, uint32_t src_column_count, uint32_t dst_column_count)
+{
+	maxpool_tile(3, 3, 1, src_pointer, dst_pointer, src_stride,
+		src_row_offset, src_row_count, src_column_offset, src_column_count, dst_column_count);
+}
+
+/* Loads count (at most 4) elements with the given stride, and fills the remaining lanes with the specified value */
+static inline __m128 load_strided(const float* data, size_t stride, size_t count, float fill) {
+	float lanes[4] NNP_SIMD_ALIGN = { fill, fill, fill, fill };
+	for (size_t i = 0; i < min(count, 4); i++) {
+		lanes[i] = data[i * stride];
+	}
+	return _mm_load_ps(lanes);
+}
+
+static inline __m128i load_strided_indices(const uint32_t* data, size_t stride, size_t count) {
+	uint32_t lanes[4] NNP_SIMD_ALIGN = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+	for (size_t i = 0; i < min(count, 4); i++) {
+		lanes[i] = data[i * stride];
+	}
+	return _mm_load_si128((const __m128i*) lanes);
+}
+
+static inline __m128 select_ps(__m128 mask, __m128 a, __m128 b) {
+	return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+}
+
+/*
+ * Same two-pass structure as nnp_maxpool_generic__avx2, with 4-wide vectors.
+ * Partial vectors at the right edge of input and output rows are processed with scalar code.
+ */
+void nnp_maxpool_generic__sse2(const float* input, float* output,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size)
+{
+	const __m128 minus_inf = _mm_set1_ps(-__builtin_inff());
+
+	/* The last pooling window may extend up to pooling_stride.width - 1 elements past the right padding */
+	const size_t row_size = round_up(input_padding.left + input_size.width + input_padding.right + pooling_stride.width, 4) + 4;
+	NNP_SIMD_ALIGN float row[row_size];
+	for (size_t x = 0; x < input_padding.left; x++) {
+		row[x] = -__builtin_inff();
+	}
+	for (size_t x = input_padding.left + input_size.width; x < row_size; x++) {
+		row[x] = -__builtin_inff();
+	}
+	float* row_data = row + input_padding.left;
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		const size_t window_start = y * pooling_stride.height;
+		const size_t input_row_start = doz(window_start, input_padding.top);
+		const size_t input_row_end = min(doz(window_start + pooling_size.height, input_padding.top), input_size.height);
+
+		/* Vertical pass */
+		size_t x = 0;
+		for (; x + 4 <= input_size.width; x += 4) {
+			__m128 max = minus_inf;
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				max = _mm_max_ps(max, _mm_loadu_ps(&input[input_row * input_size.width + x]));
+			}
+			_mm_storeu_ps(&row_data[x], max);
+		}
+		for (; x < input_size.width; x++) {
+			__m128 max = minus_inf;
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				max = _mm_max_ss(max, _mm_load_ss(&input[input_row * input_size.width + x]));
+			}
+			_mm_store_ss(&row_data[x], max);
+		}
+
+		/* Horizontal pass */
+		float* output_row = output + y * output_size.width;
+		for (size_t x = 0; x < output_size.width; x += 4) {
+			const size_t count = output_size.width - x;
+			const float* window = row + x * pooling_stride.width;
+			__m128 max = minus_inf;
+			for (size_t i = 0; i < pooling_size.width; i++) {
+				if (pooling_stride.width == 1) {
+					max = _mm_max_ps(max, _mm_loadu_ps(&window[i]));
+				} else {
+					max = _mm_max_ps(max, load_strided(&window[i], pooling_stride.width, count, -__builtin_inff()));
+				}
+			}
+			if (count >= 4) {
+				_mm_storeu_ps(&output_row[x], max);
+			} else {
+				float lanes[4] NNP_SIMD_ALIGN;
+				_mm_store_ps(lanes, max);
+				for (size_t i = 0; i < count; i++) {
+					output_row[x + i] = lanes[i];
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Same two-pass structure as nnp_maxpool_generic__sse2, but also tracks the index (y * input_size.width + x) of the
+ * maximum within the input image. Among equal maxima the leftmost column wins, and within a column the topmost row.
+ * Windows which cover only padding produce -inf and index UINT32_MAX.
+ */
+void nnp_maxpool_argmax_generic__sse2(const float* input, float* output, uint32_t* indices,
+	struct nnp_size input_size, struct nnp_padding input_padding,
+	struct nnp_size pooling_size, struct nnp_size pooling_stride,
+	struct nnp_size output_size)
+{
+	const __m128 minus_inf = _mm_set1_ps(-__builtin_inff());
+	const __m128i invalid_index = _mm_set1_epi32(-1);
+
+	/* The last pooling window may extend up to pooling_stride.width - 1 elements past the right padding */
+	const size_t row_size = round_up(input_padding.left + input_size.width + input_padding.right + pooling_stride.width, 4) + 4;
+	NNP_SIMD_ALIGN float row[row_size];
+	NNP_SIMD_ALIGN uint32_t row_indices[row_size];
+	for (size_t x = 0; x < input_padding.left; x++) {
+		row[x] = -__builtin_inff();
+		row_indices[x] = UINT32_MAX;
+	}
+	for (size_t x = input_padding.left + input_size.width; x < row_size; x++) {
+		row[x] = -__builtin_inff();
+		row_indices[x] = UINT32_MAX;
+	}
+	float* row_data = row + input_padding.left;
+	uint32_t* row_indices_data = row_indices + input_padding.left;
+
+	const __m128i column_index = _mm_setr_epi32(0, 1, 2, 3);
+
+	for (size_t y = 0; y < output_size.height; y++) {
+		const size_t window_start = y * pooling_stride.height;
+		const size_t input_row_start = doz(window_start, input_padding.top);
+		const size_t input_row_end = min(doz(window_start + pooling_size.height, input_padding.top), input_size.height);
+
+		/* Vertical pass */
+		size_t x = 0;
+		for (; x + 4 <= input_size.width; x += 4) {
+			__m128 max = minus_inf;
+			__m128i max_index = invalid_index;
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				const size_t offset = input_row * input_size.width + x;
+				const __m128 value = _mm_loadu_ps(&input[offset]);
+				const __m128 greater = _mm_cmpgt_ps(value, max);
+				max = select_ps(greater, max, value);
+				max_index = _mm_castps_si128(select_ps(greater,
+					_mm_castsi128_ps(max_index),
+					_mm_castsi128_ps(_mm_add_epi32(column_index, _mm_set1_epi32((int32_t) offset)))));
+			}
+			_mm_storeu_ps(&row_data[x], max);
+			_mm_storeu_si128((__m128i*) &row_indices_data[x], max_index);
+		}
+		for (; x < input_size.width; x++) {
+			float max = -__builtin_inff();
+			uint32_t max_index = UINT32_MAX;
+			for (size_t input_row = input_row_start; input_row < input_row_end; input_row++) {
+				const size_t offset = input_row * input_size.width + x;
+				if (input[offset] > max) {
+					max = input[offset];
+					max_index = (uint32_t) offset;
+				}
+			}
+			row_data[x] = max;
+			row_indices_data[x] = max_index;
+		}
+
+		/* Horizontal pass */
+		float* output_row = output + y * output_size.width;
+		uint32_t* indices_row = indices + y * output_size.width;
+		for (size_t x = 0; x < output_size.width; x += 4) {
+			const size_t count = output_size.width - x;
+			const float* window = row + x * pooling_stride.width;
+			const uint32_t* window_indices = row_indices + x * pooling_stride.width;
+			__m128 max = minus_inf;
+			__m128i max_index = invalid_index;
+			for (size_t i = 0; i < pooling_size.width; i++) {
+				__m128 value;
+				__m128i value_index;
+				if (pooling_stride.width == 1) {
+					value = _mm_loadu_ps(&window[i]);
+					value_index = _mm_loadu_si128((const __m128i*) &window_indices[i]);
+				} else {
+					value = load_strided(&window[i], pooling_stride.width, count, -__builtin_inff());
+					value_index = load_strided_indices(&window_indices[i], pooling_stride.width, count);
+				}
+				const __m128 greater = _mm_cmpgt_ps(value, max);
+				max = select_ps(greater, max, value);
+				max_index = _mm_castps_si128(select_ps(greater,
+					_mm_castsi128_ps(max_index), _mm_castsi128_ps(value_index)));
+			}
+			float lanes[4] NNP_SIMD_ALIGN;
+			uint32_t lane_indices[4] NNP_SIMD_ALIGN;
+			_mm_store_ps(lanes, max);
+			_mm_store_si128((__m128i*) lane_indices, max_index);
+			for (size_t i = 0; i < min(count, 4); i++) {
+				output_row[x + i] = lanes[i];
+				indices_row[x + i] = lane_indices[i];
+			}
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/activations.h>
+
+/* Negative inputs (including -0.0) are multiplied by the slope, as in the AVX2 kernels which select by the sign bit */
+static inline __m128 relu(__m128 data, __m128 negative_slope, __m128 sign) {
+	const __m128 negative = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(sign), 31));
+	return _mm_or_ps(_mm_and_ps(negative, _mm_mul_ps(data, negative_slope)), _mm_andnot_ps(negative, data));
+}
+
+void nnp_relu__sse2(const float* input, float* output, size_t length, float negative_slope) {
+	const __m128 vnegative_slope = _mm_set1_ps(negative_slope);
+	/* Each vector is loaded before it is stored, so input and output may alias */
+	for (; length >= 4; length -= 4) {
+		const __m128 data = _mm_loadu_ps(input);
+		_mm_storeu_ps(output, relu(data, vnegative_slope, data));
+		input += 4;
+		output += 4;
+	}
+	for (; length != 0; length -= 1) {
+		const __m128 data = _mm_load_ss(input);
+		_mm_store_ss(output, relu(data, vnegative_slope, data));
+		input += 1;
+		output += 1;
+	}
+}
+
+void nnp_grad_relu__sse2(const float* output_gradient, const float* input, float* input_gradient, size_t length, float negative_slope) {
+	const __m128 vnegative_slope = _mm_set1_ps(negative_slope);
+	/* Each vector is loaded before it is stored, so input gradient may alias output gradient or input */
+	for (; length >= 4; length -= 4) {
+		_mm_storeu_ps(input_gradient, relu(_mm_loadu_ps(output_gradient), vnegative_slope, _mm_loadu_ps(input)));
+		output_gradient += 4;
+		input += 4;
+		input_gradient += 4;
+	}
+	for (; length != 0; length -= 1) {
+		_mm_store_ss(input_gradient, relu(_mm_load_ss(output_gradient), vnegative_slope, _mm_load_ss(input)));
+		output_gradient += 1;
+		input += 1;
+		input_gradient += 1;
+	}
+}
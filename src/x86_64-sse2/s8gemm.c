@@ -0,0 +1,77 @@
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/blas.h>
+#include <nnpack/transform.h>
+
+#define MR_MAX 3
+#define NR_MAX 4
+
+/*
+ * Every 8-element tuple takes two XMM registers.
+ * Always inlined, so that loops over mr and nr are fully unrolled.
+ */
+static inline __attribute__((__always_inline__)) void s8gemm(size_t mr, size_t nr, size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride_c, size_t column_stride_c) {
+	__m128 vc[MR_MAX][NR_MAX][2];
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nr; n++) {
+			vc[m][n][0] = vc[m][n][1] = _mm_setzero_ps();
+		}
+	}
+
+	for (; k != 0; k--) {
+		__m128 va[MR_MAX][2];
+		for (size_t m = 0; m < mr; m++) {
+			va[m][0] = _mm_load_ps(a + m * 8);
+			va[m][1] = _mm_load_ps(a + m * 8 + 4);
+		}
+		for (size_t n = 0; n < nr; n++) {
+			const __m128 vb0 = _mm_load_ps(b + n * 8);
+			const __m128 vb1 = _mm_load_ps(b + n * 8 + 4);
+			for (size_t m = 0; m < mr; m++) {
+				vc[m][n][0] = _mm_add_ps(vc[m][n][0], _mm_mul_ps(va[m][0], vb0));
+				vc[m][n][1] = _mm_add_ps(vc[m][n][1], _mm_mul_ps(va[m][1], vb1));
+			}
+		}
+
+		a += mr * 8;
+		b += nr * 8;
+	}
+
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nr; n++) {
+			float* c_mn = c + m * row_stride_c + n * column_stride_c;
+			if (k_tile != 0) {
+				vc[m][n][0] = _mm_add_ps(vc[m][n][0], _mm_load_ps(c_mn));
+				vc[m][n][1] = _mm_add_ps(vc[m][n][1], _mm_load_ps(c_mn + 4));
+			}
+			_mm_store_ps(c_mn, vc[m][n][0]);
+			_mm_store_ps(c_mn + 4, vc[m][n][1]);
+		}
+	}
+}
+
+#define NNP_S8GEMM_SSE2(MR, NR) \
+	void nnp_s8gemm##MR##x##NR##__sse2(size_t k, size_t k_tile, const float* a, const float* b, float* c, size_t row_stride_c, size_t column_stride_c) { \
+		s8gemm(MR, NR, k, k_tile, a, b, c, row_stride_c, column_stride_c); \
+	}
+
+NNP_S8GEMM_SSE2(1, 1)
+NNP_S8GEMM_SSE2(1, 2)
+NNP_S8GEMM_SSE2(1, 3)
+NNP_S8GEMM_SSE2(1, 4)
+NNP_S8GEMM_SSE2(2, 1)
+NNP_S8GEMM_SSE2(2, 2)
+NNP_S8GEMM_SSE2(2, 3)
+NNP_S8GEMM_SSE2(2, 4)
+NNP_S8GEMM_SSE2(3, 1)
+NNP_S8GEMM_SSE2(3, 2)
+NNP_S8GEMM_SSE2(3, 3)
+NNP_S8GEMM_SSE2(3, 4)
+
+void nnp_s8x8gemm__sse2(float acc[], const float x[], const float y[]) {
+	for (size_t i = 0; i < 64; i += 4) {
+		_mm_store_ps(acc + i, _mm_add_ps(_mm_load_ps(acc + i), _mm_mul_ps(_mm_load_ps(x + i), _mm_load_ps(y + i))));
+	}
+}
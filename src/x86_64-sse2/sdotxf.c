@@ -0,0 +1,58 @@
+#include <stddef.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/blas.h>
+
+static inline float reduce_add(__m128 x) {
+	x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+	x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(x);
+}
+
+/* Always inlined, so that the loop over fused vectors is fully unrolled and accumulators stay in registers */
+static inline __attribute__((__always_inline__)) void sdotxf(size_t fusion_factor, const float* x, const float* y, size_t stride_y, float* sum, size_t n) {
+	__m128 vacc[8];
+	for (size_t f = 0; f < fusion_factor; f++) {
+		vacc[f] = _mm_setzero_ps();
+	}
+
+	for (; n >= 4; n -= 4) {
+		const __m128 vx = _mm_loadu_ps(x);
+		for (size_t f = 0; f < fusion_factor; f++) {
+			vacc[f] = _mm_add_ps(vacc[f], _mm_mul_ps(vx, _mm_loadu_ps(y + f * stride_y)));
+		}
+		x += 4;
+		y += 4;
+	}
+
+	float acc[8];
+	for (size_t f = 0; f < fusion_factor; f++) {
+		acc[f] = reduce_add(vacc[f]);
+	}
+	for (; n != 0; n--) {
+		for (size_t f = 0; f < fusion_factor; f++) {
+			acc[f] += (*x) * y[f * stride_y];
+		}
+		x += 1;
+		y += 1;
+	}
+
+	for (size_t f = 0; f < fusion_factor; f++) {
+		sum[f] = acc[f];
+	}
+}
+
+#define NNP_SDOTXF_SSE2(FUSION_FACTOR) \
+	void nnp_sdotxf##FUSION_FACTOR##__sse2(const float* x, const float* y, size_t stride_y, float* sum, size_t n) { \
+		sdotxf(FUSION_FACTOR, x, y, stride_y, sum, n); \
+	}
+
+NNP_SDOTXF_SSE2(1)
+NNP_SDOTXF_SSE2(2)
+NNP_SDOTXF_SSE2(3)
+NNP_SDOTXF_SSE2(4)
+NNP_SDOTXF_SSE2(5)
+NNP_SDOTXF_SSE2(6)
+NNP_SDOTXF_SSE2(7)
+NNP_SDOTXF_SSE2(8)
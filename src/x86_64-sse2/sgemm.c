@@ -0,0 +1,82 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/macros.h>
+#include <nnpack/blas.h>
+
+/*
+ * The packed panels have the same layout as for the FMA3 kernels: mr_max elements of A and nr_max elements of B per k.
+ * Every 8 columns of C take two XMM registers. The last 8 columns of C are updated only where col_mask is non-zero.
+ */
+#define MR_MAX 4
+#define NR_MAX 24
+
+/* Always inlined, so that loops over mr and nr are fully unrolled and accumulators stay in registers */
+static inline __attribute__((__always_inline__)) void sgemm(size_t mr, size_t nr, size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask) {
+	const size_t nv = nr / 4;
+
+	__m128 vc[MR_MAX][NR_MAX / 4];
+	for (size_t m = 0; m < mr; m++) {
+		for (size_t n = 0; n < nv; n++) {
+			vc[m][n] = _mm_setzero_ps();
+		}
+	}
+
+	do {
+		__m128 vb[NR_MAX / 4];
+		for (size_t n = 0; n < nv; n++) {
+			vb[n] = _mm_load_ps(b + n * 4);
+		}
+		for (size_t m = 0; m < mr; m++) {
+			const __m128 va = _mm_load1_ps(a + m);
+			for (size_t n = 0; n < nv; n++) {
+				vc[m][n] = _mm_add_ps(vc[m][n], _mm_mul_ps(va, vb[n]));
+			}
+		}
+
+		a += MR_MAX;
+		b += NR_MAX;
+	} while (--k);
+
+	const uint32_t* mask = col_mask;
+	for (size_t m = 0; m < mr; m++) {
+		float* c_row = c + m * row_stride_c;
+		for (size_t n = 0; n + 2 < nv; n++) {
+			__m128 vc_mn = vc[m][n];
+			if (k_block_number != 0) {
+				vc_mn = _mm_add_ps(vc_mn, _mm_loadu_ps(c_row + n * 4));
+			}
+			_mm_storeu_ps(c_row + n * 4, vc_mn);
+		}
+
+		NNP_SIMD_ALIGN float vc_tail[8];
+		_mm_store_ps(vc_tail, vc[m][nv - 2]);
+		_mm_store_ps(vc_tail + 4, vc[m][nv - 1]);
+		float* c_tail = c_row + nr - 8;
+		for (size_t n = 0; n < 8; n++) {
+			if (mask[n] != 0) {
+				c_tail[n] = (k_block_number != 0) ? c_tail[n] + vc_tail[n] : vc_tail[n];
+			}
+		}
+	}
+}
+
+#define NNP_SGEMM_SSE2(MR, NR) \
+	void nnp_sgemm_##MR##x##NR##__sse2(size_t k, size_t k_block_number, const float* a, const float* b, float* c, size_t row_stride_c, const void* col_mask) { \
+		sgemm(MR, NR, k, k_block_number, a, b, c, row_stride_c, col_mask); \
+	}
+
+NNP_SGEMM_SSE2(1, 8)
+NNP_SGEMM_SSE2(2, 8)
+NNP_SGEMM_SSE2(3, 8)
+NNP_SGEMM_SSE2(4, 8)
+NNP_SGEMM_SSE2(1, 16)
+NNP_SGEMM_SSE2(2, 16)
+NNP_SGEMM_SSE2(3, 16)
+NNP_SGEMM_SSE2(4, 16)
+NNP_SGEMM_SSE2(1, 24)
+NNP_SGEMM_SSE2(2, 24)
+NNP_SGEMM_SSE2(3, 24)
+NNP_SGEMM_SSE2(4, 24)
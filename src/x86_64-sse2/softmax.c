@@ -0,0 +1,88 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include <x86intrin.h>
+
+#include <nnpack/softmax.h>
+
+#include "exp.h"
+
+static inline float _mm_reduce_max_ps(__m128 x) {
+	x = _mm_max_ps(x, _mm_movehl_ps(x, x));
+	x = _mm_max_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(x);
+}
+
+static inline float _mm_reduce_add_ps(__m128 x) {
+	x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+	x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+	return _mm_cvtss_f32(x);
+}
+
+float nnp_vector_max__sse2(size_t length, const float* input) {
+	const __m128 minus_inf = _mm_set1_ps(-__builtin_inff());
+	__m128 max0 = minus_inf, max1 = minus_inf, max2 = minus_inf, max3 = minus_inf;
+	for (; length >= 16; length -= 16) {
+		max0 = _mm_max_ps(max0, _mm_loadu_ps(input));
+		max1 = _mm_max_ps(max1, _mm_loadu_ps(input + 4));
+		max2 = _mm_max_ps(max2, _mm_loadu_ps(input + 8));
+		max3 = _mm_max_ps(max3, _mm_loadu_ps(input + 12));
+		input += 16;
+	}
+	for (; length >= 4; length -= 4) {
+		max0 = _mm_max_ps(max0, _mm_loadu_ps(input));
+		input += 4;
+	}
+	for (; length != 0; length -= 1) {
+		max1 = _mm_max_ss(max1, _mm_load_ss(input));
+		input += 1;
+	}
+	return _mm_reduce_max_ps(_mm_max_ps(_mm_max_ps(max0, max1), _mm_max_ps(max2, max3)));
+}
+
+float nnp_vector_exp_minus_c_and_sum__sse2(size_t length, const float* input, float* output, float c) {
+	const __m128 vc = _mm_set1_ps(c);
+	__m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+	for (; length >= 8; length -= 8) {
+		const __m128 y0 = _mm_exp_ps(_mm_sub_ps(_mm_loadu_ps(input), vc));
+		const __m128 y1 = _mm_exp_ps(_mm_sub_ps(_mm_loadu_ps(input + 4), vc));
+		_mm_storeu_ps(output, y0);
+		_mm_storeu_ps(output + 4, y1);
+		sum0 = _mm_add_ps(sum0, y0);
+		sum1 = _mm_add_ps(sum1, y1);
+		input += 8;
+		output += 8;
+	}
+	for (; length >= 4; length -= 4) {
+		const __m128 y = _mm_exp_ps(_mm_sub_ps(_mm_loadu_ps(input), vc));
+		_mm_storeu_ps(output, y);
+		sum0 = _mm_add_ps(sum0, y);
+		input += 4;
+		output += 4;
+	}
+	for (; length != 0; length -= 1) {
+		/* Only the lowest element of the vector is stored and accumulated */
+		const __m128 y = _mm_exp_ps(_mm_sub_ss(_mm_load_ss(input), vc));
+		_mm_store_ss(output, y);
+		sum1 = _mm_add_ss(sum1, y);
+		input += 1;
+		output += 1;
+	}
+	return _mm_reduce_add_ps(_mm_add_ps(sum0, sum1));
+}
+
+void nnp_vector_scale__sse2(size_t length, float* data, float scale) {
+	const __m128 vscale = _mm_set1_ps(scale);
+	for (; length >= 8; length -= 8) {
+		_mm_storeu_ps(data, _mm_mul_ps(_mm_loadu_ps(data), vscale));
+		_mm_storeu_ps(data + 4, _mm_mul_ps(_mm_loadu_ps(data + 4), vscale));
+		data += 8;
+	}
+	for (; length >= 4; length -= 4) {
+		_mm_storeu_ps(data, _mm_mul_ps(_mm_loadu_ps(data), vscale));
+		data += 4;
+	}
+	for (; length != 0; length -= 1) {
+		*data++ *= scale;
+	}
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <unistd.h>
+
+#include <fstream>
+#include <iterator>
+
 #include <nnpack.h>
 
 #include <testers/convolution.h>
@@ -148,6 +153,369 @@ TEST(WT8x8_REUSE, multi_tile) {
 		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_reuse);
 }
 
+/*
+ * Test that the implementation handles multi-tile inputs when tiles are distributed over multiple threads
+ */
+
+TEST(FT8x8_RECOMPUTE, multi_tile_multithreaded) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.inputChannels(5)
+		.outputChannels(21)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT8x8_REUSE, multi_tile_multithreaded) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.inputChannels(5)
+		.outputChannels(21)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(FT16x16_RECOMPUTE, multi_tile_multithreaded) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(29, 29)
+		.inputChannels(5)
+		.outputChannels(21)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT16x16_REUSE, multi_tile_multithreaded) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(29, 29)
+		.inputChannels(5)
+		.outputChannels(21)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(WT8x8_RECOMPUTE, multi_tile_multithreaded) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.inputChannels(5)
+		.outputChannels(21)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(WT8x8_REUSE, multi_tile_multithreaded) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.inputChannels(5)
+		.outputChannels(21)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+/*
+ * Test that the implementation consumes precomputed kernel transform
+ */
+
+TEST(FT8x8_PRECOMPUTED, single_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(8, 8)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT8x8_PRECOMPUTED, multi_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT8x8_PRECOMPUTED, many_input_channels) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.inputChannels(37)
+		.outputChannels(11)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT16x16_PRECOMPUTED, single_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(16, 16)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT16x16_PRECOMPUTED, multi_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT16x16_PRECOMPUTED, many_input_channels) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(29, 29)
+		.inputChannels(37)
+		.outputChannels(11)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(WT8x8_PRECOMPUTED, single_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(8, 8)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(WT8x8_PRECOMPUTED, multi_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(WT8x8_PRECOMPUTED, many_input_channels) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.inputChannels(37)
+		.outputChannels(11)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+/*
+ * Test that the implementation works with a caller-provided workspace
+ */
+
+TEST(FT8x8_RECOMPUTE, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT8x8_REUSE, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(FT8x8_PRECOMPUTED, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT16x16_RECOMPUTE, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT16x16_REUSE, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(FT16x16_PRECOMPUTED, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(WT8x8_RECOMPUTE, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(WT8x8_REUSE, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(WT8x8_PRECOMPUTED, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+/*
+ * Test that the implementation handles subsampling of output (strided convolution)
+ */
+
+TEST(FT8x8_RECOMPUTE, output_subsampling) {
+	ConvolutionTester()
+		.inputSize(19, 17)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT8x8_REUSE, output_subsampling) {
+	ConvolutionTester()
+		.inputSize(19, 17)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(FT16x16_RECOMPUTE, output_subsampling) {
+	ConvolutionTester()
+		.inputSize(37, 35)
+		.outputSubsampling(3, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT16x16_REUSE, output_subsampling) {
+	ConvolutionTester()
+		.inputSize(37, 35)
+		.outputSubsampling(3, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(WT8x8_RECOMPUTE, output_subsampling) {
+	ConvolutionTester()
+		.inputSize(19, 17)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(WT8x8_REUSE, output_subsampling) {
+	ConvolutionTester()
+		.inputSize(19, 17)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(WT8x8_PRECOMPUTED, output_subsampling) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(19, 17)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(IMPLICIT_GEMM, multi_tile) {
+	ConvolutionTester()
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_implicit_gemm, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(IMPLICIT_GEMM, output_subsampling) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputChannels(3)
+		.outputChannels(9)
+		.inputSize(23, 21)
+		.kernelSize(7, 7)
+		.inputPadding(3, 3, 3, 3)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_implicit_gemm, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(IMPLICIT_GEMM, pointwise) {
+	ConvolutionTester()
+		.inputChannels(67)
+		.outputChannels(13)
+		.inputSize(13, 11)
+		.kernelSize(1, 1)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_implicit_gemm, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, pointwise) {
+	ConvolutionTester()
+		.inputChannels(32)
+		.outputChannels(16)
+		.inputSize(7, 7)
+		.kernelSize(1, 1)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, few_input_channels) {
+	ConvolutionTester()
+		.inputChannels(3)
+		.outputChannels(16)
+		.inputSize(29, 29)
+		.kernelSize(3, 3)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(FT16x16_REUSE, workspace_bounded) {
+	/* Input transforms are computed for a block of tiles, so the workspace does not grow with large images */
+	size_t workspace_sizes[2] = { 0, 0 };
+	const size_t image_sizes[2] = { 512, 1024 };
+	for (size_t i = 0; i < 2; i++) {
+		ASSERT_EQ(nnp_status_success, nnp_convolution_inference_with_workspace(
+			nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_reuse,
+			256, 16, nnp_size{ image_sizes[i], image_sizes[i] }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 },
+			nullptr, nullptr, nullptr, nullptr, nullptr, &workspace_sizes[i],
+			nnp_activation_identity, nullptr, nullptr, nullptr));
+	}
+	ASSERT_EQ(workspace_sizes[0], workspace_sizes[1]);
+}
+
+TEST(IMPLICIT_GEMM, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_implicit_gemm, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
 /*
  * Test that the implementation handles implicit padding of input
  */
@@ -382,6 +750,337 @@ TEST(WT8x8_REUSE, few_output_channels) {
 	}
 }
 
+/*
+ * Test that the implementation fuses ReLU activation into the output transform
+ */
+
+TEST(FT8x8_RECOMPUTE, relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT16x16_RECOMPUTE, relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(WT8x8_RECOMPUTE, relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(IMPLICIT_GEMM, relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_implicit_gemm, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+/*
+ * Test that the implementation fuses parametrized activations into the output transform
+ */
+
+TEST(FT8x8_RECOMPUTE, leaky_relu) {
+	ConvolutionTester()
+		.leakyRelu(0.1f)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT16x16_RECOMPUTE, clamp) {
+	ConvolutionTester()
+		.clamp(-1.0f, 2.0f)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(WT8x8_RECOMPUTE, clamp) {
+	ConvolutionTester()
+		.clamp(-1.0f, 2.0f)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(IMPLICIT_GEMM, leaky_relu) {
+	ConvolutionTester()
+		.leakyRelu(0.1f)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_implicit_gemm, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+/*
+ * Test that the implementation computes grouped and depthwise convolutions
+ */
+
+TEST(FT8x8_RECOMPUTE, grouped) {
+	ConvolutionTester()
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT8x8_REUSE, grouped) {
+	ConvolutionTester()
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(FT16x16_REUSE, grouped) {
+	ConvolutionTester()
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(WT8x8_RECOMPUTE, grouped) {
+	ConvolutionTester()
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(IMPLICIT_GEMM, grouped) {
+	ConvolutionTester()
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(13, 11)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_implicit_gemm, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, depthwise) {
+	ConvolutionTester()
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, depthwise_output_subsampling) {
+	ConvolutionTester()
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(15, 21)
+		.inputPadding(1, 1, 1, 1)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, depthwise_relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, depthwise_clamp) {
+	ConvolutionTester()
+		.clamp(-1.0f, 1.0f)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, depthwise_workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.multithreading(true)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+/*
+ * Test that the implementation computes dilated convolutions
+ */
+
+TEST(FT8x8_RECOMPUTE, dilation_2) {
+	ConvolutionTester()
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(13, 13)
+		.kernelDilation(2, 2)
+		.inputPadding(2, 2, 2, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT16x16_RECOMPUTE, dilation_4) {
+	ConvolutionTester()
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 31)
+		.kernelDilation(4, 4)
+		.inputPadding(4, 4, 4, 4)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_recompute);
+}
+
+TEST(FT16x16_REUSE, dilation_4) {
+	ConvolutionTester()
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 31)
+		.kernelDilation(4, 4)
+		.inputPadding(4, 4, 4, 4)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(FT16x16_REUSE, dilation_output_subsampling) {
+	ConvolutionTester()
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 29)
+		.kernelDilation(2, 2)
+		.inputPadding(2, 2, 2, 2)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(IMPLICIT_GEMM, dilation_8) {
+	ConvolutionTester()
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 31)
+		.kernelDilation(8, 8)
+		.inputPadding(8, 8, 8, 8)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_implicit_gemm, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, dilation_4) {
+	ConvolutionTester()
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(32, 32)
+		.kernelDilation(4, 4)
+		.inputPadding(4, 4, 4, 4)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+TEST(AUTO, dilation_8_workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.multithreading(true)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(32, 32)
+		.kernelDilation(8, 8)
+		.inputPadding(8, 8, 8, 8)
+		.errorLimit(1.0e-5)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+}
+
+/*
+ * Test that auto-tuning produces correct outputs, and that measurements persisted to a cache file are usable
+ */
+
+TEST(AUTOTUNE, inference) {
+	ASSERT_EQ(nnp_status_success, nnp_autotune_enable(nullptr));
+	ConvolutionTester()
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.iterations(2)
+		.errorLimit(1.0e-3)
+		.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_reuse);
+	ASSERT_EQ(nnp_status_success, nnp_autotune_disable());
+}
+
+TEST(AUTOTUNE, cache_file) {
+	char path[] = "/tmp/nnpack-autotune-XXXXXX";
+	const int fd = mkstemp(path);
+	ASSERT_NE(-1, fd);
+	close(fd);
+
+	ConvolutionTester tester;
+	tester.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-3);
+
+	ASSERT_EQ(nnp_status_success, nnp_autotune_enable(path));
+	tester.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_recompute);
+	ASSERT_EQ(nnp_status_success, nnp_autotune_disable());
+
+	std::ifstream cache(path);
+	const size_t lines = std::count(std::istreambuf_iterator<char>(cache), std::istreambuf_iterator<char>(), '\n');
+	EXPECT_EQ(1, lines);
+
+	ASSERT_EQ(nnp_status_success, nnp_autotune_enable(path));
+	tester.testInference(nnp_convolution_algorithm_auto, nnp_convolution_kernel_transform_strategy_recompute);
+	ASSERT_EQ(nnp_status_success, nnp_autotune_disable());
+
+	unlink(path);
+}
+
 int main(int argc, char* argv[]) {
 	const enum nnp_status init_status = nnp_initialize();
 	assert(init_status == nnp_status_success);
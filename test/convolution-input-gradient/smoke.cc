@@ -82,6 +82,37 @@ TEST(WT8x8, multi_tile) {
 		.testInputGradient(nnp_convolution_algorithm_wt8x8);
 }
 
+/*
+ * Test that the implementation works with a caller-provided workspace
+ */
+
+TEST(FT8x8, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputSize(11, 11)
+		.errorLimit(1.0e-2)
+		.testInputGradient(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputSize(27, 27)
+		.errorLimit(1.0e-2)
+		.testInputGradient(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(WT8x8, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-2)
+		.testInputGradient(nnp_convolution_algorithm_wt8x8);
+}
+
 /*
  * Test that the implementation handles implicit padding of input
  */
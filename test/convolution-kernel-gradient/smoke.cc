@@ -68,6 +68,13 @@ TEST(FT8x8, multi_tile) {
 		.testKernelGradient(nnp_convolution_algorithm_ft8x8);
 }
 
+TEST(FT8x8, multi_tile_non_square) {
+	ConvolutionTester()
+		.inputSize(11, 19)
+		.errorLimit(1.0e-5)
+		.testKernelGradient(nnp_convolution_algorithm_ft8x8);
+}
+
 TEST(FT16x16, multi_tile) {
 	ConvolutionTester()
 		.inputSize(29, 29)
@@ -82,6 +89,28 @@ TEST(WT8x8, DISABLED_multi_tile) {
 		.testKernelGradient(nnp_convolution_algorithm_wt8x8);
 }
 
+/*
+ * Test that the implementation works with a caller-provided workspace
+ */
+
+TEST(FT8x8, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testKernelGradient(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testKernelGradient(nnp_convolution_algorithm_ft16x16);
+}
+
 /*
  * Test that the implementation handles implicit padding of input
  */
@@ -230,6 +259,34 @@ TEST(WT8x8, DISABLED_few_output_channels) {
 	}
 }
 
+/*
+ * Test that the implementation of fused kernel update matches kernel += scale * grad_kernel
+ */
+
+TEST(FT8x8, kernel_update) {
+	ConvolutionTester tester;
+	tester.batchSize(3)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5);
+	tester.testKernelUpdate(nnp_convolution_algorithm_ft8x8);
+	tester.inputPadding(1, 1, 1, 1)
+		.testKernelUpdate(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, kernel_update) {
+	ConvolutionTester tester;
+	tester.batchSize(3)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5);
+	tester.testKernelUpdate(nnp_convolution_algorithm_ft16x16);
+	tester.inputPadding(1, 1, 1, 1)
+		.testKernelUpdate(nnp_convolution_algorithm_ft16x16);
+}
+
 int main(int argc, char* argv[]) {
 	const enum nnp_status init_status = nnp_initialize();
 	assert(init_status == nnp_status_success);
@@ -82,6 +82,275 @@ TEST(WT8x8, multi_tile) {
 		.testOutput(nnp_convolution_algorithm_wt8x8);
 }
 
+/*
+ * Test that the implementation consumes precomputed kernel transform
+ */
+
+TEST(FT8x8_PRECOMPUTED, single_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(8, 8)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT8x8_PRECOMPUTED, multi_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT8x8_PRECOMPUTED, many_input_channels) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.inputChannels(37)
+		.outputChannels(11)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT16x16_PRECOMPUTED, single_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(16, 16)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT16x16_PRECOMPUTED, multi_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(FT16x16_PRECOMPUTED, many_input_channels) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(29, 29)
+		.inputChannels(37)
+		.outputChannels(11)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(WT8x8_PRECOMPUTED, single_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(8, 8)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(WT8x8_PRECOMPUTED, multi_tile) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+TEST(WT8x8_PRECOMPUTED, many_input_channels) {
+	ConvolutionTester()
+		.multithreading(true)
+		.inputSize(13, 13)
+		.inputChannels(37)
+		.outputChannels(11)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8, nnp_convolution_kernel_transform_strategy_precomputed);
+}
+
+/*
+ * Test that the implementation works with a caller-provided workspace
+ */
+
+TEST(FT8x8, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(WT8x8, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8);
+}
+
+/*
+ * Test that the implementation handles subsampling of output (strided convolution)
+ */
+
+TEST(FT8x8, output_subsampling) {
+	ConvolutionTester()
+		.batchSize(3)
+		.inputSize(19, 17)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, output_subsampling) {
+	ConvolutionTester()
+		.batchSize(3)
+		.inputSize(37, 35)
+		.outputSubsampling(2, 3)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(WT8x8, output_subsampling) {
+	ConvolutionTester()
+		.batchSize(3)
+		.inputSize(19, 17)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8);
+}
+
+TEST(IMPLICIT_GEMM, single_pixel) {
+	ConvolutionTester()
+		.batchSize(3)
+		.inputSize(3, 3)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, multi_tile) {
+	ConvolutionTester()
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, many_input_channels) {
+	ConvolutionTester()
+		.multithreading(true)
+		.batchSize(2)
+		.inputChannels(67)
+		.outputChannels(11)
+		.inputSize(9, 9)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, output_subsampling) {
+	ConvolutionTester()
+		.batchSize(3)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(17, 19)
+		.kernelSize(7, 7)
+		.inputPadding(3, 3, 3, 3)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, pointwise) {
+	ConvolutionTester()
+		.batchSize(3)
+		.inputChannels(67)
+		.outputChannels(13)
+		.inputSize(13, 11)
+		.kernelSize(1, 1)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, pointwise_small_images) {
+	ConvolutionTester()
+		.multithreading(true)
+		.batchSize(5)
+		.inputChannels(19)
+		.outputChannels(9)
+		.inputSize(7, 7)
+		.kernelSize(1, 1)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, pointwise_subsampling) {
+	ConvolutionTester()
+		.batchSize(3)
+		.inputChannels(11)
+		.outputChannels(13)
+		.inputSize(14, 14)
+		.kernelSize(1, 1)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(AUTO, pointwise) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(32)
+		.outputChannels(16)
+		.inputSize(7, 7)
+		.kernelSize(1, 1)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, few_input_channels) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(16)
+		.inputSize(29, 29)
+		.kernelSize(3, 3)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, output_subsampling) {
+	ConvolutionTester()
+		.multithreading(true)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(15, 15)
+		.inputPadding(1, 1, 1, 1)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
 /*
  * Test that the implementation handles implicit padding of input
  */
@@ -230,6 +499,655 @@ TEST(WT8x8, few_output_channels) {
 	}
 }
 
+/*
+ * Test that the implementation fuses ReLU activation into the output transform
+ */
+
+TEST(FT8x8, relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(WT8x8, relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8);
+}
+
+TEST(FT8x8, relu_output_subsampling) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.batchSize(3)
+		.inputSize(19, 17)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(IMPLICIT_GEMM, relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+/*
+ * Test that the implementation fuses parametrized activations into the output transform
+ */
+
+TEST(FT8x8, leaky_relu) {
+	ConvolutionTester()
+		.leakyRelu(0.1f)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT8x8, clamp) {
+	ConvolutionTester()
+		.clamp(-1.0f, 2.0f)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, leaky_relu) {
+	ConvolutionTester()
+		.leakyRelu(-0.5f)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(FT16x16, clamp) {
+	ConvolutionTester()
+		.clamp(-1.0f, 2.0f)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(WT8x8, leaky_relu) {
+	ConvolutionTester()
+		.leakyRelu(0.1f)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8);
+}
+
+TEST(WT8x8, clamp) {
+	ConvolutionTester()
+		.clamp(-1.0f, 2.0f)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8);
+}
+
+TEST(IMPLICIT_GEMM, leaky_relu) {
+	ConvolutionTester()
+		.leakyRelu(0.1f)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, clamp) {
+	ConvolutionTester()
+		.clamp(-1.0f, 2.0f)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(ACTIVATION, invalid_parameters) {
+	const nnp_leaky_relu_parameters infinite_slope = { INFINITY };
+	const nnp_clamp_parameters inverted_bounds = { 1.0f, -1.0f };
+	/* Parameters are validated before the input, kernel, and output pointers are used */
+	ASSERT_EQ(nnp_status_invalid_activation_parameters, nnp_convolution_output_with_activation(
+		nnp_convolution_algorithm_auto,
+		1, 1, 1, nnp_size{ 16, 16 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 },
+		nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_leaky_relu, nullptr, nullptr, nullptr));
+	ASSERT_EQ(nnp_status_invalid_activation_parameters, nnp_convolution_output_with_activation(
+		nnp_convolution_algorithm_auto,
+		1, 1, 1, nnp_size{ 16, 16 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 },
+		nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_leaky_relu, &infinite_slope, nullptr, nullptr));
+	ASSERT_EQ(nnp_status_invalid_activation_parameters, nnp_convolution_output_with_activation(
+		nnp_convolution_algorithm_auto,
+		1, 1, 1, nnp_size{ 16, 16 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 },
+		nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_clamp, &inverted_bounds, nullptr, nullptr));
+	ASSERT_EQ(nnp_status_invalid_activation_parameters, nnp_convolution_output_with_activation(
+		nnp_convolution_algorithm_auto,
+		1, 1, 1, nnp_size{ 16, 16 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 },
+		nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_relu, &inverted_bounds, nullptr, nullptr));
+}
+
+/*
+ * Test that auto-tuning produces correct outputs both on the call which measures the algorithms and on later calls
+ */
+
+TEST(AUTOTUNE, output) {
+	ASSERT_EQ(nnp_status_success, nnp_autotune_enable(nullptr));
+	ConvolutionTester()
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 13)
+		.iterations(2)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_auto);
+	ASSERT_EQ(nnp_status_success, nnp_autotune_disable());
+}
+
+TEST(AUTOTUNE, output_with_workspace) {
+	ASSERT_EQ(nnp_status_success, nnp_autotune_enable(nullptr));
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.inputChannels(5)
+		.outputChannels(7)
+		.inputSize(13, 11)
+		.inputPadding(1, 1, 1, 1)
+		.iterations(2)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_auto);
+	ASSERT_EQ(nnp_status_success, nnp_autotune_disable());
+}
+
+/*
+ * Test that overridden cache blocking is reported and produces the same results as the default blocking
+ */
+
+TEST(BLOCKING, default_blocking) {
+	struct nnp_convolution_blocking blocking = { 0 };
+	ASSERT_EQ(nnp_status_success, nnp_convolution_output_blocking(nnp_convolution_algorithm_ft8x8,
+		64, 64, 64, nnp_size{ 32, 32 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr, &blocking));
+	ASSERT_NE(0, blocking.input_channels_block);
+	ASSERT_EQ(0, blocking.input_channels_block % 2);
+	ASSERT_NE(0, blocking.batch_block);
+	ASSERT_NE(0, blocking.output_channels_block);
+	ASSERT_EQ(nnp_status_unsupported_algorithm, nnp_convolution_output_blocking(nnp_convolution_algorithm_implicit_gemm,
+		64, 64, 64, nnp_size{ 32, 32 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr, &blocking));
+}
+
+TEST(BLOCKING, override) {
+	/* Block sizes are multiples of the register blocking of all micro-kernels, and are not rounded */
+	struct nnp_convolution_blocking override_blocking;
+	override_blocking.input_channels_block = 2;
+	override_blocking.batch_block = 12;
+	override_blocking.output_channels_block = 12;
+	ASSERT_EQ(nnp_status_success, nnp_convolution_output_set_blocking(
+		5, 7, 9, nnp_size{ 13, 13 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		&override_blocking));
+
+	struct nnp_convolution_blocking blocking = { 0 };
+	ASSERT_EQ(nnp_status_success, nnp_convolution_output_blocking(nnp_convolution_algorithm_wt8x8,
+		5, 7, 9, nnp_size{ 13, 13 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr, &blocking));
+	ASSERT_EQ(2, blocking.input_channels_block);
+	ASSERT_EQ(12, blocking.batch_block);
+	ASSERT_EQ(12, blocking.output_channels_block);
+
+	ASSERT_EQ(nnp_status_success, nnp_convolution_output_blocking(nnp_convolution_algorithm_ft8x8,
+		5, 7, 9, nnp_size{ 13, 13 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr, &blocking));
+	ASSERT_EQ(2, blocking.input_channels_block);
+	ASSERT_EQ(12, blocking.batch_block);
+	ASSERT_EQ(12, blocking.output_channels_block);
+
+	ConvolutionTester tester;
+	tester.batchSize(5)
+		.inputChannels(7)
+		.outputChannels(9)
+		.inputSize(13, 13)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-3);
+	tester.testOutput(nnp_convolution_algorithm_ft8x8);
+	tester.testOutput(nnp_convolution_algorithm_ft16x16);
+	tester.testOutput(nnp_convolution_algorithm_wt8x8);
+
+	ASSERT_EQ(nnp_status_success, nnp_convolution_output_set_blocking(
+		5, 7, 9, nnp_size{ 13, 13 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr));
+	ASSERT_EQ(nnp_status_success, nnp_convolution_output_blocking(nnp_convolution_algorithm_wt8x8,
+		5, 7, 9, nnp_size{ 13, 13 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr, &blocking));
+	ASSERT_NE(2, blocking.input_channels_block);
+}
+
+/*
+ * Test that the implementation computes grouped and depthwise convolutions
+ */
+
+TEST(FT8x8, grouped) {
+	ConvolutionTester()
+		.batchSize(3)
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, grouped) {
+	ConvolutionTester()
+		.batchSize(3)
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(29, 29)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(WT8x8, grouped) {
+	ConvolutionTester()
+		.batchSize(3)
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_wt8x8);
+}
+
+TEST(IMPLICIT_GEMM, grouped) {
+	ConvolutionTester()
+		.batchSize(3)
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(13, 11)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(FT8x8, grouped_workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(3)
+		.groups(2)
+		.inputChannels(6)
+		.outputChannels(10)
+		.inputSize(13, 13)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(AUTO, grouped) {
+	ConvolutionTester()
+		.batchSize(2)
+		.groups(4)
+		.inputChannels(16)
+		.outputChannels(8)
+		.inputSize(14, 14)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-3)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, depthwise) {
+	ConvolutionTester()
+		.batchSize(2)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, depthwise_output_subsampling) {
+	ConvolutionTester()
+		.batchSize(2)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(15, 21)
+		.inputPadding(1, 1, 1, 1)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, depthwise_relu) {
+	ConvolutionTester()
+		.activation(nnp_activation_relu)
+		.batchSize(2)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, depthwise_leaky_relu) {
+	ConvolutionTester()
+		.leakyRelu(0.1f)
+		.batchSize(2)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, depthwise_clamp_5x5) {
+	ConvolutionTester()
+		.clamp(-1.0f, 1.0f)
+		.batchSize(2)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.kernelSize(5, 5)
+		.inputPadding(2, 2, 2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, depthwise_channel_multiplier) {
+	ConvolutionTester()
+		.batchSize(2)
+		.groups(8)
+		.inputChannels(8)
+		.outputChannels(16)
+		.inputSize(9, 9)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, depthwise_5x5) {
+	ConvolutionTester()
+		.batchSize(2)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 11)
+		.kernelSize(5, 5)
+		.inputPadding(2, 2, 2, 2)
+		.outputSubsampling(2, 1)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, depthwise_workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(2)
+		.groups(16)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(13, 19)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+/*
+ * Test that the implementation computes dilated convolutions
+ */
+
+TEST(FT8x8, dilation_2) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(13, 13)
+		.kernelDilation(2, 2)
+		.inputPadding(2, 2, 2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft8x8);
+}
+
+TEST(FT16x16, dilation_2) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 29)
+		.kernelDilation(2, 2)
+		.inputPadding(2, 2, 2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(FT16x16, dilation_4) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 31)
+		.kernelDilation(4, 4)
+		.inputPadding(4, 4, 4, 4)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(FT16x16, dilation_asymmetric) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 29)
+		.kernelSize(3, 2)
+		.kernelDilation(3, 5)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(FT16x16, dilation_output_subsampling) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 29)
+		.kernelDilation(2, 2)
+		.inputPadding(2, 2, 2, 2)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(FT16x16, dilation_workspace) {
+	ConvolutionTester()
+		.workspace(true)
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 29)
+		.kernelDilation(4, 4)
+		.inputPadding(4, 4, 4, 4)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_ft16x16);
+}
+
+TEST(IMPLICIT_GEMM, dilation_8) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 31)
+		.kernelDilation(8, 8)
+		.inputPadding(8, 8, 8, 8)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(IMPLICIT_GEMM, dilation_output_subsampling) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 31)
+		.kernelDilation(4, 2)
+		.inputPadding(4, 2, 2, 4)
+		.outputSubsampling(2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_implicit_gemm);
+}
+
+TEST(AUTO, dilation_2) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(32, 32)
+		.kernelDilation(2, 2)
+		.inputPadding(2, 2, 2, 2)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, dilation_8) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(32, 32)
+		.kernelDilation(8, 8)
+		.inputPadding(8, 8, 8, 8)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(AUTO, dilation_relu) {
+	ConvolutionTester()
+		.batchSize(2)
+		.inputChannels(16)
+		.outputChannels(16)
+		.inputSize(32, 32)
+		.kernelDilation(4, 4)
+		.inputPadding(4, 4, 4, 4)
+		.activation(nnp_activation_relu)
+		.errorLimit(1.0e-5)
+		.testOutput(nnp_convolution_algorithm_auto);
+}
+
+TEST(DILATION, unsupported_and_invalid) {
+	/* Winograd transform does not support dilated kernels, and dilation must be non-zero */
+	ASSERT_EQ(nnp_status_unsupported_algorithm, nnp_convolution_output_dilated(
+		nnp_convolution_algorithm_wt8x8,
+		1, 1, 1, nnp_size{ 16, 16 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 }, nnp_size{ 2, 2 }, nnp_size{ 1, 1 },
+		nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_identity, nullptr, nullptr, nullptr));
+	ASSERT_EQ(nnp_status_invalid_kernel_dilation, nnp_convolution_output_dilated(
+		nnp_convolution_algorithm_auto,
+		1, 1, 1, nnp_size{ 16, 16 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 }, nnp_size{ 0, 1 }, nnp_size{ 1, 1 },
+		nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_identity, nullptr, nullptr, nullptr));
+	/* Padding is limited by the size of the dilated kernel rather than the kernel */
+	ASSERT_EQ(nnp_status_invalid_input_padding, nnp_convolution_output_dilated(
+		nnp_convolution_algorithm_auto,
+		1, 1, 1, nnp_size{ 16, 16 }, nnp_padding{ 5, 5, 5, 5 }, nnp_size{ 3, 3 }, nnp_size{ 2, 2 }, nnp_size{ 1, 1 },
+		nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_identity, nullptr, nullptr, nullptr));
+	/* Padded input must be at least as large as the dilated kernel */
+	ASSERT_EQ(nnp_status_invalid_input_size, nnp_convolution_output_dilated(
+		nnp_convolution_algorithm_auto,
+		1, 1, 1, nnp_size{ 4, 4 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 }, nnp_size{ 4, 4 }, nnp_size{ 1, 1 },
+		nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_identity, nullptr, nullptr, nullptr));
+	ASSERT_EQ(nnp_status_invalid_input_size, nnp_convolution_output_dilated(
+		nnp_convolution_algorithm_implicit_gemm,
+		1, 1, 1, nnp_size{ 16, 4 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 4 }, nnp_size{ 1, 1 },
+		nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+		nnp_activation_identity, nullptr, nullptr, nullptr));
+}
+
+/*
+ * Test that tiles are grouped correctly when the batch is smaller than the batch block
+ */
+
+TEST(BLOCKING, tile_blocks) {
+	/* Blocks of 4 images group 4 tiles of a single image, with a partial block at the end */
+	struct nnp_convolution_blocking override_blocking;
+	override_blocking.input_channels_block = 0;
+	override_blocking.batch_block = 4;
+	override_blocking.output_channels_block = 0;
+	ASSERT_EQ(nnp_status_success, nnp_convolution_output_set_blocking(
+		1, 3, 5, nnp_size{ 31, 29 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		&override_blocking));
+
+	ConvolutionTester tester;
+	tester.batchSize(1)
+		.inputChannels(3)
+		.outputChannels(5)
+		.inputSize(29, 31)
+		.inputPadding(1, 1, 1, 1)
+		.errorLimit(1.0e-3);
+	tester.testOutput(nnp_convolution_algorithm_ft8x8);
+	tester.testOutput(nnp_convolution_algorithm_ft16x16);
+	tester.testOutput(nnp_convolution_algorithm_wt8x8);
+
+	ASSERT_EQ(nnp_status_success, nnp_convolution_output_set_blocking(
+		1, 3, 5, nnp_size{ 31, 29 }, nnp_padding{ 1, 1, 1, 1 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr));
+
+	tester.testOutput(nnp_convolution_algorithm_ft8x8);
+	tester.testOutput(nnp_convolution_algorithm_wt8x8);
+}
+
 int main(int argc, char* argv[]) {
 	const enum nnp_status init_status = nnp_initialize();
 	assert(init_status == nnp_status_success);
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <nnpack.h>
+
+#include <testers/fully-connected.h>
+
+/*
+ * Test that implementation works for a single input vector
+ */
+
+TEST(FC_INFERENCE, single_vector) {
+	FullyConnectedTester()
+		.inputChannels(37)
+		.outputChannels(29)
+		.iterations(100)
+		.errorLimit(1.0e-5)
+		.testInference();
+}
+
+/*
+ * Test that batched implementation works for batch subblocks (less than a single register block of minibatch)
+ */
+
+TEST(FC_INFERENCE_BATCH, batch_subblock) {
+	FullyConnectedTester tester;
+	tester.inputChannels(37)
+		.outputChannels(24)
+		.iterations(100)
+		.errorLimit(1.0e-5);
+	for (size_t batchSize = 2; batchSize < 4; batchSize += 1) {
+		tester.batchSize(batchSize)
+			.testInference();
+	}
+}
+
+/*
+ * Test that batched implementation works for typical small minibatches (multiple register blocks of minibatch)
+ */
+
+TEST(FC_INFERENCE_BATCH, small_batch_size) {
+	FullyConnectedTester tester;
+	tester.inputChannels(64)
+		.outputChannels(72)
+		.iterations(10)
+		.errorLimit(1.0e-5);
+	for (size_t batchSize = 4; batchSize <= 16; batchSize += 1) {
+		tester.batchSize(batchSize)
+			.testInference();
+	}
+}
+
+/*
+ * Test that batched implementation works for many input channels (multiple blocks of L1 cache)
+ */
+
+TEST(FC_INFERENCE_BATCH, many_input_channels) {
+	FullyConnectedTester()
+		.batchSize(5)
+		.inputChannels(1024)
+		.outputChannels(48)
+		.iterations(100)
+		.errorLimit(1.0e-5)
+		.testInference();
+}
+
+/*
+ * Test that batched implementation works for a subblock of output channels (less than a single register block of output channels)
+ */
+
+TEST(FC_INFERENCE_BATCH, output_channels_subblock) {
+	FullyConnectedTester tester;
+	tester.batchSize(6)
+		.inputChannels(13)
+		.iterations(10)
+		.errorLimit(1.0e-5);
+	for (size_t outputChannels = 1; outputChannels < 24; outputChannels += 1) {
+		tester.outputChannels(outputChannels)
+			.testInference();
+	}
+}
+
+/*
+ * Test that batched implementation works for many output channels with a partial last register block
+ */
+
+TEST(FC_INFERENCE_BATCH, many_output_channels) {
+	FullyConnectedTester()
+		.batchSize(8)
+		.inputChannels(300)
+		.outputChannels(1001)
+		.iterations(10)
+		.errorLimit(1.0e-5)
+		.testInference();
+}
+
+/*
+ * Test that batched implementation works with multithreading
+ */
+
+TEST(FC_INFERENCE_BATCH, multithreading) {
+	FullyConnectedTester()
+		.multithreading(true)
+		.batchSize(16)
+		.inputChannels(1024)
+		.outputChannels(1000)
+		.iterations(10)
+		.errorLimit(1.0e-5)
+		.testInference();
+}
+
+int main(int argc, char* argv[]) {
+	const enum nnp_status init_status = nnp_initialize();
+	assert(init_status == nnp_status_success);
+	setenv("TERM", "xterm-256color", 0);
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <nnpack.h>
+
+#include <testers/fully-connected.h>
+
+/*
+ * Test that implementation works for a single channel
+ */
+
+TEST(MRxNR_4x24, single_channel) {
+	FullyConnectedTester()
+		.batchSize(4)
+		.outputChannels(24)
+		.iterations(100)
+		.errorLimit(1.0e-5)
+		.testKernelGradient();
+}
+
+/*
+ * Test that implementation works for many input and output channels (multiple cache blocks)
+ */
+
+TEST(MRxNR_4x24, many_channels) {
+	FullyConnectedTester()
+		.batchSize(4)
+		.inputChannels(1200)
+		.outputChannels(1024)
+		.iterations(10)
+		.errorLimit(1.0e-5)
+		.testKernelGradient();
+}
+
+/*
+ * Test that implementation works for batch sizes which are not a multiple of register block
+ */
+
+TEST(MRxNR_4x24, batch_sizes) {
+	FullyConnectedTester tester;
+	tester.inputChannels(37)
+		.outputChannels(24)
+		.iterations(10)
+		.errorLimit(1.0e-5);
+	for (size_t batchSize = 1; batchSize <= 13; batchSize += 1) {
+		tester.batchSize(batchSize)
+			.testKernelGradient();
+	}
+}
+
+/*
+ * Test that implementation works for input channels which are not a multiple of register block
+ */
+
+TEST(MRxNR_4x24, input_channels) {
+	FullyConnectedTester tester;
+	tester.batchSize(4)
+		.outputChannels(24)
+		.iterations(10)
+		.errorLimit(1.0e-5);
+	for (size_t inputChannels = 1; inputChannels <= 50; inputChannels += 1) {
+		tester.inputChannels(inputChannels)
+			.testKernelGradient();
+	}
+}
+
+/*
+ * Test that implementation works for output channels which are not a multiple of register block
+ */
+
+TEST(MRxNR_4x24, output_channels) {
+	FullyConnectedTester tester;
+	tester.batchSize(4)
+		.inputChannels(24)
+		.iterations(10)
+		.errorLimit(1.0e-5);
+	for (size_t outputChannels = 1; outputChannels <= 50; outputChannels += 1) {
+		tester.outputChannels(outputChannels)
+			.testKernelGradient();
+	}
+}
+
+/*
+ * Test that implementation works for a large minibatch with multithreading
+ */
+
+TEST(MRxNR_4x24, large_batch_size) {
+	FullyConnectedTester()
+		.multithreading(true)
+		.batchSize(1024)
+		.inputChannels(72)
+		.outputChannels(48)
+		.iterations(10)
+		.errorLimit(1.0e-5)
+		.testKernelGradient();
+}
+
+int main(int argc, char* argv[]) {
+	const enum nnp_status init_status = nnp_initialize();
+	assert(init_status == nnp_status_success);
+	setenv("TERM", "xterm-256color", 0);
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
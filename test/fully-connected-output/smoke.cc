@@ -127,6 +127,48 @@ TEST(MRxNR_4x24, many_output_channels) {
 		.testOutput();
 }
 
+/*
+ * Test that implementation consumes packed kernel with partial register blocks of output channels
+ */
+
+TEST(PACKED_KERNEL, few_input_channels) {
+	FullyConnectedTester()
+		.batchSize(7)
+		.inputChannels(13)
+		.outputChannels(29)
+		.iterations(100)
+		.errorLimit(1.0e-5)
+		.testOutput(true);
+}
+
+/*
+ * Test that implementation consumes packed kernel with multiple blocks of input channels
+ */
+
+TEST(PACKED_KERNEL, many_input_channels) {
+	FullyConnectedTester()
+		.batchSize(12)
+		.inputChannels(1024)
+		.outputChannels(100)
+		.iterations(10)
+		.errorLimit(1.0e-5)
+		.testOutput(true);
+}
+
+/*
+ * Test that implementation consumes packed kernel with multiple cache blocks of output channels
+ */
+
+TEST(PACKED_KERNEL, many_output_channels) {
+	FullyConnectedTester()
+		.batchSize(4)
+		.inputChannels(300)
+		.outputChannels(1200)
+		.iterations(10)
+		.errorLimit(1.0e-5)
+		.testOutput(true);
+}
+
 int main(int argc, char* argv[]) {
 	const enum nnp_status init_status = nnp_initialize();
 	assert(init_status == nnp_status_success);
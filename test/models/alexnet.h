@@ -116,4 +116,55 @@ namespace AlexNet {
 			.outputChannels(1000));
 	}
 
+	/*
+	 * AlexNet pool1 layer:
+	 *   channels         = 64
+	 *   input size       = 55x55
+	 *   implicit padding = 0
+	 *   pooling size     = 3x3
+	 *   pooling stride   = 2x2
+	 */
+	inline PoolingTester pool1() {
+		return std::move(PoolingTester()
+			.multithreading(true)
+			.channels(64)
+			.inputSize(55, 55)
+			.poolingSize(3, 3)
+			.poolingStride(2, 2));
+	}
+
+	/*
+	 * AlexNet pool2 layer:
+	 *   channels         = 192
+	 *   input size       = 27x27
+	 *   implicit padding = 0
+	 *   pooling size     = 3x3
+	 *   pooling stride   = 2x2
+	 */
+	inline PoolingTester pool2() {
+		return std::move(PoolingTester()
+			.multithreading(true)
+			.channels(192)
+			.inputSize(27, 27)
+			.poolingSize(3, 3)
+			.poolingStride(2, 2));
+	}
+
+	/*
+	 * AlexNet pool3 layer:
+	 *   channels         = 256
+	 *   input size       = 13x13
+	 *   implicit padding = 0
+	 *   pooling size     = 3x3
+	 *   pooling stride   = 2x2
+	 */
+	inline PoolingTester pool3() {
+		return std::move(PoolingTester()
+			.multithreading(true)
+			.channels(256)
+			.inputSize(13, 13)
+			.poolingSize(3, 3)
+			.poolingStride(2, 2));
+	}
+
 }
@@ -77,7 +77,7 @@ TEST(MaxPooling2x2, indivisible_size) {
  * Test that implementation works for a single-channel image with implicit padding
  */
 
-TEST(MaxPooling2x2, DISABLED_implicit_padding) {
+TEST(MaxPooling2x2, implicit_padding) {
 	PoolingTester tester;
 	tester.inputSize(24, 24)
 		.poolingSize(2, 2)
@@ -127,6 +127,402 @@ TEST(MaxPooling2x2, few_channels) {
 	}
 }
 
+/*
+ * Test that implementation of 3x3 pooling with 2x2 stride works for a single pool
+ */
+
+TEST(MaxPooling3x3s2, single_pool) {
+	PoolingTester()
+		.inputSize(3, 3)
+		.poolingSize(3, 3)
+		.poolingStride(2, 2)
+		.iterations(100)
+		.testOutput();
+}
+
+/*
+ * Test that implementation of 3x3 pooling with 2x2 stride works for images of various sizes
+ */
+
+TEST(MaxPooling3x3s2, image_sizes) {
+	for (size_t imageHeight = 3; imageHeight <= 20; imageHeight += 1) {
+		for (size_t imageWidth = 3; imageWidth <= 40; imageWidth += 1) {
+			PoolingTester()
+				.inputSize(imageHeight, imageWidth)
+				.poolingSize(3, 3)
+				.poolingStride(2, 2)
+				.iterations(10)
+				.testOutput();
+		}
+	}
+}
+
+/*
+ * Test that implementation of 3x3 pooling with 2x2 stride works with implicit padding
+ */
+
+TEST(MaxPooling3x3s2, implicit_padding) {
+	PoolingTester tester;
+	tester.inputSize(13, 21)
+		.poolingSize(3, 3)
+		.poolingStride(2, 2)
+		.iterations(10);
+	for (size_t paddingTop = 0; paddingTop < tester.kernelHeight(); paddingTop++) {
+		for (size_t paddingRight = 0; paddingRight < tester.kernelWidth(); paddingRight++) {
+			for (size_t paddingLeft = 0; paddingLeft < tester.kernelWidth(); paddingLeft++) {
+				for (size_t paddingBottom = 0; paddingBottom < tester.kernelHeight(); paddingBottom++) {
+					tester.inputPadding(paddingTop, paddingRight, paddingLeft, paddingBottom)
+						.testOutput();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Test that 3x3 pooling with 2x2 stride produces no windows which start in the bottom or right padding
+ */
+
+TEST(MaxPooling3x3s2, trailing_padding) {
+	PoolingTester tester;
+	tester.inputSize(13, 21)
+		.inputPadding(1, 2, 1, 2)
+		.poolingSize(3, 3)
+		.poolingStride(2, 2)
+		.iterations(10);
+	EXPECT_EQ(7u, tester.outputHeight());
+	EXPECT_EQ(11u, tester.outputWidth());
+	tester.testOutput();
+}
+
+/*
+ * Test that implementation of 3x3 pooling with 2x2 stride can handle non-unit batch size and number of channels
+ */
+
+TEST(MaxPooling3x3s2, small_batch_few_channels) {
+	PoolingTester()
+		.inputSize(13, 13)
+		.poolingSize(3, 3)
+		.poolingStride(2, 2)
+		.batchSize(3)
+		.channels(5)
+		.iterations(10)
+		.testOutput();
+}
+
+/*
+ * Test that implementation of 3x3 pooling with unit stride works for images of various sizes
+ */
+
+TEST(MaxPooling3x3s1, image_sizes) {
+	for (size_t imageHeight = 3; imageHeight <= 20; imageHeight += 1) {
+		for (size_t imageWidth = 3; imageWidth <= 40; imageWidth += 1) {
+			PoolingTester()
+				.inputSize(imageHeight, imageWidth)
+				.poolingSize(3, 3)
+				.poolingStride(1, 1)
+				.iterations(10)
+				.testOutput();
+		}
+	}
+}
+
+/*
+ * Test that implementation of 3x3 pooling with unit stride works with implicit padding
+ */
+
+TEST(MaxPooling3x3s1, implicit_padding) {
+	PoolingTester tester;
+	tester.inputSize(13, 21)
+		.poolingSize(3, 3)
+		.poolingStride(1, 1)
+		.iterations(10);
+	for (size_t paddingTop = 0; paddingTop < tester.kernelHeight(); paddingTop++) {
+		for (size_t paddingRight = 0; paddingRight < tester.kernelWidth(); paddingRight++) {
+			for (size_t paddingLeft = 0; paddingLeft < tester.kernelWidth(); paddingLeft++) {
+				for (size_t paddingBottom = 0; paddingBottom < tester.kernelHeight(); paddingBottom++) {
+					tester.inputPadding(paddingTop, paddingRight, paddingLeft, paddingBottom)
+						.testOutput();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Test that generic implementation works for pooling sizes and strides without specialized kernels
+ */
+
+TEST(MaxPoolingGeneric, pooling_sizes_and_strides) {
+	for (size_t poolingHeight = 1; poolingHeight <= 5; poolingHeight++) {
+		for (size_t poolingWidth = 1; poolingWidth <= 5; poolingWidth++) {
+			for (size_t strideHeight = 1; strideHeight <= poolingHeight; strideHeight++) {
+				for (size_t strideWidth = 1; strideWidth <= poolingWidth; strideWidth++) {
+					PoolingTester()
+						.inputSize(17, 23)
+						.poolingSize(poolingHeight, poolingWidth)
+						.poolingStride(strideHeight, strideWidth)
+						.testOutput();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Test that generic implementation works with implicit padding
+ */
+
+TEST(MaxPoolingGeneric, implicit_padding) {
+	PoolingTester tester;
+	tester.inputSize(17, 23)
+		.poolingSize(4, 5)
+		.poolingStride(3, 2)
+		.iterations(10);
+	for (size_t paddingTop = 0; paddingTop < tester.kernelHeight(); paddingTop++) {
+		for (size_t paddingRight = 0; paddingRight < tester.kernelWidth(); paddingRight++) {
+			for (size_t paddingLeft = 0; paddingLeft < tester.kernelWidth(); paddingLeft++) {
+				for (size_t paddingBottom = 0; paddingBottom < tester.kernelHeight(); paddingBottom++) {
+					tester.inputPadding(paddingTop, paddingRight, paddingLeft, paddingBottom)
+						.testOutput();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Test that generic implementation can handle non-unit batch size and number of channels
+ */
+
+TEST(MaxPoolingGeneric, small_batch_few_channels) {
+	PoolingTester()
+		.inputSize(17, 23)
+		.poolingSize(5, 5)
+		.poolingStride(3, 3)
+		.batchSize(3)
+		.channels(5)
+		.iterations(10)
+		.testOutput();
+}
+
+/*
+ * Test that max pooling rejects pooling windows larger than the padded input, for both specialized and generic kernels
+ */
+
+TEST(MaxPoolingGeneric, window_larger_than_input) {
+	ASSERT_EQ(nnp_status_invalid_input_size, nnp_max_pooling_output(
+		1, 1, nnp_size{ 2, 2 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 }, nnp_size{ 2, 2 },
+		nullptr, nullptr, nullptr));
+	ASSERT_EQ(nnp_status_invalid_input_size, nnp_max_pooling_output(
+		1, 1, nnp_size{ 1, 8 }, nnp_padding{ 1, 0, 0, 0 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr, nullptr, nullptr));
+	ASSERT_EQ(nnp_status_invalid_input_size, nnp_max_pooling_output(
+		1, 1, nnp_size{ 4, 4 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 5, 2 }, nnp_size{ 3, 2 },
+		nullptr, nullptr, nullptr));
+}
+
+/*
+ * Test that average pooling works for various pooling sizes and strides
+ */
+
+TEST(AveragePooling, pooling_sizes_and_strides) {
+	for (size_t poolingHeight = 1; poolingHeight <= 5; poolingHeight++) {
+		for (size_t poolingWidth = 1; poolingWidth <= 5; poolingWidth++) {
+			for (size_t strideHeight = 1; strideHeight <= poolingHeight; strideHeight++) {
+				for (size_t strideWidth = 1; strideWidth <= poolingWidth; strideWidth++) {
+					PoolingTester()
+						.inputSize(17, 23)
+						.poolingSize(poolingHeight, poolingWidth)
+						.poolingStride(strideHeight, strideWidth)
+						.errorLimit(1.0e-5)
+						.testAverageOutput();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Test that average pooling excludes implicit padding from the average
+ */
+
+TEST(AveragePooling, implicit_padding) {
+	PoolingTester tester;
+	tester.inputSize(17, 23)
+		.poolingSize(3, 3)
+		.poolingStride(2, 2)
+		.errorLimit(1.0e-5)
+		.iterations(10);
+	for (size_t paddingTop = 0; paddingTop < tester.kernelHeight(); paddingTop++) {
+		for (size_t paddingRight = 0; paddingRight < tester.kernelWidth(); paddingRight++) {
+			for (size_t paddingLeft = 0; paddingLeft < tester.kernelWidth(); paddingLeft++) {
+				for (size_t paddingBottom = 0; paddingBottom < tester.kernelHeight(); paddingBottom++) {
+					tester.inputPadding(paddingTop, paddingRight, paddingLeft, paddingBottom)
+						.testAverageOutput();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Test that average pooling rejects pooling windows larger than the padded input
+ */
+
+TEST(AveragePooling, window_larger_than_input) {
+	ASSERT_EQ(nnp_status_invalid_input_size, nnp_average_pooling_output(
+		1, 1, nnp_size{ 2, 2 }, nnp_padding{ 0, 0, 0, 0 }, nnp_size{ 3, 3 }, nnp_size{ 2, 2 },
+		nullptr, nullptr, nullptr));
+	ASSERT_EQ(nnp_status_invalid_input_size, nnp_average_pooling_output(
+		1, 1, nnp_size{ 8, 1 }, nnp_padding{ 0, 1, 0, 0 }, nnp_size{ 3, 3 }, nnp_size{ 1, 1 },
+		nullptr, nullptr, nullptr));
+}
+
+/*
+ * Test that average pooling can handle non-unit batch size and number of channels
+ */
+
+TEST(AveragePooling, small_batch_few_channels) {
+	PoolingTester()
+		.inputSize(17, 17)
+		.poolingSize(3, 3)
+		.poolingStride(1, 1)
+		.inputPadding(1, 1, 1, 1)
+		.batchSize(3)
+		.channels(5)
+		.errorLimit(1.0e-5)
+		.iterations(10)
+		.testAverageOutput();
+}
+
+/*
+ * Test that global average pooling works for images of various sizes
+ */
+
+TEST(GlobalAveragePooling, image_sizes) {
+	for (size_t imageSize = 1; imageSize <= 15; imageSize++) {
+		PoolingTester()
+			.inputSize(imageSize, imageSize)
+			.errorLimit(1.0e-5)
+			.iterations(10)
+			.testGlobalAverageOutput();
+	}
+}
+
+/*
+ * Test that global average pooling can handle non-unit batch size and number of channels
+ */
+
+TEST(GlobalAveragePooling, small_batch_many_channels) {
+	PoolingTester tester;
+	tester.inputSize(7, 7)
+		.errorLimit(1.0e-5)
+		.iterations(10);
+	for (size_t channels = 2; channels <= 40; channels += 7) {
+		tester.batchSize(3)
+			.channels(channels)
+			.testGlobalAverageOutput();
+	}
+}
+
+/*
+ * Test that global average pooling works with multithreading on a classifier-sized input
+ */
+
+TEST(GlobalAveragePooling, multithreaded) {
+	PoolingTester()
+		.multithreading(true)
+		.inputSize(7, 7)
+		.batchSize(16)
+		.channels(1024)
+		.errorLimit(1.0e-5)
+		.testGlobalAverageOutput();
+}
+
+/*
+ * Test that indices of maxima and input gradient are correct for common pooling configurations
+ */
+
+TEST(MaxPoolingGradient, common_configurations) {
+	PoolingTester()
+		.inputSize(24, 24)
+		.poolingSize(2, 2)
+		.poolingStride(2, 2)
+		.iterations(10)
+		.testInputGradient();
+	PoolingTester()
+		.inputSize(27, 27)
+		.poolingSize(3, 3)
+		.poolingStride(2, 2)
+		.iterations(10)
+		.testInputGradient();
+	PoolingTester()
+		.inputSize(13, 13)
+		.poolingSize(3, 3)
+		.poolingStride(1, 1)
+		.iterations(10)
+		.testInputGradient();
+}
+
+/*
+ * Test that input gradient is correct for various pooling sizes and strides
+ */
+
+TEST(MaxPoolingGradient, pooling_sizes_and_strides) {
+	for (size_t poolingHeight = 1; poolingHeight <= 5; poolingHeight++) {
+		for (size_t poolingWidth = 1; poolingWidth <= 5; poolingWidth++) {
+			for (size_t strideHeight = 1; strideHeight <= poolingHeight; strideHeight++) {
+				for (size_t strideWidth = 1; strideWidth <= poolingWidth; strideWidth++) {
+					PoolingTester()
+						.inputSize(17, 23)
+						.poolingSize(poolingHeight, poolingWidth)
+						.poolingStride(strideHeight, strideWidth)
+						.testInputGradient();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Test that input gradient is correct with implicit padding
+ */
+
+TEST(MaxPoolingGradient, implicit_padding) {
+	PoolingTester tester;
+	tester.inputSize(17, 23)
+		.poolingSize(4, 5)
+		.poolingStride(3, 2)
+		.iterations(10);
+	for (size_t paddingTop = 0; paddingTop < tester.kernelHeight(); paddingTop++) {
+		for (size_t paddingRight = 0; paddingRight < tester.kernelWidth(); paddingRight++) {
+			for (size_t paddingLeft = 0; paddingLeft < tester.kernelWidth(); paddingLeft++) {
+				for (size_t paddingBottom = 0; paddingBottom < tester.kernelHeight(); paddingBottom++) {
+					tester.inputPadding(paddingTop, paddingRight, paddingLeft, paddingBottom)
+						.testInputGradient();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Test that input gradient is correct with multithreading, non-unit batch size and number of channels
+ */
+
+TEST(MaxPoolingGradient, multithreaded) {
+	PoolingTester()
+		.multithreading(true)
+		.inputSize(27, 27)
+		.poolingSize(3, 3)
+		.poolingStride(2, 2)
+		.batchSize(3)
+		.channels(16)
+		.iterations(10)
+		.testInputGradient();
+}
+
 int main(int argc, char* argv[]) {
 	const enum nnp_status init_status = nnp_initialize();
 	assert(init_status == nnp_status_success);
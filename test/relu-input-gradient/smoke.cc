@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <nnpack.h>
+
+#include <testers/relu.h>
+
+/*
+ * Test that implementation works for a single vector with a single element
+ */
+
+TEST(ReLUInputGradient, single_element) {
+	ReLUTester()
+		.channels(1)
+		.iterations(100)
+		.testInputGradient();
+}
+
+/*
+ * Test that implementation works for vectors with lengths which are not multiples of SIMD width
+ */
+
+TEST(ReLUInputGradient, small_channels) {
+	for (size_t channels = 2; channels <= 64; channels++) {
+		ReLUTester()
+			.channels(channels)
+			.iterations(100)
+			.testInputGradient();
+	}
+}
+
+/*
+ * Test that implementation works with large vectors which span several parallelization blocks
+ */
+
+TEST(ReLUInputGradient, large_channels) {
+	ReLUTester tester;
+	tester.iterations(10);
+	for (size_t channels : { 1000, 4096, 21841 }) {
+		tester.channels(channels)
+			.testInputGradient();
+	}
+}
+
+/*
+ * Test that implementation supports non-zero negative slope (leaky ReLU)
+ */
+
+TEST(ReLUInputGradient, negative_slope) {
+	ReLUTester tester;
+	tester.channels(1000)
+		.iterations(10);
+	for (float negativeSlope : { 0.01f, 0.1f, 0.5f, 1.0f }) {
+		tester.negativeSlope(negativeSlope)
+			.testInputGradient();
+	}
+}
+
+/*
+ * Test that implementation can compute ReLU in-place
+ */
+
+TEST(ReLUInputGradient, in_place) {
+	ReLUTester()
+		.channels(1000)
+		.negativeSlope(0.1f)
+		.inPlace(true)
+		.iterations(10)
+		.testInputGradient();
+}
+
+/*
+ * Test that implementation can handle small non-unit batch_size
+ */
+
+TEST(ReLUInputGradient, small_batch) {
+	ReLUTester tester;
+	tester.channels(1001)
+		.iterations(10);
+	for (size_t batchSize = 2; batchSize <= 5; batchSize++) {
+		tester.batchSize(batchSize)
+			.testInputGradient();
+	}
+}
+
+/*
+ * Test that implementation can handle large batch_size with multithreading
+ */
+
+TEST(ReLUInputGradient, multithreaded_batch) {
+	ReLUTester()
+		.multithreading(true)
+		.batchSize(64)
+		.channels(1001)
+		.iterations(10)
+		.testInputGradient();
+}
+
+int main(int argc, char* argv[]) {
+	const enum nnp_status init_status = nnp_initialize();
+	assert(init_status == nnp_status_success);
+	setenv("TERM", "xterm-256color", 0);
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <nnpack.h>
+
+#include <testers/softmax.h>
+
+/*
+ * Test that implementation works for a single vector with a single element
+ */
+
+TEST(SoftmaxOutput, single_element) {
+	SoftmaxTester()
+		.channels(1)
+		.iterations(100)
+		.testOutput();
+}
+
+/*
+ * Test that implementation works for vectors with lengths which are not multiples of SIMD width
+ */
+
+TEST(SoftmaxOutput, small_channels) {
+	for (size_t channels = 2; channels <= 64; channels++) {
+		SoftmaxTester()
+			.channels(channels)
+			.iterations(100)
+			.testOutput();
+	}
+}
+
+/*
+ * Test that implementation works with classifier-sized vectors.
+ * Error limit is relaxed because of the error of sequential summation in the reference implementation.
+ */
+
+TEST(SoftmaxOutput, large_channels) {
+	SoftmaxTester tester;
+	tester.iterations(10)
+		.errorLimit(1.0e-4);
+	for (size_t channels : { 1000, 1001, 4096, 21841 }) {
+		tester.channels(channels)
+			.testOutput();
+	}
+}
+
+/*
+ * Test that implementation does not overflow or underflow with a wide range of inputs
+ */
+
+TEST(SoftmaxOutput, wide_input_range) {
+	SoftmaxTester()
+		.channels(1000)
+		.inputRange(-100.0f, 100.0f)
+		.iterations(100)
+		.testOutput();
+}
+
+/*
+ * Test that implementation can compute softmax in-place
+ */
+
+TEST(SoftmaxOutput, in_place) {
+	SoftmaxTester()
+		.channels(1000)
+		.inPlace(true)
+		.iterations(10)
+		.testOutput();
+}
+
+/*
+ * Test that implementation can handle small non-unit batch_size
+ */
+
+TEST(SoftmaxOutput, small_batch) {
+	SoftmaxTester tester;
+	tester.channels(1000)
+		.iterations(10);
+	for (size_t batchSize = 2; batchSize <= 5; batchSize++) {
+		tester.batchSize(batchSize)
+			.testOutput();
+	}
+}
+
+/*
+ * Test that implementation can handle large batch_size with multithreading
+ */
+
+TEST(SoftmaxOutput, multithreaded_batch) {
+	SoftmaxTester()
+		.multithreading(true)
+		.batchSize(64)
+		.channels(1000)
+		.iterations(10)
+		.testOutput();
+}
+
+int main(int argc, char* argv[]) {
+	const enum nnp_status init_status = nnp_initialize();
+	assert(init_status == nnp_status_success);
+	setenv("TERM", "xterm-256color", 0);
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -10,23 +10,33 @@
 #include <chrono>
 #include <functional>
 #include <algorithm>
+#include <numeric>
 
 #include <nnpack.h>
 #include <nnpack/reference.h>
 
+#include <AlignedAllocator.h>
+
 class ConvolutionTester {
 public:
 	ConvolutionTester() :
 		iterations_(1),
 		errorLimit_(1.0e-5),
 		multithreading_(false),
+		workspace_(false),
+		activation_(nnp_activation_identity),
+		leakyReluParameters_{ 0.0f },
+		clampParameters_{ 0.0f, 0.0f },
 		batchSize_(1),
+		groups_(1),
 		inputChannels_(1),
 		outputChannels_(1)
 	{
 		inputSize(4, 4);
 		kernelSize(3, 3);
+		kernelDilation(1, 1);
 		inputPadding(0, 0, 0, 0);
+		outputSubsampling(1, 1);
 
 		this->threadpool = nullptr;
 	}
@@ -37,12 +47,19 @@ public:
 		iterations_(tester.iterations_),
 		errorLimit_(tester.errorLimit_),
 		multithreading_(tester.multithreading_),
+		workspace_(tester.workspace_),
+		activation_(tester.activation_),
+		leakyReluParameters_(tester.leakyReluParameters_),
+		clampParameters_(tester.clampParameters_),
 		batchSize_(tester.batchSize_),
+		groups_(tester.groups_),
 		inputChannels_(tester.inputChannels_),
 		outputChannels_(tester.outputChannels_),
 		inputSize_(tester.inputSize_),
 		kernelSize_(tester.kernelSize_),
+		kernelDilation_(tester.kernelDilation_),
 		inputPadding_(tester.inputPadding_),
+		outputSubsampling_(tester.outputSubsampling_),
 		threadpool(tester.threadpool)
 	{
 		tester.threadpool = nullptr;
@@ -90,6 +107,48 @@ public:
 		return this->multithreading_;
 	}
 
+	inline ConvolutionTester& workspace(bool workspace) {
+		this->workspace_ = workspace;
+		return *this;
+	}
+
+	inline bool workspace() const {
+		return this->workspace_;
+	}
+
+	inline ConvolutionTester& activation(enum nnp_activation activation) {
+		this->activation_ = activation;
+		return *this;
+	}
+
+	inline enum nnp_activation activation() const {
+		return this->activation_;
+	}
+
+	inline ConvolutionTester& leakyRelu(float negativeSlope) {
+		this->activation_ = nnp_activation_leaky_relu;
+		this->leakyReluParameters_.negative_slope = negativeSlope;
+		return *this;
+	}
+
+	inline ConvolutionTester& clamp(float min, float max) {
+		this->activation_ = nnp_activation_clamp;
+		this->clampParameters_.min = min;
+		this->clampParameters_.max = max;
+		return *this;
+	}
+
+	inline const void* activationParameters() const {
+		switch (activation()) {
+			case nnp_activation_leaky_relu:
+				return &this->leakyReluParameters_;
+			case nnp_activation_clamp:
+				return &this->clampParameters_;
+			default:
+				return nullptr;
+		}
+	}
+
 	inline ConvolutionTester& batchSize(size_t batchSize) {
 		this->batchSize_ = batchSize;
 		return *this;
@@ -99,6 +158,15 @@ public:
 		return this->batchSize_;
 	}
 
+	inline ConvolutionTester& groups(size_t groups) {
+		this->groups_ = groups;
+		return *this;
+	}
+
+	inline size_t groups() const {
+		return this->groups_;
+	}
+
 	inline ConvolutionTester& inputChannels(size_t inputChannels) {
 		this->inputChannels_ = inputChannels;
 		return *this;
@@ -153,6 +221,28 @@ public:
 		return this->kernelSize_.width;
 	}
 
+	inline ConvolutionTester& kernelDilation(size_t height, size_t width) {
+		this->kernelDilation_.height = height;
+		this->kernelDilation_.width = width;
+		return *this;
+	}
+
+	inline struct nnp_size kernelDilation() const {
+		return this->kernelDilation_;
+	}
+
+	inline bool dilated() const {
+		return (this->kernelDilation_.height != 1) || (this->kernelDilation_.width != 1);
+	}
+
+	inline size_t dilatedKernelHeight() const {
+		return (this->kernelSize_.height - 1) * this->kernelDilation_.height + 1;
+	}
+
+	inline size_t dilatedKernelWidth() const {
+		return (this->kernelSize_.width - 1) * this->kernelDilation_.width + 1;
+	}
+
 	inline struct nnp_size outputSize() const {
 		struct nnp_size outputSize;
 		outputSize.height = this->outputHeight();
@@ -161,11 +251,25 @@ public:
 	}
 
 	inline size_t outputHeight() const {
-		return this->inputPadding_.top + this->inputSize_.height + this->inputPadding_.bottom - this->kernelSize_.height + 1;
+		return (this->inputPadding_.top + this->inputSize_.height + this->inputPadding_.bottom - dilatedKernelHeight()) / this->outputSubsampling_.height + 1;
 	}
 
 	inline size_t outputWidth() const {
-		return this->inputPadding_.left + this->inputSize_.width + this->inputPadding_.right - this->kernelSize_.width + 1;
+		return (this->inputPadding_.left + this->inputSize_.width + this->inputPadding_.right - dilatedKernelWidth()) / this->outputSubsampling_.width + 1;
+	}
+
+	inline ConvolutionTester& outputSubsampling(size_t height, size_t width) {
+		this->outputSubsampling_.height = height;
+		this->outputSubsampling_.width = width;
+		return *this;
+	}
+
+	inline struct nnp_size outputSubsampling() const {
+		return this->outputSubsampling_;
+	}
+
+	inline bool strided() const {
+		return (this->outputSubsampling_.height != 1) || (this->outputSubsampling_.width != 1);
 	}
 
 	inline ConvolutionTester& inputPadding(size_t top, size_t right, size_t left, size_t bottom) {
@@ -180,12 +284,12 @@ public:
 		return this->inputPadding_;
 	}
 
-	void testOutput(enum nnp_convolution_algorithm algorithm) const {
+	void testOutput(enum nnp_convolution_algorithm algorithm, enum nnp_convolution_kernel_transform_strategy kernel_transform_strategy=nnp_convolution_kernel_transform_strategy_reuse) const {
 		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
 		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
 
 		std::vector<float> input(batchSize() * inputChannels() * inputHeight() * inputWidth());
-		std::vector<float> kernel(outputChannels() * inputChannels() * kernelHeight() * kernelWidth());
+		std::vector<float> kernel(outputChannels() * (inputChannels() / groups()) * kernelHeight() * kernelWidth());
 
 		std::vector<float> bias(outputChannels());
 
@@ -198,23 +302,71 @@ public:
 			std::generate(bias.begin(), bias.end(), std::ref(rng));
 			std::fill(output.begin(), output.end(), std::nanf(""));
 
-			nnp_convolution_output__reference(
-				batchSize(), inputChannels(), outputChannels(),
-				inputSize(), inputPadding(), kernelSize(),
-				input.data(), kernel.data(), bias.data(), referenceOutput.data(),
-				this->threadpool);
-
-			enum nnp_status status = nnp_convolution_output(
-				algorithm,
-				batchSize(), inputChannels(), outputChannels(),
-				inputSize(), inputPadding(), kernelSize(),
-				input.data(), kernel.data(), bias.data(), output.data(),
-				this->threadpool, nullptr);
+			computeReferenceOutput(batchSize(), input, kernel, bias, referenceOutput);
+
+			enum nnp_status status;
+			if (kernel_transform_strategy == nnp_convolution_kernel_transform_strategy_precomputed) {
+				std::vector<uint8_t, AlignedAllocator<uint8_t, 64>> transformedKernel;
+				transformKernel(algorithm, nnp_convolution_kernel_transform_layout_output, kernel, transformedKernel);
+
+				status = callWithWorkspace([&](void* workspaceBuffer, size_t* workspaceSize) {
+					return nnp_convolution_output_precomputed_with_workspace(
+						algorithm,
+						batchSize(), inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(),
+						input.data(), transformedKernel.data(), bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				});
+			} else if (groups() != 1) {
+				status = callWithWorkspace([&](void* workspaceBuffer, size_t* workspaceSize) {
+					return nnp_convolution_output_grouped(
+						algorithm,
+						batchSize(), groups(), inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(), outputSubsampling(),
+						input.data(), kernel.data(), bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				});
+			} else if (dilated()) {
+				status = callWithWorkspace([&](void* workspaceBuffer, size_t* workspaceSize) {
+					return nnp_convolution_output_dilated(
+						algorithm,
+						batchSize(), inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(), kernelDilation(), outputSubsampling(),
+						input.data(), kernel.data(), bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				});
+			} else if (strided()) {
+				status = callWithWorkspace([&](void* workspaceBuffer, size_t* workspaceSize) {
+					return nnp_convolution_output_strided(
+						algorithm,
+						batchSize(), inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(), outputSubsampling(),
+						input.data(), kernel.data(), bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				});
+			} else {
+				status = callWithWorkspace([&](void* workspaceBuffer, size_t* workspaceSize) {
+					return nnp_convolution_output_with_workspace(
+						algorithm,
+						batchSize(), inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(),
+						input.data(), kernel.data(), bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				});
+			}
 			ASSERT_EQ(nnp_status_success, status);
 
-			const float maxError = std::inner_product(referenceOutput.cbegin(), referenceOutput.cend(), output.cbegin(), 0.0f,
-				[](float x, float y)->float { return std::max<float>(y, x); }, relativeError);
-			EXPECT_LT(maxError, errorLimit());
+			EXPECT_LT(outputError(referenceOutput, output), errorLimit());
 		}
 	}
 
@@ -240,12 +392,15 @@ public:
 				outputGradient.data(), kernel.data(), referenceInputGradient.data(),
 				this->threadpool);
 
-			enum nnp_status status = nnp_convolution_input_gradient(
-				algorithm,
-				batchSize(), inputChannels(), outputChannels(),
-				inputSize(), inputPadding(), kernelSize(),
-				outputGradient.data(), kernel.data(), inputGradient.data(),
-				this->threadpool, nullptr);
+			enum nnp_status status = callWithWorkspace([&](void* workspaceBuffer, size_t* workspaceSize) {
+				return nnp_convolution_input_gradient_with_workspace(
+					algorithm,
+					batchSize(), inputChannels(), outputChannels(),
+					inputSize(), inputPadding(), kernelSize(),
+					outputGradient.data(), kernel.data(), inputGradient.data(),
+					workspaceBuffer, workspaceSize,
+					this->threadpool, nullptr);
+			});
 			ASSERT_EQ(nnp_status_success, status);
 
 			const float maxError = std::inner_product(referenceInputGradient.cbegin(), referenceInputGradient.cend(), inputGradient.cbegin(), 0.0f,
@@ -275,16 +430,55 @@ public:
 				input.data(), outputGradient.data(), referenceKernelGradient.data(),
 				this->threadpool);
 
-			enum nnp_status status = nnp_convolution_kernel_gradient(
+			enum nnp_status status = callWithWorkspace([&](void* workspaceBuffer, size_t* workspaceSize) {
+				return nnp_convolution_kernel_gradient_with_workspace(
+					algorithm,
+					batchSize(), inputChannels(), outputChannels(),
+					inputSize(), inputPadding(), kernelSize(),
+					input.data(), outputGradient.data(), kernelGradient.data(),
+					workspaceBuffer, workspaceSize,
+					this->threadpool, nullptr);
+			});
+			ASSERT_EQ(nnp_status_success, status);
+
+			const float maxError = std::inner_product(referenceKernelGradient.cbegin(), referenceKernelGradient.cend(), kernelGradient.cbegin(), 0.0f,
+				[](float x, float y)->float { return std::max<float>(y, x); }, relativeError);
+			EXPECT_LT(maxError, errorLimit());
+		}
+	}
+
+	void testKernelUpdate(enum nnp_convolution_algorithm algorithm) const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
+
+		std::vector<float> input(batchSize() * inputChannels() * inputHeight() * inputWidth());
+		std::vector<float> outputGradient(batchSize() * outputChannels() * outputHeight() * outputWidth());
+		std::vector<float> kernel(outputChannels() * inputChannels() * kernelHeight() * kernelWidth());
+
+		std::vector<float> referenceKernel(outputChannels() * inputChannels() * kernelHeight() * kernelWidth());
+
+		for (size_t iteration = 0; iteration < iterations(); iteration++) {
+			std::generate(input.begin(), input.end(), std::ref(rng));
+			std::generate(outputGradient.begin(), outputGradient.end(), std::ref(rng));
+			std::generate(kernel.begin(), kernel.end(), std::ref(rng));
+			std::copy(kernel.cbegin(), kernel.cend(), referenceKernel.begin());
+			const float scale = rng();
+
+			nnp_convolution_kernel_update__reference(
+				batchSize(), inputChannels(), outputChannels(),
+				inputSize(), inputPadding(), kernelSize(),
+				input.data(), outputGradient.data(), referenceKernel.data(), scale,
+				this->threadpool);
+
+			enum nnp_status status = nnp_convolution_kernel_update(
 				algorithm,
 				batchSize(), inputChannels(), outputChannels(),
 				inputSize(), inputPadding(), kernelSize(),
-				input.data(), outputGradient.data(), kernelGradient.data(),
-				this->threadpool,
-				NULL);
+				input.data(), outputGradient.data(), kernel.data(), scale,
+				this->threadpool, nullptr);
 			ASSERT_EQ(nnp_status_success, status);
 
-			const float maxError = std::inner_product(referenceKernelGradient.cbegin(), referenceKernelGradient.cend(), kernelGradient.cbegin(), 0.0f,
+			const float maxError = std::inner_product(referenceKernel.cbegin(), referenceKernel.cend(), kernel.cbegin(), 0.0f,
 				[](float x, float y)->float { return std::max<float>(y, x); }, relativeError);
 			EXPECT_LT(maxError, errorLimit());
 		}
@@ -297,7 +491,7 @@ public:
 		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
 
 		std::vector<float> input(inputChannels() * inputHeight() * inputWidth());
-		std::vector<float> kernel(outputChannels() * inputChannels() * kernelHeight() * kernelWidth());
+		std::vector<float> kernel(outputChannels() * (inputChannels() / groups()) * kernelHeight() * kernelWidth());
 
 		std::vector<float> bias(outputChannels());
 
@@ -310,31 +504,179 @@ public:
 			std::generate(bias.begin(), bias.end(), std::ref(rng));
 			std::fill(output.begin(), output.end(), std::nanf(""));
 
+			computeReferenceOutput(1, input, kernel, bias, referenceOutput);
+
+			std::vector<uint8_t, AlignedAllocator<uint8_t, 64>> transformedKernel;
+			const float* kernelData = kernel.data();
+			if (kernel_transform_strategy == nnp_convolution_kernel_transform_strategy_precomputed) {
+				transformKernel(algorithm, nnp_convolution_kernel_transform_layout_inference, kernel, transformedKernel);
+				kernelData = reinterpret_cast<const float*>(transformedKernel.data());
+			}
+
+			enum nnp_status status = callWithWorkspace([&](void* workspaceBuffer, size_t* workspaceSize) {
+				if (groups() != 1) {
+					return nnp_convolution_inference_grouped(
+						algorithm,
+						kernel_transform_strategy,
+						groups(), inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(), outputSubsampling(),
+						input.data(), kernelData, bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				} else if (dilated()) {
+					return nnp_convolution_inference_dilated(
+						algorithm,
+						kernel_transform_strategy,
+						inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(), kernelDilation(), outputSubsampling(),
+						input.data(), kernelData, bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				} else if (strided()) {
+					return nnp_convolution_inference_strided(
+						algorithm,
+						kernel_transform_strategy,
+						inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(), outputSubsampling(),
+						input.data(), kernelData, bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				} else {
+					return nnp_convolution_inference_with_workspace(
+						algorithm,
+						kernel_transform_strategy,
+						inputChannels(), outputChannels(),
+						inputSize(), inputPadding(), kernelSize(),
+						input.data(), kernelData, bias.data(), output.data(),
+						workspaceBuffer, workspaceSize,
+						activation(), activationParameters(),
+						this->threadpool, nullptr);
+				}
+			});
+			ASSERT_EQ(nnp_status_success, status);
+
+			EXPECT_LT(outputError(referenceOutput, output), errorLimit());
+		}
+	}
+
+protected:
+	pthreadpool_t threadpool;
+
+private:
+	/*
+	 * Calls the function without workspace, or queries the workspace size and calls the function with a workspace.
+	 * The workspace is filled with NaNs to detect reads of uninitialized data.
+	 */
+	template <class Function>
+	enum nnp_status callWithWorkspace(Function function) const {
+		if (!workspace()) {
+			return function(nullptr, nullptr);
+		}
+
+		size_t workspaceSize = 0;
+		const enum nnp_status status = function(nullptr, &workspaceSize);
+		if (status != nnp_status_success) {
+			return status;
+		}
+
+		/* A NULL buffer would make another size query: without temporary buffers the function takes no workspace */
+		if (workspaceSize == 0) {
+			return function(nullptr, nullptr);
+		}
+
+		std::vector<uint8_t, AlignedAllocator<uint8_t, 64>> workspaceBuffer(workspaceSize, 0xFF);
+		return function(workspaceBuffer.data(), &workspaceSize);
+	}
+
+	/*
+	 * Computes the reference output with the activation applied.
+	 * With an activation the bias is shifted so that about half of the outputs in every channel are negative before
+	 * activation.
+	 */
+	void computeReferenceOutput(size_t batchSize,
+		const std::vector<float>& input, const std::vector<float>& kernel,
+		std::vector<float>& bias, std::vector<float>& referenceOutput) const
+	{
+		nnp_convolution_output__reference(
+			batchSize, groups(), inputChannels(), outputChannels(),
+			inputSize(), inputPadding(), kernelSize(), kernelDilation(), outputSubsampling(),
+			input.data(), kernel.data(), bias.data(), referenceOutput.data(),
+			this->threadpool);
+
+		if (activation() != nnp_activation_identity) {
+			const size_t outputElements = outputHeight() * outputWidth();
+			for (size_t outputChannel = 0; outputChannel < outputChannels(); outputChannel++) {
+				double sum = 0.0;
+				for (size_t sample = 0; sample < batchSize; sample++) {
+					const auto channelOutput = referenceOutput.cbegin() + (sample * outputChannels() + outputChannel) * outputElements;
+					sum = std::accumulate(channelOutput, channelOutput + outputElements, sum);
+				}
+				bias[outputChannel] -= float(sum / double(batchSize * outputElements));
+			}
+
 			nnp_convolution_output__reference(
-				1, inputChannels(), outputChannels(),
-				inputSize(), inputPadding(), kernelSize(),
+				batchSize, groups(), inputChannels(), outputChannels(),
+				inputSize(), inputPadding(), kernelSize(), kernelDilation(), outputSubsampling(),
 				input.data(), kernel.data(), bias.data(), referenceOutput.data(),
 				this->threadpool);
+			for (float& value : referenceOutput) {
+				value = applyActivation(value);
+			}
+		}
+	}
 
-			enum nnp_status status = nnp_convolution_inference(
-				algorithm,
-				kernel_transform_strategy,
-				inputChannels(), outputChannels(),
-				inputSize(), inputPadding(), kernelSize(),
-				input.data(), kernel.data(), bias.data(), output.data(),
-				this->threadpool, nullptr);
-			ASSERT_EQ(nnp_status_success, status);
+	float applyActivation(float value) const {
+		switch (activation()) {
+			case nnp_activation_relu:
+				return std::max(value, 0.0f);
+			case nnp_activation_leaky_relu:
+				return value < 0.0f ? value * this->leakyReluParameters_.negative_slope : value;
+			case nnp_activation_clamp:
+				return std::min(std::max(value, this->clampParameters_.min), this->clampParameters_.max);
+			default:
+				return value;
+		}
+	}
 
-			const float maxError = std::inner_product(referenceOutput.cbegin(), referenceOutput.cend(), output.cbegin(), 0.0f,
+	/*
+	 * Outputs after an activation are often zero, close to zero, or reduced in magnitude, so relative error is not
+	 * meaningful for them. With an activation the error is relative to the largest output magnitude.
+	 */
+	float outputError(const std::vector<float>& referenceOutput, const std::vector<float>& output) const {
+		if (activation() != nnp_activation_identity) {
+			const float maxOutput = std::accumulate(referenceOutput.cbegin(), referenceOutput.cend(), FLT_MIN,
+				[](float x, float y)->float { return std::max<float>(x, std::abs(y)); });
+			return std::inner_product(referenceOutput.cbegin(), referenceOutput.cend(), output.cbegin(), 0.0f,
+				[](float x, float y)->float { return std::max<float>(y, x); },
+				[maxOutput](float reference, float actual)->float { return std::abs(reference - actual) / maxOutput; });
+		} else {
+			return std::inner_product(referenceOutput.cbegin(), referenceOutput.cend(), output.cbegin(), 0.0f,
 				[](float x, float y)->float { return std::max<float>(y, x); }, relativeError);
-			EXPECT_LT(maxError, errorLimit());
 		}
 	}
 
-protected:
-	pthreadpool_t threadpool;
+	void transformKernel(enum nnp_convolution_algorithm algorithm, enum nnp_convolution_kernel_transform_layout layout,
+		const std::vector<float>& kernel, std::vector<uint8_t, AlignedAllocator<uint8_t, 64>>& transformedKernel) const
+	{
+		size_t transformedKernelSize = 0;
+		enum nnp_status status = nnp_convolution_kernel_transform_size(
+			algorithm, layout,
+			inputChannels(), outputChannels(), kernelSize(),
+			&transformedKernelSize);
+		ASSERT_EQ(nnp_status_success, status);
+
+		transformedKernel.resize(transformedKernelSize);
+		status = nnp_convolution_kernel_transform(
+			algorithm, layout,
+			inputChannels(), outputChannels(), kernelSize(),
+			kernel.data(), transformedKernel.data(), transformedKernel.size(),
+			this->threadpool);
+		ASSERT_EQ(nnp_status_success, status);
+	}
 
-private:
 	inline static float relativeError(float reference, float actual) {
 		return std::abs(reference - actual) / std::max(FLT_MIN, std::abs(reference));
 	}
@@ -342,11 +684,18 @@ private:
 	size_t iterations_;
 	float errorLimit_;
 	bool multithreading_;
+	bool workspace_;
+	enum nnp_activation activation_;
+	struct nnp_leaky_relu_parameters leakyReluParameters_;
+	struct nnp_clamp_parameters clampParameters_;
 
 	size_t batchSize_;
+	size_t groups_;
 	size_t inputChannels_;
 	size_t outputChannels_;
 	struct nnp_size inputSize_;
 	struct nnp_padding inputPadding_;
 	struct nnp_size kernelSize_;
+	struct nnp_size kernelDilation_;
+	struct nnp_size outputSubsampling_;
 };
@@ -14,6 +14,8 @@
 #include <nnpack.h>
 #include <nnpack/reference.h>
 
+#include <AlignedAllocator.h>
+
 class FullyConnectedTester {
 public:
 	FullyConnectedTester() :
@@ -110,7 +112,7 @@ public:
 		return this->outputChannels_;
 	}
 
-	void testOutput() const {
+	void testOutput(bool packedKernel = false) const {
 		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
 		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
 
@@ -130,10 +132,29 @@ public:
 				input.data(), kernel.data(), referenceOutput.data(),
 				this->threadpool);
 
-			enum nnp_status status = nnp_fully_connected_output(
-				batchSize(), inputChannels(), outputChannels(),
-				input.data(), kernel.data(), output.data(),
-				this->threadpool, nullptr);
+			enum nnp_status status = nnp_status_success;
+			if (packedKernel) {
+				size_t packedKernelSize = 0;
+				status = nnp_fully_connected_packed_kernel_size(inputChannels(), outputChannels(), &packedKernelSize);
+				ASSERT_EQ(nnp_status_success, status);
+
+				std::vector<uint8_t, AlignedAllocator<uint8_t, 64>> packedKernelBuffer(packedKernelSize);
+				status = nnp_fully_connected_pack_kernel(
+					inputChannels(), outputChannels(),
+					kernel.data(), packedKernelBuffer.data(), packedKernelBuffer.size(),
+					this->threadpool);
+				ASSERT_EQ(nnp_status_success, status);
+
+				status = nnp_fully_connected_output_packed(
+					batchSize(), inputChannels(), outputChannels(),
+					input.data(), packedKernelBuffer.data(), output.data(),
+					this->threadpool, nullptr);
+			} else {
+				status = nnp_fully_connected_output(
+					batchSize(), inputChannels(), outputChannels(),
+					input.data(), kernel.data(), output.data(),
+					this->threadpool, nullptr);
+			}
 			ASSERT_EQ(nnp_status_success, status);
 
 			const float maxError = std::inner_product(referenceOutput.cbegin(), referenceOutput.cend(), output.cbegin(), 0.0f,
@@ -143,16 +164,14 @@ public:
 	}
 
 	void testInference() const {
-		ASSERT_EQ(1, batchSize());
-
 		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
 		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
 
-		std::vector<float> input(inputChannels());
+		std::vector<float> input(batchSize() * inputChannels());
 		std::vector<float> kernel(outputChannels() * inputChannels());
 
-		std::vector<float> output(outputChannels());
-		std::vector<float> referenceOutput(outputChannels());
+		std::vector<float> output(batchSize() * outputChannels());
+		std::vector<float> referenceOutput(batchSize() * outputChannels());
 
 		for (size_t iteration = 0; iteration < iterations(); iteration++) {
 			std::generate(input.begin(), input.end(), std::ref(rng));
@@ -160,14 +179,23 @@ public:
 			std::fill(output.begin(), output.end(), std::nanf(""));
 
 			nnp_fully_connected_output__reference(
-				1, inputChannels(), outputChannels(),
+				batchSize(), inputChannels(), outputChannels(),
 				input.data(), kernel.data(), referenceOutput.data(),
 				this->threadpool);
 
-			enum nnp_status status = nnp_fully_connected_inference(
-				inputChannels(), outputChannels(),
-				input.data(), kernel.data(), output.data(),
-				this->threadpool);
+			/* Single vectors go through the original inference function, minibatches through the batched one */
+			enum nnp_status status = nnp_status_success;
+			if (batchSize() == 1) {
+				status = nnp_fully_connected_inference(
+					inputChannels(), outputChannels(),
+					input.data(), kernel.data(), output.data(),
+					this->threadpool);
+			} else {
+				status = nnp_fully_connected_inference_batch(
+					batchSize(), inputChannels(), outputChannels(),
+					input.data(), kernel.data(), output.data(),
+					this->threadpool);
+			}
 			ASSERT_EQ(nnp_status_success, status);
 
 			const float maxError = std::inner_product(referenceOutput.cbegin(), referenceOutput.cend(), output.cbegin(), 0.0f,
@@ -176,6 +204,70 @@ public:
 		}
 	}
 
+	void testInputGradient() const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
+
+		std::vector<float> gradOutput(batchSize() * outputChannels());
+		std::vector<float> kernel(outputChannels() * inputChannels());
+
+		std::vector<float> gradInput(batchSize() * inputChannels());
+		std::vector<float> referenceGradInput(batchSize() * inputChannels());
+
+		for (size_t iteration = 0; iteration < iterations(); iteration++) {
+			std::generate(gradOutput.begin(), gradOutput.end(), std::ref(rng));
+			std::generate(kernel.begin(), kernel.end(), std::ref(rng));
+			std::fill(gradInput.begin(), gradInput.end(), std::nanf(""));
+
+			nnp_fully_connected_input_gradient__reference(
+				batchSize(), inputChannels(), outputChannels(),
+				gradOutput.data(), kernel.data(), referenceGradInput.data(),
+				this->threadpool);
+
+			enum nnp_status status = nnp_fully_connected_input_gradient(
+				batchSize(), inputChannels(), outputChannels(),
+				gradOutput.data(), kernel.data(), gradInput.data(),
+				this->threadpool, nullptr);
+			ASSERT_EQ(nnp_status_success, status);
+
+			const float maxError = std::inner_product(referenceGradInput.cbegin(), referenceGradInput.cend(), gradInput.cbegin(), 0.0f,
+				[](float x, float y)->float { return std::max<float>(y, x); }, relativeError);
+			EXPECT_LT(maxError, errorLimit());
+		}
+	}
+
+	void testKernelGradient() const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
+
+		std::vector<float> input(batchSize() * inputChannels());
+		std::vector<float> gradOutput(batchSize() * outputChannels());
+
+		std::vector<float> gradKernel(outputChannels() * inputChannels());
+		std::vector<float> referenceGradKernel(outputChannels() * inputChannels());
+
+		for (size_t iteration = 0; iteration < iterations(); iteration++) {
+			std::generate(input.begin(), input.end(), std::ref(rng));
+			std::generate(gradOutput.begin(), gradOutput.end(), std::ref(rng));
+			std::fill(gradKernel.begin(), gradKernel.end(), std::nanf(""));
+
+			nnp_fully_connected_kernel_gradient__reference(
+				batchSize(), inputChannels(), outputChannels(),
+				input.data(), gradOutput.data(), referenceGradKernel.data(),
+				this->threadpool);
+
+			enum nnp_status status = nnp_fully_connected_kernel_gradient(
+				batchSize(), inputChannels(), outputChannels(),
+				input.data(), gradOutput.data(), gradKernel.data(),
+				this->threadpool, nullptr);
+			ASSERT_EQ(nnp_status_success, status);
+
+			const float maxError = std::inner_product(referenceGradKernel.cbegin(), referenceGradKernel.cend(), gradKernel.cbegin(), 0.0f,
+				[](float x, float y)->float { return std::max<float>(y, x); }, relativeError);
+			EXPECT_LT(maxError, errorLimit());
+		}
+	}
+
 protected:
 	pthreadpool_t threadpool;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 
 #include <cmath>
@@ -163,11 +164,11 @@ public:
 	}
 
 	inline size_t outputHeight() const {
-		return divide_round_up(this->inputPadding_.top + this->inputSize_.height + this->inputPadding_.bottom, this->poolingSize_.height);
+		return pooling_output_dimension(this->inputSize_.height, this->inputPadding_.top, this->inputPadding_.bottom, this->poolingSize_.height, this->poolingStride_.height);
 	}
 
 	inline size_t outputWidth() const {
-		return divide_round_up(this->inputPadding_.left + this->inputSize_.width + this->inputPadding_.right, this->poolingSize_.width);
+		return pooling_output_dimension(this->inputSize_.width, this->inputPadding_.left, this->inputPadding_.right, this->poolingSize_.width, this->poolingStride_.width);
 	}
 
 	inline PoolingTester& inputPadding(size_t top, size_t right, size_t left, size_t bottom) {
@@ -213,10 +214,140 @@ public:
 		}
 	}
 
+	void testAverageOutput() const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
+
+		std::vector<float> input(batchSize() * channels() * inputHeight() * inputWidth());
+		std::vector<float> output(batchSize() * channels() * outputHeight() * outputWidth());
+		std::vector<float> referenceOutput(batchSize() * channels() * outputHeight() * outputWidth());
+
+		for (size_t iteration = 0; iteration < iterations(); iteration++) {
+			std::generate(input.begin(), input.end(), std::ref(rng));
+			std::fill(output.begin(), output.end(), std::nanf(""));
+
+			nnp_average_pooling_output__reference(
+				batchSize(), channels(),
+				inputSize(), inputPadding(), poolingSize(), poolingStride(),
+				input.data(), referenceOutput.data(),
+				this->threadpool);
+
+			enum nnp_status status = nnp_average_pooling_output(
+				batchSize(), channels(),
+				inputSize(), inputPadding(), poolingSize(), poolingStride(),
+				input.data(), output.data(),
+				this->threadpool);
+			ASSERT_EQ(nnp_status_success, status);
+
+			const float maxError = std::inner_product(referenceOutput.cbegin(), referenceOutput.cend(), output.cbegin(), 0.0f,
+				[](float x, float y)->float { return std::max<float>(y, x); }, relativeError);
+			EXPECT_LT(maxError, errorLimit());
+		}
+	}
+
+	void testGlobalAverageOutput() const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
+
+		std::vector<float> input(batchSize() * channels() * inputHeight() * inputWidth());
+		std::vector<float> output(batchSize() * channels());
+		std::vector<float> referenceOutput(batchSize() * channels());
+
+		for (size_t iteration = 0; iteration < iterations(); iteration++) {
+			std::generate(input.begin(), input.end(), std::ref(rng));
+			std::fill(output.begin(), output.end(), std::nanf(""));
+
+			nnp_global_average_pooling_output__reference(
+				batchSize(), channels(), inputSize(),
+				input.data(), referenceOutput.data(),
+				this->threadpool);
+
+			enum nnp_status status = nnp_global_average_pooling_output(
+				batchSize(), channels(), inputSize(),
+				input.data(), output.data(),
+				this->threadpool);
+			ASSERT_EQ(nnp_status_success, status);
+
+			const float maxError = std::inner_product(referenceOutput.cbegin(), referenceOutput.cend(), output.cbegin(), 0.0f,
+				[](float x, float y)->float { return std::max<float>(y, x); }, relativeError);
+			EXPECT_LT(maxError, errorLimit());
+		}
+	}
+
+	void testInputGradient() const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<float>(), std::mt19937(seed));
+
+		std::vector<float> input(batchSize() * channels() * inputHeight() * inputWidth());
+		std::vector<float> output(batchSize() * channels() * outputHeight() * outputWidth());
+		std::vector<uint32_t> indices(batchSize() * channels() * outputHeight() * outputWidth());
+		std::vector<float> referenceOutput(batchSize() * channels() * outputHeight() * outputWidth());
+		std::vector<float> gradOutput(batchSize() * channels() * outputHeight() * outputWidth());
+		std::vector<float> gradInput(batchSize() * channels() * inputHeight() * inputWidth());
+		std::vector<float> referenceGradInput(batchSize() * channels() * inputHeight() * inputWidth());
+
+		const size_t inputElements = inputHeight() * inputWidth();
+		const size_t outputElements = outputHeight() * outputWidth();
+		for (size_t iteration = 0; iteration < iterations(); iteration++) {
+			std::generate(input.begin(), input.end(), std::ref(rng));
+			std::generate(gradOutput.begin(), gradOutput.end(), std::ref(rng));
+			std::fill(output.begin(), output.end(), std::nanf(""));
+			std::fill(gradInput.begin(), gradInput.end(), std::nanf(""));
+
+			nnp_max_pooling_output__reference(
+				batchSize(), channels(),
+				inputSize(), inputPadding(), poolingSize(), poolingStride(),
+				input.data(), referenceOutput.data(),
+				this->threadpool);
+
+			nnp_max_pooling_input_gradient__reference(
+				batchSize(), channels(),
+				inputSize(), inputPadding(), poolingSize(), poolingStride(),
+				input.data(), gradOutput.data(), referenceGradInput.data(),
+				this->threadpool);
+
+			enum nnp_status status = nnp_max_pooling_output_with_indices(
+				batchSize(), channels(),
+				inputSize(), inputPadding(), poolingSize(), poolingStride(),
+				input.data(), output.data(), indices.data(),
+				this->threadpool);
+			ASSERT_EQ(nnp_status_success, status);
+
+			ASSERT_EQ(referenceOutput, output);
+			for (size_t image = 0; image < batchSize() * channels(); image++) {
+				for (size_t i = 0; i < outputElements; i++) {
+					const uint32_t index = indices[image * outputElements + i];
+					if (index == UINT32_MAX) {
+						/* Pooling window covers only implicit padding */
+						ASSERT_EQ(-INFINITY, output[image * outputElements + i]);
+					} else {
+						ASSERT_LT(index, inputElements);
+						ASSERT_EQ(output[image * outputElements + i], input[image * inputElements + index]);
+					}
+				}
+			}
+
+			status = nnp_max_pooling_input_gradient(
+				batchSize(), channels(),
+				inputSize(), inputPadding(), poolingSize(), poolingStride(),
+				gradOutput.data(), indices.data(), gradInput.data(),
+				this->threadpool);
+			ASSERT_EQ(nnp_status_success, status);
+
+			const float maxError = std::inner_product(referenceGradInput.cbegin(), referenceGradInput.cend(), gradInput.cbegin(), 0.0f,
+				[](float x, float y)->float { return std::max<float>(y, x); }, absoluteError);
+			EXPECT_LT(maxError, errorLimit());
+		}
+	}
+
 protected:
 	pthreadpool_t threadpool;
 
 private:
+	inline static float absoluteError(float reference, float actual) {
+		return std::abs(reference - actual);
+	}
+
 	inline static float relativeError(float reference, float actual) {
 		return std::abs(reference - actual) / std::max(FLT_MIN, std::abs(reference));
 	}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+
+#include <nnpack.h>
+#include <nnpack/reference.h>
+
+class ReLUTester {
+public:
+	ReLUTester() :
+		iterations_(1),
+		multithreading_(false),
+		inPlace_(false),
+		batchSize_(1),
+		channels_(1),
+		negativeSlope_(0.0f)
+	{
+		this->threadpool = nullptr;
+	}
+
+	ReLUTester(const ReLUTester&) = delete;
+
+	inline ReLUTester(ReLUTester&& tester) :
+		iterations_(tester.iterations_),
+		multithreading_(tester.multithreading_),
+		inPlace_(tester.inPlace_),
+		batchSize_(tester.batchSize_),
+		channels_(tester.channels_),
+		negativeSlope_(tester.negativeSlope_),
+		threadpool(tester.threadpool)
+	{
+		tester.threadpool = nullptr;
+	}
+
+	ReLUTester& operator=(const ReLUTester&) = delete;
+
+	~ReLUTester() {
+		if (this->threadpool != nullptr) {
+			pthreadpool_destroy(this->threadpool);
+			this->threadpool = nullptr;
+		}
+	}
+
+	inline ReLUTester& iterations(size_t iterations) {
+		this->iterations_ = iterations;
+		return *this;
+	}
+
+	inline size_t iterations() const {
+		return this->iterations_;
+	}
+
+	inline ReLUTester& multithreading(bool multithreading) {
+		this->multithreading_ = multithreading;
+		if (multithreading && this->threadpool == nullptr) {
+			this->threadpool = pthreadpool_create(0);
+		} else if (!multithreading && this->threadpool != nullptr) {
+			pthreadpool_destroy(this->threadpool);
+			this->threadpool = nullptr;
+		}
+		return *this;
+	}
+
+	inline bool multithreading() const {
+		return this->multithreading_;
+	}
+
+	inline ReLUTester& inPlace(bool inPlace) {
+		this->inPlace_ = inPlace;
+		return *this;
+	}
+
+	inline bool inPlace() const {
+		return this->inPlace_;
+	}
+
+	inline ReLUTester& batchSize(size_t batchSize) {
+		this->batchSize_ = batchSize;
+		return *this;
+	}
+
+	inline size_t batchSize() const {
+		return this->batchSize_;
+	}
+
+	inline ReLUTester& channels(size_t channels) {
+		this->channels_ = channels;
+		return *this;
+	}
+
+	inline size_t channels() const {
+		return this->channels_;
+	}
+
+	inline ReLUTester& negativeSlope(float negativeSlope) {
+		this->negativeSlope_ = negativeSlope;
+		return *this;
+	}
+
+	inline float negativeSlope() const {
+		return this->negativeSlope_;
+	}
+
+	/*
+	 * ReLU involves at most one multiplication per element, so results must match the reference exactly
+	 */
+	void testOutput() const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<float>(-1.0f, 1.0f), std::mt19937(seed));
+
+		std::vector<float> input(batchSize() * channels());
+		std::vector<float> output(batchSize() * channels());
+		std::vector<float> referenceOutput(batchSize() * channels());
+
+		for (size_t iteration = 0; iteration < iterations(); iteration++) {
+			std::generate(input.begin(), input.end(), std::ref(rng));
+			std::fill(output.begin(), output.end(), std::nanf(""));
+
+			nnp_relu_output__reference(
+				batchSize(), channels(),
+				input.data(), referenceOutput.data(), negativeSlope(),
+				this->threadpool);
+
+			enum nnp_status status;
+			if (inPlace()) {
+				std::copy(input.cbegin(), input.cend(), output.begin());
+				status = nnp_relu_output(
+					batchSize(), channels(),
+					output.data(), output.data(), negativeSlope(),
+					this->threadpool);
+			} else {
+				status = nnp_relu_output(
+					batchSize(), channels(),
+					input.data(), output.data(), negativeSlope(),
+					this->threadpool);
+			}
+			ASSERT_EQ(nnp_status_success, status);
+
+			EXPECT_EQ(referenceOutput, output);
+		}
+	}
+
+	void testInputGradient() const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<float>(-1.0f, 1.0f), std::mt19937(seed));
+
+		std::vector<float> input(batchSize() * channels());
+		std::vector<float> outputGradient(batchSize() * channels());
+		std::vector<float> inputGradient(batchSize() * channels());
+		std::vector<float> referenceInputGradient(batchSize() * channels());
+
+		for (size_t iteration = 0; iteration < iterations(); iteration++) {
+			std::generate(input.begin(), input.end(), std::ref(rng));
+			std::generate(outputGradient.begin(), outputGradient.end(), std::ref(rng));
+			std::fill(inputGradient.begin(), inputGradient.end(), std::nanf(""));
+
+			nnp_relu_input_gradient__reference(
+				batchSize(), channels(),
+				outputGradient.data(), input.data(), referenceInputGradient.data(), negativeSlope(),
+				this->threadpool);
+
+			enum nnp_status status;
+			if (inPlace()) {
+				std::copy(outputGradient.cbegin(), outputGradient.cend(), inputGradient.begin());
+				status = nnp_relu_input_gradient(
+					batchSize(), channels(),
+					inputGradient.data(), input.data(), inputGradient.data(), negativeSlope(),
+					this->threadpool);
+			} else {
+				status = nnp_relu_input_gradient(
+					batchSize(), channels(),
+					outputGradient.data(), input.data(), inputGradient.data(), negativeSlope(),
+					this->threadpool);
+			}
+			ASSERT_EQ(nnp_status_success, status);
+
+			EXPECT_EQ(referenceInputGradient, inputGradient);
+		}
+	}
+
+protected:
+	pthreadpool_t threadpool;
+
+private:
+	size_t iterations_;
+	bool multithreading_;
+	bool inPlace_;
+
+	size_t batchSize_;
+	size_t channels_;
+	float negativeSlope_;
+};